@@ -0,0 +1,156 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file BenchmarkSerialization.cpp
+ *
+ */
+
+#include "BenchmarkSerialization.h"
+#include "BenchmarkPubSubTypes.h"
+#include "Benchmark_smallPubSubTypes.h"
+#include "Benchmark_mediumPubSubTypes.h"
+#include "Benchmark_bigPubSubTypes.h"
+
+#include <fastrtps/types/DynamicDataFactory.h>
+#include <fastrtps/types/DynamicTypeBuilderFactory.h>
+#include <fastrtps/types/DynamicTypeBuilderPtr.h>
+#include <fastrtps/types/DynamicTypeBuilder.h>
+#include <fastrtps/types/DynamicPubSubType.h>
+#include <fastrtps/types/DynamicData.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+using namespace eprosima::fastrtps::types;
+
+BenchMarkSerialization::BenchMarkSerialization()
+	: m_iTestTimeMs(10000)
+	, m_iSize(0)
+{
+}
+
+BenchMarkSerialization::~BenchMarkSerialization()
+{
+}
+
+bool BenchMarkSerialization::init(int time, int size)
+{
+	m_iTestTimeMs = time;
+	m_iSize = size;
+	return m_iTestTimeMs > 0;
+}
+
+void BenchMarkSerialization::measure(const std::string& name, TopicDataType& type, void* data)
+{
+	// Half of the time for each direction.
+	std::chrono::milliseconds test_time(m_iTestTimeMs / 2);
+	SerializedPayload_t payload(type.m_typeSize);
+	uint64_t serialized = 0;
+	uint64_t deserialized = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	auto end = start;
+	while (end - start < test_time)
+	{
+		type.serialize(data, &payload);
+		++serialized;
+		end = std::chrono::steady_clock::now();
+	}
+	double serialize_us = std::chrono::duration<double, std::micro>(end - start).count() / serialized;
+
+	start = std::chrono::steady_clock::now();
+	end = start;
+	while (end - start < test_time)
+	{
+		type.deserialize(&payload, data);
+		++deserialized;
+		end = std::chrono::steady_clock::now();
+	}
+	double deserialize_us = std::chrono::duration<double, std::micro>(end - start).count() / deserialized;
+
+	std::cout << name << " (" << payload.length << " bytes): serialize " << serialize_us << " us, deserialize "
+		<< deserialize_us << " us" << std::endl;
+}
+
+void BenchMarkSerialization::run()
+{
+	DynamicTypeBuilderFactory* factory = DynamicTypeBuilderFactory::get_instance();
+	DynamicTypeBuilder_ptr struct_builder = factory->create_struct_builder();
+	std::vector<uint32_t> lengths;
+	MemberId index_id = 0;
+
+	switch (m_iSize)
+	{
+	default:
+	case 0:
+	{
+		BenchMarkPubSubType type;
+		BenchMark sample;
+		sample.index(1);
+		measure("Generated BenchMark", type, &sample);
+		struct_builder->set_name("BenchMark");
+		break;
+	}
+	case 1:
+	{
+		BenchMarkSmallPubSubType type;
+		BenchMarkSmall sample;
+		sample.index(1);
+		measure("Generated BenchMarkSmall", type, &sample);
+		struct_builder->set_name("BenchMarkSmall");
+		lengths.push_back(16384);
+		break;
+	}
+	case 2:
+	{
+		BenchMarkMediumPubSubType type;
+		BenchMarkMedium* sample = new BenchMarkMedium();
+		sample->index(1);
+		measure("Generated BenchMarkMedium", type, sample);
+		delete sample;
+		struct_builder->set_name("BenchMarkMedium");
+		lengths.push_back(524288);
+		break;
+	}
+	case 3:
+	{
+		BenchMarkBigPubSubType type;
+		BenchMarkBig* sample = new BenchMarkBig();
+		sample->index(1);
+		measure("Generated BenchMarkBig", type, sample);
+		delete sample;
+		struct_builder->set_name("BenchMarkBig");
+		lengths.push_back(8388608);
+		break;
+	}
+	}
+
+	// Same layout as the IDL types: an optional char array followed by the index.
+	if (!lengths.empty())
+	{
+		DynamicTypeBuilder_ptr array_builder = factory->create_array_builder(factory->create_char8_builder(), lengths);
+		struct_builder->add_member(index_id++, "data", array_builder.get());
+	}
+	struct_builder->add_member(index_id, "index", factory->create_uint32_type());
+
+	DynamicType_ptr dynamic_type = struct_builder->build();
+	DynamicPubSubType dynamic_pubsub(dynamic_type);
+	DynamicData* dynamic_sample = DynamicDataFactory::get_instance()->create_data(dynamic_type);
+	dynamic_sample->set_uint32_value(1, index_id);
+	measure("Dynamic " + dynamic_type->get_name(), dynamic_pubsub, dynamic_sample);
+	DynamicDataFactory::get_instance()->delete_data(dynamic_sample);
+}
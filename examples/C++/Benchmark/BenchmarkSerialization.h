@@ -0,0 +1,47 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file BenchmarkSerialization.h
+ *
+ */
+
+#ifndef BENCHMARKSERIALIZATION_H_
+#define BENCHMARKSERIALIZATION_H_
+
+#include <fastrtps/TopicDataType.h>
+
+#include <string>
+
+/**
+ * Measures, without any network involved, the serialization and deserialization of the benchmark types
+ * using the generated code and the equivalent dynamic type.
+ */
+class BenchMarkSerialization {
+public:
+	BenchMarkSerialization();
+	virtual ~BenchMarkSerialization();
+	//!Initialize
+	bool init(int time, int size);
+	//!Run the measurements
+	void run();
+private:
+
+	void measure(const std::string& name, eprosima::fastrtps::TopicDataType& type, void* data);
+
+	int m_iTestTimeMs;
+	int m_iSize;
+};
+
+#endif /* BENCHMARKSERIALIZATION_H_ */
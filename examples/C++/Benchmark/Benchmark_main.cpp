@@ -19,6 +19,7 @@
 
 #include "BenchmarkPublisher.h"
 #include "BenchmarkSubscriber.h"
+#include "BenchmarkSerialization.h"
 
 #include <fastrtps/Domain.h>
 
@@ -57,12 +58,18 @@ int main(int argc, char** argv)
         {
             type = 2;
         }
+        else if(strcmp(argv[1],"serialization")==0)
+        {
+            type = 3;
+        }
         else
         {
             paramsOk = false;
         }
 
-        if (paramsOk && argc > 2)
+        // The serialization test doesn't use any transport.
+        int first_option = type == 3 ? 2 : 3;
+        if (paramsOk && type != 3 && argc > 2)
         {
             if (strcmp(argv[2], "udp") == 0)
             {
@@ -85,13 +92,13 @@ int main(int argc, char** argv)
                 paramsOk = false;
             }
         }
-		if (argc > 3)
+		if (argc > first_option)
 		{
-			if (argc % 2 == 0)
+			if ((argc - first_option) % 2 != 0)
 			{
 				paramsOk = false;
 			}
-			for (int i = 3; i < argc; i += 2)
+			for (int i = first_option; i < argc; i += 2)
 			{
 				if (strcmp(argv[i], "-topic") == 0)
 				{
@@ -165,7 +172,7 @@ int main(int argc, char** argv)
 
     if (!paramsOk)
     {
-		std::cout << "publisher OR subscriber argument needed" << std::endl;
+		std::cout << "publisher OR subscriber OR serialization argument needed" << std::endl;
 		std::cout << "tcp OR udp argument needed" << std::endl;
 		std::cout << "-------------------------------------------------------------------- " << std::endl;
 		std::cout << "Common optional arguments: [-topic] [-domain][-reliable] " << std::endl;
@@ -183,6 +190,8 @@ int main(int argc, char** argv)
 		std::cout << "\t-time: Milliseconds that the test is going to run. " << std::endl;
 		std::cout << "\t-tick: Milliseconds to take samples of the performance. " << std::endl;
 		std::cout << "-------------------------------------------------------------------- " << std::endl;
+		std::cout << "serialization compares generated and dynamic types, it only uses [-size] and [-time] " << std::endl;
+		std::cout << "-------------------------------------------------------------------- " << std::endl;
         Log::Reset();
         return 0;
     }
@@ -209,6 +218,15 @@ int main(int argc, char** argv)
 				delete mysub;
                 break;
             }
+        case 3:
+            {
+                BenchMarkSerialization myser;
+                if(myser.init(test_time, size))
+                {
+                    myser.run();
+                }
+                break;
+            }
     }
     Domain::stopAll();
     Log::Reset();
@@ -81,6 +81,15 @@ class  TopicDataType {
          */
         RTPS_DllAPI virtual bool getKey(void* data, rtps::InstanceHandle_t* ihandle, bool force_md5 = false) = 0;
 
+        /**
+         * Whether the type is plain: it has a bounded size, has no pointers or references to other memory, and
+         * serialize() writes the sample at the start of the payload exactly as it is laid out in memory.
+         * Subscribers of plain types can access loaned samples in place, with SampleLoan::get.
+         * Plain types are only meant for topics where all the participants use the same platform.
+         * @return False by default.
+         */
+        RTPS_DllAPI virtual bool is_plain() const { return false; }
+
         /**
          * Set topic data type name
          * @param nam Topic data type name
@@ -41,6 +41,7 @@
 #include "attributes/SubscriberAttributes.h"
 
 #include "subscriber/SampleInfo.h"
+#include "subscriber/SampleLoan.h"
 #include "TopicDataType.h"
 
 #include "utils/IPFinder.h"
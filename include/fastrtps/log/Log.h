@@ -22,6 +22,9 @@
 #include <sstream>
 #include <atomic>
 #include <regex>
+#include <chrono>
+#include <memory>
+#include <vector>
 
 /**
  * eProsima log layer. Logging categories and verbosities can be specified dynamically at runtime. However, even on a category
@@ -33,6 +36,12 @@
  * * #define LOG_NO_INFO
  *
  * Additionally. the lowest level (Info) is disabled by default on release branches.
+ *
+ * Messages are written by the calling thread into a fixed-size record of a per-thread ring, which is handed over to
+ * the logging thread without locking. Timestamps, filtering and the consumers run on the logging thread, so once
+ * the ring of a thread is created, logging does not allocate on it. Messages longer than Log::MaxMessageSize are
+ * truncated, and entries are dropped (and accounted on the next entry) when the ring of a thread is full or when
+ * the category exceeds the rate set with Log::SetCategoryRateLimit.
  */
 
 // Logging API:
@@ -104,6 +113,14 @@ class Log
         //! Sets a filter that will pattern-match against the provided error string, dropping any unmatched categories.
         RTPS_DllAPI static void SetErrorStringFilter(const std::regex&);
 
+        /**
+        * Limits the number of entries per second that each category can produce.
+        * Exceeding entries are dropped before being formatted, and their number is reported on the next entry
+        * of the category.
+        * @param max_entries_per_second Maximum number of entries per second and category. 0 means no limit (default).
+        */
+        RTPS_DllAPI static void SetCategoryRateLimit(uint32_t max_entries_per_second);
+
         //! Returns the logging engine to configuration defaults.
         RTPS_DllAPI static void Reset();
 
@@ -143,7 +160,80 @@ class Log
                 const Log::Context&,
                 Log::Kind);
 
+        //! Maximum length of the message of an entry produced by the logging macros.
+        static const size_t MaxMessageSize = 512;
+
+        /**
+        * Not recommended to call this method directly! Use the logging macros.
+        * Opens a record on the ring of the calling thread.
+        * @param category Category of the entry.
+        * @return Stream where the message should be written, nullptr when the entry should be dropped.
+        */
+        RTPS_DllAPI static std::ostream* StartRecord(const char* category);
+
+        /**
+        * Not recommended to call this method directly! Use the logging macros.
+        * Hands over the record opened with StartRecord to the logging thread.
+        */
+        RTPS_DllAPI static void CommitRecord(
+                const Log::Context&,
+                Log::Kind);
+
+        /**
+        * Not recommended to call this method directly! Use the logging macros.
+        * Drops the record opened with StartRecord, when writing its message has failed.
+        */
+        RTPS_DllAPI static void DiscardRecord();
+
+        /**
+        * Not recommended to use directly! Used by the logging macros.
+        * Discards the open record of the thread unless it is committed, e.g. when writing the message throws.
+        */
+        class RecordGuard
+        {
+        public:
+
+            RecordGuard()
+                : committed_(false)
+            {
+            }
+
+            ~RecordGuard()
+            {
+                if (!committed_)
+                {
+                    Log::DiscardRecord();
+                }
+            }
+
+            void commit(
+                    const Log::Context& context,
+                    Log::Kind kind)
+            {
+                Log::CommitRecord(context, kind);
+                committed_ = true;
+            }
+
+        private:
+
+            RecordGuard(const RecordGuard&) = delete;
+            RecordGuard& operator=(const RecordGuard&) = delete;
+
+            bool committed_;
+        };
+
     private:
+        struct ThreadRing;
+
+        struct RateBucket
+        {
+            std::atomic<int64_t> window;
+            std::atomic<uint32_t> count;
+            std::atomic<uint32_t> suppressed;
+        };
+
+        static const size_t RateBuckets = 64;
+
         struct Resources
         {
             DBQueue<Entry> mLogs;
@@ -166,6 +256,15 @@ class Log
 
             std::atomic<Log::Kind> mVerbosity;
 
+            // Per-thread rings of records.
+            std::mutex mRingsMutex;
+            std::vector<std::shared_ptr<ThreadRing>> mRings;
+            std::atomic_bool mWakeRequested;
+
+            // Rate limiting, indexed by a hash of the category.
+            std::atomic<uint32_t> mRateLimit;
+            RateBucket mRateBuckets[RateBuckets];
+
             Resources();
 
             ~Resources();
@@ -182,7 +281,20 @@ class Log
 
         static void Run();
 
-        static void GetTimestamp(std::string&);
+        // Wakes up the logging thread, launching it when not running.
+        static void Wake();
+
+        // Returns the ring of the calling thread, creating it on first use.
+        static ThreadRing* GetThreadRing();
+
+        // Consumes all the records available on the rings.
+        static void ConsumeRings();
+
+        static bool RingsEmpty();
+
+        static void GetTimestamp(
+                std::string&,
+                const std::chrono::system_clock::time_point&);
 };
 
 /**
@@ -226,25 +338,33 @@ class LogConsumer
 #endif
 
 #ifndef LOG_NO_ERROR
-#define logError_(cat, msg)                                                                          \
-    {                                                                                                \
-        std::stringstream ss;                                                                        \
-        ss << msg;                                                                                   \
-        Log::QueueLog(ss.str(), Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Error); \
+#define logError_(cat, msg)                                                                             \
+    {                                                                                                   \
+        std::ostream* log_stream_ = Log::StartRecord(#cat);                                             \
+        if (log_stream_ != nullptr)                                                                     \
+        {                                                                                               \
+            Log::RecordGuard log_guard_;                                                                \
+            *log_stream_ << msg;                                                                        \
+            log_guard_.commit(Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Error);      \
+        }                                                                                               \
     }
 #else
 #define logError_(cat, msg)
 #endif
 
 #ifndef LOG_NO_WARNING
-#define logWarning_(cat, msg)                                                                              \
-    {                                                                                                      \
-        if (Log::GetVerbosity() >= Log::Kind::Warning)                                                     \
-        {                                                                                                  \
-            std::stringstream ss;                                                                          \
-            ss << msg;                                                                                     \
-            Log::QueueLog(ss.str(), Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Warning); \
-        }                                                                                                  \
+#define logWarning_(cat, msg)                                                                           \
+    {                                                                                                   \
+        if (Log::GetVerbosity() >= Log::Kind::Warning)                                                  \
+        {                                                                                               \
+            std::ostream* log_stream_ = Log::StartRecord(#cat);                                         \
+            if (log_stream_ != nullptr)                                                                 \
+            {                                                                                           \
+                Log::RecordGuard log_guard_;                                                            \
+                *log_stream_ << msg;                                                                    \
+                log_guard_.commit(Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Warning);\
+            }                                                                                           \
+        }                                                                                               \
     }
 #else
 #define logWarning_(cat, msg)
@@ -255,9 +375,13 @@ class LogConsumer
     {                                                                                                   \
         if (Log::GetVerbosity() >= Log::Kind::Info)                                                     \
         {                                                                                               \
-            std::stringstream ss;                                                                       \
-            ss << msg;                                                                                  \
-            Log::QueueLog(ss.str(), Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Info); \
+            std::ostream* log_stream_ = Log::StartRecord(#cat);                                         \
+            if (log_stream_ != nullptr)                                                                 \
+            {                                                                                           \
+                Log::RecordGuard log_guard_;                                                            \
+                *log_stream_ << msg;                                                                    \
+                log_guard_.commit(Log::Context{__FILE__, __LINE__, __func__, #cat}, Log::Kind::Info);   \
+            }                                                                                           \
         }                                                                                               \
     }
 #else
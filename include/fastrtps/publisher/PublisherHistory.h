@@ -26,6 +26,7 @@
 #include "../rtps/history/WriterHistory.h"
 #include "../qos/QosPolicies.h"
 #include "../common/KeyedChanges.h"
+#include "../utils/collections/IndexedHeap.hpp"
 
 namespace eprosima {
 namespace fastrtps {
@@ -121,6 +122,8 @@ private:
         t_m_Inst_Caches keyed_changes_;
         //!Time point when the next deadline will occur (only used for topics with no key)
         std::chrono::steady_clock::time_point next_deadline_us_;
+        //!Next deadline of each instance, earliest first (only used for topics with key)
+        IndexedHeap<rtps::InstanceHandle_t, std::chrono::steady_clock::time_point> instance_deadlines_;
         //!HistoryQosPolicy values.
         HistoryQosPolicy m_historyQos;
         //!ResourceLimitsQosPolicy values.
@@ -22,12 +22,16 @@
 #define RTPSRTPSParticipant_H_
 
 #include "common/Types.h"
+#include "common/Guid.h"
 
 #include "attributes/RTPSParticipantAttributes.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <map>
 #include <mutex>
 #include <set>
+#include <vector>
 
 namespace eprosima{
 namespace fastrtps{
@@ -130,6 +134,29 @@ class RTPSDomain
             m_maxRTPSParticipantID = maxRTPSParticipantId;
         }
 
+        /**
+         * Find a user reader created in this process.
+         * Used by the writers delivering their data without the transports (see
+         * RTPSParticipantAttributes::intraprocessDelivery).
+         * @param reader_guid GUID of the reader.
+         * @return Pointer to the reader, or nullptr if it does not belong to this process.
+         */
+        static RTPSReader* find_local_reader(const GUID_t& reader_guid);
+
+        /**
+         * Keep a user reader created in this process from being destroyed while data is handed to it.
+         * Every successful call must be followed by a call to release_local_reader.
+         * @param reader_guid GUID of the reader.
+         * @return Pointer to the reader, or nullptr if it does not belong to this process or it is being removed.
+         */
+        static RTPSReader* acquire_local_reader(const GUID_t& reader_guid);
+
+        /**
+         * Allow the destruction of a reader obtained with acquire_local_reader.
+         * @param reader_guid GUID of the reader.
+         */
+        static void release_local_reader(const GUID_t& reader_guid);
+
     private:
         typedef std::pair<RTPSParticipant*,RTPSParticipantImpl*> t_p_RTPSParticipant;
 
@@ -148,6 +175,32 @@ class RTPSDomain
 
         static void removeRTPSParticipant_nts(std::vector<t_p_RTPSParticipant>::iterator it);
 
+        /**
+         * Remove a reader from the local readers, and make the writers of this process stop using it.
+         * Must be called with m_mutex taken, so no writer is removed meanwhile.
+         * @param reader Reader that is going to be removed.
+         */
+        static void unregister_local_reader_nts(RTPSReader* reader);
+
+        /**
+         * Remove all the readers of a participant from the local readers.
+         * Must be called with m_mutex taken.
+         * @param participant Participant that is going to be removed.
+         * @param reader_guids Filled with the GUIDs of the readers removed.
+         */
+        static void unregister_local_readers_nts(
+                RTPSParticipantImpl* participant,
+                std::vector<GUID_t>& reader_guids);
+
+        /**
+         * Wait until no data is being handed to a reader removed from the local readers.
+         * Deliveries in progress on the calling thread, i.e. when called from a listener of the reader, are not
+         * waited for.
+         * Must be called without m_mutex taken, as the listener of the reader may need it.
+         * @param reader_guid GUID of the reader.
+         */
+        static void wait_local_reader_released(const GUID_t& reader_guid);
+
         static std::mutex m_mutex;
 
         static std::atomic<uint32_t> m_maxRTPSParticipantID;
@@ -155,6 +208,23 @@ class RTPSDomain
         static std::vector<t_p_RTPSParticipant> m_RTPSParticipants;
 
         static std::set<uint32_t> m_RTPSParticipantIDs;
+
+        //! Reader of this process and the number of deliveries in progress to it.
+        struct LocalReader
+        {
+            RTPSReader* reader;
+            uint32_t in_use;
+            //! The reader is being removed, so no new delivery may start.
+            bool removed;
+        };
+
+        //! Protects m_local_readers. No other lock is taken while holding it.
+        static std::mutex m_local_readers_mutex;
+
+        //! Signaled when a removed reader is no longer in use.
+        static std::condition_variable m_local_readers_cv;
+
+        static std::map<GUID_t, LocalReader> m_local_readers;
 };
 
 }
@@ -295,6 +295,8 @@ class RTPSParticipantAttributes
             setName("RTPSParticipant");
             sendSocketBufferSize = 0;
             listenSocketBufferSize = 0;
+            receiveProcessingThreads = 0;
+            intraprocessDelivery = false;
             participantID = -1;
             useBuiltinTransports = true;
         }
@@ -308,6 +310,8 @@ class RTPSParticipantAttributes
                    (this->defaultMulticastLocatorList == b.defaultMulticastLocatorList) &&
                    (this->sendSocketBufferSize == b.sendSocketBufferSize) &&
                    (this->listenSocketBufferSize == b.listenSocketBufferSize) &&
+                   (this->receiveProcessingThreads == b.receiveProcessingThreads) &&
+                   (this->intraprocessDelivery == b.intraprocessDelivery) &&
                    (this->builtin == b.builtin) &&
                    (this->port == b.port) &&
                    (this->userData == b.userData) &&
@@ -341,6 +345,23 @@ class RTPSParticipantAttributes
          */
         uint32_t listenSocketBufferSize;
 
+        /*!
+         * @brief Number of threads delivering received data to the readers.
+         * Submessages are assigned to a thread by writer GUID, so the data of each writer is still processed in order.
+         * Zero value indicates to deliver the data on the thread receiving it.
+         * Default value: 0.
+         */
+        uint32_t receiveProcessingThreads;
+
+        /*!
+         * @brief Whether the writers of this participant hand their data directly to the matched readers
+         * created in the same process, instead of sending it through the transports.
+         * The data is handed on the thread writing it once the writer is unlocked, so the listeners of the readers
+         * are called on that thread.
+         * Default value: false.
+         */
+        bool intraprocessDelivery;
+
         //! Optionally allow user defined GuidPrefix_t
         GuidPrefix_t prefix;
 
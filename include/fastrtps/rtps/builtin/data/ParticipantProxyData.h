@@ -29,6 +29,8 @@
 #include "../../common/Token.h"
 #include "../../common/RemoteLocators.hpp"
 
+#include <array>
+
 #if HAVE_SECURITY
 #include "../../security/accesscontrol/ParticipantSecurityAttributes.h"
 #endif
@@ -131,6 +133,8 @@ class ParticipantProxyData
         ResourceLimitedVector<ReaderProxyData*> m_readers;
         //!
         ResourceLimitedVector<WriterProxyData*> m_writers;
+        //!MD5 digest of the last announcement received from this participant. All zeros when unknown.
+        std::array<octet, 16> m_payloadDigest;
 
         /**
          * Update the data.
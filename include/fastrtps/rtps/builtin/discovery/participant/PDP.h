@@ -23,6 +23,7 @@
 
 #include <mutex>
 #include <functional>
+#include <unordered_map>
 
 #include "../../../common/Guid.h"
 #include "../../../attributes/RTPSParticipantAttributes.h"
@@ -304,6 +305,20 @@ public:
     CDRMessage_t get_participant_proxy_data_serialized(Endianness_t endian);
 
 protected:
+    //! Hashes a GuidPrefix_t for the participant proxies index.
+    struct GuidPrefixHash
+    {
+        size_t operator()(const GuidPrefix_t& prefix) const
+        {
+            size_t ret_val = 0;
+            for (size_t i = 0; i < GuidPrefix_t::size; ++i)
+            {
+                ret_val = (ret_val * 31) ^ prefix.value[i];
+            }
+            return ret_val;
+        }
+    };
+
     //!Pointer to the builtin protocols object.
     BuiltinProtocols* mp_builtin;
     //!TimedEvent to periodically resend the local RTPSParticipant information.
@@ -324,6 +339,8 @@ protected:
     ResourceLimitedVector<ParticipantProxyData*> participant_proxies_;
     //!Pool of participant proxy data objects ready for reuse
     ResourceLimitedVector<ParticipantProxyData*> participant_proxies_pool_;
+    //!Registered RTPSParticipants indexed by their GuidPrefix_t. Kept in sync with participant_proxies_.
+    std::unordered_map<GuidPrefix_t, ParticipantProxyData*, GuidPrefixHash> participant_proxies_by_prefix_;
     //!Number of reader proxy data objects created
     size_t reader_proxies_number_;
     //!Pool of reader proxy data objects ready for reuse
@@ -362,6 +379,26 @@ protected:
             const GUID_t& participant_guid,
             bool with_lease_duration);
 
+    /**
+     * Looks for the participant proxy information of a participant.
+     * Should be called with mp_mutex taken.
+     *
+     * @param prefix GuidPrefix_t of the participant to look for.
+     *
+     * @return pointer to the proxy object, nullptr if the participant is not known.
+     */
+    ParticipantProxyData* find_participant_proxy_data(
+            const GuidPrefix_t& prefix) const;
+
+    /**
+     * Refreshes the lease duration of a remote participant.
+     * Should be called with mp_mutex taken.
+     *
+     * @param pdata Proxy object of the participant.
+     */
+    void refresh_participant_lease(
+            ParticipantProxyData* pdata);
+
     /**
      * Gets the key of a participant proxy data.
      *
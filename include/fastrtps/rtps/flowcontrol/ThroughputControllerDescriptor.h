@@ -33,14 +33,20 @@ struct ThroughputControllerDescriptor
     uint32_t bytesPerPeriod;
     //! Window of time in which no more than 'bytesPerPeriod' bytes are allowed.
     uint32_t periodMillisecs;
+    /**
+     * Maximum number of bytes that can be accumulated while the controller is idle and then sent at once.
+     * Zero means 'bytesPerPeriod'.
+     */
+    uint32_t burstSize;
 
     RTPS_DllAPI ThroughputControllerDescriptor();
-    RTPS_DllAPI ThroughputControllerDescriptor(uint32_t size, uint32_t time);
+    RTPS_DllAPI ThroughputControllerDescriptor(uint32_t size, uint32_t time, uint32_t burst = 0);
 
     bool operator==(const ThroughputControllerDescriptor& b) const
     {
         return (this->bytesPerPeriod == b.bytesPerPeriod) &&
-               (this->periodMillisecs == b.periodMillisecs);
+               (this->periodMillisecs == b.periodMillisecs) &&
+               (this->burstSize == b.burstSize);
     }
 };
 
@@ -29,6 +29,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <mutex>
+#include <atomic>
 
 
 namespace eprosima {
@@ -57,8 +58,8 @@ class CacheChangePool {
          * @brief Reserves a CacheChange from the pool.
          * @param chan Returned pointer to the reserved CacheChange.
          * @param calculateSizeFunc Function that returns the size of the data which will go into the CacheChange.
-         * This function is executed depending on the memory management policy (DYNAMIC_RESERVE_MEMORY_MODE and
-         * PREALLOCATED_WITH_REALLOC_MEMORY_MODE)
+         * This function is executed depending on the memory management policy (DYNAMIC_RESERVE_MEMORY_MODE,
+         * PREALLOCATED_WITH_REALLOC_MEMORY_MODE and SIZE_CLASS_MEMORY_MODE)
          * @return True whether the CacheChange could be allocated. In other case returns false.
          */
         bool reserve_Cache(CacheChange_t** chan, const std::function<uint32_t()>& calculateSizeFunc);
@@ -67,17 +68,24 @@ class CacheChangePool {
          * @brief Reserves a CacheChange from the pool.
          * @param chan Returned pointer to the reserved CacheChange.
          * @param dataSize Size of the data which will go into the CacheChange if it is necessary (on memory management
-         * policy DYNAMIC_RESERVE_MEMORY_MODE and PREALLOCATED_WITH_REALLOC_MEMORY_MODE). In other case this variable is not used.
+         * policy DYNAMIC_RESERVE_MEMORY_MODE, PREALLOCATED_WITH_REALLOC_MEMORY_MODE and SIZE_CLASS_MEMORY_MODE).
+         * In other case this variable is not used.
          * @return True whether the CacheChange could be allocated. In other case returns false.
          */
         bool reserve_Cache(CacheChange_t** chan, uint32_t dataSize);
 
-        //!Release a Cache back to the pool.
+        /*!
+         * @brief Release a Cache back to the pool.
+         * On SIZE_CLASS_MEMORY_MODE this method is lock-free, and can be called concurrently with itself and with
+         * reserve_Cache.
+         */
         void release_Cache(CacheChange_t*);
+        //!Whether release_Cache can be called without holding the lock of the history.
+        inline bool is_release_lock_free() const { return memoryMode == SIZE_CLASS_MEMORY_MODE; }
         //!Get the size of the cache vector; all of them (reserved and not reserved).
         size_t get_allCachesSize(){return m_allCaches.size();}
         //!Get the number of frre caches.
-        size_t get_freeCachesSize(){return m_freeCaches.size();}
+        size_t get_freeCachesSize(){return m_freeCaches.size() + m_freeClassesCount + m_releasedCount;}
         //!Get the initial payload size associated with the Pool.
         inline uint32_t getInitialPayloadSize(){return m_initial_payload_size;};
     private:
@@ -87,8 +95,20 @@ class CacheChangePool {
         uint32_t m_max_pool_size;
         std::vector<CacheChange_t*> m_freeCaches;
         std::vector<CacheChange_t*> m_allCaches;
+        //!Free caches on SIZE_CLASS_MEMORY_MODE, one list per size class.
+        std::vector<std::vector<CacheChange_t*>> m_freeClasses;
+        //!Number of caches on m_freeClasses.
+        size_t m_freeClassesCount;
+        //!Caches released on SIZE_CLASS_MEMORY_MODE, not yet moved to m_freeClasses.
+        std::atomic<CacheChange_t*> m_releasedCaches;
+        //!Number of caches on m_releasedCaches.
+        std::atomic<size_t> m_releasedCount;
         bool allocateGroup(uint32_t pool_size);
         CacheChange_t* allocateSingle(uint32_t dataSize);
+        bool reserveSizeClass(CacheChange_t** chan, uint32_t dataSize);
+        bool takeFromSmallerClass(uint32_t size_class, CacheChange_t*& ch);
+        void collectReleased();
+        static void resetChange(CacheChange_t* ch);
         MemoryManagementPolicy_t memoryMode;
 };
 }
@@ -28,6 +28,7 @@
 #include "../common/Guid.h"
 #include "../attributes/HistoryAttributes.h"
 #include "../../utils/TimedMutex.hpp"
+#include "../../utils/collections/HeadIndexedVector.hpp"
 
 #include <cassert>
 
@@ -69,10 +70,16 @@ class History
 
         /**
          * release a previously reserved CacheChange_t.
+         * The history mutex is only taken when the memory policy of the pool needs it.
          * @param ch Pointer to the CacheChange_t.
          */
         RTPS_DllAPI inline void release_Cache(CacheChange_t* ch)
         {
+            if (m_changePool.is_release_lock_free())
+            {
+                return m_changePool.release_Cache(ch);
+            }
+
             std::lock_guard<RecursiveTimedMutex> guard(*mp_mutex);
             return m_changePool.release_Cache(ch);
         }
@@ -163,8 +170,8 @@ class History
 
     protected:
 
-        //!Vector of pointers to the CacheChange_t.
-        std::vector<CacheChange_t*> m_changes;
+        //!Vector of pointers to the CacheChange_t. Removing the first one does not move the rest.
+        HeadIndexedVector<CacheChange_t*> m_changes;
 
         //!Variable to know if the history is full without needing to block the History mutex.
         bool m_isHistoryFull;
@@ -181,6 +188,9 @@ class History
         //!Pointer to the maximum sequeceNumber CacheChange.
         CacheChange_t* mp_maxSeqCacheChange;
 
+        //!The minimum and maximum changes have to be looked for again before being used.
+        bool m_isMinMaxOutdated;
+
         //!Print the seqNum of the changes in the History (for debuggisi, mng purposes).
         void print_changes_seqNum2();
 
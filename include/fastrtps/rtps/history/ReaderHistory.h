@@ -75,7 +75,9 @@ public:
      * */
     RTPS_DllAPI bool remove_changes_with_guid(const GUID_t& a_guid);
     /**
-     * Sort the CacheChange_t from the History by timestamp
+     * Sort the CacheChange_t from the History by timestamp.
+     * Changes are already kept sorted when added, so this is only needed if their timestamps are modified
+     * while stored in the history.
      */
     RTPS_DllAPI void sortCacheChanges();
     /**
@@ -86,6 +88,22 @@ public:
     RTPS_DllAPI bool get_min_change_from(CacheChange_t** min_change, const GUID_t& writerGuid);
 
 protected:
+    /**
+     * Find a change in the history, using a binary search on its source timestamp.
+     * @param a_change Pointer to a change with the sequence number, writer GUID and timestamp to look for.
+     * @return Iterator to the change in the history, or m_changes.end() if not found.
+     */
+    std::vector<CacheChange_t*>::iterator find_change(const CacheChange_t* a_change);
+
+    /**
+     * Remove a CacheChange_t from the ReaderHistory.
+     * @param a_change Pointer to the CacheChange to remove.
+     * @param release Whether the change is given back to the pool. When false, it must be given back later
+     * with release_Cache.
+     * @return True if removed.
+     */
+    bool remove_change(CacheChange_t* a_change, bool release);
+
     //!Pointer to the reader
     RTPSReader* mp_reader;
 };
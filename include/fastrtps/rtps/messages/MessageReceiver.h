@@ -24,8 +24,11 @@
 
 #include "../common/all_common.h"
 #include "../../qos/ParameterList.h"
+#include "../../utils/shared_mutex.hpp"
 
-#include <mutex>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace eprosima {
 namespace fastrtps {
@@ -35,6 +38,8 @@ class RTPSParticipantImpl;
 class Endpoint;
 class RTPSWriter;
 class RTPSReader;
+class ReceiveProcessingPool;
+class CacheChangePool;
 struct SubmessageHeader_t;
 
 /**
@@ -78,9 +83,25 @@ class MessageReceiver
         void removeEndpoint(Endpoint *to_remove);
 
     private:
+
+        //! Hashes an EntityId_t for the dispatch tables.
+        struct EntityIdHash
+        {
+            size_t operator()(const EntityId_t& id) const
+            {
+                return (static_cast<size_t>(id.value[0]) << 24) | (static_cast<size_t>(id.value[1]) << 16) |
+                    (static_cast<size_t>(id.value[2]) << 8) | static_cast<size_t>(id.value[3]);
+            }
+        };
+
         std::vector<RTPSWriter *> AssociatedWriters;
         std::vector<RTPSReader *> AssociatedReaders;
-        std::mutex mtx;
+        //! Writers indexed by their EntityId, used to dispatch ACKNACK and NACK_FRAG submessages.
+        std::unordered_map<EntityId_t, std::vector<RTPSWriter*>, EntityIdHash> writers_by_id_;
+        //! Readers indexed by their EntityId, used to dispatch DATA, DATA_FRAG, HEARTBEAT and GAP submessages.
+        std::unordered_map<EntityId_t, std::vector<RTPSReader*>, EntityIdHash> readers_by_id_;
+        //! Taken exclusively to associate/remove endpoints, and shared while dispatching submessages.
+        shared_mutex mtx;
         //!Protocol version of the message
         ProtocolVersion_t sourceVersion;
         //!VendorID that created the message
@@ -143,7 +164,37 @@ class MessageReceiver
         bool proc_Submsg_SecureMessage(CDRMessage_t*msg, SubmessageHeader_t* smh);
         bool proc_Submsg_SecureSubMessage(CDRMessage_t*msg, SubmessageHeader_t* smh);
 
+        /**
+         * Get the readers a submessage should be dispatched to. Should be called with mtx taken.
+         * @param reader_id EntityId the submessage is directed to.
+         * @return Pointer to the candidate readers, or nullptr when no reader has that EntityId.
+         * Candidates should still be checked with acceptMsgDirectedTo.
+         */
+        const std::vector<RTPSReader*>* find_readers(const EntityId_t& reader_id) const;
+
+        /**
+         * Get the writers with a given EntityId. Should be called with mtx taken.
+         * @return Pointer to the writers, or nullptr when no writer has that EntityId.
+         */
+        const std::vector<RTPSWriter*>* find_writers(const EntityId_t& writer_id) const;
+
         RTPSParticipantImpl* participant_;
+
+        /**
+         * Copies a received change, which points to the receive buffer, so it can be delivered by the processing
+         * pool. Should only be called from the receiving thread.
+         * @return The copy, to be given back with release_pooled_change, or nullptr when it cannot be reserved.
+         */
+        CacheChange_t* pooled_change_copy(const CacheChange_t& change);
+
+        //! Gives back a change taken with pooled_change_copy. Can be called from any thread.
+        void release_pooled_change(CacheChange_t* change);
+
+        //! Pool where DATA, DATA_FRAG, HEARTBEAT and GAP are delivered to the readers. nullptr to deliver inline.
+        ReceiveProcessingPool* processing_pool_;
+
+        //! Changes holding the DATA and DATA_FRAG queued on processing_pool_. Their release is lock-free.
+        std::unique_ptr<CacheChangePool> pooled_changes_;
 };
 }
 } /* namespace rtps */
@@ -27,6 +27,8 @@
 #include <fastrtps/rtps/common/FragmentNumber.h>
 
 #include <vector>
+#include <set>
+#include <utility>
 #include <chrono>
 #include <cassert>
 
@@ -45,6 +47,28 @@ class RTPSMessageGroup_t
 {
     public:
 
+        //! Serialized payloads smaller than this are copied into the message instead of being referenced.
+        static constexpr uint32_t min_referenced_payload_size = 1024;
+
+        //! Maximum number of serialized payloads referenced by a single message.
+        static constexpr size_t max_payload_references = 16;
+
+        /**
+         * A serialized payload that is sent, without being copied, right after the submessage
+         * ending at a given offset of the full message.
+         */
+        struct PayloadReference
+        {
+            //! Offset in the full message where the payload goes.
+            uint32_t offset = 0;
+            //! First byte of the payload.
+            const octet* data = nullptr;
+            //! Size of the payload.
+            uint32_t size = 0;
+            //! Zero octets sent after the payload to keep submessages aligned.
+            uint32_t padding = 0;
+        };
+
         RTPSMessageGroup_t(
                 uint32_t payload,
                 const GuidPrefix_t& participant_guid,
@@ -59,12 +83,20 @@ class RTPSMessageGroup_t
 
             CDRMessage::initCDRMsg(&rtpsmsg_fullmsg_);
             RTPSMessageCreator::addHeader(&rtpsmsg_fullmsg_, participant_guid);
+
+            payload_references_.reserve(max_payload_references);
+            // Each reference may split the message in a chunk of the full message, the payload and its padding
+            send_buffers_.reserve(3 * max_payload_references + 1);
         }
 
         CDRMessage_t rtpsmsg_submessage_;
 
         CDRMessage_t rtpsmsg_fullmsg_;
 
+        std::vector<PayloadReference> payload_references_;
+
+        std::vector<NetworkBuffer> send_buffers_;
+
 #if HAVE_SECURITY
         CDRMessage_t rtpsmsg_encrypt_;
 #endif
@@ -153,6 +185,13 @@ class RTPSWriter;
          */
         bool add_gap(std::set<SequenceNumber_t>& changes_seq_numbers);
 
+        /**
+         * Adds a GAP message to the group.
+         * @param changes_seq_numbers Missed sequence numbers, in ascending order and without duplicates.
+         * @return True when message was added to the group.
+         */
+        bool add_gap(const std::vector<SequenceNumber_t>& changes_seq_numbers);
+
         /**
          * Adds a ACKNACK message to the group.
          * @param seq_num_set Set of missing sequence numbers.
@@ -177,7 +216,7 @@ class RTPSWriter;
                 FragmentNumberSet_t fn_state,
                 int32_t count);
 
-        uint32_t get_current_bytes_processed() { return currentBytesSent_ + full_msg_->length; }
+        uint32_t get_current_bytes_processed() { return currentBytesSent_ + full_msg_->length + referenced_bytes_; }
 
         /**
          * To be used whenever destination locators/guids change between two add_xxx calls.
@@ -200,10 +239,18 @@ class RTPSWriter;
 
         bool insert_submessage();
 
+        bool append_submessage();
+
+        bool can_reference_payload(
+                const CacheChange_t& change,
+                uint32_t size) const;
+
         bool add_info_dst_in_buffer(CDRMessage_t* buffer);
 
         bool add_info_ts_in_buffer(const Time_t& timestamp);
 
+        bool add_gap_sequences(const std::vector<std::pair<SequenceNumber_t, SequenceNumberSet_t>>& sequences);
+
         const RTPSMessageSenderInterface& sender_;
             
         Endpoint* endpoint_;
@@ -214,6 +261,19 @@ class RTPSWriter;
 
         uint32_t currentBytesSent_;
 
+        std::vector<RTPSMessageGroup_t::PayloadReference>& payload_references_;
+
+        std::vector<NetworkBuffer>& send_buffers_;
+
+        //! Bytes of referenced payloads (and their padding) that are part of the message being built.
+        uint32_t referenced_bytes_;
+
+        //! Payload to be referenced by the submessage being built. Its size is 0 when the payload is copied.
+        RTPSMessageGroup_t::PayloadReference pending_reference_;
+
+        //! Payloads are only referenced when no transformation is applied to the message.
+        bool reference_payloads_;
+
         GuidPrefix_t current_dst_;
 
 #if HAVE_SECURITY
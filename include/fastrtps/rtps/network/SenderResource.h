@@ -18,6 +18,9 @@
 #include <functional>
 #include <vector>
 #include <chrono>
+#include <mutex>
+
+#include "../../transport/NetworkBuffer.h"
 
 namespace eprosima{
 namespace fastrtps{
@@ -64,6 +67,80 @@ public:
         return returned_value;
     }
 
+    /**
+     * Sends a message made of several slices to a destination locator, through the channel managed by
+     * this resource. The slices are sent in order as a single message.
+     * When the underlying transport is not able to gather the slices, they are copied into a
+     * contiguous buffer first.
+     * @param buffers List of slices to be sent.
+     * @param total_bytes Sum of the sizes of all the slices.
+     * @param destination_locator Locator describing the destination endpoint.
+     * @param timeout If transport supports it then it will use it as maximum blocking time.
+     * @return Success of the send operation.
+     */
+    bool send(
+            const std::vector<NetworkBuffer>& buffers,
+            uint32_t total_bytes,
+            const Locator_t& destination_locator,
+            const std::chrono::microseconds& timeout)
+    {
+        bool returned_value = false;
+
+        if (send_buffers_lambda_)
+        {
+            returned_value = send_buffers_lambda_(buffers, total_bytes, destination_locator, timeout);
+        }
+        else if (send_lambda_)
+        {
+            if (buffers.size() == 1)
+            {
+                returned_value = send_lambda_(static_cast<const octet*>(buffers.front().buffer),
+                        buffers.front().size, destination_locator, timeout);
+            }
+            else
+            {
+                // Several threads may send through the same resource at the same time.
+                std::lock_guard<std::mutex> guard(gather_mutex_);
+                coalesce_network_buffers(buffers, total_bytes, gather_buffer_);
+                returned_value = send_lambda_(gather_buffer_.data(), total_bytes, destination_locator, timeout);
+            }
+        }
+
+        return returned_value;
+    }
+
+    /**
+     * Sends a message made of several slices to a list of destination locators, through the channel managed
+     * by this resource. Transports able to send the same message to several destinations in one call do it,
+     * the others send it to each destination in turn.
+     * @param buffers List of slices to be sent.
+     * @param total_bytes Sum of the sizes of all the slices.
+     * @param destination_locators Array of locators describing the destination endpoints.
+     * @param num_destinations Number of locators in destination_locators.
+     * @param timeout If transport supports it then it will use it as maximum blocking time.
+     * @return Success of the send operation to all the destinations.
+     */
+    bool send(
+            const std::vector<NetworkBuffer>& buffers,
+            uint32_t total_bytes,
+            const Locator_t* destination_locators,
+            size_t num_destinations,
+            const std::chrono::microseconds& timeout)
+    {
+        if (send_to_many_lambda_)
+        {
+            return send_to_many_lambda_(buffers, total_bytes, destination_locators, num_destinations, timeout);
+        }
+
+        bool returned_value = true;
+        for (size_t i = 0; i < num_destinations; ++i)
+        {
+            returned_value &= send(buffers, total_bytes, destination_locators[i], timeout);
+        }
+
+        return returned_value;
+    }
+
     /**
      * Resources can only be transfered through move semantics. Copy, assignment, and
      * construction outside of the factory are forbidden.
@@ -72,6 +149,8 @@ public:
     {
         clean_up.swap(rValueResource.clean_up);
         send_lambda_.swap(rValueResource.send_lambda_);
+        send_buffers_lambda_.swap(rValueResource.send_buffers_lambda_);
+        send_to_many_lambda_.swap(rValueResource.send_to_many_lambda_);
     }
 
     virtual ~SenderResource() = default;
@@ -87,8 +166,22 @@ protected:
     std::function<void()> clean_up;
     std::function<bool(const octet*, uint32_t, const Locator_t&, const std::chrono::microseconds&)> send_lambda_;
 
+    //! Optional. Set by transports able to send a list of slices without copying them.
+    std::function<bool(const std::vector<NetworkBuffer>&, uint32_t, const Locator_t&,
+            const std::chrono::microseconds&)> send_buffers_lambda_;
+
+    //! Optional. Set by transports able to send a list of slices to several destinations in one call.
+    std::function<bool(const std::vector<NetworkBuffer>&, uint32_t, const Locator_t*, size_t,
+            const std::chrono::microseconds&)> send_to_many_lambda_;
+
 private:
 
+    //! Scratch buffer used to coalesce slices when the transport only accepts contiguous data.
+    std::vector<octet> gather_buffer_;
+
+    //! Protects gather_buffer_.
+    std::mutex gather_mutex_;
+
     SenderResource()                                 = delete;
     SenderResource(const SenderResource&)            = delete;
     SenderResource& operator=(const SenderResource&) = delete;
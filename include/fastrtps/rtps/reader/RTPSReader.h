@@ -210,6 +210,17 @@ public:
             CacheChange_t** change,
             WriterProxy** wp) = 0;
 
+    /**
+     * Mark a given CacheChange_t of the history as read, if it is available to the user.
+     * Used to visit the changes of the history in a different order than the one of nextUnreadCache.
+     * @param change Pointer to the CacheChange_t.
+     * @param wp Pointer to pointer to the WriterProxy.
+     * @return True if the change is available and was marked as read.
+     */
+    RTPS_DllAPI virtual bool readCache(
+            CacheChange_t* change,
+            WriterProxy** wp) = 0;
+
     RTPS_DllAPI bool wait_for_unread_cache(
             const eprosima::fastrtps::Duration_t &timeout);
 
@@ -90,10 +90,21 @@ class StatefulReader : public RTPSReader
                 const GUID_t& writerGUID,
                 WriterProxy** WP);
 
+        /**
+         * Get the first sequence number of a matched writer not received yet, i.e. the base of the ACKNACK the
+         * reader would send to it.
+         * @param writer_guid GUID of the writer.
+         * @param seq_num Filled with the sequence number.
+         * @return false if the writer is not matched.
+         */
+        bool acknowledgement_base(
+                const GUID_t& writer_guid,
+                SequenceNumber_t& seq_num);
+
         /**
          * Processes a new DATA message. Previously the message must have been accepted by function acceptMsgDirectedTo.
          * @param change Pointer to the CacheChange_t.
-         * @return true if the reader accepts messages.
+         * @return true if the reader accepts messages from the writer and the change is in the history.
          */
         bool processDataMsg(CacheChange_t* change) override;
 
@@ -177,6 +188,16 @@ class StatefulReader : public RTPSReader
                 CacheChange_t** change,
                 WriterProxy** wpout = nullptr) override;
 
+        /**
+         * Mark a CacheChange_t of the history as read, if it is available to the user.
+         * @param change Pointer to the CacheChange_t
+         * @param wpout Pointer to pointer the matched writer proxy
+         * @return True if the change is available.
+         */
+        bool readCache(
+                CacheChange_t* change,
+                WriterProxy** wpout = nullptr) override;
+
         /**
          * Update the times parameters of the Reader.
          * @param times ReaderTimes reference.
@@ -236,12 +257,14 @@ class StatefulReader : public RTPSReader
 
         /**
          * Use the participant of this reader to send a message to certain locator.
-         * @param message Message to be sent.
+         * @param buffers List of slices that make up the message to be sent.
+         * @param total_bytes Sum of the sizes of all the slices.
          * @param locator Destination locator.
          * @param max_blocking_time_point Future time point where any blocking should end.
          */
         bool send_sync_nts(
-                CDRMessage_t* message,
+                const std::vector<NetworkBuffer>& buffers,
+                uint32_t total_bytes,
                 const Locator_t& locator,
                 std::chrono::steady_clock::time_point& max_blocking_time_point);
 
@@ -258,7 +281,14 @@ class StatefulReader : public RTPSReader
                 const GUID_t& writerGUID,
                 WriterProxy** wp) const;
 
-        void NotifyChanges(WriterProxy* wp);
+        /**
+         * Notify the changes of a writer that became available, in sequence number order.
+         * @param wp Pointer to the WriterProxy.
+         * @param received_change Change just received from the writer, if any. It saves looking it up on the history.
+         */
+        void NotifyChanges(
+                WriterProxy* wp,
+                CacheChange_t* received_change = nullptr);
 
         //! Acknack Count
         uint32_t acknack_count_;
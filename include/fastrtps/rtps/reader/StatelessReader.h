@@ -152,6 +152,16 @@ public:
             CacheChange_t** change,
             WriterProxy** wpout = nullptr) override;
 
+    /**
+     * Mark a CacheChange_t of the history as read, if it is available to the user.
+     * @param change Pointer to the CacheChange_t
+     * @param wpout Pointer to pointer of the matched writer proxy
+     * @return True if the change is available.
+     */
+    bool readCache(
+            CacheChange_t* change,
+            WriterProxy** wpout = nullptr) override;
+
     /**
      * Get the number of matched writers
      * @return Number of matched writers
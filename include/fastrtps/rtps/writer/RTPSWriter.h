@@ -133,6 +133,12 @@ public:
      */
     RTPS_DllAPI virtual void send_any_unsent_changes() = 0;
 
+    /**
+     * Hands the data queued for the readers of this process to them.
+     * Must be called without the mutex of the writer taken, as the listeners of the readers are called.
+     */
+    virtual void deliver_to_local_readers() {}
+
     /**
      * Get Min Seq Num in History.
      * @return Minimum sequence number in history
@@ -309,11 +315,13 @@ public:
     /**
      * Send a message through this interface.
      *
-     * @param message Pointer to the buffer with the message already serialized.
+     * @param buffers List of slices that make up the message, already serialized.
+     * @param total_bytes Sum of the sizes of all the slices.
      * @param max_blocking_time_point Future timepoint where blocking send should end.
      */
     bool send(
-            CDRMessage_t* message,
+            const std::vector<NetworkBuffer>& buffers,
+            uint32_t total_bytes,
             std::chrono::steady_clock::time_point& max_blocking_time_point) const override;
 
 protected:
@@ -333,6 +341,9 @@ protected:
 
     LocatorSelector locator_selector_;
 
+    //! Selected locators, grouped by kind, of the message being sent. Reused by send, under the writer mutex.
+    mutable std::vector<Locator_t> send_locators_;
+
     ResourceLimitedVector<GUID_t> all_remote_readers_;
     ResourceLimitedVector<GuidPrefix_t> all_remote_participants_;
 
@@ -363,6 +374,17 @@ protected:
      */
     virtual bool change_removed_by_history(CacheChange_t* a_change)=0;
 
+    /**
+     * Check whether a change removed by the history can be given back to the pool.
+     * @param a_change Pointer to the change removed.
+     * @return false when the writer is still handing it to some reader, and gives it back to the history later.
+     */
+    virtual bool change_can_be_released(CacheChange_t* a_change)
+    {
+        (void)a_change;
+        return true;
+    }
+
 #if HAVE_SECURITY
     SerializedPayload_t encrypt_payload_;
 
@@ -22,6 +22,7 @@
 #include <mutex>
 #include <set>
 #include <atomic>
+#include <vector>
 
 #include <fastrtps/rtps/builtin/data/ReaderProxyData.h>
 #include <fastrtps/rtps/writer/ReaderLocator.h>
@@ -33,14 +34,18 @@
 #include "../common/FragmentNumber.h"
 #include "../attributes/WriterAttributes.h"
 #include "../attributes/RTPSParticipantAllocationAttributes.hpp"
-#include "../../utils/collections/ResourceLimitedVector.hpp"
 
+// Testing purpose
+#ifndef TEST_FRIENDS
+#define TEST_FRIENDS
+#endif // TEST_FRIENDS
 
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
 class StatefulWriter;
+class RTPSReader;
 class TimedEvent;
 
 /**
@@ -49,6 +54,8 @@ class TimedEvent;
  */
 class ReaderProxy
 {
+    TEST_FRIENDS
+
 public:
     ~ReaderProxy();
 
@@ -66,8 +73,12 @@ public:
     /**
      * Activate this proxy associating it to a remote reader.
      * @param reader_attributes ReaderProxyData of the reader for which to keep state.
+     * @param local_reader Pointer to the reader when it belongs to this process and the writer hands the data
+     * directly to it, nullptr otherwise.
      */
-    void start(const ReaderProxyData& reader_attributes);
+    void start(
+            const ReaderProxyData& reader_attributes,
+            RTPSReader* local_reader = nullptr);
 
     /**
      * Update information about the remote reader.
@@ -134,41 +145,49 @@ public:
             const SequenceNumber_t& max_seq,
             BinaryFunction f) const
     {
-        if (!changes_for_reader_.empty())
+        SequenceNumber_t current_seq = changes_low_mark_ + 1;
+
+        // Changes kept out of the ring are older than all the ones on it.
+        for (const ChangeForReader_t& change : sparse_changes_)
         {
-            SequenceNumber_t current_seq = changes_low_mark_ + 1;
-            ChangeConstIterator it = changes_for_reader_.begin();
-            while (it != changes_for_reader_.end())
+            for (; current_seq < change.getSequenceNumber(); ++current_seq)
             {
-                // Holes before this change are informed as irrelevant.
-                SequenceNumber_t change_seq = it->getSequenceNumber();
-                for(; current_seq < change_seq; ++current_seq)
-                {
-                    f(current_seq, nullptr);
-                }
-
-                // We then inform of this change if it is unsent, and go to the next one.
-                if (it->getStatus() == UNSENT)
-                {
-                    f(current_seq, &(*it));
-                }
-                ++current_seq;
-                ++it;
+                f(current_seq, nullptr);
             }
 
-            // After the last change has been checked, there may be a hole at the end.
-            for (; current_seq < max_seq; ++current_seq)
+            if (UNSENT == change.getStatus())
             {
-                f(current_seq, nullptr);
+                f(current_seq, &change);
             }
+            ++current_seq;
         }
-        else
+
+        if (0 < changes_span_)
         {
-            // This may be entered if all changes where removed before being acknowledged.
-            for (SequenceNumber_t seq = changes_low_mark_ + 1; seq < max_seq; ++seq)
+            // Changes removed before the first one kept are informed as irrelevant.
+            for (; current_seq < changes_base_; ++current_seq)
+            {
+                f(current_seq, nullptr);
+            }
+
+            // Only the slots holding an unsent change or a hole are visited.
+            size_t offset = next_unsent_or_hole(0);
+            while (offset < changes_span_)
             {
-                f(seq, nullptr);
+                size_t slot = slot_of(offset);
+                current_seq = changes_base_ + static_cast<uint32_t>(offset);
+                f(current_seq, is_present(slot) ? &changes_for_reader_[slot] : nullptr);
+                offset = next_unsent_or_hole(offset + 1);
             }
+
+            current_seq = changes_base_ + static_cast<uint32_t>(changes_span_);
+        }
+
+        // After the last change has been checked, there may be a hole at the end.
+        // This is also the case when all changes where removed before being acknowledged.
+        for (; current_seq < max_seq; ++current_seq)
+        {
+            f(current_seq, nullptr);
         }
     }
 
@@ -256,6 +275,33 @@ public:
         return reader_attributes_.m_qos.m_reliability.kind == RELIABLE_RELIABILITY_QOS;
     }
 
+    /**
+     * Check if the reader represented by this proxy receives the data directly, without the transports.
+     * @return true if the reader belongs to this process and the writer hands the data directly to it.
+     */
+    inline bool is_local_reader() const
+    {
+        return is_local_reader_;
+    }
+
+    /**
+     * Get the reader represented by this proxy when it receives the data directly.
+     * @return Pointer to the reader, or nullptr if it is not local or it is being destroyed.
+     */
+    inline RTPSReader* local_reader() const
+    {
+        return local_reader_;
+    }
+
+    /**
+     * Called when the local reader represented by this proxy is going to be destroyed.
+     * The proxy is still considered local, but nothing is delivered to the reader anymore.
+     */
+    inline void local_reader_removed()
+    {
+        local_reader_ = nullptr;
+    }
+
     /**
      * Get the attributes of the reader represented by this proxy.
      * @return the attributes of the reader represented by this proxy.
@@ -346,8 +392,34 @@ private:
     ReaderProxyData reader_attributes_;
     //!Pointer to the associated StatefulWriter.
     StatefulWriter* writer_;
-    //!Set of the changes and its state.
-    ResourceLimitedVector<ChangeForReader_t, std::true_type> changes_for_reader_;
+    //!Whether the reader belongs to this process and receives the data directly.
+    bool is_local_reader_;
+    //!Reader receiving the data directly. Only valid while is_local_reader_ is true.
+    RTPSReader* local_reader_;
+    /*!
+     * Ring of changes indexed by sequence number. Its size is always a power of two, and it does not grow beyond
+     * max_ring_slots_ (twice the number of changes kept when the history is unlimited), as on keyed histories
+     * the span of sequence numbers may be much bigger than the number of changes.
+     */
+    std::vector<ChangeForReader_t> changes_for_reader_;
+    //! One bit per slot of changes_for_reader_, set when the slot holds a change.
+    std::vector<uint64_t> present_bits_;
+    //! One bitmap per ChangeForReaderStatus_t, with the slots whose change has that status.
+    std::vector<uint64_t> status_bits_[UNDERWAY + 1];
+    //! Number of changes with each ChangeForReaderStatus_t, on the ring or out of it.
+    size_t status_count_[UNDERWAY + 1];
+    //! Number of changes kept on the ring.
+    size_t present_count_;
+    //! Slot holding the change with sequence number changes_base_.
+    size_t changes_head_;
+    //! Number of slots from changes_head_ to the last change kept, holes included.
+    size_t changes_span_;
+    //! Sequence number of the first change kept on the ring.
+    SequenceNumber_t changes_base_;
+    //! Changes that did not fit on the ring, sorted by sequence number. All of them precede changes_base_.
+    std::vector<ChangeForReader_t> sparse_changes_;
+    //! Maximum size of the ring, given by the maximum number of changes on the history. Zero when unlimited.
+    size_t max_ring_slots_;
     //! Timed Event to manage the delay to mark a change as UNACKED after sending it.
     TimedEvent* nack_supression_event_;
     //! Are timed events enabled?
@@ -359,9 +431,6 @@ private:
 
     SequenceNumber_t changes_low_mark_;
 
-    using ChangeIterator = ResourceLimitedVector<ChangeForReader_t, std::true_type>::iterator;
-    using ChangeConstIterator = ResourceLimitedVector<ChangeForReader_t, std::true_type>::const_iterator;
-
     void disable_timers();
 
     /*
@@ -387,21 +456,91 @@ private:
     void add_change(
             const ChangeForReader_t& change);
 
+    inline size_t slot_of(size_t offset) const
+    {
+        return (changes_head_ + offset) & (changes_for_reader_.size() - 1);
+    }
+
+    inline bool is_present(size_t slot) const
+    {
+        return (present_bits_[slot >> 6] & (uint64_t(1) << (slot & 63))) != 0;
+    }
+
+    //! Slots past the end of the ring refer to sparse_changes_.
+    inline bool is_sparse(size_t slot) const
+    {
+        return slot >= changes_for_reader_.size();
+    }
+
+    inline ChangeForReader_t& change_at(size_t slot)
+    {
+        return is_sparse(slot) ? sparse_changes_[slot - changes_for_reader_.size()] : changes_for_reader_[slot];
+    }
+
+    inline const ChangeForReader_t& change_at(size_t slot) const
+    {
+        return is_sparse(slot) ? sparse_changes_[slot - changes_for_reader_.size()] : changes_for_reader_[slot];
+    }
+
+    //! Value returned by find_change when the change is not kept.
+    static const size_t no_change = static_cast<size_t>(-1);
+
     /**
-     * @brief Find a change with the specified sequence number.
+     * @brief Find the slot holding a change with the specified sequence number.
      * @param seq_num Sequence number to find.
-     * @return Iterator pointing to the change, changes_for_reader_.end() if not found.
+     * @return Index of the slot on changes_for_reader_, changes_for_reader_.size() plus the index on
+     * sparse_changes_ for changes out of the ring, or no_change if not found.
+     */
+    size_t find_change(const SequenceNumber_t& seq_num) const;
+
+    /**
+     * @brief Get the offset of the first slot, starting on the given one, that holds an UNSENT change or a hole.
+     * @param offset Offset from changes_head_ where the search starts.
+     * @return Offset of the slot found, a value greater or equal than changes_span_ if none was found.
+     */
+    size_t next_unsent_or_hole(size_t offset) const;
+
+    /**
+     * @brief Store a change on its slot, extending the ring when the sequence number is out of it.
+     * When the ring would grow beyond its limit, the oldest changes are moved to sparse_changes_.
+     * @param change Change to store. It should not be already kept.
+     */
+    void insert_change(const ChangeForReader_t& change);
+
+    void insert_sparse_change(const ChangeForReader_t& change);
+
+    /**
+     * @brief Move the first changes of the ring to sparse_changes_ until the given sequence number fits on the ring.
+     * @param seq_num Sequence number that should fit on the ring.
+     * @param max_slots Maximum number of slots of the ring.
      */
-    ChangeIterator find_change(
+    void move_front_to_sparse(
             const SequenceNumber_t& seq_num,
-            bool exact);
+            size_t max_slots);
+
+    //! Maximum number of slots the ring may grow to.
+    size_t ring_limit() const;
+
+    void set_status(
+            size_t slot,
+            ChangeForReaderStatus_t status);
 
     /**
-     * @brief Find a change with the specified sequence number.
-     * @param seq_num Sequence number to find.
-     * @return Iterator pointing to the change, changes_for_reader_.end() if not found.
+     * @brief Turn a slot into a hole, and drop the holes on both ends of the ring.
+     * Changes out of the ring are erased.
+     * @param slot Slot holding the change to remove.
+     */
+    void remove_change(size_t slot);
+
+    void clear_slot(size_t slot);
+
+    void trim_holes();
+
+    /**
+     * @brief Reallocate the ring with enough room for the given number of slots.
+     * @param min_slots Minimum number of slots needed.
      */
-    ChangeConstIterator find_change(const SequenceNumber_t& seq_num) const;
+    void grow(uint64_t min_slots);
 };
 
 } /* namespace rtps */
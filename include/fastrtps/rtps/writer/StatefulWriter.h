@@ -25,6 +25,8 @@
 #include "../../utils/collections/ResourceLimitedVector.hpp"
 #include <condition_variable>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 
 namespace eprosima {
@@ -32,7 +34,10 @@ namespace fastrtps {
 namespace rtps {
 
 class ReaderProxy;
+class RTPSReader;
 class TimedEvent;
+template<class T> class RTPSWriterCollector;
+class StatefulWriterOrganizer;
 
 /**
  * Class StatefulWriter, specialization of RTPSWriter that maintains information of each matched Reader.
@@ -127,6 +132,14 @@ public:
      */
     bool matched_reader_add(const ReaderProxyData& data) override;
 
+    /**
+     * Hands the data queued for the readers of this process to them.
+     * If another thread is already doing it, that thread hands the data queued by this one too.
+     */
+    void deliver_to_local_readers() override;
+
+    bool change_can_be_released(CacheChange_t* a_change) override;
+
     /**
      * Remove a matched reader.
      * @param reader_guid GUID of the reader to remove.
@@ -134,6 +147,12 @@ public:
      */
     bool matched_reader_remove(const GUID_t& reader_guid) override;
 
+    /**
+     * Stop handing data directly to a reader of this process, as it is going to be destroyed.
+     * @param reader_guid GUID of the reader.
+     */
+    void local_reader_removed(const GUID_t& reader_guid);
+
     /**
      * Tells us if a specific Reader is matched against this writer
      * @param reader_guid GUID of the reader to check.
@@ -275,6 +294,9 @@ private:
 
     void update_reader_info(bool create_sender_resources);
 
+    //! Fills the state of a new proxy of a reader of this process, and hands it the history.
+    void matched_local_reader_add_nts(ReaderProxy* rp);
+
     void send_heartbeat_piggyback_nts_(
             ReaderProxy* reader,
             RTPSMessageGroup& message_group,
@@ -288,6 +310,56 @@ private:
 
     void check_acked_status();
 
+    /**
+     * Queues the handing of a change to a matched reader of this process.
+     * The reader gets the change of the history itself, which is kept until then even if it is removed.
+     */
+    void intraprocess_delivery(
+            CacheChange_t* change,
+            ReaderProxy& reader_proxy);
+
+    /**
+     * Queues the informing of a matched reader of this process that a range of changes is irrelevant to it.
+     */
+    void intraprocess_gap(
+            ReaderProxy& reader_proxy,
+            const SequenceNumber_t& first_seq,
+            const SequenceNumber_t& last_seq);
+
+    /**
+     * Queues the informing of a matched reader of this process of the changes available on the history.
+     * The reader only answers, through the transports, when it misses some change.
+     */
+    void intraprocess_heartbeat(
+            ReaderProxy& reader_proxy,
+            bool liveliness = false);
+
+    struct LocalDelivery;
+
+    /**
+     * Hands a queued delivery to its reader. Called without the mutex of the writer taken.
+     * @param delivery Delivery to perform. Filled with the acknowledgement of the reader.
+     */
+    void deliver_to_local_reader(
+            LocalDelivery& delivery);
+
+    /**
+     * Called after handing data to a reader of this process.
+     * @param reader_guid GUID of the reader.
+     * @param seq_num Base of the ACKNACK the reader would send, i.e. first change it has not received.
+     */
+    void local_reader_acknowledged_nts(
+            const GUID_t& reader_guid,
+            const SequenceNumber_t& seq_num);
+
+    /**
+     * Queues the handing of all the unsent changes of a matched reader of this process to it.
+     * @return true if some change is pending of being acknowledged by the reader.
+     */
+    bool send_unsent_changes_to_local_reader_nts(
+            ReaderProxy& reader_proxy,
+            const SequenceNumber_t& max_sequence);
+
     /**
      * @brief A method called when the ack timer expires
      * @details Only used if disable positive ACKs QoS is enabled
@@ -309,6 +381,51 @@ private:
 
     std::vector<std::unique_ptr<FlowController> > m_controllers;
 
+    //! Changes to be sent on send_any_unsent_changes. Reused across calls to avoid allocations.
+    std::unique_ptr<RTPSWriterCollector<ReaderProxy*>> relevant_changes_;
+    //! Changes to be notified with a GAP on send_any_unsent_changes. Reused across calls to avoid allocations.
+    std::unique_ptr<StatefulWriterOrganizer> not_relevant_changes_;
+
+    //! Whether the matched readers of this process receive the data directly, without the transports.
+    bool intraprocess_delivery_;
+    //! Unsent changes of a local reader, nullptr for irrelevant ones. Reused across calls to avoid allocations.
+    std::vector<std::pair<SequenceNumber_t, CacheChange_t*>> local_unsent_changes_;
+
+    //! Something to hand to a reader of this process.
+    struct LocalDelivery
+    {
+        enum Kind
+        {
+            DATA,
+            GAP,
+            HEARTBEAT
+        };
+
+        Kind kind;
+        GUID_t reader_guid;
+        //! Change of the history for DATA.
+        CacheChange_t* change;
+        //! Range of irrelevant changes for GAP, or changes available for HEARTBEAT.
+        SequenceNumber_t first_seq;
+        SequenceNumber_t last_seq;
+        uint32_t heartbeat_count;
+        bool liveliness;
+        //! The change was removed from the history meanwhile, and this is the last delivery using it.
+        bool release_change;
+        //! Filled after the delivery with the first change the reader has not received.
+        SequenceNumber_t ack_base;
+        bool acknowledged;
+    };
+
+    //! Deliveries queued with the mutex taken. Reused across calls to avoid allocations.
+    std::vector<LocalDelivery> local_deliveries_;
+    //! Deliveries being handed by the thread running deliver_to_local_readers.
+    std::vector<LocalDelivery> local_deliveries_in_progress_;
+    //! Whether some thread is running deliver_to_local_readers. Protected by mp_mutex.
+    bool local_delivery_running_;
+    //! View of the change being handed, sharing the payload of the change of the history.
+    CacheChange_t local_delivery_view_;
+
     StatefulWriter& operator=(const StatefulWriter&) = delete;
 };
 
@@ -32,6 +32,7 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+template<class T> class RTPSWriterCollector;
 
 /**
  * Class StatelessWriter, specialization of RTPSWriter that manages writers that don't keep state of the matched readers.
@@ -128,11 +129,13 @@ public:
     /**
      * Send a message through this interface.
      *
-     * @param message Pointer to the buffer with the message already serialized.
+     * @param buffers List of slices that make up the message, already serialized.
+     * @param total_bytes Sum of the sizes of all the slices.
      * @param max_blocking_time_point Future timepoint where blocking send should end.
      */
     bool send(
-            CDRMessage_t* message,
+            const std::vector<NetworkBuffer>& buffers,
+            uint32_t total_bytes,
             std::chrono::steady_clock::time_point& max_blocking_time_point) const override;
 
 private:
@@ -148,6 +151,10 @@ private:
     ResourceLimitedVector<ReaderLocator> matched_readers_;
     ResourceLimitedVector<ChangeForReader_t, std::true_type> unsent_changes_;
     std::vector<std::unique_ptr<FlowController> > flow_controllers_;
+    //! Changes to be sent on send_any_unsent_changes. Reused across calls to avoid allocations.
+    std::unique_ptr<RTPSWriterCollector<ReaderLocator*>> changes_to_send_;
+    //! Changes received by all the readers on send_any_unsent_changes. Reused across calls to avoid allocations.
+    ResourceLimitedVector<CacheChange_t*> changes_acked_by_all_;
 };
 }
 } /* namespace rtps */
@@ -0,0 +1,98 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SampleLoan.h
+ */
+
+#ifndef SAMPLELOAN_H_
+#define SAMPLELOAN_H_
+
+#include "../fastrtps_dll.h"
+#include "../rtps/common/CacheChange.h"
+
+namespace eprosima {
+namespace fastrtps {
+
+class SubscriberHistory;
+
+/**
+ * Class SampleLoan, gives access to a sample taken from a Subscriber without copying it.
+ *
+ * The sample is kept in the memory where it was received, and that memory is not reused by the Subscriber
+ * until the loan is given back with Subscriber::return_loan. Loans must be returned before the Subscriber
+ * is removed.
+ * @ingroup FASTRTPS_MODULE
+ */
+class RTPS_DllAPI SampleLoan
+{
+    friend class SubscriberHistory;
+
+public:
+
+    SampleLoan()
+        : change_(nullptr)
+        , plain_(false)
+    {
+    }
+
+    SampleLoan(const SampleLoan&) = delete;
+    SampleLoan& operator=(const SampleLoan&) = delete;
+
+    //! Whether the loan currently holds a sample.
+    bool is_loaned() const
+    {
+        return change_ != nullptr;
+    }
+
+    /**
+     * Get the serialized sample.
+     * @return Pointer to the serialized payload, or nullptr if nothing is loaned.
+     * The payload is empty for samples that are not ALIVE.
+     */
+    const rtps::SerializedPayload_t* payload() const
+    {
+        return change_ != nullptr ? &change_->serializedPayload : nullptr;
+    }
+
+    /**
+     * Get a typed view of the sample.
+     * Only available when the TopicDataType of the Subscriber is plain (see TopicDataType::is_plain).
+     * @tparam T Type of the samples of the topic.
+     * @return Pointer to the sample, or nullptr if nothing is loaned, the type is not plain or the sample is smaller
+     * than T.
+     */
+    template<typename T>
+    const T* get() const
+    {
+        if (change_ == nullptr || !plain_ || change_->serializedPayload.length < sizeof(T))
+        {
+            return nullptr;
+        }
+
+        return reinterpret_cast<const T*>(change_->serializedPayload.data);
+    }
+
+private:
+
+    //! Change pinned by the loan. It is out of the history, but not back in its pool.
+    rtps::CacheChange_t* change_;
+
+    bool plain_;
+};
+
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif /* SAMPLELOAN_H_ */
@@ -21,6 +21,7 @@
 #define SUBSCRIBER_H_
 
 #include "../rtps/common/Guid.h"
+#include "../rtps/common/InstanceHandle.h"
 #include "../rtps/common/Time_t.h"
 #include "../attributes/SubscriberAttributes.h"
 #include "../qos/DeadlineMissedStatus.h"
@@ -31,6 +32,7 @@ namespace fastrtps {
 
 class SubscriberImpl;
 class SampleInfo_t;
+class SampleLoan;
 
 /**
  * Class Subscriber, contains the public API that allows the user to control the reception of messages.
@@ -90,6 +92,76 @@ public:
             void* sample,
             SampleInfo_t* info);
 
+    /**
+     * @brief Takes next sample from the Subscriber without copying it. The sample is removed from the subscriber.
+     * The memory of the sample is not reused until the loan is given back with return_loan.
+     * @param loan Empty SampleLoan where the sample is stored.
+     * @param info Pointer to a SampleInfo_t structure that informs you about your sample.
+     * @return True if a sample was taken.
+     * @note This method is blocked for a period of time.
+     * ReliabilityQosPolicy.max_blocking_time on SubscriberAttributes defines this period of time.
+     */
+    bool take_loan(
+            SampleLoan& loan,
+            SampleInfo_t* info);
+
+    /**
+     * @brief Gives back a sample obtained with take_loan, so its memory can be reused.
+     * @param loan Loan to return. It is left empty.
+     * @return True if the loan was returned.
+     */
+    bool return_loan(SampleLoan& loan);
+
+    /**
+     * @brief Reads up to max_samples unread samples from the Subscriber, holding its history only once.
+     * @param samples Array of pointers to the objects where you want the samples stored.
+     * @param infos Array of SampleInfo_t structures that inform you about your samples. It can be nullptr.
+     * @param max_samples Maximum number of samples to read. Both arrays should have at least this size.
+     * @param handle Only samples of this instance are read. By default samples of any instance are read.
+     * @return Number of samples read.
+     * @note This method is blocked for a period of time.
+     * ReliabilityQosPolicy.max_blocking_time on SubscriberAttributes defines this period of time.
+     */
+    uint32_t read(
+            void* const* samples,
+            SampleInfo_t* infos,
+            uint32_t max_samples,
+            const rtps::InstanceHandle_t& handle = rtps::c_InstanceHandle_Unknown);
+
+    /**
+     * @brief Takes up to max_samples samples from the Subscriber, holding its history only once.
+     * The samples are removed from the subscriber.
+     * @param samples Array of pointers to the objects where you want the samples stored.
+     * @param infos Array of SampleInfo_t structures that inform you about your samples. It can be nullptr.
+     * @param max_samples Maximum number of samples to take. Both arrays should have at least this size.
+     * @param handle Only samples of this instance are taken. By default samples of any instance are taken.
+     * @return Number of samples taken.
+     * @note This method is blocked for a period of time.
+     * ReliabilityQosPolicy.max_blocking_time on SubscriberAttributes defines this period of time.
+     */
+    uint32_t take(
+            void* const* samples,
+            SampleInfo_t* infos,
+            uint32_t max_samples,
+            const rtps::InstanceHandle_t& handle = rtps::c_InstanceHandle_Unknown);
+
+    /**
+     * @brief Takes up to max_samples samples from the Subscriber without copying them, holding its history only once.
+     * Each loan must be given back with return_loan.
+     * @param loans Array of empty SampleLoan where the samples are stored.
+     * @param infos Array of SampleInfo_t structures that inform you about your samples. It can be nullptr.
+     * @param max_samples Maximum number of samples to take. Both arrays should have at least this size.
+     * @param handle Only samples of this instance are taken. By default samples of any instance are taken.
+     * @return Number of samples taken.
+     * @note This method is blocked for a period of time.
+     * ReliabilityQosPolicy.max_blocking_time on SubscriberAttributes defines this period of time.
+     */
+    uint32_t take_loans(
+            SampleLoan* loans,
+            SampleInfo_t* infos,
+            uint32_t max_samples,
+            const rtps::InstanceHandle_t& handle = rtps::c_InstanceHandle_Unknown);
+
     /**
      * Update the Attributes of the subscriber;
      * @param att Reference to a SubscriberAttributes object to update the parameters;
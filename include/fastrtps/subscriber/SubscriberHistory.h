@@ -25,7 +25,9 @@
 #include "../rtps/history/ReaderHistory.h"
 #include "../qos/QosPolicies.h"
 #include "../common/KeyedChanges.h"
+#include "../utils/collections/IndexedHeap.hpp"
 #include "SampleInfo.h"
+#include "SampleLoan.h"
 
 #include <chrono>
 
@@ -96,13 +98,81 @@ class SubscriberHistory: public rtps::ReaderHistory
         bool readNextBuffer(rtps::SerializedPayload_t* data, SampleInfo_t* info);
         bool takeNextBuffer(rtps::SerializedPayload_t* data, SampleInfo_t* info);
 
+        /**
+         * Takes the next sample from the history without deserializing it.
+         * The change is removed from the history, but is not given back to the pool until return_loan is called.
+         * @param loan Empty loan where the sample is stored.
+         * @param info Pointer to a SampleInfo_t object where the information about the sample is stored.
+         * @param max_blocking_time Maximum time the function can be blocked.
+         * @return True if a sample was taken.
+         */
+        bool take_loan(
+                SampleLoan& loan,
+                SampleInfo_t* info,
+                std::chrono::steady_clock::time_point& max_blocking_time);
+
+        /**
+         * Gives back to the pool the sample of a loan obtained with take_loan.
+         * @param loan Loan to return. It is left empty.
+         * @return True if the loan was returned, false if it was not obtained from this history.
+         */
+        bool return_loan(SampleLoan& loan);
+
+        /** @name Batch read or take data methods.
+         * Methods to read or take several samples from the History while holding its mutex only once.
+         * Samples are retrieved in the same order as readNextData and takeNextData would.
+         * @param samples Array of pointers to the objects where the samples are deserialized.
+         * @param infos Array of SampleInfo_t objects where the information about the samples is stored.
+         * It can be nullptr if the information is not needed.
+         * @param max_samples Maximum number of samples to retrieve. Arrays should have at least this size.
+         * @param handle Instance whose samples are retrieved. With c_InstanceHandle_Unknown, or on topics
+         * without key, samples of any instance are retrieved.
+         * @param max_blocking_time Maximum time the function can be blocked.
+         * @return Number of samples retrieved.
+         */
+        ///@{
+        uint32_t read(
+                void* const* samples,
+                SampleInfo_t* infos,
+                uint32_t max_samples,
+                const rtps::InstanceHandle_t& handle,
+                std::chrono::steady_clock::time_point& max_blocking_time);
+
+        uint32_t take(
+                void* const* samples,
+                SampleInfo_t* infos,
+                uint32_t max_samples,
+                const rtps::InstanceHandle_t& handle,
+                std::chrono::steady_clock::time_point& max_blocking_time);
+        ///@}
+
+        /**
+         * Takes several samples from the history without deserializing them, like take_loan does.
+         * @param loans Array of empty loans where the samples are stored.
+         * @param infos Array of SampleInfo_t objects where the information about the samples is stored.
+         * It can be nullptr if the information is not needed.
+         * @param max_samples Maximum number of samples to take. Arrays should have at least this size.
+         * @param handle Instance whose samples are taken. With c_InstanceHandle_Unknown, or on topics
+         * without key, samples of any instance are taken.
+         * @param max_blocking_time Maximum time the function can be blocked.
+         * @return Number of samples taken.
+         */
+        uint32_t take_loans(
+                SampleLoan* loans,
+                SampleInfo_t* infos,
+                uint32_t max_samples,
+                const rtps::InstanceHandle_t& handle,
+                std::chrono::steady_clock::time_point& max_blocking_time);
 
         /**
          * This method is called to remove a change from the SubscriberHistory.
          * @param change Pointer to the CacheChange_t.
+         * @param release Whether the change is given back to the pool.
          * @return True if removed.
          */
-        bool remove_change_sub(rtps::CacheChange_t* change);
+        bool remove_change_sub(
+                rtps::CacheChange_t* change,
+                bool release = true);
 
         /**
          * @brief A method to set the next deadline for the given instance
@@ -132,6 +202,8 @@ class SubscriberHistory: public rtps::ReaderHistory
         t_m_Inst_Caches keyed_changes_;
         //!Time point when the next deadline will occur (only used for topics with no key)
         std::chrono::steady_clock::time_point next_deadline_us_;
+        //!Next deadline of each instance, earliest first (only used for topics with key)
+        IndexedHeap<rtps::InstanceHandle_t, std::chrono::steady_clock::time_point> instance_deadlines_;
         //!HistoryQosPolicy values.
         HistoryQosPolicy m_historyQos;
         //!ResourceLimitsQosPolicy values.
@@ -142,6 +214,9 @@ class SubscriberHistory: public rtps::ReaderHistory
         //!Type object to deserialize Key
         void * mp_getKeyObject;
 
+        //!Changes taken with take_loan and not yet returned.
+        std::vector<rtps::CacheChange_t*> loaned_changes_;
+
         /**
          * @brief Method that finds a key in m_keyedChanges or tries to add it if not found
          * @param a_change The change to get the key from
@@ -151,6 +226,46 @@ class SubscriberHistory: public rtps::ReaderHistory
         bool find_key(
                 rtps::CacheChange_t* a_change,
                 t_m_Inst_Caches::iterator* map_it);
+
+        /**
+         * @brief Gets the changes of an instance when a retrieval is filtered by instance handle
+         * @param handle The handle to the instance, or c_InstanceHandle_Unknown
+         * @param instance_changes Changes of the instance, or nullptr when the retrieval is not filtered
+         * @return False if the retrieval is filtered by an instance not present on the history
+         */
+        bool get_instance_changes(
+                const rtps::InstanceHandle_t& handle,
+                std::vector<rtps::CacheChange_t*>** instance_changes);
+
+        /**
+         * @brief Gets the next change to read or take, marking it as read
+         * @param instance_changes Changes of the instance to consider, or nullptr to consider the whole history
+         * @param index Position on instance_changes where the search starts. Updated with the position of the
+         * change found
+         * @param only_unread Whether read changes are skipped
+         * @param change Pointer to pointer where the change is returned
+         * @param wp Pointer to pointer where the writer proxy of the change is returned
+         * @return True if a change was found
+         */
+        bool next_change(
+                std::vector<rtps::CacheChange_t*>* instance_changes,
+                size_t& index,
+                bool only_unread,
+                rtps::CacheChange_t** change,
+                rtps::WriterProxy** wp);
+
+        /**
+         * @brief Deserializes a change and fills its SampleInfo_t
+         * @param change The change retrieved
+         * @param wp Writer proxy of the change
+         * @param data Object where the change is deserialized, or nullptr to leave it serialized
+         * @param info SampleInfo_t to fill, or nullptr
+         */
+        void get_sample(
+                rtps::CacheChange_t* change,
+                rtps::WriterProxy* wp,
+                void* data,
+                SampleInfo_t* info);
 };
 
 } /* namespace fastrtps */
@@ -0,0 +1,84 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRANSPORT_NETWORKBUFFER_H
+#define TRANSPORT_NETWORKBUFFER_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+/**
+ * A slice of memory that is part of an outgoing message.
+ *
+ * A message may be given to a transport as a list of slices, which are sent in order as a single
+ * datagram (or a single framed TCP message). The memory is not owned by the slice, and must remain
+ * valid until the send call returns.
+ * @ingroup TRANSPORT_MODULE
+ */
+struct NetworkBuffer
+{
+    //! Pointer to the first byte of the slice.
+    const void* buffer;
+
+    //! Number of bytes in the slice.
+    uint32_t size;
+
+    NetworkBuffer()
+        : buffer(nullptr)
+        , size(0)
+    {
+    }
+
+    NetworkBuffer(
+            const void* buf,
+            uint32_t len)
+        : buffer(buf)
+        , size(len)
+    {
+    }
+};
+
+/**
+ * Copies a list of slices into a contiguous buffer.
+ * @param buffers List of slices to copy.
+ * @param total_bytes Sum of the sizes of all the slices.
+ * @param [out] destination Buffer receiving the data. It is resized to total_bytes.
+ */
+inline void coalesce_network_buffers(
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        std::vector<uint8_t>& destination)
+{
+    destination.resize(total_bytes);
+    uint8_t* dst = destination.data();
+    for (const NetworkBuffer& buf : buffers)
+    {
+        if (buf.size > 0)
+        {
+            memcpy(dst, buf.buffer, buf.size);
+            dst += buf.size;
+        }
+    }
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // TRANSPORT_NETWORKBUFFER_H
@@ -0,0 +1,248 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SHAREDMEM_TRANSPORT_H
+#define SHAREDMEM_TRANSPORT_H
+
+#include "TransportInterface.h"
+#include "SharedMemTransportDescriptor.h"
+#include "NetworkBuffer.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+class SharedMemSegment;
+class SharedMemPort;
+class SharedMemChannelResource;
+struct SharedMemBufferDescriptor;
+
+/**
+ * Transport for processes running on the same host, using shared memory.
+ *    - Each transport owns a shared memory segment. Sending a message copies it once into that segment,
+ *       and queues a descriptor of it on the destination port. Listeners read the message in place, and
+ *       the space is reused once every listener is done with it.
+ *
+ *    - A port is a shared memory object with a lock-free descriptor ring per listener. Unicast ports have a
+ *       single listener, so opening one in use fails as a bound UDP port would. Multicast ports are read by
+ *       every listener on them.
+ *
+ *    - Locators have kind LOCATOR_KIND_SHM and carry an identifier of the host, so locators of other hosts
+ *       are never selected.
+ * @ingroup TRANSPORT_MODULE
+ */
+class SharedMemTransport : public TransportInterface
+{
+    friend class SharedMemChannelResource;
+
+public:
+
+    RTPS_DllAPI SharedMemTransport(const SharedMemTransportDescriptor&);
+
+    virtual ~SharedMemTransport() override;
+
+    bool init() override;
+
+    virtual bool IsInputChannelOpen(const Locator_t&) const override;
+
+    //! Checks for SHM kind.
+    virtual bool IsLocatorSupported(const Locator_t&) const override;
+
+    //! Only multicast locators and locators of this host are allowed.
+    virtual bool is_locator_allowed(const Locator_t&) const override;
+
+    virtual Locator_t RemoteToMainLocal(const Locator_t& remote) const override;
+
+    virtual bool transform_remote_locator(
+            const Locator_t& remote_locator,
+            Locator_t& result_locator) const override;
+
+    //! A single sender resource serves every destination.
+    virtual bool OpenOutputChannel(
+            SendResourceList& sender_resource_list,
+            const Locator_t&) override;
+
+    //! Registers as a listener of the port given by the locator and starts receiving from it.
+    virtual bool OpenInputChannel(
+            const Locator_t&,
+            TransportReceiverInterface*,
+            uint32_t) override;
+
+    virtual bool CloseInputChannel(const Locator_t&) override;
+
+    //! Reports whether Locators correspond to the same port.
+    virtual bool DoInputLocatorsMatch(const Locator_t&, const Locator_t&) const override;
+
+    virtual LocatorList_t NormalizeLocator(const Locator_t& locator) override;
+
+    /**
+     * Performs the locator selection algorithm for this transport.
+     *
+     * Unicast locators of this host are selected. Multicast ones are only selected for entries without
+     * unicast locators, as every listener of a multicast port receives the message.
+     *
+     * @param [in, out] selector Locator selector.
+     */
+    virtual void select_locators(LocatorSelector& selector) const override;
+
+    virtual bool is_local_locator(const Locator_t& locator) const override;
+
+    TransportDescriptorInterface* get_configuration() override { return &configuration_; }
+
+    virtual void AddDefaultOutputLocator(LocatorList_t& defaultList) override;
+
+    virtual bool getDefaultMetatrafficMulticastLocators(
+            LocatorList_t& locators,
+            uint32_t metatraffic_multicast_port) const override;
+
+    virtual bool getDefaultMetatrafficUnicastLocators(
+            LocatorList_t& locators,
+            uint32_t metatraffic_unicast_port) const override;
+
+    virtual bool getDefaultUnicastLocators(
+            LocatorList_t& locators,
+            uint32_t unicast_port) const override;
+
+    virtual bool fillMetatrafficMulticastLocator(
+            Locator_t& locator,
+            uint32_t metatraffic_multicast_port) const override;
+
+    virtual bool fillMetatrafficUnicastLocator(
+            Locator_t& locator,
+            uint32_t metatraffic_unicast_port) const override;
+
+    virtual bool configureInitialPeerLocator(
+            Locator_t& locator,
+            const PortParameters& port_params,
+            uint32_t domainId,
+            LocatorList_t& list) const override;
+
+    virtual bool fillUnicastLocator(
+            Locator_t& locator,
+            uint32_t well_known_port) const override;
+
+    /**
+     * Copies a message into the segment of this transport and queues it on the port of the remote locator.
+     * Blocks up to timeout while the segment or the ring of a listener is full.
+     * @param send_buffer Message to send.
+     * @param send_buffer_size Size of the message.
+     * @param remote_locator Destination.
+     * @param timeout Maximum blocking time.
+     * @return false when the destination is not reachable or the message could not be placed in the segment.
+     */
+    bool send(
+            const octet* send_buffer,
+            uint32_t send_buffer_size,
+            const Locator_t& remote_locator,
+            const std::chrono::microseconds& timeout);
+
+    /**
+     * Sends a message made of several slices, which are gathered directly into the segment.
+     * @see send
+     */
+    bool send(
+            const std::vector<NetworkBuffer>& buffers,
+            uint32_t total_bytes,
+            const Locator_t& remote_locator,
+            const std::chrono::microseconds& timeout);
+
+protected:
+
+    SharedMemTransportDescriptor configuration_;
+
+private:
+
+    typedef std::pair<uint32_t, bool> PortKey;
+
+    static PortKey port_key(const Locator_t& locator);
+
+    void fill_locator(
+            Locator_t& locator,
+            uint32_t port,
+            bool is_multicast) const;
+
+    //! Port used to send to a locator. Opened on first use.
+    SharedMemPort* output_port(const Locator_t& locator);
+
+    /**
+     * Reserves space for a message in the segment of this transport, reusing the space of released messages.
+     * @return Offset of the buffer, or false when there is no space before deadline.
+     */
+    bool allocate_buffer(
+            uint32_t size,
+            const std::chrono::steady_clock::time_point& deadline,
+            uint32_t& offset);
+
+    //! Moves forward over the oldest buffers not referenced anymore. allocation_mutex_ must be locked.
+    void reclaim_buffers();
+
+    //! Queues an allocated buffer on every listener of a port and drops the reference of the sender.
+    bool deliver_buffer(
+            SharedMemPort* port,
+            uint32_t offset,
+            uint32_t size,
+            const std::chrono::steady_clock::time_point& deadline);
+
+    //! Maps the segment of a sender, using the given cache.
+    static SharedMemSegment* find_segment(
+            std::map<uint64_t, std::unique_ptr<SharedMemSegment>>& segments,
+            uint64_t segment_id);
+
+    //! Payload of a received descriptor, or nullptr when the descriptor does not fit its segment.
+    static const octet* buffer_data(
+            SharedMemSegment* segment,
+            const SharedMemBufferDescriptor& descriptor);
+
+    //! Drops the reference a listener holds on a buffer.
+    static void release_buffer(
+            SharedMemSegment* segment,
+            const SharedMemBufferDescriptor& descriptor);
+
+    //! Releases a buffer queued on a listener that will never read it.
+    void release_pending_buffer(const SharedMemBufferDescriptor& descriptor);
+
+    uint32_t host_id_;
+
+    uint64_t segment_id_;
+
+    std::unique_ptr<SharedMemSegment> segment_;
+
+    std::mutex allocation_mutex_;
+    uint32_t allocation_head_;
+    uint32_t allocation_tail_;
+    uint32_t allocation_used_;
+
+    std::mutex output_ports_mutex_;
+    std::map<PortKey, std::unique_ptr<SharedMemPort>> output_ports_;
+
+    mutable std::mutex input_channels_mutex_;
+    std::map<PortKey, std::unique_ptr<SharedMemChannelResource>> input_channels_;
+
+    //! Segments of other transports mapped to release buffers of dead or closing listeners.
+    std::mutex pending_segments_mutex_;
+    std::map<uint64_t, std::unique_ptr<SharedMemSegment>> pending_segments_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // SHAREDMEM_TRANSPORT_H
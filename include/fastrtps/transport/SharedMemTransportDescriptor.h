@@ -0,0 +1,76 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SHAREDMEM_TRANSPORT_DESCRIPTOR_H
+#define SHAREDMEM_TRANSPORT_DESCRIPTOR_H
+
+#include "TransportDescriptorInterface.h"
+#include "../fastrtps_dll.h"
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+class TransportInterface;
+
+static const uint32_t s_defaultSharedMemSegmentSize = 1024 * 1024;
+static const uint32_t s_defaultSharedMemPortQueueCapacity = 512;
+static const uint32_t s_defaultSharedMemPermissions = 0600;
+
+/**
+ * Shared memory transport configuration
+ *
+ * - segment_size: size of the shared memory segment where the transport places the messages it sends.
+ *                 Messages stay in the segment until every listener has processed them, so it bounds
+ *                 the amount of data in flight. It must be greater than maxMessageSize.
+ *
+ * - port_queue_capacity: number of messages a listening port holds before its listener takes them.
+ *                 Only used by the transport that creates the port; the rest use the capacity found
+ *                 in the existing port.
+ *
+ * - permissions: access mode, as in chmod, of the shared memory objects the transport creates. The default
+ *                 0600 only lets processes of the same user communicate; 0660 or 0666 open it to the group
+ *                 or to everybody.
+ *
+ * maxMessageSize keeps the UDP default, because the participant uses the greatest size among all its
+ * transports. It can be raised when shared memory is the only transport of the participant.
+ * @ingroup TRANSPORT_MODULE
+ */
+typedef struct SharedMemTransportDescriptor : public TransportDescriptorInterface
+{
+    virtual ~SharedMemTransportDescriptor(){}
+
+    virtual TransportInterface* create_transport() const override;
+
+    virtual uint32_t min_send_buffer_size() const override { return segment_size; }
+
+    RTPS_DllAPI SharedMemTransportDescriptor();
+
+    RTPS_DllAPI SharedMemTransportDescriptor(const SharedMemTransportDescriptor& t);
+
+    //! Size in bytes of the segment holding the messages sent by the transport.
+    uint32_t segment_size;
+
+    //! Number of messages each listening port can queue.
+    uint32_t port_queue_capacity;
+
+    //! Access mode of the segment and the ports created by the transport.
+    uint32_t permissions;
+} SharedMemTransportDescriptor;
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // SHAREDMEM_TRANSPORT_DESCRIPTOR_H
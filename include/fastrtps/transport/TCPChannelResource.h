@@ -18,6 +18,7 @@
 #include <fastrtps/transport/TCPTransportDescriptor.h>
 #include <fastrtps/transport/TransportReceiverInterface.h>
 #include <fastrtps/transport/ChannelResource.h>
+#include <fastrtps/transport/NetworkBuffer.h>
 #include <fastrtps/transport/tcp/RTCPMessageManager.h>
 #include <fastrtps/rtps/common/Locator.h>
 
@@ -126,6 +127,17 @@ public:
         size_t size,
         asio::error_code& ec) = 0;
 
+    /**
+     * Sends a header followed by a list of slices as a single gathered write.
+     * @return Number of bytes written, including the header.
+     */
+    virtual size_t send(
+        const octet* header,
+        size_t header_size,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        asio::error_code& ec) = 0;
+
     virtual asio::ip::tcp::endpoint remote_endpoint() const = 0;
 
     virtual asio::ip::tcp::endpoint local_endpoint() const = 0;
@@ -22,6 +22,8 @@ namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
+class NetworkBufferSequence;
+
 class TCPChannelResourceBasic : public TCPChannelResource
 {
     asio::io_service& service_;
@@ -60,6 +62,13 @@ public:
         size_t size,
         asio::error_code& ec) override;
 
+    size_t send(
+        const octet* header,
+        size_t header_size,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        asio::error_code& ec) override;
+
     asio::ip::tcp::endpoint remote_endpoint() const override;
     asio::ip::tcp::endpoint local_endpoint() const override;
 
@@ -77,6 +86,10 @@ public:
 private:
     TCPChannelResourceBasic(const TCPChannelResourceBasic&) = delete;
     TCPChannelResourceBasic& operator=(const TCPChannelResourceBasic&) = delete;
+
+    size_t send_sequence(
+        const NetworkBufferSequence& buffers,
+        asio::error_code& ec);
 };
 
 
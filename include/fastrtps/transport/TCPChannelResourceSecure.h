@@ -24,6 +24,8 @@ namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
+class NetworkBufferSequence;
+
 class TCPChannelResourceSecure : public TCPChannelResource
 {
     public:
@@ -62,6 +64,13 @@ class TCPChannelResourceSecure : public TCPChannelResource
                 size_t size,
                 asio::error_code& ec) override;
 
+        size_t send(
+                const octet* header,
+                size_t header_size,
+                const std::vector<NetworkBuffer>& buffers,
+                uint32_t total_bytes,
+                asio::error_code& ec) override;
+
         asio::ip::tcp::endpoint remote_endpoint() const override;
         asio::ip::tcp::endpoint local_endpoint() const override;
 
@@ -83,6 +92,10 @@ class TCPChannelResourceSecure : public TCPChannelResource
         TCPChannelResourceSecure(const TCPChannelResource&) = delete;
         TCPChannelResourceSecure& operator=(const TCPChannelResource&) = delete;
 
+        size_t send_sequence(
+                const NetworkBufferSequence& buffers,
+                asio::error_code& ec);
+
         asio::io_service& service_;
         asio::ssl::context& ssl_context_;
         asio::io_service::strand strand_read_;
@@ -120,10 +120,14 @@ protected:
         const octet *data,
         uint32_t size) const;
 
+    void calculate_crc(
+        TCPHeader &header,
+        const std::vector<NetworkBuffer>& buffers) const;
+
     void fill_rtcp_header(
         TCPHeader& header,
-        const octet* send_buffer,
-        uint32_t send_buffer_size,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
         uint16_t logical_port) const;
 
     //! Closes the given p_channel_resource and unbind it from every resource.
@@ -302,6 +306,21 @@ public:
         std::shared_ptr<TCPChannelResource>& channel,
         const Locator_t& remote_locator);
 
+    /**
+    * Blocking Send of a message made of several slices through the specified channel.
+    * The TCP header and all the slices are written with a single gathered write.
+    * @param buffers List of slices to send, in order.
+    * @param total_bytes Sum of the sizes of all the slices.
+    * It must not exceed the send_buffer_size fed to this class during construction.
+    * @param channel channel we're sending from.
+    * @param remote_locator Locator describing the remote destination we're sending to.
+    */
+    bool send(
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        std::shared_ptr<TCPChannelResource>& channel,
+        const Locator_t& remote_locator);
+
     /**
      * Performs the locator selection algorithm for this transport.
      *
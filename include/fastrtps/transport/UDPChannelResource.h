@@ -19,6 +19,10 @@
 #include <fastrtps/rtps/common/Locator.h>
 #include <asio.hpp>
 
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
 namespace eprosima{
 namespace fastrtps{
 namespace rtps{
@@ -141,6 +145,12 @@ public:
         ChannelResource::disable();
     }
 
+    /**
+     * When the socket is serviced by the transport's receive threads, waits for the last asynchronous
+     * receive operation to complete before finishing the channel.
+     */
+    virtual void clear() override;
+
     void release();
 
 protected:
@@ -166,6 +176,39 @@ protected:
             uint32_t& receive_buffer_size,
             Locator_t& remote_locator);
 
+    /**
+     * Starts an asynchronous receive operation on the socket. Its completion is dispatched by one of
+     * the receive threads shared by all the channel resources of the transport.
+     */
+    void async_receive();
+
+    /**
+     * Completion handler of an asynchronous receive operation. Dispatches the received message and
+     * starts the next receive operation while the channel is alive.
+     * @param error Result of the receive operation.
+     * @param bytes_received Size of the received datagram.
+     */
+    void on_async_receive(
+            const asio::error_code& error,
+            std::size_t bytes_received);
+
+#if defined(__linux__)
+    /**
+     * Function to be called from a new thread when batched receive is enabled. It performs a blocking
+     * receive of several datagrams at once and dispatches them in arrival order.
+     * @param input_locator - Locator that triggered the creation of the resource
+     */
+    void perform_batched_listen_operation(
+            Locator_t input_locator);
+
+    /**
+     * Blocking receive of up to receive_batch_size_ datagrams from the specified channel.
+     * Blocks until at least one datagram is available, then retrieves the ones already queued.
+     * @return Number of datagrams stored on batch_buffers_ and batch_endpoints_.
+     */
+    uint32_t ReceiveBatch();
+#endif
+
 private:
 
     TransportReceiverInterface* message_receiver_; //Associated Readers/Writers inside of MessageReceiver
@@ -174,6 +217,26 @@ private:
     std::string interface_;
     UDPTransportInterface* transport_;
 
+    //! Maximum number of datagrams retrieved on each receive call.
+    uint32_t receive_batch_size_;
+
+    //! Whether the socket is serviced by the transport's shared receive threads.
+    bool use_receive_threads_;
+    Locator_t input_locator_;
+    asio::ip::udp::endpoint async_remote_endpoint_;
+    std::mutex async_receive_mutex_;
+    std::condition_variable async_receive_cv_;
+    bool async_receive_pending_;
+
+#if defined(__linux__)
+    //! Receive buffers used on batched mode.
+    std::vector<CDRMessage_t> batch_buffers_;
+    //! Origin of each datagram received on batched mode.
+    std::vector<asio::ip::udp::endpoint> batch_endpoints_;
+    std::vector<struct iovec> batch_iovecs_;
+    std::vector<struct mmsghdr> batch_headers_;
+#endif
+
     UDPChannelResource(const UDPChannelResource&) = delete;
     UDPChannelResource& operator=(const UDPChannelResource&) = delete;
 };
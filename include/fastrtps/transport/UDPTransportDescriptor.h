@@ -55,6 +55,38 @@ typedef struct UDPTransportDescriptor: public SocketTransportDescriptor
     * datagram. This may hinder performance on high-frequency writers.
     */
    bool non_blocking_send = false;
+
+   /**
+    * Maximum number of datagrams retrieved from a listening socket on each receive call.
+    *
+    * When set to a value greater than 1, and the platform supports it (recvmmsg on Linux), each
+    * listening thread pulls up to this number of datagrams in a single system call and dispatches
+    * them in arrival order. This reduces the per-datagram system call overhead under bursts of small
+    * samples, at the cost of allocating this number of receive buffers per listening socket.
+    *
+    * When set to 1, one datagram is received per call.
+    */
+   uint32_t receive_batch_size = 1;
+
+   /**
+    * Number of threads servicing the listening sockets of this transport.
+    *
+    * When set to 0, each listening socket is serviced by its own thread.
+    *
+    * When greater than 0, all listening sockets of the transport are serviced by a shared pool with
+    * this number of threads, which wait for incoming datagrams through the platform's reactor (epoll on
+    * Linux). This bounds the number of receive threads regardless of the number of open locators and
+    * interfaces. In this mode receive_batch_size is not used.
+    */
+   uint32_t receive_threads = 0;
+
+   /**
+    * CPU cores the shared receive threads are pinned to (only supported on Linux).
+    *
+    * Thread i of the pool is pinned to receive_threads_affinity[i % receive_threads_affinity.size()].
+    * When empty, receive threads are not pinned.
+    */
+   std::vector<uint32_t> receive_threads_affinity;
 } UDPTransportDescriptor;
 
 } // namespace rtps
@@ -21,6 +21,7 @@
 #include "TransportInterface.h"
 #include "UDPChannelResource.h"
 #include "UDPTransportDescriptor.h"
+#include "NetworkBuffer.h"
 #include "../utils/IPFinder.h"
 
 #include <vector>
@@ -32,6 +33,8 @@ namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
+class NetworkBufferSequence;
+
 class UDPTransportInterface : public TransportInterface
 {
 public:
@@ -105,6 +108,52 @@ public:
            bool only_multicast_purpose,
            const std::chrono::microseconds& timeout);
 
+   /**
+   * Blocking Send of a message made of several slices through the specified channel.
+   * The slices are gathered by the socket layer (sendmsg) into a single datagram, so they are never
+   * copied into an intermediate buffer.
+   * @param buffers List of slices to send, in order.
+   * @param total_bytes Sum of the sizes of all the slices. It must not exceed the send_buffer_size fed to this
+   * class during construction.
+   * @param socket channel we're sending from.
+   * @param remote_locator Locator describing the remote destination we're sending to.
+   * @param only_multicast_purpose
+   * @param timeout Maximum time this function will block
+   */
+   virtual bool send(
+           const std::vector<NetworkBuffer>& buffers,
+           uint32_t total_bytes,
+           eProsimaUDPSocket& socket,
+           const Locator_t& remote_locator,
+           bool only_multicast_purpose,
+           const std::chrono::microseconds& timeout);
+
+   /**
+   * Blocking Send of a message made of several slices to a list of destinations through the specified channel.
+   * On Linux the datagrams to all the destinations are handed to the socket layer in batches (sendmmsg),
+   * so fanning out a message costs a few system calls instead of one per destination.
+   * @param buffers List of slices to send, in order.
+   * @param total_bytes Sum of the sizes of all the slices. It must not exceed the send_buffer_size fed to this
+   * class during construction.
+   * @param socket channel we're sending from.
+   * @param remote_locators Array of locators describing the remote destinations we're sending to.
+   * Locators not supported by this transport are skipped.
+   * @param num_locators Number of locators in remote_locators.
+   * @param only_multicast_purpose
+   * @param timeout Maximum time this function will block. Once it expires, the datagrams still pending are
+   * only handed to the socket layer if that does not block.
+   * @return false when the datagram was not sent to some destination, including those dropped because the
+   * socket would block.
+   */
+   virtual bool send(
+           const std::vector<NetworkBuffer>& buffers,
+           uint32_t total_bytes,
+           eProsimaUDPSocket& socket,
+           const Locator_t* remote_locators,
+           size_t num_locators,
+           bool only_multicast_purpose,
+           const std::chrono::microseconds& timeout);
+
     /**
      * Performs the locator selection algorithm for this transport.
      *
@@ -144,8 +193,17 @@ protected:
     uint32_t mSendBufferSize;
     uint32_t mReceiveBufferSize;
 
+    //! Shared threads servicing the asynchronous receive operations of all input sockets, when enabled.
+    std::vector<std::thread> receive_threads_;
+
     UDPTransportInterface(int32_t transport_kind);
 
+    //! Starts the configured number of shared receive threads, pinning them if requested.
+    void start_receive_threads();
+
+    //! Stops and joins the shared receive threads.
+    void stop_receive_threads();
+
     virtual bool compare_locator_ip(const Locator_t& lh, const Locator_t& rh) const = 0;
     virtual bool compare_locator_ip_and_port(const Locator_t& lh, const Locator_t& rh) const = 0;
 
@@ -182,6 +240,15 @@ protected:
     virtual void set_receive_buffer_size(uint32_t size) = 0;
     virtual void set_send_buffer_size(uint32_t size) = 0;
     virtual void SetSocketOutboundInterface(eProsimaUDPSocket&, const std::string&) = 0;
+
+    //! Sends a gathered sequence of slices as a single datagram.
+    bool send_sequence(
+            const NetworkBufferSequence& buffers,
+            uint32_t total_bytes,
+            eProsimaUDPSocket& socket,
+            const Locator_t& remote_locator,
+            bool only_multicast_purpose,
+            const std::chrono::microseconds& timeout);
 };
 
 } // namespace rtps
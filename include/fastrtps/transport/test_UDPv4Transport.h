@@ -18,6 +18,8 @@
 #include <fastrtps/rtps/messages/RTPS_messages.h>
 #include <fastrtps/rtps/common/SequenceNumber.h>
 #include <fastrtps/rtps/messages/CDRMessage.h>
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 #include "test_UDPv4TransportDescriptor.h"
@@ -44,13 +46,33 @@ public:
            bool only_multicast_purpose,
            const std::chrono::microseconds& timeout) override;
 
-    RTPS_DllAPI static bool test_UDPv4Transport_ShutdownAllNetwork;
+    virtual bool send(
+           const std::vector<NetworkBuffer>& buffers,
+           uint32_t total_bytes,
+           eProsimaUDPSocket& socket,
+           const Locator_t& remote_locator,
+           bool only_multicast_purpose,
+           const std::chrono::microseconds& timeout) override;
+
+    virtual bool send(
+           const std::vector<NetworkBuffer>& buffers,
+           uint32_t total_bytes,
+           eProsimaUDPSocket& socket,
+           const Locator_t* remote_locators,
+           size_t num_locators,
+           bool only_multicast_purpose,
+           const std::chrono::microseconds& timeout) override;
+
+    RTPS_DllAPI static std::atomic<bool> test_UDPv4Transport_ShutdownAllNetwork;
     // Handle to a persistent log of dropped packets. Defaults to length 0 (no logging) to prevent wasted resources.
     RTPS_DllAPI static std::vector<std::vector<octet> > test_UDPv4Transport_DropLog;
     RTPS_DllAPI static uint32_t test_UDPv4Transport_DropLogLength;
 
 private:
 
+    //! Protects the drop log, as several threads may send through the transports at the same time.
+    static std::mutex drop_log_mutex_;
+
     struct PercentageData
     {
         PercentageData(uint8_t percent)
@@ -72,6 +94,8 @@ private:
     PercentageData drop_ack_nack_messages_percentage_;
     std::vector<SequenceNumber_t> sequence_number_data_messages_to_drop_;
     PercentageData percentage_of_messages_to_drop_;
+    //! Protects the accumulators of the percentages, as several threads may send at the same time.
+    std::mutex drop_mutex_;
 
     bool log_drop(const octet* buffer, uint32_t size);
     bool packet_should_drop(const octet* send_buffer, uint32_t send_buffer_size);
@@ -133,6 +133,16 @@ protected:
     std::map<MemberId, DynamicData*> complex_values_;
 #else
     std::map<MemberId, void*> values_;
+
+    //! In place storage for the value of primitive, enum and bitmask types, so it needs no allocation of its own.
+    union
+    {
+        int64_t int64_;
+        uint64_t uint64_;
+        double float64_;
+        long double float128_;
+        wchar_t char16_;
+    } primitive_value_;
 #endif
     std::vector<MemberId> loaned_values_;
     bool key_element_;
@@ -144,6 +154,7 @@ protected:
 
     friend class DynamicDataFactory;
     friend class DynamicPubSubType;
+    friend class DynamicSerializationPlan;
 
 public:
 
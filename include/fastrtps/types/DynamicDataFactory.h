@@ -21,6 +21,7 @@
 #include <fastrtps/types/DynamicType.h>
 #include <fastrtps/types/DynamicData.h>
 #include <mutex>
+#include <vector>
 //#define DISABLE_DYNAMIC_MEMORY_CHECK
 
 namespace eprosima {
@@ -37,7 +38,28 @@ protected:
             DynamicType_ptr pType);
 
 #ifndef DISABLE_DYNAMIC_MEMORY_CHECK
+    void register_data(DynamicData* pData);
+
+    bool unregister_data(DynamicData* pData);
+
+    //! Finds the slot of a data in dynamic_datas_index_, or the free slot where it would be stored.
+    size_t find_index_slot(DynamicData* pData) const;
+
+    //! Compacts dynamic_datas_ and rebuilds dynamic_datas_index_ with room for the live data.
+    void rebuild_index();
+
+    struct IndexSlot
+    {
+        DynamicData* data;
+        size_t position;
+    };
+
+    // Kept in creation order, nullptr for deleted data. Compacted when half of it is deleted data.
     std::vector<DynamicData*> dynamic_datas_;
+    // Open addressing table from data to its position in dynamic_datas_, so no allocation is done per data.
+    std::vector<IndexSlot> dynamic_datas_index_;
+    size_t live_datas_ = 0;
+    size_t used_index_slots_ = 0;
     mutable std::recursive_mutex mutex_;
 #endif
 
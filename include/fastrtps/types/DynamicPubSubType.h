@@ -24,6 +24,8 @@ namespace eprosima {
 namespace fastrtps {
 namespace types {
 
+class DynamicSerializationPlan;
+
 class DynamicPubSubType : public eprosima::fastrtps::TopicDataType
 {
 protected:
@@ -33,6 +35,9 @@ protected:
     DynamicType_ptr dynamic_type_;
     MD5 m_md5;
     unsigned char* m_keyBuffer;
+    size_t m_keyBufferSize;
+    //! Serialization instructions compiled from dynamic_type_.
+    DynamicSerializationPlan* m_serializationPlan;
 
 public:
 
@@ -42,6 +42,7 @@ protected:
     friend class DynamicData;
     friend class DynamicTypeMember;
     friend class TypeObjectFactory;
+    friend class DynamicSerializationPlan;
 
     bool is_default_value_consistent(const std::string& sDefaultValue) const;
 
@@ -0,0 +1,231 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file HeadIndexedVector.hpp
+ *
+ */
+
+#ifndef FASTRTPS_UTILS_COLLECTIONS_HEADINDEXEDVECTOR_HPP_
+#define FASTRTPS_UTILS_COLLECTIONS_HEADINDEXEDVECTOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+
+/**
+ * Vector whose first element starts at a moving head inside a std::vector.
+ *
+ * Erasing the first element just advances the head, so using it as a FIFO is constant time. Erasing or inserting
+ * closer to the beginning than to the end moves the elements before the position instead of the ones after it.
+ * The free room before the head is reclaimed when the storage runs out of capacity, so a FIFO of bounded size
+ * stops allocating once it has grown to twice that size.
+ *
+ * Iterators are the ones of the underlying std::vector, and are invalidated as with it by any insertion or
+ * erasure.
+ *
+ * @tparam _Ty    Element type.
+ * @tparam _Alloc Allocator to use on the underlying vector, defaults to std::allocator<_Ty>.
+ *
+ * @ingroup UTILITIES_MODULE
+ */
+template <
+    typename _Ty,
+    typename _Alloc = std::allocator<_Ty> >
+class HeadIndexedVector
+{
+public:
+
+    using collection_type = std::vector<_Ty, _Alloc>;
+
+    using value_type = typename collection_type::value_type;
+    using size_type = typename collection_type::size_type;
+    using reference = typename collection_type::reference;
+    using const_reference = typename collection_type::const_reference;
+    using iterator = typename collection_type::iterator;
+    using const_iterator = typename collection_type::const_iterator;
+    using reverse_iterator = typename collection_type::reverse_iterator;
+    using const_reverse_iterator = typename collection_type::const_reverse_iterator;
+
+    HeadIndexedVector()
+        : head_(0)
+    {
+    }
+
+    iterator begin()
+    {
+        return collection_.begin() + head_;
+    }
+
+    const_iterator begin() const
+    {
+        return collection_.begin() + head_;
+    }
+
+    iterator end()
+    {
+        return collection_.end();
+    }
+
+    const_iterator end() const
+    {
+        return collection_.end();
+    }
+
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    bool empty() const
+    {
+        return collection_.size() == head_;
+    }
+
+    size_type size() const
+    {
+        return collection_.size() - head_;
+    }
+
+    reference operator [](
+            size_type pos)
+    {
+        return collection_[head_ + pos];
+    }
+
+    const_reference operator [](
+            size_type pos) const
+    {
+        return collection_[head_ + pos];
+    }
+
+    reference front()
+    {
+        return collection_[head_];
+    }
+
+    const_reference front() const
+    {
+        return collection_[head_];
+    }
+
+    reference back()
+    {
+        return collection_.back();
+    }
+
+    const_reference back() const
+    {
+        return collection_.back();
+    }
+
+    void reserve(
+            size_type new_capacity)
+    {
+        collection_.reserve(head_ + new_capacity);
+    }
+
+    void clear()
+    {
+        collection_.clear();
+        head_ = 0;
+    }
+
+    void push_back(
+            const value_type& val)
+    {
+        make_room();
+        collection_.push_back(val);
+    }
+
+    iterator insert(
+            iterator pos,
+            const value_type& val)
+    {
+        size_type index = static_cast<size_type>(pos - begin());
+        if (head_ > 0 && index < size() / 2)
+        {
+            // The elements before the position move one place towards the head.
+            --head_;
+            iterator first = begin();
+            std::move(first + 1, first + 1 + index, first);
+            *(first + index) = val;
+            return first + index;
+        }
+
+        make_room();
+        return collection_.insert(begin() + index, val);
+    }
+
+    iterator erase(
+            iterator pos)
+    {
+        size_type index = static_cast<size_type>(pos - begin());
+        if (index < size() / 2 || index == 0)
+        {
+            // The elements before the position move one place away from the head.
+            std::move_backward(begin(), pos, pos + 1);
+            ++head_;
+            if (empty())
+            {
+                clear();
+            }
+            return begin() + index;
+        }
+
+        return collection_.erase(pos);
+    }
+
+private:
+
+    //! Reclaims the room before the head when the storage is full and at least half of it is free.
+    void make_room()
+    {
+        if (head_ > 0 && collection_.size() == collection_.capacity() && head_ * 2 >= collection_.size())
+        {
+            collection_.erase(collection_.begin(), collection_.begin() + head_);
+            head_ = 0;
+        }
+    }
+
+    collection_type collection_;
+
+    //! Position in collection_ of the first element.
+    size_type head_;
+};
+
+}  // namespace fastrtps
+}  // namespace eprosima
+
+#endif /* FASTRTPS_UTILS_COLLECTIONS_HEADINDEXEDVECTOR_HPP_ */
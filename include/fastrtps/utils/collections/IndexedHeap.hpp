@@ -0,0 +1,214 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file IndexedHeap.hpp
+ *
+ */
+
+#ifndef FASTRTPS_UTILS_COLLECTIONS_INDEXEDHEAP_HPP_
+#define FASTRTPS_UTILS_COLLECTIONS_INDEXEDHEAP_HPP_
+
+#include <assert.h>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+
+/**
+ * Binary min-heap of keys ordered by a priority, with lookup by key.
+ *
+ * Every key appears at most once. Its priority can be changed or the key removed at any time, both in
+ * logarithmic time, and the key with the lowest priority is accessed in constant time.
+ *
+ * @tparam _Key        Key type.
+ * @tparam _Priority   Priority type. The top of the heap holds the lowest one.
+ * @tparam _KeyLess    Strict weak ordering of keys, defaults to std::less<_Key>.
+ *
+ * @ingroup UTILITIES_MODULE
+ */
+template <
+    typename _Key,
+    typename _Priority,
+    typename _KeyLess = std::less<_Key> >
+class IndexedHeap
+{
+public:
+
+    typedef std::pair<_Priority, _Key> value_type;
+    typedef std::size_t size_type;
+
+    bool empty() const
+    {
+        return heap_.empty();
+    }
+
+    size_type size() const
+    {
+        return heap_.size();
+    }
+
+    void clear()
+    {
+        heap_.clear();
+        positions_.clear();
+    }
+
+    /**
+     * Whether a key is on the heap.
+     * @param key Key to look for.
+     */
+    bool contains(const _Key& key) const
+    {
+        return positions_.find(key) != positions_.end();
+    }
+
+    /**
+     * Sets the priority of a key, adding the key when it is not on the heap.
+     * @param key Key to update.
+     * @param priority New priority of the key.
+     */
+    void update(
+            const _Key& key,
+            const _Priority& priority)
+    {
+        auto it = positions_.find(key);
+        if (it == positions_.end())
+        {
+            positions_.emplace(key, heap_.size());
+            heap_.emplace_back(priority, key);
+            sift_up(heap_.size() - 1);
+        }
+        else
+        {
+            size_type pos = it->second;
+            heap_[pos].first = priority;
+            if (!sift_up(pos))
+            {
+                sift_down(pos);
+            }
+        }
+    }
+
+    /**
+     * Removes a key from the heap.
+     * @param key Key to remove.
+     * @return true when the key was on the heap.
+     */
+    bool erase(const _Key& key)
+    {
+        auto it = positions_.find(key);
+        if (it == positions_.end())
+        {
+            return false;
+        }
+
+        size_type pos = it->second;
+        positions_.erase(it);
+
+        size_type last = heap_.size() - 1;
+        if (pos != last)
+        {
+            heap_[pos] = std::move(heap_[last]);
+            positions_[heap_[pos].second] = pos;
+            heap_.pop_back();
+            if (!sift_up(pos))
+            {
+                sift_down(pos);
+            }
+        }
+        else
+        {
+            heap_.pop_back();
+        }
+
+        return true;
+    }
+
+    /**
+     * Priority and key with the lowest priority. The heap must not be empty.
+     */
+    const value_type& top() const
+    {
+        assert(!heap_.empty());
+        return heap_.front();
+    }
+
+private:
+
+    //! Moves an element towards the root while it is lower than its parent. Returns whether it moved.
+    bool sift_up(size_type pos)
+    {
+        bool moved = false;
+        while (pos > 0)
+        {
+            size_type parent = (pos - 1) / 2;
+            if (!(heap_[pos].first < heap_[parent].first))
+            {
+                break;
+            }
+            swap_nodes(pos, parent);
+            pos = parent;
+            moved = true;
+        }
+        return moved;
+    }
+
+    //! Moves an element towards the leaves while it is greater than one of its children.
+    void sift_down(size_type pos)
+    {
+        size_type count = heap_.size();
+        for (;;)
+        {
+            size_type lowest = pos;
+            size_type left = 2 * pos + 1;
+            size_type right = left + 1;
+            if (left < count && heap_[left].first < heap_[lowest].first)
+            {
+                lowest = left;
+            }
+            if (right < count && heap_[right].first < heap_[lowest].first)
+            {
+                lowest = right;
+            }
+            if (lowest == pos)
+            {
+                break;
+            }
+            swap_nodes(pos, lowest);
+            pos = lowest;
+        }
+    }
+
+    void swap_nodes(
+            size_type a,
+            size_type b)
+    {
+        std::swap(heap_[a], heap_[b]);
+        positions_[heap_[a].second] = a;
+        positions_[heap_[b].second] = b;
+    }
+
+    std::vector<value_type> heap_;
+    std::map<_Key, size_type, _KeyLess> positions_;
+};
+
+}  // namespace fastrtps
+}  // namespace eprosima
+
+#endif /* FASTRTPS_UTILS_COLLECTIONS_INDEXEDHEAP_HPP_ */
@@ -0,0 +1,170 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file shared_mutex.hpp
+ */
+
+#ifndef _UTILS_SHARED_MUTEX_HPP_
+#define _UTILS_SHARED_MUTEX_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace eprosima {
+namespace fastrtps {
+
+/**
+ * Reader-writer mutex, usable on C++11 builds where std::shared_timed_mutex is not available.
+ *
+ * Writers have priority: once a writer is waiting, new readers block until it has finished.
+ * This keeps the (rare) writers from starving when the mutex guards read-mostly state
+ * on a hot path.
+ */
+class shared_mutex
+{
+public:
+
+    shared_mutex() = default;
+
+    shared_mutex(const shared_mutex&) = delete;
+    shared_mutex& operator=(const shared_mutex&) = delete;
+
+    void lock()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++waiting_writers_;
+        writer_cv_.wait(lock, [this]()
+                {
+                    return !writer_active_ && active_readers_ == 0;
+                });
+        --waiting_writers_;
+        writer_active_ = true;
+    }
+
+    bool try_lock()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (writer_active_ || active_readers_ > 0)
+        {
+            return false;
+        }
+        writer_active_ = true;
+        return true;
+    }
+
+    void unlock()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            writer_active_ = false;
+        }
+
+        // Either another writer or all the blocked readers may proceed.
+        writer_cv_.notify_one();
+        reader_cv_.notify_all();
+    }
+
+    void lock_shared()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        reader_cv_.wait(lock, [this]()
+                {
+                    return !writer_active_ && waiting_writers_ == 0;
+                });
+        ++active_readers_;
+    }
+
+    bool try_lock_shared()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (writer_active_ || waiting_writers_ > 0)
+        {
+            return false;
+        }
+        ++active_readers_;
+        return true;
+    }
+
+    void unlock_shared()
+    {
+        bool last_reader = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last_reader = (--active_readers_ == 0);
+        }
+
+        if (last_reader)
+        {
+            writer_cv_.notify_one();
+        }
+    }
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable reader_cv_;
+    std::condition_variable writer_cv_;
+    uint32_t active_readers_ = 0;
+    uint32_t waiting_writers_ = 0;
+    bool writer_active_ = false;
+};
+
+/**
+ * RAII holder of a shared_mutex in shared mode. Equivalent to std::shared_lock.
+ */
+template<class Mutex>
+class shared_lock
+{
+public:
+
+    explicit shared_lock(Mutex& mutex)
+        : mutex_(mutex)
+        , owns_(true)
+    {
+        mutex_.lock_shared();
+    }
+
+    ~shared_lock()
+    {
+        if (owns_)
+        {
+            mutex_.unlock_shared();
+        }
+    }
+
+    shared_lock(const shared_lock&) = delete;
+    shared_lock& operator=(const shared_lock&) = delete;
+
+    //! Releases the mutex before the end of the scope.
+    void unlock()
+    {
+        if (owns_)
+        {
+            owns_ = false;
+            mutex_.unlock_shared();
+        }
+    }
+
+private:
+
+    Mutex& mutex_;
+    bool owns_;
+};
+
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _UTILS_SHARED_MUTEX_HPP_
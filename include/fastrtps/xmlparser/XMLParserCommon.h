@@ -56,6 +56,10 @@ extern const char* RECEIVE_BUFFER_SIZE;
 extern const char* SEND_BUFFER_SIZE;
 extern const char* TTL;
 extern const char* NON_BLOCKING_SEND;
+extern const char* RECEIVE_BATCH_SIZE;
+extern const char* RECEIVE_THREADS;
+extern const char* RECEIVE_THREADS_AFFINITY;
+extern const char* CPU;
 extern const char* WHITE_LIST;
 extern const char* MAX_MESSAGE_SIZE;
 extern const char* MAX_INITIAL_PEERS_RANGE;
@@ -69,6 +73,9 @@ extern const char* METADATA_LOGICAL_PORT;
 extern const char* LISTENING_PORTS;
 extern const char* CALCULATE_CRC;
 extern const char* CHECK_CRC;
+extern const char* SEGMENT_SIZE;
+extern const char* PORT_QUEUE_CAPACITY;
+extern const char* PERMISSIONS;
 
 extern const char* QOS_PROFILE;
 extern const char* APPLICATION;
@@ -84,6 +91,8 @@ extern const char* DEF_UNI_LOC_LIST;
 extern const char* DEF_MULTI_LOC_LIST;
 extern const char* SEND_SOCK_BUF_SIZE;
 extern const char* LIST_SOCK_BUF_SIZE;
+extern const char* RECV_PROCESSING_THREADS;
+extern const char* INTRAPROCESS_DELIVERY;
 extern const char* BUILTIN;
 extern const char* PORT;
 extern const char* PORTS;
@@ -130,6 +139,7 @@ extern const char* PROPAGATE;
 extern const char* PREALLOCATED;
 extern const char* PREALLOCATED_WITH_REALLOC;
 extern const char* DYNAMIC;
+extern const char* SIZE_CLASS;
 extern const char* LOCATOR;
 extern const char* UDPv4_LOCATOR;
 extern const char* UDPv6_LOCATOR;
@@ -144,6 +154,7 @@ extern const char* UDPv4;
 extern const char* UDPv6;
 extern const char* TCPv4;
 extern const char* TCPv6;
+extern const char* SHM;
 extern const char* INIT_ACKNACK_DELAY;
 extern const char* HEARTB_RESP_DELAY;
 extern const char* INIT_HEARTB_DELAY;
@@ -220,6 +231,7 @@ extern const char* DEPTH;
 extern const char* ALLOCATED_SAMPLES;
 extern const char* BYTES_PER_SECOND;
 extern const char* PERIOD_MILLISECS;
+extern const char* BURST_SIZE;
 extern const char* PORT_BASE;
 extern const char* DOMAIN_ID_GAIN;
 extern const char* PARTICIPANT_ID_GAIN;
@@ -1,6 +1,7 @@
 #include <chrono>
 #include <iomanip>
 #include <mutex>
+#include <streambuf>
 
 #include <fastrtps/log/Log.h>
 #include <fastrtps/log/StdoutConsumer.h>
@@ -11,14 +12,96 @@ using namespace std;
 namespace eprosima {
 namespace fastrtps {
 
+/**
+ * Single-producer single-consumer ring of fixed-size records.
+ * The owning thread writes the messages directly on the records, and the logging thread consumes them.
+ */
+struct Log::ThreadRing
+{
+    static const size_t Capacity = 64;
+
+    struct Record
+    {
+        Log::Context context;
+        Log::Kind kind;
+        std::chrono::system_clock::time_point time;
+        uint32_t suppressed;
+        bool truncated;
+        size_t length;
+        char message[Log::MaxMessageSize];
+    };
+
+    //! Stream buffer writing on the message of a record, truncating what does not fit.
+    class RecordBuffer : public std::streambuf
+    {
+    public:
+
+        void reset(
+                char* buffer,
+                size_t size)
+        {
+            setp(buffer, buffer + size);
+            truncated = false;
+        }
+
+        size_t length() const
+        {
+            return static_cast<size_t>(pptr() - pbase());
+        }
+
+        bool truncated = false;
+
+    protected:
+
+        int_type overflow(int_type) override
+        {
+            truncated = true;
+            return traits_type::eof();
+        }
+    };
+
+    ThreadRing()
+        : head(0)
+        , tail(0)
+        , orphan(false)
+        , dropped(0)
+        , open(false)
+        , stream(&buffer)
+    {
+    }
+
+    Record records[Capacity];
+    //! Next record to consume. Only written by the logging thread.
+    std::atomic<size_t> head;
+    //! Next record to produce. Only written by the owning thread.
+    std::atomic<size_t> tail;
+    //! Set when the owning thread has finished.
+    std::atomic_bool orphan;
+    //! Entries dropped because the ring was full.
+    uint32_t dropped;
+    //! A record has been started and not committed yet.
+    bool open;
+    RecordBuffer buffer;
+    std::ostream stream;
+};
+
 struct Log::Resources Log::mResources;
 
 Log::Resources::Resources() : mLogging(false),
         mWork(false),
         mFilenames(false),
         mFunctions(true),
-        mVerbosity(Log::Error)
+        mVerbosity(Log::Error),
+        mWakeRequested(false),
+        mRateLimit(0)
 {
+    for (RateBucket& bucket : mRateBuckets)
+    {
+        bucket.window = 0;
+        bucket.count = 0;
+        bucket.suppressed = 0;
+    }
+
     mResources.mConsumers.emplace_back(new StdoutConsumer);
 }
 
@@ -38,7 +121,7 @@ void Log::ClearConsumers()
     std::unique_lock<std::mutex> working(mResources.mCvMutex);
     mResources.mCv.wait(working, [&]()
     {
-        return mResources.mLogs.BothEmpty();
+        return mResources.mLogs.BothEmpty() && RingsEmpty();
     });
     std::unique_lock<std::mutex> guard(mResources.mConfigMutex);
     mResources.mConsumers.clear();
@@ -53,6 +136,7 @@ void Log::Reset()
     mResources.mFilenames = false;
     mResources.mFunctions = true;
     mResources.mVerbosity = Log::Error;
+    mResources.mRateLimit = 0;
     mResources.mConsumers.clear();
     mResources.mConsumers.emplace_back(new StdoutConsumer);
 }
@@ -70,7 +154,7 @@ void Log::Flush()
     // Wait till the background thread signals and...
     mResources.mCv.wait(guard, [&]()
     {   // ... either the logging has ended or the queue is flushed
-        return !mResources.mLogging || mResources.mLogs.BothEmpty();
+        return !mResources.mLogging || (mResources.mLogs.BothEmpty() && RingsEmpty());
     });
 
 }
@@ -85,6 +169,10 @@ void Log::Run()
             mResources.mWork = false;
             guard.unlock();
             {
+                // Records committed from now on will request a new wake up
+                mResources.mWakeRequested = false;
+                ConsumeRings();
+
                 mResources.mLogs.Swap();
                 while (!mResources.mLogs.Empty())
                 {
@@ -155,6 +243,9 @@ void Log::KillThread()
 #endif
         mResources.mLoggingThread.reset();
     }
+
+    // Next record will launch the thread again
+    mResources.mWakeRequested = false;
 }
 
 void Log::QueueLog(const std::string &message, const Log::Context &context, Log::Kind kind)
@@ -169,7 +260,7 @@ void Log::QueueLog(const std::string &message, const Log::Context &context, Log:
     }
 
     std::string timestamp;
-    GetTimestamp(timestamp);
+    GetTimestamp(timestamp, std::chrono::system_clock::now());
     mResources.mLogs.Push(Log::Entry{message, context, kind, timestamp});
     {
         std::unique_lock<std::mutex> guard(mResources.mCvMutex);
@@ -178,6 +269,214 @@ void Log::QueueLog(const std::string &message, const Log::Context &context, Log:
     mResources.mCv.notify_all();
 }
 
+std::ostream* Log::StartRecord(const char* category)
+{
+    uint32_t suppressed = 0;
+    uint32_t rate_limit = mResources.mRateLimit;
+    if (rate_limit != 0)
+    {
+        size_t hash = 0;
+        for (const char* c = category; *c != '\0'; ++c)
+        {
+            hash = (hash * 31) + static_cast<unsigned char>(*c);
+        }
+        RateBucket& bucket = mResources.mRateBuckets[hash % RateBuckets];
+
+        int64_t window = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t current = bucket.window;
+        if (current != window && bucket.window.compare_exchange_strong(current, window))
+        {
+            bucket.count = 0;
+        }
+
+        if (++bucket.count > rate_limit)
+        {
+            ++bucket.suppressed;
+            return nullptr;
+        }
+
+        suppressed = bucket.suppressed.exchange(0);
+    }
+
+    ThreadRing* ring = GetThreadRing();
+    if (ring->open)
+    {
+        // Logging while the message of another entry is being written
+        ++ring->dropped;
+        return nullptr;
+    }
+
+    size_t tail = ring->tail.load(std::memory_order_relaxed);
+    if (tail - ring->head.load(std::memory_order_acquire) >= ThreadRing::Capacity)
+    {
+        ++ring->dropped;
+        Wake();
+        return nullptr;
+    }
+
+    ThreadRing::Record& record = ring->records[tail % ThreadRing::Capacity];
+    record.suppressed = suppressed + ring->dropped;
+    ring->dropped = 0;
+    ring->buffer.reset(record.message, MaxMessageSize);
+    // The stream is reused by every entry of the thread, so the format left by the previous message is reset
+    ring->stream.clear();
+    ring->stream.flags(std::ios_base::skipws | std::ios_base::dec);
+    ring->stream.precision(6);
+    ring->stream.width(0);
+    ring->stream.fill(' ');
+    ring->open = true;
+    return &ring->stream;
+}
+
+void Log::CommitRecord(const Log::Context& context, Log::Kind kind)
+{
+    ThreadRing* ring = GetThreadRing();
+    size_t tail = ring->tail.load(std::memory_order_relaxed);
+    ThreadRing::Record& record = ring->records[tail % ThreadRing::Capacity];
+    record.context = context;
+    record.kind = kind;
+    record.time = std::chrono::system_clock::now();
+    record.length = ring->buffer.length();
+    record.truncated = ring->buffer.truncated;
+    ring->open = false;
+    ring->tail.store(tail + 1, std::memory_order_release);
+
+    // Only the first record after the logging thread has started consuming needs to notify it
+    if (!mResources.mWakeRequested.exchange(true))
+    {
+        Wake();
+    }
+}
+
+void Log::DiscardRecord()
+{
+    ThreadRing* ring = GetThreadRing();
+    if (ring->open)
+    {
+        // Entries already reported by the discarded record are reported by the next one
+        size_t tail = ring->tail.load(std::memory_order_relaxed);
+        ring->dropped += ring->records[tail % ThreadRing::Capacity].suppressed + 1;
+        ring->open = false;
+    }
+}
+
+void Log::Wake()
+{
+    {
+        std::unique_lock<std::mutex> guard(mResources.mCvMutex);
+        if (!mResources.mLogging && !mResources.mLoggingThread)
+        {
+            mResources.mLogging = true;
+            mResources.mLoggingThread.reset(new thread(Log::Run));
+        }
+        mResources.mWork = true;
+    }
+    mResources.mCv.notify_all();
+}
+
+Log::ThreadRing* Log::GetThreadRing()
+{
+    // Marks the ring as orphan when the thread finishes, so the logging thread can release it.
+    struct ThreadRingHolder
+    {
+        ~ThreadRingHolder()
+        {
+            if (ring)
+            {
+                ring->orphan = true;
+            }
+        }
+
+        std::shared_ptr<ThreadRing> ring;
+    };
+
+    static thread_local ThreadRingHolder holder;
+    if (!holder.ring)
+    {
+        holder.ring = std::make_shared<ThreadRing>();
+        std::unique_lock<std::mutex> guard(mResources.mRingsMutex);
+        mResources.mRings.push_back(holder.ring);
+    }
+
+    return holder.ring.get();
+}
+
+void Log::ConsumeRings()
+{
+    // Consumers may log, so the rings are not locked while consuming them
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    {
+        std::unique_lock<std::mutex> guard(mResources.mRingsMutex);
+        rings = mResources.mRings;
+    }
+
+    for (auto& ring : rings)
+    {
+        size_t head = ring->head.load(std::memory_order_relaxed);
+        while (head != ring->tail.load(std::memory_order_acquire))
+        {
+            const ThreadRing::Record& record = ring->records[head % ThreadRing::Capacity];
+
+            Log::Entry entry;
+            entry.message.assign(record.message, record.length);
+            if (record.truncated)
+            {
+                entry.message += "[...]";
+            }
+            if (record.suppressed != 0)
+            {
+                entry.message += " (" + std::to_string(record.suppressed) + " previous entries dropped)";
+            }
+            entry.context = record.context;
+            entry.kind = record.kind;
+            GetTimestamp(entry.timestamp, record.time);
+
+            {
+                std::unique_lock<std::mutex> configGuard(mResources.mConfigMutex);
+                if (Preprocess(entry))
+                {
+                    for (auto &consumer : mResources.mConsumers)
+                    {
+                        consumer->Consume(entry);
+                    }
+                }
+            }
+
+            // Only consumed records leave the ring, so Flush and ClearConsumers wait for the consumers.
+            ring->head.store(++head, std::memory_order_release);
+        }
+    }
+
+    std::unique_lock<std::mutex> guard(mResources.mRingsMutex);
+    auto it = mResources.mRings.begin();
+    while (it != mResources.mRings.end())
+    {
+        if ((*it)->orphan && (*it)->head == (*it)->tail)
+        {
+            it = mResources.mRings.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+bool Log::RingsEmpty()
+{
+    std::unique_lock<std::mutex> guard(mResources.mRingsMutex);
+    for (auto& ring : mResources.mRings)
+    {
+        if (ring->head != ring->tail)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 Log::Kind Log::GetVerbosity()
 {
     return mResources.mVerbosity;
@@ -207,10 +506,14 @@ void Log::SetErrorStringFilter(const std::regex &filter)
     mResources.mErrorStringFilter.reset(new std::regex(filter));
 }
 
-void Log::GetTimestamp(std::string &timestamp)
+void Log::SetCategoryRateLimit(uint32_t max_entries_per_second)
+{
+    mResources.mRateLimit = max_entries_per_second;
+}
+
+void Log::GetTimestamp(std::string &timestamp, const std::chrono::system_clock::time_point& now)
 {
     std::stringstream stream;
-    auto now = std::chrono::system_clock::now();
     std::time_t now_c = std::chrono::system_clock::to_time_t(now);
     std::chrono::system_clock::duration tp = now.time_since_epoch();
     tp -= std::chrono::duration_cast<std::chrono::seconds>(tp);
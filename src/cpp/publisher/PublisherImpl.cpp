@@ -257,6 +257,9 @@ bool PublisherImpl::create_new_change_with_params(
                 lifespan_timer_->restart_timer();
             }
 
+            // Readers of this process get the change once the writer is unlocked, so their listeners may write.
+            lock.unlock();
+            mp_writer->deliver_to_local_readers();
             return true;
         }
     }
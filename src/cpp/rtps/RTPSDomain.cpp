@@ -35,8 +35,13 @@
 #include <fastrtps/utils/md5.h>
 
 #include <fastrtps/rtps/writer/RTPSWriter.h>
+#include <fastrtps/rtps/writer/StatefulWriter.h>
 #include <fastrtps/rtps/reader/RTPSReader.h>
 
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
@@ -45,12 +50,30 @@ std::mutex RTPSDomain::m_mutex;
 std::atomic<uint32_t> RTPSDomain::m_maxRTPSParticipantID(1);
 std::vector<RTPSDomain::t_p_RTPSParticipant> RTPSDomain::m_RTPSParticipants;
 std::set<uint32_t> RTPSDomain::m_RTPSParticipantIDs;
+std::mutex RTPSDomain::m_local_readers_mutex;
+std::condition_variable RTPSDomain::m_local_readers_cv;
+std::map<GUID_t, RTPSDomain::LocalReader> RTPSDomain::m_local_readers;
+
+//! Readers acquired by the calling thread and not released yet.
+static thread_local std::vector<GUID_t> t_acquired_local_readers;
 
 void RTPSDomain::stopAll()
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
+    std::unique_lock<std::mutex> lock(m_mutex);
     logInfo(RTPS_PARTICIPANT,"DELETING ALL ENDPOINTS IN THIS DOMAIN");
 
+    std::vector<GUID_t> reader_guids;
+    for (t_p_RTPSParticipant& participant : m_RTPSParticipants)
+    {
+        unregister_local_readers_nts(participant.second, reader_guids);
+    }
+    lock.unlock();
+    for (const GUID_t& reader_guid : reader_guids)
+    {
+        wait_local_reader_released(reader_guid);
+    }
+    lock.lock();
+
     while(m_RTPSParticipants.size()>0)
     {
         RTPSDomain::removeRTPSParticipant_nts(m_RTPSParticipants.begin());
@@ -183,11 +206,34 @@ bool RTPSDomain::removeRTPSParticipant(RTPSParticipant* p)
 {
     if(p!=nullptr)
     {
-        std::lock_guard<std::mutex> guard(m_mutex);
+        std::unique_lock<std::mutex> lock(m_mutex);
         for(auto it = m_RTPSParticipants.begin();it!= m_RTPSParticipants.end();++it)
         {
             if(it->second->getGuid().guidPrefix == p->getGuid().guidPrefix)
             {
+                // Deliveries in progress to the readers are finished before destroying them.
+                std::vector<GUID_t> reader_guids;
+                unregister_local_readers_nts(it->second, reader_guids);
+                if (!reader_guids.empty())
+                {
+                    lock.unlock();
+                    for (const GUID_t& reader_guid : reader_guids)
+                    {
+                        wait_local_reader_released(reader_guid);
+                    }
+                    lock.lock();
+
+                    it = std::find_if(m_RTPSParticipants.begin(), m_RTPSParticipants.end(),
+                            [p](const t_p_RTPSParticipant& participant)
+                            {
+                                return participant.second->getGuid().guidPrefix == p->getGuid().guidPrefix;
+                            });
+                    if (it == m_RTPSParticipants.end())
+                    {
+                        break;
+                    }
+                }
+
                 removeRTPSParticipant_nts(it);
                 return true;
             }
@@ -199,6 +245,11 @@ bool RTPSDomain::removeRTPSParticipant(RTPSParticipant* p)
 
 void RTPSDomain::removeRTPSParticipant_nts(std::vector<RTPSDomain::t_p_RTPSParticipant>::iterator it)
 {
+    for (auto rit = it->second->userReadersListBegin(); rit != it->second->userReadersListEnd(); ++rit)
+    {
+        unregister_local_reader_nts(*rit);
+    }
+
     m_RTPSParticipantIDs.erase(m_RTPSParticipantIDs.find(it->second->getRTPSParticipantID()));
     delete(it->second);
     m_RTPSParticipants.erase(it);
@@ -256,6 +307,8 @@ RTPSReader* RTPSDomain::createRTPSReader(
             RTPSReader* reader;
             if(it->second->createReader(&reader,ratt,rhist,rlisten))
             {
+                std::lock_guard<std::mutex> local_guard(m_local_readers_mutex);
+                m_local_readers[reader->getGuid()] = LocalReader{reader, 0u, false};
                 return reader;
             }
 
@@ -269,10 +322,19 @@ bool RTPSDomain::removeRTPSReader(RTPSReader* reader)
 {
     if(reader !=  nullptr)
     {
+        GUID_t reader_guid = reader->getGuid();
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            unregister_local_reader_nts(reader);
+        }
+
+        // Deliveries in progress run the listener of the reader, which may need m_mutex.
+        wait_local_reader_released(reader_guid);
+
         std::lock_guard<std::mutex> guard(m_mutex);
         for(auto it= m_RTPSParticipants.begin();it!=m_RTPSParticipants.end();++it)
         {
-            if(it->first->getGuid().guidPrefix == reader->getGuid().guidPrefix)
+            if(it->first->getGuid().guidPrefix == reader_guid.guidPrefix)
             {
                 return it->second->deleteUserEndpoint((Endpoint*)reader);
             }
@@ -281,6 +343,108 @@ bool RTPSDomain::removeRTPSReader(RTPSReader* reader)
     return false;
 }
 
+RTPSReader* RTPSDomain::find_local_reader(const GUID_t& reader_guid)
+{
+    std::lock_guard<std::mutex> guard(m_local_readers_mutex);
+    auto it = m_local_readers.find(reader_guid);
+    return it != m_local_readers.end() && !it->second.removed ? it->second.reader : nullptr;
+}
+
+RTPSReader* RTPSDomain::acquire_local_reader(const GUID_t& reader_guid)
+{
+    std::lock_guard<std::mutex> guard(m_local_readers_mutex);
+    auto it = m_local_readers.find(reader_guid);
+    if (it == m_local_readers.end() || it->second.removed)
+    {
+        return nullptr;
+    }
+
+    ++it->second.in_use;
+    t_acquired_local_readers.push_back(reader_guid);
+    return it->second.reader;
+}
+
+void RTPSDomain::release_local_reader(const GUID_t& reader_guid)
+{
+    std::lock_guard<std::mutex> guard(m_local_readers_mutex);
+    auto it = m_local_readers.find(reader_guid);
+    assert(it != m_local_readers.end() && it->second.in_use > 0);
+    auto acquired = std::find(t_acquired_local_readers.rbegin(), t_acquired_local_readers.rend(), reader_guid);
+    assert(acquired != t_acquired_local_readers.rend());
+    t_acquired_local_readers.erase(std::next(acquired).base());
+
+    --it->second.in_use;
+    if (it->second.removed)
+    {
+        if (it->second.in_use == 0)
+        {
+            m_local_readers.erase(it);
+        }
+        m_local_readers_cv.notify_all();
+    }
+}
+
+void RTPSDomain::unregister_local_reader_nts(RTPSReader* reader)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_local_readers_mutex);
+        auto it = m_local_readers.find(reader->getGuid());
+        if (it == m_local_readers.end() || it->second.removed)
+        {
+            return;
+        }
+
+        // Readers in use are erased when the last delivery in progress finishes.
+        if (it->second.in_use == 0)
+        {
+            m_local_readers.erase(it);
+        }
+        else
+        {
+            it->second.removed = true;
+        }
+    }
+
+    // From now on no writer can find the reader. Make the ones that already found it forget it.
+    for (t_p_RTPSParticipant& participant : m_RTPSParticipants)
+    {
+        for (auto wit = participant.second->userWritersListBegin(); wit != participant.second->userWritersListEnd();
+                ++wit)
+        {
+            StatefulWriter* writer = dynamic_cast<StatefulWriter*>(*wit);
+            if (writer != nullptr)
+            {
+                writer->local_reader_removed(reader->getGuid());
+            }
+        }
+    }
+}
+
+void RTPSDomain::unregister_local_readers_nts(
+        RTPSParticipantImpl* participant,
+        std::vector<GUID_t>& reader_guids)
+{
+    for (auto rit = participant->userReadersListBegin(); rit != participant->userReadersListEnd(); ++rit)
+    {
+        reader_guids.push_back((*rit)->getGuid());
+        unregister_local_reader_nts(*rit);
+    }
+}
+
+void RTPSDomain::wait_local_reader_released(const GUID_t& reader_guid)
+{
+    // A listener removing its own reader would otherwise wait for the delivery calling it.
+    uint32_t own_uses = static_cast<uint32_t>(
+        std::count(t_acquired_local_readers.begin(), t_acquired_local_readers.end(), reader_guid));
+
+    std::unique_lock<std::mutex> lock(m_local_readers_mutex);
+    m_local_readers_cv.wait(lock, [&reader_guid, own_uses]()
+            {
+                auto it = m_local_readers.find(reader_guid);
+                return it == m_local_readers.end() || it->second.in_use <= own_uses;
+            });
+}
+
 } /* namespace  rtps */
 } /* namespace  fastrtps */
 } /* namespace eprosima */
@@ -54,6 +54,7 @@ ParticipantProxyData::ParticipantProxyData(const RTPSParticipantAllocationAttrib
     , m_readers(allocation.readers)
     , m_writers(allocation.writers)
     {
+        m_payloadDigest.fill(0);
     }
 
 ParticipantProxyData::ParticipantProxyData(const ParticipantProxyData& pdata) 
@@ -79,6 +80,7 @@ ParticipantProxyData::ParticipantProxyData(const ParticipantProxyData& pdata)
     , m_userData(pdata.m_userData)
     , lease_duration_event(nullptr)
     , should_check_lease_duration(false)
+    , m_payloadDigest(pdata.m_payloadDigest)
 
     // This method is only called from SecurityManager when a new participant is discovered and the
     // corresponding DiscoveredParticipantInfo struct is created. Only participant info is used,
@@ -399,6 +401,7 @@ void ParticipantProxyData::clear()
     m_properties.properties.clear();
     m_properties.length = 0;
     m_userData.clear();
+    m_payloadDigest.fill(0);
 }
 
 void ParticipantProxyData::copy(const ParticipantProxyData& pdata)
@@ -417,6 +420,7 @@ void ParticipantProxyData::copy(const ParticipantProxyData& pdata)
     isAlive = pdata.isAlive;
     m_properties = pdata.m_properties;
     m_userData = pdata.m_userData;
+    m_payloadDigest = pdata.m_payloadDigest;
 
     // This method is only called when a new participant is discovered.The destination of the copy
     // will always be a new ParticipantProxyData or one from the pool, so there is no need for
@@ -438,6 +442,7 @@ bool ParticipantProxyData::updateData(ParticipantProxyData& pdata)
     m_properties = pdata.m_properties;
     m_leaseDuration = pdata.m_leaseDuration;
     m_userData = pdata.m_userData;
+    m_payloadDigest = pdata.m_payloadDigest;
     isAlive = true;
 #if HAVE_SECURITY
     identity_token_ = pdata.identity_token_;
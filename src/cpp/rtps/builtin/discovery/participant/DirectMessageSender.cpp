@@ -91,16 +91,18 @@ const std::vector<GUID_t>& DirectMessageSender::remote_guids() const
 /**
  * Send a message through this interface.
  *
- * @param message Pointer to the buffer with the message already serialized.
+ * @param buffers List of slices that make up the message, already serialized.
+ * @param total_bytes Sum of the sizes of all the slices.
  * @param max_blocking_time_point Future timepoint where blocking send should end.
  */
 bool DirectMessageSender::send(
-        CDRMessage_t* message,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
         std::chrono::steady_clock::time_point& max_blocking_time_point) const
 {
     for (const Locator_t& loc : *locators_)
     {
-        if (!participant_->sendSync(message, loc, max_blocking_time_point))
+        if (!participant_->sendSync(buffers, total_bytes, loc, max_blocking_time_point))
         {
             return false;
         }
@@ -50,6 +50,7 @@
 #include <fastrtps/log/Log.h>
 
 #include <mutex>
+#include <algorithm>
 
 using namespace eprosima::fastrtps;
 
@@ -80,6 +81,7 @@ PDP::PDP (
     , participant_proxies_number_(allocation.participants.initial)
     , participant_proxies_(allocation.participants)
     , participant_proxies_pool_(allocation.participants)
+    , participant_proxies_by_prefix_(allocation.participants.initial)
     , reader_proxies_number_(allocation.total_readers().initial)
     , reader_proxies_pool_(allocation.total_readers())
     , writer_proxies_number_(allocation.total_writers().initial)
@@ -192,10 +194,30 @@ ParticipantProxyData* PDP::add_participant_proxy_data(
     ret_val->should_check_lease_duration = with_lease_duration;
     ret_val->m_guid = participant_guid;
     participant_proxies_.push_back(ret_val);
+    participant_proxies_by_prefix_[participant_guid.guidPrefix] = ret_val;
 
     return ret_val;
 }
 
+ParticipantProxyData* PDP::find_participant_proxy_data(
+        const GuidPrefix_t& prefix) const
+{
+    auto it = participant_proxies_by_prefix_.find(prefix);
+    return it != participant_proxies_by_prefix_.end() ? it->second : nullptr;
+}
+
+void PDP::refresh_participant_lease(
+        ParticipantProxyData* pdata)
+{
+    // TODO Ricardo: Study if isAlive attribute is necessary.
+    pdata->isAlive = true;
+    if(pdata->lease_duration_event != nullptr && pdata->should_check_lease_duration)
+    {
+        pdata->lease_duration_event->cancel_timer();
+        pdata->lease_duration_event->restart_timer();
+    }
+}
+
 void PDP::initializeParticipantProxyData(ParticipantProxyData* participant_data)
 {
     participant_data->m_leaseDuration = mp_RTPSParticipant->getAttributes().builtin.discovery_config.leaseDuration;
@@ -832,15 +854,13 @@ bool PDP::remove_remote_participant(
 
     //Remove it from our vector or RTPSParticipantProxies:
     this->mp_mutex->lock();
-    for(ResourceLimitedVector<ParticipantProxyData*>::iterator pit = participant_proxies_.begin();
-            pit!=participant_proxies_.end();++pit)
+    auto index_it = participant_proxies_by_prefix_.find(partGUID.guidPrefix);
+    if (index_it != participant_proxies_by_prefix_.end() && index_it->second->m_guid == partGUID)
     {
-        if((*pit)->m_guid == partGUID)
-        {
-            pdata = *pit;
-            participant_proxies_.erase(pit);
-            break;
-        }
+        pdata = index_it->second;
+        participant_proxies_by_prefix_.erase(index_it);
+        // Keep insertion order, as the local participant should remain the first one
+        participant_proxies_.erase(std::find(participant_proxies_.begin(), participant_proxies_.end(), pdata));
     }
     this->mp_mutex->unlock();
 
@@ -952,20 +972,11 @@ const BuiltinAttributes& PDP::builtin_attributes() const
 void PDP::assertRemoteParticipantLiveliness(const GuidPrefix_t& guidP)
 {
     std::lock_guard<std::recursive_mutex> guardPDP(*this->mp_mutex);
-    for(ParticipantProxyData* it : this->participant_proxies_)
+    ParticipantProxyData* pdata = find_participant_proxy_data(guidP);
+    if(pdata != nullptr)
     {
-        if(it->m_guid.guidPrefix == guidP)
-        {
-            logInfo(RTPS_LIVELINESS,"RTPSParticipant " << it->m_guid << " is Alive");
-            // TODO Ricardo: Study if isAlive attribute is necessary.
-            it->isAlive = true;
-            if(it->lease_duration_event != nullptr && it->should_check_lease_duration)
-            {
-                it->lease_duration_event->cancel_timer();
-                it->lease_duration_event->restart_timer();
-            }
-            break;
-        }
+        logInfo(RTPS_LIVELINESS,"RTPSParticipant " << pdata->m_guid << " is Alive");
+        refresh_participant_lease(pdata);
     }
 }
 
@@ -22,6 +22,7 @@
 #include <fastrtps/rtps/history/ReaderHistory.h>
 
 #include <fastrtps/utils/TimeConversion.h>
+#include <fastrtps/utils/md5.h>
 
 #include <fastrtps/rtps/builtin/discovery/participant/PDP.h>
 #include <fastrtps/rtps/builtin/discovery/endpoint/EDP.h>
@@ -34,6 +35,7 @@
 #include "../../../participant/RTPSParticipantImpl.h"
 
 #include <mutex>
+#include <algorithm>
 
 #include <fastrtps/log/Log.h>
 
@@ -79,6 +81,32 @@ void PDPListener::onNewCacheChangeAdded(
             return;
         }
         
+        // Periodic announcements are usually identical to the previous one received from the same participant.
+        // In that case there is no need to parse them again, only the lease duration has to be refreshed.
+        MD5 payload_hash;
+        payload_hash.update(change->serializedPayload.data, change->serializedPayload.length);
+        payload_hash.finalize();
+        std::array<octet, 16> payload_digest;
+        std::copy(payload_hash.digest, payload_hash.digest + payload_digest.size(), payload_digest.begin());
+
+        bool unchanged = false;
+        {
+            std::lock_guard<std::recursive_mutex> lock(*parent_pdp_->getMutex());
+            ParticipantProxyData* pdata = parent_pdp_->find_participant_proxy_data(guid.guidPrefix);
+            if (pdata != nullptr && pdata->m_guid == guid && pdata->m_payloadDigest == payload_digest)
+            {
+                parent_pdp_->refresh_participant_lease(pdata);
+                unchanged = true;
+            }
+        }
+
+        if (unchanged)
+        {
+            logInfo(RTPS_PDP, "Unchanged announcement from " << guid);
+            parent_pdp_->mp_PDPReaderHistory->remove_change(change);
+            return;
+        }
+
         // Access to temp_participant_data_ is protected by reader lock
 
         // Load information on temp_participant_data_
@@ -87,20 +115,18 @@ void PDPListener::onNewCacheChangeAdded(
         {
             // After correctly reading it
             change->instanceHandle = temp_participant_data_.m_key;
+            temp_participant_data_.m_payloadDigest = payload_digest;
 
             // At this point we can release reader lock.
             reader->getMutex().unlock();
 
             // Check if participant already exists (updated info)
-            ParticipantProxyData* pdata = nullptr;
             std::unique_lock<std::recursive_mutex> lock(*parent_pdp_->getMutex());
-            for (ParticipantProxyData* it : parent_pdp_->participant_proxies_)
+            ParticipantProxyData* pdata = parent_pdp_->find_participant_proxy_data(
+                temp_participant_data_.m_guid.guidPrefix);
+            if (pdata != nullptr && pdata->m_guid != temp_participant_data_.m_guid)
             {
-                if(temp_participant_data_.m_guid == it->m_guid)
-                {
-                    pdata = it;
-                    break;
-                }
+                pdata = nullptr;
             }
 
             auto status = (pdata == nullptr) ? ParticipantDiscoveryInfo::DISCOVERED_PARTICIPANT :
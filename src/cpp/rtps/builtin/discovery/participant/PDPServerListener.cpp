@@ -98,15 +98,12 @@ void PDPServerListener::onNewCacheChangeAdded(
             reader->getMutex().unlock();
 
             // Check if participant already exists (updated info)
-            ParticipantProxyData* pdata = nullptr;
             std::unique_lock<std::recursive_mutex> lock(*parent_pdp_->getMutex());
-            for (ParticipantProxyData* it : parent_pdp_->participant_proxies_)
+            ParticipantProxyData* pdata = parent_pdp_->find_participant_proxy_data(
+                temp_participant_data_.m_guid.guidPrefix);
+            if (pdata != nullptr && pdata->m_guid != temp_participant_data_.m_guid)
             {
-                if(temp_participant_data_.m_guid == it->m_guid)
-                {
-                    pdata = it;
-                    break;
-                }
+                pdata = nullptr;
             }
 
             auto status = (pdata == nullptr) ? ParticipantDiscoveryInfo::DISCOVERED_PARTICIPANT :
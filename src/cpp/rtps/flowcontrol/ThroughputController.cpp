@@ -17,64 +17,89 @@
 #include "../participant/RTPSParticipantImpl.h"
 #include <fastrtps/rtps/writer/RTPSWriter.h>
 #include <asio.hpp>
-#include <asio/steady_timer.hpp>
 #include <cassert>
+#include <future>
 
 
 namespace eprosima{
 namespace fastrtps{
 namespace rtps{
 
+static uint32_t burst_size(const ThroughputControllerDescriptor& descriptor)
+{
+    return descriptor.burstSize != 0 ? descriptor.burstSize : descriptor.bytesPerPeriod;
+}
+
 ThroughputController::ThroughputController(const ThroughputControllerDescriptor& descriptor, RTPSWriter* associatedWriter):
     mBytesPerPeriod(descriptor.bytesPerPeriod),
-    mAccumulatedPayloadSize(0),
     mPeriodMillisecs(descriptor.periodMillisecs),
+    mBurstSize(burst_size(descriptor)),
+    mAvailableBytes(mBurstSize),
+    mLastRefill(std::chrono::steady_clock::now()),
     mAssociatedParticipant(nullptr),
-    mAssociatedWriter(associatedWriter)
+    mAssociatedWriter(associatedWriter),
+    mRefillTimer(*FlowController::ControllerService),
+    mRefillScheduled(false)
 {
 }
 
 ThroughputController::ThroughputController(const ThroughputControllerDescriptor& descriptor, RTPSParticipantImpl* associatedParticipant):
     mBytesPerPeriod(descriptor.bytesPerPeriod),
-    mAccumulatedPayloadSize(0),
     mPeriodMillisecs(descriptor.periodMillisecs),
+    mBurstSize(burst_size(descriptor)),
+    mAvailableBytes(mBurstSize),
+    mLastRefill(std::chrono::steady_clock::now()),
     mAssociatedParticipant(associatedParticipant),
-    mAssociatedWriter(nullptr)
+    mAssociatedWriter(nullptr),
+    mRefillTimer(*FlowController::ControllerService),
+    mRefillScheduled(false)
 {
 }
 
-void ThroughputController::operator()(RTPSWriterCollector<ReaderLocator*>& changesToSend)
+ThroughputController::~ThroughputController()
 {
-    std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
-
-    auto it = changesToSend.items().begin();
+    disable();
 
-    while(it != changesToSend.items().end())
+    // Wait for a refill handler that could be running on the controllers' thread.
+    if (!FlowController::ControllerService->running_in_this_thread())
     {
-        if(!process_change_nts_(it->cacheChange, it->sequenceNumber, it->fragmentNumber))
-            break;
-
-        ++it;
+        std::promise<void> handlers_done;
+        FlowController::ControllerService->post([&handlers_done]()
+                {
+                    handlers_done.set_value();
+                });
+        handlers_done.get_future().wait();
     }
-
-    changesToSend.items().erase(it, changesToSend.items().end());
 }
 
-void ThroughputController::operator()(RTPSWriterCollector<ReaderProxy*>& changesToSend)
+template<class T>
+void ThroughputController::filter_changes(RTPSWriterCollector<T>& changesToSend)
 {
     std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
 
-    auto it = changesToSend.items().begin();
+    refill_nts_();
 
-    while(it != changesToSend.items().end())
+    auto it = changesToSend.begin();
+
+    while(it != changesToSend.end())
     {
-        if(!process_change_nts_(it->cacheChange, it->sequenceNumber, it->fragmentNumber))
+        if(!process_change_nts_((*it)->cacheChange, (*it)->sequenceNumber, (*it)->fragmentNumber))
             break;
 
         ++it;
     }
 
-    changesToSend.items().erase(it, changesToSend.items().end());
+    changesToSend.erase(it, changesToSend.end());
+}
+
+void ThroughputController::operator()(RTPSWriterCollector<ReaderLocator*>& changesToSend)
+{
+    filter_changes(changesToSend);
+}
+
+void ThroughputController::operator()(RTPSWriterCollector<ReaderProxy*>& changesToSend)
+{
+    filter_changes(changesToSend);
 }
 
 
@@ -83,6 +108,7 @@ void ThroughputController::disable()
     std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
     mAssociatedWriter = nullptr;
     mAssociatedParticipant = nullptr;
+    mRefillTimer.cancel();
 }
 
 bool ThroughputController::process_change_nts_(CacheChange_t* change, const SequenceNumber_t& /*seqNum*/,
@@ -96,47 +122,104 @@ bool ThroughputController::process_change_nts_(CacheChange_t* change, const Sequ
         dataLength = (fragNum + 1) != change->getFragmentCount() ?
             change->getFragmentSize() : change->serializedPayload.length - (fragNum * change->getFragmentSize());
 
-    if((mAccumulatedPayloadSize + dataLength) <= mBytesPerPeriod)
+    // A change bigger than the bucket is let through when the bucket is full, leaving it in debt.
+    if (dataLength <= mAvailableBytes || mAvailableBytes == mBurstSize)
     {
-        mAccumulatedPayloadSize += dataLength;
-        ScheduleRefresh(dataLength);
+        mAvailableBytes -= dataLength;
+        ScheduleRefresh();
         return true;
     }
 
     return false;
 }
 
-void ThroughputController::ScheduleRefresh(uint32_t sizeToRestore)
+void ThroughputController::refill_nts_()
 {
-    std::shared_ptr<asio::steady_timer> throwawayTimer(std::make_shared<asio::steady_timer>(*FlowController::ControllerService));
-    auto refresh = [throwawayTimer, this, sizeToRestore]
-        (const asio::error_code& error)
-        {
-            if ((error != asio::error::operation_aborted) &&
-                    FlowController::IsListening(this))
+    auto now = std::chrono::steady_clock::now();
+
+    if (mBytesPerPeriod == 0)
+    {
+        return;
+    }
+
+    if (mAvailableBytes >= mBurstSize || mPeriodMillisecs == 0)
+    {
+        mAvailableBytes = mBurstSize;
+        mLastRefill = now;
+        return;
+    }
+
+    const std::chrono::microseconds period = std::chrono::milliseconds(mPeriodMillisecs);
+    std::chrono::microseconds elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - mLastRefill);
+
+    // Number of periods needed to fill the bucket from its current level. Avoids overflows on long idle times.
+    uint64_t missing_bytes = static_cast<uint64_t>(mBurstSize - mAvailableBytes);
+    if (static_cast<uint64_t>(elapsed.count()) >= (missing_bytes / mBytesPerPeriod + 1) * period.count())
+    {
+        mAvailableBytes = mBurstSize;
+        mLastRefill = now;
+        return;
+    }
+
+    uint64_t bytes = static_cast<uint64_t>(elapsed.count()) * mBytesPerPeriod / period.count();
+    mAvailableBytes += static_cast<int64_t>(bytes);
+
+    if (mAvailableBytes >= mBurstSize)
+    {
+        mAvailableBytes = mBurstSize;
+        mLastRefill = now;
+    }
+    else
+    {
+        // Only account the time that produced whole bytes, so fractions are not lost between refills.
+        mLastRefill += std::chrono::microseconds(bytes * period.count() / mBytesPerPeriod);
+    }
+}
+
+void ThroughputController::ScheduleRefresh()
+{
+    if (mRefillScheduled || (mAssociatedWriter == nullptr && mAssociatedParticipant == nullptr))
+    {
+        return;
+    }
+
+    mRefillScheduled = true;
+    mRefillTimer.expires_from_now(std::chrono::milliseconds(mPeriodMillisecs));
+    mRefillTimer.async_wait([this](const asio::error_code& error)
             {
-                std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
-                throwawayTimer->cancel();
-                mAccumulatedPayloadSize = sizeToRestore > mAccumulatedPayloadSize ? 0 : mAccumulatedPayloadSize - sizeToRestore;
+                on_refill_timer(error);
+            });
+}
 
-                if (mAssociatedWriter)
-                {
-                    mAssociatedWriter->getRTPSParticipant()->async_thread().wake_up(mAssociatedWriter);
-                }
-                else if (mAssociatedParticipant)
-                {
-                    std::unique_lock<std::recursive_mutex> lock(*mAssociatedParticipant->getParticipantMutex());
-                    for (auto it = mAssociatedParticipant->userWritersListBegin();
-                            it != mAssociatedParticipant->userWritersListEnd(); ++it)
-                    {
-                        mAssociatedParticipant->async_thread().wake_up(*it);
-                    }
-                }
-            }
-        };
-
-    throwawayTimer->expires_from_now(std::chrono::milliseconds(mPeriodMillisecs));
-    throwawayTimer->async_wait(refresh);
+void ThroughputController::on_refill_timer(const asio::error_code& error)
+{
+    if ((error == asio::error::operation_aborted) || !FlowController::IsListening(this))
+    {
+        return;
+    }
+
+    std::unique_lock<std::recursive_mutex> scopedLock(mThroughputControllerMutex);
+    mRefillScheduled = false;
+    refill_nts_();
+
+    if (mAssociatedWriter)
+    {
+        mAssociatedWriter->getRTPSParticipant()->async_thread().wake_up(mAssociatedWriter);
+    }
+    else if (mAssociatedParticipant)
+    {
+        std::unique_lock<std::recursive_mutex> lock(*mAssociatedParticipant->getParticipantMutex());
+        for (auto it = mAssociatedParticipant->userWritersListBegin();
+                it != mAssociatedParticipant->userWritersListEnd(); ++it)
+        {
+            mAssociatedParticipant->async_thread().wake_up(*it);
+        }
+    }
+
+    if (mAvailableBytes < mBurstSize)
+    {
+        ScheduleRefresh();
+    }
 }
 
 } // namespace rtps
@@ -18,6 +18,8 @@
 #include "FlowController.h"
 #include <fastrtps/rtps/flowcontrol/ThroughputControllerDescriptor.h>
 
+#include <asio/steady_timer.hpp>
+#include <chrono>
 #include <thread>
 
 namespace eprosima{
@@ -28,10 +30,9 @@ class RTPSWriter;
 class RTPSParticipantImpl;
 
 /**
- * Simple filter that only clears changes up to a certain accumulated payload size.
- * It refreshes after a given time in MS, in a staggered way (e.g. if it clears
- * 500kb at t=0 and 800 kb at t=10, it will refresh 500kb at t = 0 + period, and
- * then fully refresh at t = 10 + period).
+ * Token bucket filter that only clears changes while there are bytes available on the bucket.
+ * The bucket is refilled at a rate of 'bytesPerPeriod' bytes every period of time, up to the burst size.
+ * A single periodic timer refills the bucket and wakes up the associated writers while the bucket is not full.
  */
 class ThroughputController : public FlowController
 {
@@ -39,6 +40,8 @@ class ThroughputController : public FlowController
         ThroughputController(const ThroughputControllerDescriptor&, RTPSWriter* associatedWriter);
         ThroughputController(const ThroughputControllerDescriptor&, RTPSParticipantImpl* associatedParticipant);
 
+        virtual ~ThroughputController();
+
         virtual void operator()(RTPSWriterCollector<ReaderLocator*>& changesToSend) override;
         virtual void operator()(RTPSWriterCollector<ReaderProxy*>& changesToSend) override;
 
@@ -46,22 +49,38 @@ class ThroughputController : public FlowController
 
     private:
 
+        template<class T>
+        void filter_changes(RTPSWriterCollector<T>& changesToSend);
+
         bool process_change_nts_(CacheChange_t* change, const SequenceNumber_t& seqNum,
                 const FragmentNumber_t fragNum);
 
+        //! Adds to the bucket the bytes corresponding to the time elapsed since the last refill.
+        void refill_nts_();
+
         uint32_t mBytesPerPeriod;
-        uint32_t mAccumulatedPayloadSize;
         uint32_t mPeriodMillisecs;
+        //! Maximum number of bytes the bucket can hold.
+        uint32_t mBurstSize;
+        //! Bytes on the bucket. It is negative when a change bigger than the burst size has been let through.
+        int64_t mAvailableBytes;
+        //! Time point up to which the refill of the bucket has been accounted.
+        std::chrono::steady_clock::time_point mLastRefill;
         std::recursive_mutex mThroughputControllerMutex;
 
         RTPSParticipantImpl* mAssociatedParticipant;
         RTPSWriter* mAssociatedWriter;
 
+        asio::steady_timer mRefillTimer;
+        bool mRefillScheduled;
+
         /*
-         * Schedules the filter to be refreshed in period ms. When it does, its capacity
-         * will be partially restored, by "sizeToRestore" bytes.
+         * Schedules the refill timer, if not already scheduled. When it expires, the bucket is refilled
+         * and the associated writers are woken up.
          */
-        void ScheduleRefresh(uint32_t sizeToRestore);
+        void ScheduleRefresh();
+
+        void on_refill_timer(const asio::error_code& error);
 };
 
 } // namespace rtps
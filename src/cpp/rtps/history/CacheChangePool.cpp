@@ -22,6 +22,7 @@
 #include <fastrtps/log/Log.h>
 
 #include <mutex>
+#include <algorithm>
 
 #include <cassert>
 
@@ -30,6 +31,57 @@ namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+namespace {
+
+//! Payload size of the smallest size class, as a power of two (256 bytes).
+constexpr uint32_t min_size_class_bits = 8;
+//! Number of size classes (from 256 bytes to 2 GB).
+constexpr uint32_t num_size_classes = 32 - min_size_class_bits;
+
+uint32_t size_of_class(uint32_t size_class)
+{
+    return 1u << (size_class + min_size_class_bits);
+}
+
+//! Returns the smallest size class able to hold size bytes.
+uint32_t size_class_for_size(uint32_t size)
+{
+    uint32_t size_class = 0;
+    while (size_class + 1 < num_size_classes && size_of_class(size_class) < size)
+    {
+        ++size_class;
+    }
+    return size_class;
+}
+
+//! Returns the biggest size class that fits on capacity bytes.
+uint32_t size_class_for_capacity(uint32_t capacity)
+{
+    uint32_t size_class = 0;
+    while (size_class + 1 < num_size_classes && size_of_class(size_class + 1) <= capacity)
+    {
+        ++size_class;
+    }
+    return size_class;
+}
+
+/**
+ * CacheChange_t allocated on SIZE_CLASS_MEMORY_MODE.
+ * Adds the link used to return it to the pool without locking.
+ */
+struct SizeClassCacheChange : public CacheChange_t
+{
+    explicit SizeClassCacheChange(uint32_t payload_size)
+        : CacheChange_t(payload_size)
+        , next_released(nullptr)
+    {
+    }
+
+    CacheChange_t* next_released;
+};
+
+} // namespace
+
 
 CacheChangePool::~CacheChangePool()
 {
@@ -37,11 +89,21 @@ CacheChangePool::~CacheChangePool()
     //Deletion process does not depend on the memory management policy
     for(std::vector<CacheChange_t*>::iterator it = m_allCaches.begin();it!=m_allCaches.end();++it)
     {
-        delete(*it);
+        if (memoryMode == SIZE_CLASS_MEMORY_MODE)
+        {
+            delete(static_cast<SizeClassCacheChange*>(*it));
+        }
+        else
+        {
+            delete(*it);
+        }
     }
 }
 
 CacheChangePool::CacheChangePool(int32_t pool_size, uint32_t payload_size, int32_t max_pool_size, MemoryManagementPolicy_t memoryPolicy) :
+    m_freeClassesCount(0),
+    m_releasedCaches(nullptr),
+    m_releasedCount(0),
     memoryMode(memoryPolicy)
 {
     //Common for all modes: Set the payload size (maximum allowed), size and size limit
@@ -76,6 +138,18 @@ CacheChangePool::CacheChangePool(int32_t pool_size, uint32_t payload_size, int32
         case DYNAMIC_RESERVE_MEMORY_MODE:
             logInfo(RTPS_UTILS,"Dynamic Mode is active, CacheChanges are allocated on request");
             break;
+        case SIZE_CLASS_MEMORY_MODE:
+            logInfo(RTPS_UTILS,"Size Class Mode is active, preallocating pool_size elements with the smallest payload size");
+            m_freeClasses.resize(num_size_classes);
+            for (int32_t i = 0; i < pool_size && ((m_max_pool_size == 0) || (m_pool_size < m_max_pool_size)); ++i)
+            {
+                CacheChange_t* ch = new SizeClassCacheChange(size_of_class(0));
+                m_allCaches.push_back(ch);
+                m_freeClasses[0].push_back(ch);
+                ++m_freeClassesCount;
+                ++m_pool_size;
+            }
+            break;
     }
 }
 
@@ -141,6 +215,9 @@ bool CacheChangePool::reserve_Cache(CacheChange_t** chan, uint32_t dataSize)
             *chan = allocateSingle(dataSize); //Allocates a single, empty CacheChange. Allocated on Copy
             if(*chan == nullptr) return false;
             break;
+
+        case SIZE_CLASS_MEMORY_MODE:
+            return reserveSizeClass(chan, dataSize);
     }
 
     return true;
@@ -151,33 +228,27 @@ void CacheChangePool::release_Cache(CacheChange_t* ch)
     switch(memoryMode)
     {
         case PREALLOCATED_MEMORY_MODE:
-            ch->kind = ALIVE;
-            ch->sequenceNumber.high = 0;
-            ch->sequenceNumber.low = 0;
-            ch->writerGUID = c_Guid_Unknown;
-            ch->serializedPayload.length = 0;
-            ch->serializedPayload.pos = 0;
-            for(uint8_t i=0;i<16;++i)
-                ch->instanceHandle.value[i] = 0;
-            ch->isRead = 0;
-            ch->sourceTimestamp.seconds(0);
-            ch->sourceTimestamp.fraction(0);
+            resetChange(ch);
             m_freeCaches.push_back(ch);
             break;
         case PREALLOCATED_WITH_REALLOC_MEMORY_MODE:
-            ch->kind = ALIVE;
-            ch->sequenceNumber.high = 0;
-            ch->sequenceNumber.low = 0;
-            ch->writerGUID = c_Guid_Unknown;
-            ch->serializedPayload.length = 0;
-            ch->serializedPayload.pos = 0;
-            for(uint8_t i=0;i<16;++i)
-                ch->instanceHandle.value[i] = 0;
-            ch->isRead = 0;
-            ch->sourceTimestamp.seconds(0);
-            ch->sourceTimestamp.fraction(0);
+            resetChange(ch);
             m_freeCaches.push_back(ch);
             break;
+        case SIZE_CLASS_MEMORY_MODE:
+        {
+            // Push on the released stack. The reserving thread takes the whole stack at once, so there is no ABA.
+            resetChange(ch);
+            SizeClassCacheChange* node = static_cast<SizeClassCacheChange*>(ch);
+            ++m_releasedCount;
+            CacheChange_t* head = m_releasedCaches.load(std::memory_order_relaxed);
+            do
+            {
+                node->next_released = head;
+            } while (!m_releasedCaches.compare_exchange_weak(head, ch, std::memory_order_release,
+                        std::memory_order_relaxed));
+            break;
+        }
         case DYNAMIC_RESERVE_MEMORY_MODE:
             // Find pointer in CacheChange vector, remove element, then delete it
             std::vector<CacheChange_t*>::iterator target = m_allCaches.begin();
@@ -196,6 +267,130 @@ void CacheChangePool::release_Cache(CacheChange_t* ch)
     }
 }
 
+void CacheChangePool::resetChange(CacheChange_t* ch)
+{
+    ch->kind = ALIVE;
+    ch->sequenceNumber.high = 0;
+    ch->sequenceNumber.low = 0;
+    ch->writerGUID = c_Guid_Unknown;
+    ch->serializedPayload.length = 0;
+    ch->serializedPayload.pos = 0;
+    for(uint8_t i=0;i<16;++i)
+        ch->instanceHandle.value[i] = 0;
+    ch->isRead = 0;
+    ch->sourceTimestamp.seconds(0);
+    ch->sourceTimestamp.fraction(0);
+}
+
+bool CacheChangePool::reserveSizeClass(CacheChange_t** chan, uint32_t dataSize)
+{
+    // This method should only be called from within SIZE_CLASS_MEMORY_MODE
+    assert(memoryMode == SIZE_CLASS_MEMORY_MODE);
+
+    uint32_t size_class = size_class_for_size(dataSize);
+    if (m_freeClasses[size_class].empty())
+    {
+        collectReleased();
+    }
+
+    CacheChange_t* ch = nullptr;
+    if (!m_freeClasses[size_class].empty())
+    {
+        ch = m_freeClasses[size_class].back();
+        m_freeClasses[size_class].pop_back();
+        --m_freeClassesCount;
+    }
+    else if (takeFromSmallerClass(size_class, ch))
+    {
+        // Its payload will be enlarged below, but the change itself is reused
+    }
+    else if ((m_max_pool_size == 0) || (m_pool_size < m_max_pool_size))
+    {
+        try
+        {
+            ch = new SizeClassCacheChange(std::max(dataSize, size_of_class(size_class)));
+        }
+        catch(std::bad_alloc& ex)
+        {
+            logError(RTPS_HISTORY, "Failed to allocate memory for the serializedPayload, exception caught: " << ex.what());
+            *chan = nullptr;
+            return false;
+        }
+        m_allCaches.push_back(ch);
+        ++m_pool_size;
+    }
+    else
+    {
+        // No more changes can be allocated, use one from a bigger size class
+        for (uint32_t bigger = size_class + 1; bigger < num_size_classes; ++bigger)
+        {
+            if (!m_freeClasses[bigger].empty())
+            {
+                ch = m_freeClasses[bigger].back();
+                m_freeClasses[bigger].pop_back();
+                --m_freeClassesCount;
+                break;
+            }
+        }
+
+        if (ch == nullptr)
+        {
+            logWarning(RTPS_HISTORY, "Maximum number of allowed reserved caches reached");
+            *chan = nullptr;
+            return false;
+        }
+    }
+
+    try
+    {
+        ch->serializedPayload.reserve(std::max(dataSize, size_of_class(size_class)));
+    }
+    catch(std::bad_alloc& ex)
+    {
+        logError(RTPS_HISTORY, "Failed to allocate memory for the serializedPayload, exception caught: " << ex.what());
+        // The failed reserve has freed the old buffer, so the change is recycled without payload.
+        ch->serializedPayload.data = nullptr;
+        ch->serializedPayload.max_size = 0;
+        m_freeClasses[0].push_back(ch);
+        ++m_freeClassesCount;
+        *chan = nullptr;
+        return false;
+    }
+
+    *chan = ch;
+    return true;
+}
+
+bool CacheChangePool::takeFromSmallerClass(uint32_t size_class, CacheChange_t*& ch)
+{
+    for (uint32_t smaller = size_class; smaller > 0; --smaller)
+    {
+        std::vector<CacheChange_t*>& free_list = m_freeClasses[smaller - 1];
+        if (!free_list.empty())
+        {
+            ch = free_list.back();
+            free_list.pop_back();
+            --m_freeClassesCount;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CacheChangePool::collectReleased()
+{
+    CacheChange_t* released = m_releasedCaches.exchange(nullptr, std::memory_order_acquire);
+    while (released != nullptr)
+    {
+        SizeClassCacheChange* ch = static_cast<SizeClassCacheChange*>(released);
+        released = ch->next_released;
+        m_freeClasses[size_class_for_capacity(ch->serializedPayload.max_size)].push_back(ch);
+        ++m_freeClassesCount;
+        --m_releasedCount;
+    }
+}
+
 bool CacheChangePool::allocateGroup(uint32_t group_size)
 {
     // This method should only called from within PREALLOCATED_MEMORY_MODE
@@ -38,6 +38,7 @@ History::History(const HistoryAttributes & att)
     , m_changePool(att.initialReservedCaches,att.payloadMaxSize,att.maximumReservedCaches,att.memoryPolicy)
     , mp_minSeqCacheChange(nullptr)
     , mp_maxSeqCacheChange(nullptr)
+    , m_isMinMaxOutdated(false)
     , mp_mutex(nullptr)
 
     {
@@ -82,6 +83,12 @@ bool History::remove_all_changes()
 
 bool History::get_min_change(CacheChange_t** min_change)
 {
+    if (m_isMinMaxOutdated)
+    {
+        std::lock_guard<RecursiveTimedMutex> guard(*mp_mutex);
+        updateMaxMinSeqNum();
+    }
+
     if(mp_minSeqCacheChange->sequenceNumber != mp_invalidCache->sequenceNumber)
     {
         *min_change = mp_minSeqCacheChange;
@@ -92,6 +99,12 @@ bool History::get_min_change(CacheChange_t** min_change)
 }
 bool History::get_max_change(CacheChange_t** max_change)
 {
+    if (m_isMinMaxOutdated)
+    {
+        std::lock_guard<RecursiveTimedMutex> guard(*mp_mutex);
+        updateMaxMinSeqNum();
+    }
+
     if(mp_maxSeqCacheChange->sequenceNumber != mp_invalidCache->sequenceNumber)
     {
         *max_change = mp_maxSeqCacheChange;
@@ -24,12 +24,20 @@
 #include <fastrtps/rtps/reader/RTPSReader.h>
 #include <fastrtps/rtps/reader/ReaderListener.h>
 
+#include <algorithm>
 #include <mutex>
 
 namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+static bool change_timestamp_cmp(
+        const CacheChange_t* c1,
+        const CacheChange_t* c2)
+{
+    return c1->sourceTimestamp < c2->sourceTimestamp;
+}
+
 ReaderHistory::ReaderHistory(const HistoryAttributes& att)
     : History(att)
     , mp_reader(nullptr)
@@ -67,15 +75,44 @@ bool ReaderHistory::add_change(CacheChange_t* a_change)
         logError(RTPS_HISTORY,"The Writer GUID_t must be defined");
     }
 
-    m_changes.push_back(a_change);
-    sortCacheChanges();
-    updateMaxMinSeqNum();
+    // Changes are kept ordered by source timestamp. Changes arriving in order are just appended, otherwise
+    // they are inserted after the last change with a timestamp not greater than theirs.
+    if (m_changes.empty() || !change_timestamp_cmp(a_change, m_changes.back()))
+    {
+        m_changes.push_back(a_change);
+    }
+    else
+    {
+        m_changes.insert(std::upper_bound(m_changes.begin(), m_changes.end(), a_change, change_timestamp_cmp),
+            a_change);
+    }
+
+    // Outdated limits will be looked for among all the changes, this one included.
+    if (!m_isMinMaxOutdated)
+    {
+        if (mp_minSeqCacheChange == mp_invalidCache ||
+                a_change->sequenceNumber < mp_minSeqCacheChange->sequenceNumber)
+        {
+            mp_minSeqCacheChange = a_change;
+        }
+        if (mp_maxSeqCacheChange == mp_invalidCache ||
+                !(a_change->sequenceNumber < mp_maxSeqCacheChange->sequenceNumber))
+        {
+            mp_maxSeqCacheChange = a_change;
+        }
+    }
+
     logInfo(RTPS_HISTORY, "Change " << a_change->sequenceNumber << " added with " << a_change->serializedPayload.length << " bytes");
 
     return true;
 }
 
 bool ReaderHistory::remove_change(CacheChange_t* a_change)
+{
+    return remove_change(a_change, true);
+}
+
+bool ReaderHistory::remove_change(CacheChange_t* a_change, bool release)
 {
     if(mp_reader == nullptr || mp_mutex == nullptr)
     {
@@ -83,29 +120,48 @@ bool ReaderHistory::remove_change(CacheChange_t* a_change)
         return false;
     }
 
-    std::lock_guard<RecursiveTimedMutex> guard(*mp_mutex);
     if(a_change == nullptr)
     {
         logError(RTPS_HISTORY,"Pointer is not valid")
         return false;
     }
-    for(std::vector<CacheChange_t*>::iterator chit = m_changes.begin();
-            chit!=m_changes.end();++chit)
+
     {
-        if((*chit)->sequenceNumber == a_change->sequenceNumber &&
-                (*chit)->writerGUID == a_change->writerGUID)
+        std::lock_guard<RecursiveTimedMutex> guard(*mp_mutex);
+        std::vector<CacheChange_t*>::iterator chit = find_change(a_change);
+        if(chit == m_changes.end())
+        {
+            logWarning(RTPS_HISTORY,"SequenceNumber "<<a_change->sequenceNumber << " not found");
+            return false;
+        }
+
+        logInfo(RTPS_HISTORY,"Removing change "<< a_change->sequenceNumber);
+        bool update_min_max = (*chit == mp_minSeqCacheChange) || (*chit == mp_maxSeqCacheChange);
+        mp_reader->change_removed_by_history(a_change);
+        // Removing the first change, the usual case, does not move the others.
+        m_changes.erase(chit);
+        if (m_changes.empty())
         {
-            logInfo(RTPS_HISTORY,"Removing change "<< a_change->sequenceNumber);
-            mp_reader->change_removed_by_history(a_change);
-            m_changePool.release_Cache(a_change);
-            m_changes.erase(chit);
-            sortCacheChanges();
             updateMaxMinSeqNum();
+        }
+        else if (update_min_max)
+        {
+            // Looked for only when needed, as taking every change in order would look for them each time.
+            m_isMinMaxOutdated = true;
+        }
+
+        if (release && !m_changePool.is_release_lock_free())
+        {
+            m_changePool.release_Cache(a_change);
             return true;
         }
     }
-    logWarning(RTPS_HISTORY,"SequenceNumber "<<a_change->sequenceNumber << " not found");
-    return false;
+
+    if (release)
+    {
+        m_changePool.release_Cache(a_change);
+    }
+    return true;
 }
 
 bool ReaderHistory::remove_changes_with_guid(const GUID_t& a_guid)
@@ -140,15 +196,33 @@ bool ReaderHistory::remove_changes_with_guid(const GUID_t& a_guid)
     return true;
 }
 
+std::vector<CacheChange_t*>::iterator ReaderHistory::find_change(const CacheChange_t* a_change)
+{
+    auto matches = [a_change](const CacheChange_t* ch)
+    {
+        return ch->sequenceNumber == a_change->sequenceNumber && ch->writerGUID == a_change->writerGUID;
+    };
+
+    // Binary search among the changes with the same source timestamp.
+    auto range = std::equal_range(m_changes.begin(), m_changes.end(), a_change, change_timestamp_cmp);
+    auto chit = std::find_if(range.first, range.second, matches);
+    if (chit != range.second)
+    {
+        return chit;
+    }
+
+    // Fallback in case the timestamp of the change was modified after it was added.
+    return std::find_if(m_changes.begin(), m_changes.end(), matches);
+}
+
 void ReaderHistory::sortCacheChanges()
 {
-    std::sort(m_changes.begin(),
-              m_changes.end(),
-              [](CacheChange_t* c1, CacheChange_t* c2){ return c1->sourceTimestamp < c2->sourceTimestamp; });
+    std::stable_sort(m_changes.begin(), m_changes.end(), change_timestamp_cmp);
 }
 
 void ReaderHistory::updateMaxMinSeqNum()
 {
+    m_isMinMaxOutdated = false;
     if(m_changes.size()==0)
     {
         mp_minSeqCacheChange = mp_invalidCache;
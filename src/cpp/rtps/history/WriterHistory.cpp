@@ -45,12 +45,17 @@ WriterHistory::~WriterHistory()
 bool WriterHistory::add_change(CacheChange_t* a_change)
 {
     WriteParams wparams;
-    return add_change_(a_change, wparams);
+    return add_change(a_change, wparams);
 }
 
 bool WriterHistory::add_change(CacheChange_t* a_change, WriteParams& wparams)
 {
-    return add_change_(a_change, wparams);
+    bool ret = add_change_(a_change, wparams);
+    if (ret)
+    {
+        mp_writer->deliver_to_local_readers();
+    }
+    return ret;
 }
 
 bool WriterHistory::add_change_(CacheChange_t* a_change, WriteParams &wparams,
@@ -137,7 +142,10 @@ bool WriterHistory::remove_change(CacheChange_t* a_change)
         if((*chit)->sequenceNumber == a_change->sequenceNumber)
         {
             mp_writer->change_removed_by_history(a_change);
-            m_changePool.release_Cache(a_change);
+            if (mp_writer->change_can_be_released(a_change))
+            {
+                m_changePool.release_Cache(a_change);
+            }
             m_changes.erase(chit);
             updateMaxMinSeqNum();
             m_isHistoryFull = false;
@@ -169,7 +177,10 @@ bool WriterHistory::remove_change(const SequenceNumber_t& sequence_number)
         if((*chit)->sequenceNumber == sequence_number)
         {
             mp_writer->change_removed_by_history(*chit);
-            m_changePool.release_Cache(*chit);
+            if (mp_writer->change_can_be_released(*chit))
+            {
+                m_changePool.release_Cache(*chit);
+            }
             m_changes.erase(chit);
             updateMaxMinSeqNum();
             m_isHistoryFull = false;
@@ -25,12 +25,17 @@
 
 #include <fastrtps/rtps/reader/ReaderListener.h>
 
+#include <fastrtps/rtps/history/CacheChangePool.h>
+
 #include "../participant/RTPSParticipantImpl.h"
+#include "ReceiveProcessingPool.h"
 
 #include <mutex>
 
 #include <limits>
 #include <cassert>
+#include <algorithm>
+#include <memory>
 
 
 #include <fastrtps/log/Log.h>
@@ -43,14 +48,24 @@ namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
+//! Changes preallocated to queue DATA and DATA_FRAG on the processing pool. More are allocated when needed.
+static const int32_t pooled_changes_initial_size = 16;
 
 MessageReceiver::MessageReceiver(RTPSParticipantImpl* participant, uint32_t rec_buffer_size) :
 #if HAVE_SECURITY
     m_crypto_msg(rec_buffer_size),
 #endif
-    sourceVendorId(c_VendorId_Unknown), participant_(participant)
+    sourceVendorId(c_VendorId_Unknown), participant_(participant),
+    processing_pool_(participant->receive_processing_pool())
 {
     init(rec_buffer_size);
+
+    if (processing_pool_ != nullptr)
+    {
+        // Reserved by the receiving thread and released by the workers, without locks.
+        pooled_changes_.reset(new CacheChangePool(pooled_changes_initial_size, mMaxPayload_, 0,
+                SIZE_CLASS_MEMORY_MODE));
+    }
 }
 
 void MessageReceiver::init(uint32_t rec_buffer_size){
@@ -66,6 +81,28 @@ void MessageReceiver::init(uint32_t rec_buffer_size){
     mMaxPayload_ = ((uint32_t)std::numeric_limits<uint16_t>::max() < rec_buffer_size) ? std::numeric_limits<uint16_t>::max() : (uint16_t)rec_buffer_size;
 }
 
+CacheChange_t* MessageReceiver::pooled_change_copy(const CacheChange_t& change)
+{
+    CacheChange_t* copy = nullptr;
+    if (!pooled_changes_->reserve_Cache(&copy, change.serializedPayload.length))
+    {
+        return nullptr;
+    }
+
+    if (!copy->copy(&change))
+    {
+        pooled_changes_->release_Cache(copy);
+        return nullptr;
+    }
+
+    return copy;
+}
+
+void MessageReceiver::release_pooled_change(CacheChange_t* change)
+{
+    pooled_changes_->release_Cache(change);
+}
+
 MessageReceiver::~MessageReceiver()
 {
     logInfo(RTPS_MSG_IN,"");
@@ -75,7 +112,8 @@ MessageReceiver::~MessageReceiver()
 
 void MessageReceiver::associateEndpoint(Endpoint *to_add){
     bool found = false;
-    std::lock_guard<std::mutex> guard(mtx);
+    const EntityId_t& entity_id = to_add->getGuid().entityId;
+    std::lock_guard<shared_mutex> guard(mtx);
     if(to_add->getAttributes().endpointKind == WRITER)
     {
         for(auto it = AssociatedWriters.begin(); it != AssociatedWriters.end(); ++it)
@@ -86,7 +124,11 @@ void MessageReceiver::associateEndpoint(Endpoint *to_add){
                 break;
             }
         }
-        if(!found) AssociatedWriters.push_back((RTPSWriter*)to_add);
+        if(!found)
+        {
+            AssociatedWriters.push_back((RTPSWriter*)to_add);
+            writers_by_id_[entity_id].push_back((RTPSWriter*)to_add);
+        }
     }
     else
     {
@@ -98,13 +140,38 @@ void MessageReceiver::associateEndpoint(Endpoint *to_add){
                 break;
             }
         }
-        if(!found) AssociatedReaders.push_back((RTPSReader*)to_add);
+        if(!found)
+        {
+            AssociatedReaders.push_back((RTPSReader*)to_add);
+            readers_by_id_[entity_id].push_back((RTPSReader*)to_add);
+        }
     }
     return;
 }
+
+//! Removes an endpoint from one of the EntityId indexed dispatch tables.
+template<typename Table, typename EndpointType>
+static void remove_from_table(
+        Table& table,
+        const EntityId_t& entity_id,
+        EndpointType* endpoint)
+{
+    auto entry = table.find(entity_id);
+    if (entry != table.end())
+    {
+        std::vector<EndpointType*>& endpoints = entry->second;
+        endpoints.erase(std::remove(endpoints.begin(), endpoints.end(), endpoint), endpoints.end());
+        if (endpoints.empty())
+        {
+            table.erase(entry);
+        }
+    }
+}
+
 void MessageReceiver::removeEndpoint(Endpoint *to_remove){
 
-    std::lock_guard<std::mutex> guard(mtx);
+    const EntityId_t& entity_id = to_remove->getGuid().entityId;
+    std::lock_guard<shared_mutex> guard(mtx);
     if(to_remove->getAttributes().endpointKind == WRITER){
         RTPSWriter* var = (RTPSWriter *)to_remove;
         for(auto it=AssociatedWriters.begin(); it !=AssociatedWriters.end(); ++it){
@@ -113,6 +180,7 @@ void MessageReceiver::removeEndpoint(Endpoint *to_remove){
                 break;
             }
         }
+        remove_from_table(writers_by_id_, entity_id, var);
     }else{
         RTPSReader *var = (RTPSReader *)to_remove;
         for(auto it=AssociatedReaders.begin(); it !=AssociatedReaders.end(); ++it){
@@ -121,10 +189,29 @@ void MessageReceiver::removeEndpoint(Endpoint *to_remove){
                 break;
             }
         }
+        remove_from_table(readers_by_id_, entity_id, var);
     }
     return;
 }
 
+const std::vector<RTPSReader*>* MessageReceiver::find_readers(const EntityId_t& reader_id) const
+{
+    // Submessages not directed to a particular reader are offered to all of them
+    if (reader_id == c_EntityId_Unknown)
+    {
+        return AssociatedReaders.empty() ? nullptr : &AssociatedReaders;
+    }
+
+    auto entry = readers_by_id_.find(reader_id);
+    return entry == readers_by_id_.end() ? nullptr : &entry->second;
+}
+
+const std::vector<RTPSWriter*>* MessageReceiver::find_writers(const EntityId_t& writer_id) const
+{
+    auto entry = writers_by_id_.find(writer_id);
+    return entry == writers_by_id_.end() ? nullptr : &entry->second;
+}
+
 
 void MessageReceiver::reset(){
     destVersion = c_ProtocolVersion;
@@ -408,7 +495,7 @@ bool MessageReceiver::readSubmessageHeader(CDRMessage_t* msg, SubmessageHeader_t
 
 bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh)
 {
-    std::lock_guard<std::mutex> guard(mtx);
+    shared_lock<shared_mutex> guard(mtx);
 
     //READ and PROCESS
     if(smh->submessageLength < RTPSMESSAGE_DATA_MIN_LENGTH)
@@ -445,24 +532,14 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
     valid &= CDRMessage::readEntityId(msg,&readerID);
 
     //WE KNOW THE READER THAT THE MESSAGE IS DIRECTED TO SO WE LOOK FOR IT:
-
-    RTPSReader* firstReader = nullptr;
     if(AssociatedReaders.empty())
     {
         logWarning(RTPS_MSG_IN,IDSTRING"Data received when NO readers are listening");
         return false;
     }
 
-    for(std::vector<RTPSReader*>::iterator it=AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        if((*it)->acceptMsgDirectedTo(readerID)) //add
-        {
-            firstReader = *it;
-            break;
-        }
-    }
-    if(firstReader == nullptr) //Reader not found
+    const std::vector<RTPSReader*>* readers = find_readers(readerID);
+    if(readers == nullptr) //Reader not found
     {
         logWarning(RTPS_MSG_IN, IDSTRING"No Reader accepts this message (directed to: " <<readerID << ")");
         return false;
@@ -560,14 +637,46 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 
 
     //FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
-    logInfo(RTPS_MSG_IN,IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: "<<AssociatedReaders.size());
-    //Look for the correct reader to add the change
-    for(std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    logInfo(RTPS_MSG_IN,IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: "<<readers->size());
+    if(processing_pool_ != nullptr)
+    {
+        // The pool may block, so the lock is released first. Readers are looked up again by the worker.
+        guard.unlock();
+        CacheChange_t* change = pooled_change_copy(ch);
+        ch.serializedPayload.data = nullptr;
+        if(change == nullptr)
+        {
+            logWarning(RTPS_MSG_IN, IDSTRING"Cannot queue DATA from " << ch.writerGUID << ", discarded");
+            return true;
+        }
+
+        processing_pool_->push(change->writerGUID, [this, readerID, change]()
+                {
+                    {
+                        shared_lock<shared_mutex> worker_guard(mtx);
+                        const std::vector<RTPSReader*>* worker_readers = find_readers(readerID);
+                        if(worker_readers != nullptr)
+                        {
+                            for(RTPSReader* reader : *worker_readers)
+                            {
+                                if(reader->acceptMsgDirectedTo(readerID))
+                                {
+                                    reader->processDataMsg(change);
+                                }
+                            }
+                        }
+                    }
+                    release_pooled_change(change);
+                });
+        return true;
+    }
+
+    //Add the change to the readers found before
+    for(RTPSReader* reader : *readers)
     {
-        if((*it)->acceptMsgDirectedTo(readerID))
+        if(reader->acceptMsgDirectedTo(readerID))
         {
-            (*it)->processDataMsg(&ch);
+            reader->processDataMsg(&ch);
         }
     }
 
@@ -580,7 +689,7 @@ bool MessageReceiver::proc_Submsg_Data(CDRMessage_t* msg,SubmessageHeader_t* smh
 
 bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t* smh)
 {
-    std::lock_guard<std::mutex> guard(mtx);
+    shared_lock<shared_mutex> guard(mtx);
 
     //READ and PROCESS
     if (smh->submessageLength < RTPSMESSAGE_DATA_MIN_LENGTH)
@@ -618,18 +727,8 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
         return false;
     }
 
-    RTPSReader* firstReader = nullptr;
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
-    {
-        if ((*it)->acceptMsgDirectedTo(readerID)) //add
-        {
-            firstReader = *it;
-            break;
-        }
-    }
-
-    if (firstReader == nullptr) //Reader not found
+    const std::vector<RTPSReader*>* readers = find_readers(readerID);
+    if (readers == nullptr) //Reader not found
     {
         logWarning(RTPS_MSG_IN, IDSTRING"No Reader accepts this message (directed to: " << readerID << ")");
         return false;
@@ -750,14 +849,46 @@ bool MessageReceiver::proc_Submsg_DataFrag(CDRMessage_t* msg, SubmessageHeader_t
         ch.sourceTimestamp = this->timestamp;
 
     //FIXME: DO SOMETHING WITH PARAMETERLIST CREATED.
-    logInfo(RTPS_MSG_IN, IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: " << AssociatedReaders.size());
-    //Look for the correct reader to add the change
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    logInfo(RTPS_MSG_IN, IDSTRING"from Writer " << ch.writerGUID << "; possible RTPSReaders: " << readers->size());
+    if (processing_pool_ != nullptr)
     {
-        if ((*it)->acceptMsgDirectedTo(readerID))
+        // The pool may block, so the lock is released first. Readers are looked up again by the worker.
+        guard.unlock();
+        CacheChange_t* change = pooled_change_copy(ch);
+        ch.serializedPayload.data = nullptr;
+        if (change == nullptr)
         {
-            (*it)->processDataFragMsg(&ch, sampleSize, fragmentStartingNum);
+            logWarning(RTPS_MSG_IN, IDSTRING"Cannot queue DATA_FRAG from " << ch.writerGUID << ", discarded");
+            return true;
+        }
+
+        processing_pool_->push(change->writerGUID, [this, readerID, change, sampleSize, fragmentStartingNum]()
+                {
+                    {
+                        shared_lock<shared_mutex> worker_guard(mtx);
+                        const std::vector<RTPSReader*>* worker_readers = find_readers(readerID);
+                        if (worker_readers != nullptr)
+                        {
+                            for (RTPSReader* reader : *worker_readers)
+                            {
+                                if (reader->acceptMsgDirectedTo(readerID))
+                                {
+                                    reader->processDataFragMsg(change, sampleSize, fragmentStartingNum);
+                                }
+                            }
+                        }
+                    }
+                    release_pooled_change(change);
+                });
+        return true;
+    }
+
+    //Add the fragment to the readers found before
+    for (RTPSReader* reader : *readers)
+    {
+        if (reader->acceptMsgDirectedTo(readerID))
+        {
+            reader->processDataFragMsg(&ch, sampleSize, fragmentStartingNum);
         }
     }
 
@@ -797,15 +928,30 @@ bool MessageReceiver::proc_Submsg_Heartbeat(CDRMessage_t* msg,SubmessageHeader_t
     uint32_t HBCount;
     CDRMessage::readUInt32(msg,&HBCount);
 
-    std::lock_guard<std::mutex> guard(mtx);
-    //Look for the correct reader and writers:
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    auto deliver = [this, readerGUID, writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag]()
     {
-        if((*it)->acceptMsgDirectedTo(readerGUID.entityId))
+        shared_lock<shared_mutex> guard(mtx);
+        //Look for the correct reader and writers:
+        const std::vector<RTPSReader*>* readers = find_readers(readerGUID.entityId);
+        if (readers != nullptr)
         {
-            (*it)->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
+            for (RTPSReader* reader : *readers)
+            {
+                if(reader->acceptMsgDirectedTo(readerGUID.entityId))
+                {
+                    reader->processHeartbeatMsg(writerGUID, HBCount, firstSN, lastSN, finalFlag, livelinessFlag);
+                }
+            }
         }
+    };
+
+    if (processing_pool_ != nullptr)
+    {
+        processing_pool_->push(writerGUID, deliver);
+    }
+    else
+    {
+        deliver();
     }
     return true;
 }
@@ -831,19 +977,22 @@ bool MessageReceiver::proc_Submsg_Acknack(CDRMessage_t* msg,SubmessageHeader_t*
     uint32_t Ackcount;
     CDRMessage::readUInt32(msg,&Ackcount);
 
-    std::lock_guard<std::mutex> guard(mtx);
+    shared_lock<shared_mutex> guard(mtx);
     //Look for the correct writer to use the acknack
-    for (std::vector<RTPSWriter*>::iterator it = AssociatedWriters.begin();
-            it != AssociatedWriters.end(); ++it)
+    const std::vector<RTPSWriter*>* writers = find_writers(writerGUID.entityId);
+    if (writers != nullptr)
     {
-        bool result;
-        if ((*it)->process_acknack(writerGUID, readerGUID, Ackcount, SNSet, finalFlag, result))
+        for (RTPSWriter* writer : *writers)
         {
-            if (!result)
+            bool result;
+            if (writer->process_acknack(writerGUID, readerGUID, Ackcount, SNSet, finalFlag, result))
             {
-                logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to NOT stateful writer ");
+                if (!result)
+                {
+                    logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to NOT stateful writer ");
+                }
+                return result;
             }
-            return result;
         }
     }
     logInfo(RTPS_MSG_IN,IDSTRING"Acknack msg to UNKNOWN writer (I loooked through "
@@ -873,14 +1022,29 @@ bool MessageReceiver::proc_Submsg_Gap(CDRMessage_t* msg,SubmessageHeader_t* smh)
     if(gapStart <= SequenceNumber_t(0, 0))
         return false;
 
-    std::lock_guard<std::mutex> guard(mtx);
-    for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
-            it != AssociatedReaders.end(); ++it)
+    auto deliver = [this, readerGUID, writerGUID, gapStart, gapList]()
     {
-        if((*it)->acceptMsgDirectedTo(readerGUID.entityId))
+        shared_lock<shared_mutex> guard(mtx);
+        const std::vector<RTPSReader*>* readers = find_readers(readerGUID.entityId);
+        if (readers != nullptr)
         {
-            (*it)->processGapMsg(writerGUID, gapStart, gapList);
+            for (RTPSReader* reader : *readers)
+            {
+                if(reader->acceptMsgDirectedTo(readerGUID.entityId))
+                {
+                    reader->processGapMsg(writerGUID, gapStart, gapList);
+                }
+            }
         }
+    };
+
+    if (processing_pool_ != nullptr)
+    {
+        processing_pool_->push(writerGUID, deliver);
+    }
+    else
+    {
+        deliver();
     }
 
     return true;
@@ -973,19 +1137,22 @@ bool MessageReceiver::proc_Submsg_NackFrag(CDRMessage_t*msg, SubmessageHeader_t*
     uint32_t Ackcount;
     CDRMessage::readUInt32(msg, &Ackcount);
 
-    std::lock_guard<std::mutex> guard(mtx);
+    shared_lock<shared_mutex> guard(mtx);
     //Look for the correct writer to use the acknack
-    for (std::vector<RTPSWriter*>::iterator it = AssociatedWriters.begin();
-            it != AssociatedWriters.end(); ++it)
+    const std::vector<RTPSWriter*>* writers = find_writers(writerGUID.entityId);
+    if (writers != nullptr)
     {
-        bool result;
-        if ((*it)->process_nack_frag(writerGUID, readerGUID, Ackcount, writerSN, fnState, result))
+        for (RTPSWriter* writer : *writers)
         {
-            if (!result)
+            bool result;
+            if (writer->process_nack_frag(writerGUID, readerGUID, Ackcount, writerSN, fnState, result))
             {
-                logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to NOT stateful writer ");
+                if (!result)
+                {
+                    logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to NOT stateful writer ");
+                }
+                return result;
             }
-            return result;
         }
     }
     logInfo(RTPS_MSG_IN, IDSTRING"Acknack msg to UNKNOWN writer (I looked through "
@@ -1019,7 +1186,7 @@ bool MessageReceiver::proc_Submsg_HeartbeatFrag(CDRMessage_t*msg, SubmessageHead
 
     // XXX TODO VALIDATE DATA?
 
-    std::lock_guard<std::mutex> guard(mtx);
+    shared_lock<shared_mutex> guard(mtx);
     //Look for the correct reader and writers:
     for (std::vector<RTPSReader*>::iterator it = AssociatedReaders.begin();
             it != AssociatedReaders.end(); ++it)
@@ -43,7 +43,11 @@ bool sort_SeqNum(const SequenceNumber_t& s1,const SequenceNumber_t& s2)
 
 typedef std::pair<SequenceNumber_t,SequenceNumberSet_t> pair_T;
 
-void prepare_SequenceNumberSet(std::set<SequenceNumber_t>& changesSeqNum,
+//! Sent after referenced payloads to keep submessages aligned to 4
+static const octet padding_octets[3] = {0, 0, 0};
+
+template<class SeqNumCollection>
+void prepare_SequenceNumberSet(const SeqNumCollection& changesSeqNum,
         std::vector<pair_T>& sequences)
 {
     //First compute the number of GAP messages we need:
@@ -149,6 +153,10 @@ RTPSMessageGroup::RTPSMessageGroup(
     , full_msg_(&msg_group.rtpsmsg_fullmsg_)
     , submessage_msg_(&msg_group.rtpsmsg_submessage_)
     , currentBytesSent_(0)
+    , payload_references_(msg_group.payload_references_)
+    , send_buffers_(msg_group.send_buffers_)
+    , referenced_bytes_(0)
+    , reference_payloads_(true)
 #if HAVE_SECURITY
     , participant_(participant)
     , encrypt_msg_(&msg_group.rtpsmsg_encrypt_)
@@ -170,6 +178,9 @@ RTPSMessageGroup::RTPSMessageGroup(
     if (participant->is_secure())
     {
         CDRMessage::initCDRMsg(encrypt_msg_);
+
+        // Encoders work on contiguous buffers
+        reference_payloads_ = false;
     }
 #endif
 }
@@ -184,6 +195,8 @@ void RTPSMessageGroup::reset_to_header()
     CDRMessage::initCDRMsg(full_msg_);
     full_msg_->pos = RTPSMESSAGE_HEADER_SIZE;
     full_msg_->length = RTPSMESSAGE_HEADER_SIZE;
+    payload_references_.clear();
+    referenced_bytes_ = 0;
 }
 
 void RTPSMessageGroup::flush()
@@ -219,11 +232,30 @@ void RTPSMessageGroup::send()
         }
 #endif
 
-        if(!sender_.send(msgToSend, max_blocking_time_point_))
+        // Referenced payloads are interleaved with the chunks of the message they belong to
+        uint32_t total_bytes = msgToSend->length + referenced_bytes_;
+        uint32_t from = 0;
+        send_buffers_.clear();
+        for (const RTPSMessageGroup_t::PayloadReference& reference : payload_references_)
+        {
+            send_buffers_.emplace_back(&msgToSend->buffer[from], reference.offset - from);
+            send_buffers_.emplace_back(reference.data, reference.size);
+            if (reference.padding > 0)
+            {
+                send_buffers_.emplace_back(padding_octets, reference.padding);
+            }
+            from = reference.offset;
+        }
+        if (from < msgToSend->length)
+        {
+            send_buffers_.emplace_back(&msgToSend->buffer[from], msgToSend->length - from);
+        }
+
+        if(!sender_.send(send_buffers_, total_bytes, max_blocking_time_point_))
         {
             throw timeout();
         }
-        currentBytesSent_ += msgToSend->length;
+        currentBytesSent_ += total_bytes;
     }
 }
 
@@ -238,6 +270,7 @@ void RTPSMessageGroup::flush_and_reset()
 void RTPSMessageGroup::check_and_maybe_flush()
 {
     CDRMessage::initCDRMsg(submessage_msg_);
+    pending_reference_ = RTPSMessageGroup_t::PayloadReference();
 
     if(sender_.destinations_have_changed())
         flush_and_reset();
@@ -247,7 +280,7 @@ void RTPSMessageGroup::check_and_maybe_flush()
 
 bool RTPSMessageGroup::insert_submessage()
 {
-    if(!CDRMessage::appendMsg(full_msg_, submessage_msg_))
+    if(!append_submessage())
     {
         // Retry
         flush();
@@ -270,6 +303,42 @@ bool RTPSMessageGroup::insert_submessage()
     return true;
 }
 
+bool RTPSMessageGroup::append_submessage()
+{
+    uint32_t pending_bytes = pending_reference_.size + pending_reference_.padding;
+
+    // Referenced payloads are not in full_msg_, but they count for the size of the datagram
+    if(full_msg_->length + referenced_bytes_ + submessage_msg_->length + pending_bytes > full_msg_->max_size)
+    {
+        return false;
+    }
+
+    if(!CDRMessage::appendMsg(full_msg_, submessage_msg_))
+    {
+        return false;
+    }
+
+    if(pending_bytes > 0)
+    {
+        pending_reference_.offset = full_msg_->length;
+        payload_references_.push_back(pending_reference_);
+        referenced_bytes_ += pending_bytes;
+    }
+
+    return true;
+}
+
+bool RTPSMessageGroup::can_reference_payload(
+        const CacheChange_t& change,
+        uint32_t size) const
+{
+    return reference_payloads_ &&
+        change.kind == ALIVE &&
+        change.serializedPayload.data != nullptr &&
+        size >= RTPSMessageGroup_t::min_referenced_payload_size &&
+        payload_references_.size() < RTPSMessageGroup_t::max_payload_references;
+}
+
 bool RTPSMessageGroup::add_info_dst_in_buffer(CDRMessage_t* buffer)
 {
 #if HAVE_SECURITY
@@ -355,15 +424,23 @@ bool RTPSMessageGroup::add_data(
 #endif
     const EntityId_t& readerId = get_entity_id(sender_.remote_guids());
 
-    // TODO (Ricardo). Check to create special wrapper.
+    // Big payloads are sent directly from the history instead of being copied into the message
+    bool reference_payload = can_reference_payload(change, change.serializedPayload.length);
 
     if(!RTPSMessageCreator::addSubmessageData(submessage_msg_, &change, endpoint_->getAttributes().topicKind,
-                readerId, expectsInlineQos, inlineQos))
+                readerId, expectsInlineQos, inlineQos, !reference_payload))
     {
         logError(RTPS_WRITER, "Cannot add DATA submsg to the CDRMessage. Buffer too small");
         return false;
     }
 
+    if(reference_payload)
+    {
+        pending_reference_.data = change.serializedPayload.data;
+        pending_reference_.size = change.serializedPayload.length;
+        pending_reference_.padding = (4 - (submessage_msg_->pos + pending_reference_.size) % 4) & 3;
+    }
+
 #if HAVE_SECURITY
     if(endpoint_->getAttributes().security_attributes().is_submessage_protected)
     {
@@ -451,14 +528,24 @@ bool RTPSMessageGroup::add_data_frag(
     }
 #endif
 
+    // Big fragments are sent directly from the history instead of being copied into the message
+    bool reference_payload = can_reference_payload(change_to_add, change_to_add.serializedPayload.length);
+
     if(!RTPSMessageCreator::addSubmessageDataFrag(submessage_msg_, &change_to_add, fragment_number,
                 change.serializedPayload.length, endpoint_->getAttributes().topicKind, readerId,
-                expectsInlineQos, inlineQos))
+                expectsInlineQos, inlineQos, !reference_payload))
     {
         logError(RTPS_WRITER, "Cannot add DATA_FRAG submsg to the CDRMessage. Buffer too small");
         change_to_add.serializedPayload.data = NULL;
         return false;
     }
+
+    if(reference_payload)
+    {
+        pending_reference_.data = change_to_add.serializedPayload.data;
+        pending_reference_.size = change_to_add.serializedPayload.length;
+        pending_reference_.padding = (4 - (submessage_msg_->pos + pending_reference_.size) % 4) & 3;
+    }
     change_to_add.serializedPayload.data = NULL;
 
 #if HAVE_SECURITY
@@ -546,7 +633,21 @@ bool RTPSMessageGroup::add_gap(std::set<SequenceNumber_t>& changesSeqNum)
 {
     std::vector<pair_T> Sequences;
     prepare_SequenceNumberSet(changesSeqNum, Sequences);
-    std::vector<pair_T>::iterator seqit = Sequences.begin();
+    return add_gap_sequences(Sequences);
+}
+
+bool RTPSMessageGroup::add_gap(const std::vector<SequenceNumber_t>& changesSeqNum)
+{
+    assert(std::is_sorted(changesSeqNum.begin(), changesSeqNum.end()));
+
+    std::vector<pair_T> Sequences;
+    prepare_SequenceNumberSet(changesSeqNum, Sequences);
+    return add_gap_sequences(Sequences);
+}
+
+bool RTPSMessageGroup::add_gap_sequences(const std::vector<pair_T>& Sequences)
+{
+    std::vector<pair_T>::const_iterator seqit = Sequences.begin();
 
     uint16_t gap_n = 1;
 
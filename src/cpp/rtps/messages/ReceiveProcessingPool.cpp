@@ -0,0 +1,143 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReceiveProcessingPool.cpp
+ */
+
+#include "ReceiveProcessingPool.h"
+
+#include <cassert>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+constexpr size_t ReceiveProcessingPool::max_queued_tasks;
+
+ReceiveProcessingPool::ReceiveProcessingPool(uint32_t num_threads)
+{
+    assert(num_threads > 0);
+
+    workers_.reserve(num_threads);
+    for (uint32_t i = 0; i < num_threads; ++i)
+    {
+        workers_.emplace_back(new Worker());
+        Worker* worker = workers_.back().get();
+        worker->thread = std::thread(&ReceiveProcessingPool::run, worker);
+    }
+}
+
+ReceiveProcessingPool::~ReceiveProcessingPool()
+{
+    stop();
+}
+
+void ReceiveProcessingPool::push(
+        const GUID_t& writer_guid,
+        Task&& task)
+{
+    Worker& worker = *workers_[worker_index(writer_guid)];
+
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    worker.cv.wait(lock, [&worker]()
+            {
+                return !worker.running || worker.tasks.size() < max_queued_tasks;
+            });
+
+    if (!worker.running)
+    {
+        return;
+    }
+
+    worker.tasks.push_back(std::move(task));
+    if (worker.tasks.size() == 1)
+    {
+        lock.unlock();
+        worker.cv.notify_all();
+    }
+}
+
+void ReceiveProcessingPool::stop()
+{
+    for (auto& worker : workers_)
+    {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->running = false;
+        }
+        worker->cv.notify_all();
+    }
+
+    for (auto& worker : workers_)
+    {
+        if (worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+}
+
+void ReceiveProcessingPool::run(Worker* worker)
+{
+    std::deque<Task> batch;
+
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    while (true)
+    {
+        worker->cv.wait(lock, [worker]()
+                {
+                    return !worker->running || !worker->tasks.empty();
+                });
+
+        if (worker->tasks.empty())
+        {
+            // Not running and everything processed
+            break;
+        }
+
+        // Take the whole queue, so the receiving thread only contends once per batch.
+        batch.swap(worker->tasks);
+        lock.unlock();
+        worker->cv.notify_all();
+
+        for (Task& task : batch)
+        {
+            task();
+        }
+        batch.clear();
+
+        lock.lock();
+    }
+}
+
+size_t ReceiveProcessingPool::worker_index(const GUID_t& writer_guid) const
+{
+    // FNV-1a over the whole GUID. Writers of the same participant only differ on the entity id.
+    uint32_t hash = 2166136261u;
+    for (octet byte : writer_guid.guidPrefix.value)
+    {
+        hash = (hash ^ byte) * 16777619u;
+    }
+    for (octet byte : writer_guid.entityId.value)
+    {
+        hash = (hash ^ byte) * 16777619u;
+    }
+
+    return hash % workers_.size();
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
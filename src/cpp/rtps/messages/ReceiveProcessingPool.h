@@ -0,0 +1,101 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ReceiveProcessingPool.h
+ */
+
+#ifndef _RTPS_MESSAGES_RECEIVEPROCESSINGPOOL_H_
+#define _RTPS_MESSAGES_RECEIVEPROCESSINGPOOL_H_
+
+#include <fastrtps/rtps/common/Guid.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Set of worker threads where received submessages are delivered to the local readers.
+ *
+ * Each worker owns a FIFO queue. Tasks are assigned to a queue by hashing the GUID of the remote writer,
+ * so all the submessages of a writer are processed in arrival order by the same worker, while submessages
+ * of different writers may be processed in parallel.
+ * @ingroup MANAGEMENT_MODULE
+ */
+class ReceiveProcessingPool
+{
+public:
+
+    typedef std::function<void()> Task;
+
+    //! Maximum number of tasks waiting on a worker queue before the receiving thread is blocked.
+    static constexpr size_t max_queued_tasks = 4096u;
+
+    /**
+     * Creates the pool and starts its workers.
+     * @param num_threads Number of workers.
+     */
+    explicit ReceiveProcessingPool(uint32_t num_threads);
+
+    ~ReceiveProcessingPool();
+
+    ReceiveProcessingPool(const ReceiveProcessingPool&) = delete;
+    ReceiveProcessingPool& operator=(const ReceiveProcessingPool&) = delete;
+
+    /**
+     * Queues a task on the worker assigned to a remote writer.
+     * Blocks while that worker queue is full. Must not be called with locks the workers may need.
+     * @param writer_guid GUID of the remote writer the task belongs to.
+     * @param task Task to execute.
+     */
+    void push(
+            const GUID_t& writer_guid,
+            Task&& task);
+
+    /**
+     * Processes all the queued tasks and stops the workers. Tasks pushed afterwards are discarded.
+     */
+    void stop();
+
+private:
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<Task> tasks;
+        bool running = true;
+        std::thread thread;
+    };
+
+    static void run(Worker* worker);
+
+    size_t worker_index(const GUID_t& writer_guid) const;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // _RTPS_MESSAGES_RECEIVEPROCESSINGPOOL_H_
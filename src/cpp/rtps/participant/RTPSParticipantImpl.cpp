@@ -21,6 +21,7 @@
 
 #include "../flowcontrol/ThroughputController.h"
 #include "../persistence/PersistenceService.h"
+#include "../messages/ReceiveProcessingPool.h"
 
 #include <fastrtps/rtps/messages/MessageReceiver.h>
 
@@ -130,6 +131,12 @@ RTPSParticipantImpl::RTPSParticipantImpl(const RTPSParticipantAttributes& PParam
     mp_userParticipant->mp_impl = this;
     mp_event_thr.init_thread();
 
+    // Must be created before any MessageReceiver
+    if (PParam.receiveProcessingThreads > 0)
+    {
+        m_receive_processing_pool.reset(new ReceiveProcessingPool(PParam.receiveProcessingThreads));
+    }
+
     // Throughput controller, if the descriptor has valid values
     if (PParam.throughputController.bytesPerPeriod != UINT32_MAX && PParam.throughputController.periodMillisecs != 0)
     {
@@ -270,6 +277,12 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
         block.disable();
     }
 
+    // Deliver what was already received while all the endpoints are still alive.
+    if (m_receive_processing_pool)
+    {
+        m_receive_processing_pool->stop();
+    }
+
     while(m_userReaderList.size() > 0)
     {
         deleteUserEndpoint(static_cast<Endpoint*>(*m_userReaderList.begin()));
@@ -295,6 +308,7 @@ RTPSParticipantImpl::~RTPSParticipantImpl()
 
     delete(this->mp_ResourceSemaphore);
     delete(this->mp_userParticipant);
+    std::atomic_store(&send_dispatch_table_, std::shared_ptr<const SendDispatchTable>());
     send_resource_list_.clear();
 
     delete(this->mp_mutex);
@@ -770,7 +784,7 @@ bool RTPSParticipantImpl::createSendResources(Endpoint *pend)
         m_network_Factory.GetDefaultOutputLocators(pend->m_att.remoteLocatorList);
     }
 
-    std::lock_guard<std::timed_mutex> guard(m_send_resources_mutex_);
+    std::lock_guard<std::mutex> guard(m_send_resources_mutex_);
 
     //Output locators have been specified, create them
     for (auto it = pend->m_att.remoteLocatorList.begin(); it != pend->m_att.remoteLocatorList.end(); ++it)
@@ -782,6 +796,7 @@ bool RTPSParticipantImpl::createSendResources(Endpoint *pend)
         }
     }
 
+    update_send_dispatch_table_nts();
     return true;
 }
 
@@ -821,19 +836,60 @@ void RTPSParticipantImpl::createReceiverResources(LocatorList_t& Locator_list, b
 
 void RTPSParticipantImpl::createSenderResources(const LocatorList_t& locator_list)
 {
-    std::unique_lock<std::timed_mutex> lock(m_send_resources_mutex_);
+    std::unique_lock<std::mutex> lock(m_send_resources_mutex_);
 
     for (auto it_loc = locator_list.begin(); it_loc != locator_list.end(); ++it_loc)
     {
         m_network_Factory.build_send_resources(send_resource_list_, *it_loc);
     }
+
+    update_send_dispatch_table_nts();
 }
 
 void RTPSParticipantImpl::createSenderResources(const Locator_t& locator)
 {
-    std::unique_lock<std::timed_mutex> lock(m_send_resources_mutex_);
-    
+    std::unique_lock<std::mutex> lock(m_send_resources_mutex_);
+
     m_network_Factory.build_send_resources(send_resource_list_, locator);
+    update_send_dispatch_table_nts();
+}
+
+void RTPSParticipantImpl::update_send_dispatch_table_nts()
+{
+    // Resources are only added, so the table only changes when the list grows.
+    std::shared_ptr<const SendDispatchTable> current = std::atomic_load(&send_dispatch_table_);
+    size_t current_size = 0;
+    if (current)
+    {
+        for (const SendResourcesOfKind& entry : *current)
+        {
+            current_size += entry.resources.size();
+        }
+    }
+
+    if (current && current_size == send_resource_list_.size())
+    {
+        return;
+    }
+
+    std::shared_ptr<SendDispatchTable> table = std::make_shared<SendDispatchTable>();
+    for (auto& send_resource : send_resource_list_)
+    {
+        auto entry = std::find_if(table->begin(), table->end(), [&send_resource](const SendResourcesOfKind& e)
+                {
+                    return e.kind == send_resource->kind();
+                });
+
+        if (entry == table->end())
+        {
+            table->push_back(SendResourcesOfKind{send_resource->kind(), {}});
+            entry = table->end() - 1;
+        }
+
+        entry->resources.push_back(send_resource.get());
+    }
+
+    std::atomic_store(&send_dispatch_table_, std::shared_ptr<const SendDispatchTable>(std::move(table)));
 }
 
 bool RTPSParticipantImpl::deleteUserEndpoint(Endpoint* p_endpoint)
@@ -964,29 +1020,93 @@ std::vector<std::string> RTPSParticipantImpl::getParticipantNames() const
 }
 
 bool RTPSParticipantImpl::sendSync(
-        CDRMessage_t* msg,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
         const Locator_t& destination_loc,
         std::chrono::steady_clock::time_point& max_blocking_time_point)
 {
-    bool ret_code = false;
-    std::unique_lock<std::timed_mutex> lock(m_send_resources_mutex_, std::defer_lock);
-
-    if(lock.try_lock_until(max_blocking_time_point))
+    // Only the resources of the transport kind of the locator are tried. Transports already rejected the
+    // locators of other kinds.
+    std::shared_ptr<const SendDispatchTable> table = std::atomic_load(&send_dispatch_table_);
+    if (table)
     {
-        ret_code = true;
+        for (const SendResourcesOfKind& entry : *table)
+        {
+            if (entry.kind != destination_loc.kind)
+            {
+                continue;
+            }
+
+            for (SenderResource* send_resource : entry.resources)
+            {
+                // Calculate next timeout.
+                std::chrono::microseconds timeout =
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                            max_blocking_time_point - std::chrono::steady_clock::now());
+
+                send_resource->send(buffers, total_bytes, destination_loc, timeout);
+            }
+            break;
+        }
+    }
 
-        for (auto& send_resource : send_resource_list_)
+    return true;
+}
+
+bool RTPSParticipantImpl::sendSync(
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        const Locator_t* destination_locators,
+        size_t num_destinations,
+        std::chrono::steady_clock::time_point& max_blocking_time_point)
+{
+    std::shared_ptr<const SendDispatchTable> table = std::atomic_load(&send_dispatch_table_);
+    if (table)
+    {
+        // Each entry is given the runs of consecutive destinations of its own kind straight from the caller's list.
+        for (const SendResourcesOfKind& entry : *table)
         {
-            // Calculate next timeout.
-            std::chrono::microseconds timeout =
-                std::chrono::duration_cast<std::chrono::microseconds>(
-                        max_blocking_time_point - std::chrono::steady_clock::now());
+            size_t i = 0;
+            while (i < num_destinations)
+            {
+                if (destination_locators[i].kind != entry.kind)
+                {
+                    ++i;
+                    continue;
+                }
 
-            send_resource->send(msg->buffer, msg->length, destination_loc, timeout);
+                size_t run_begin = i;
+                while (i < num_destinations && destination_locators[i].kind == entry.kind)
+                {
+                    ++i;
+                }
+
+                send_to_resources_of_kind(entry, buffers, total_bytes, destination_locators + run_begin,
+                        i - run_begin, max_blocking_time_point);
+            }
         }
     }
 
-    return ret_code;
+    return true;
+}
+
+void RTPSParticipantImpl::send_to_resources_of_kind(
+        const SendResourcesOfKind& entry,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        const Locator_t* destination_locators,
+        size_t num_destinations,
+        std::chrono::steady_clock::time_point& max_blocking_time_point)
+{
+    for (SenderResource* send_resource : entry.resources)
+    {
+        // Calculate next timeout.
+        std::chrono::microseconds timeout =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                    max_blocking_time_point - std::chrono::steady_clock::now());
+
+        send_resource->send(buffers, total_bytes, destination_locators, num_destinations, timeout);
+    }
 }
 
 void RTPSParticipantImpl::setGuid(GUID_t& guid)
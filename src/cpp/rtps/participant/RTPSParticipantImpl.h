@@ -22,6 +22,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <list>
+#include <memory>
 #include <sys/types.h>
 #include <mutex>
 #include <atomic>
@@ -78,6 +79,7 @@ class StatefulReader;
 class PDPSimple;
 class FlowController;
 class IPersistenceService;
+class ReceiveProcessingPool;
 class WLP;
 
 /**
@@ -180,12 +182,25 @@ public:
     //!Get Pointer to the Event Resource.
     ResourceEvent& getEventResource() { return mp_event_thr; }
 
+    //!Get the pool where received submessages are delivered to the readers. nullptr when they are delivered inline.
+    ReceiveProcessingPool* receive_processing_pool() const { return m_receive_processing_pool.get(); }
+
     //!Send Method - Deprecated - Stays here for reference purposes
     bool sendSync(
-            CDRMessage_t* msg,
+            const std::vector<NetworkBuffer>& buffers,
+            uint32_t total_bytes,
             const Locator_t& destination_loc,
             std::chrono::steady_clock::time_point& max_blocking_time_point);
 
+    //!Send the same message to several destinations, letting transports batch the datagrams.
+    //!Destinations of the same kind should be consecutive, as each run of them is handed to the transports at once.
+    bool sendSync(
+            const std::vector<NetworkBuffer>& buffers,
+            uint32_t total_bytes,
+            const Locator_t* destination_locators,
+            size_t num_destinations,
+            std::chrono::steady_clock::time_point& max_blocking_time_point);
+
     //!Get the participant Mutex
     std::recursive_mutex* getParticipantMutex() const { return mp_mutex; };
 
@@ -294,11 +309,45 @@ private:
     std::list<ReceiverControlBlock> m_receiverResourcelist;
     //! Receiver resource list needs its own mutext to avoid a race condition.
     std::mutex m_receiverResourcelistMutex;
+    //! Workers delivering received submessages, when RTPSParticipantAttributes::receiveProcessingThreads is not 0.
+    std::unique_ptr<ReceiveProcessingPool> m_receive_processing_pool;
 
     //!SenderResource List
-    std::timed_mutex m_send_resources_mutex_;
+    std::mutex m_send_resources_mutex_;
     SendResourceList send_resource_list_;
 
+    //! Sender resources of the same transport kind.
+    struct SendResourcesOfKind
+    {
+        int32_t kind;
+        std::vector<SenderResource*> resources;
+    };
+
+    //! Sender resources grouped by the locator kind they can send to.
+    using SendDispatchTable = std::vector<SendResourcesOfKind>;
+
+    /**
+     * Table used by sendSync to find the sender resources of a locator.
+     * It is replaced, never modified, whenever send_resource_list_ grows, so senders only need an atomic load
+     * of the pointer and can send in parallel.
+     */
+    std::shared_ptr<const SendDispatchTable> send_dispatch_table_;
+
+    /**
+     * Rebuilds send_dispatch_table_ from send_resource_list_.
+     * m_send_resources_mutex_ should be locked.
+     */
+    void update_send_dispatch_table_nts();
+
+    //! Sends a message through all the resources of an entry of the dispatch table.
+    void send_to_resources_of_kind(
+            const SendResourcesOfKind& entry,
+            const std::vector<NetworkBuffer>& buffers,
+            uint32_t total_bytes,
+            const Locator_t* destination_locators,
+            size_t num_destinations,
+            std::chrono::steady_clock::time_point& max_blocking_time_point);
+
     //!Participant Listener
     RTPSParticipantListener* mp_participantListener;
     //!Pointer to the user participant
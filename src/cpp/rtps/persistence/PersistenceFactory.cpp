@@ -21,6 +21,11 @@
 #include "SQLite3PersistenceService.h"
 
 #include <fastrtps/rtps/attributes/PropertyPolicy.h>
+#include <fastrtps/log/Log.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
 
 namespace eprosima {
 namespace fastrtps{
@@ -38,7 +43,31 @@ IPersistenceService* PersistenceFactory::create_persistence_service(const Proper
             const std::string* filename_property = PropertyPolicyHelper::find_property(property_policy, "dds.persistence.sqlite3.filename");
             const char* filename = (filename_property == nullptr) ?
                 "persistence.db" : filename_property->c_str();
-            ret_val = create_SQLite3_persistence_service(filename);
+            const std::string* mode_property = PropertyPolicyHelper::find_property(property_policy, "dds.persistence.sqlite3.mode");
+            if (mode_property != nullptr && mode_property->compare("ASYNCHRONOUS") == 0)
+            {
+                const std::string* interval_property = PropertyPolicyHelper::find_property(property_policy,
+                        "dds.persistence.sqlite3.flush_interval_ms");
+                uint32_t flush_interval_ms = 100u;
+                if (interval_property != nullptr)
+                {
+                    unsigned long value = std::strtoul(interval_property->c_str(), nullptr, 10);
+                    if (value > 0 && value <= UINT32_MAX)
+                    {
+                        flush_interval_ms = static_cast<uint32_t>(value);
+                    }
+                    else
+                    {
+                        logWarning(RTPS_PERSISTENCE, "Invalid flush interval " << *interval_property <<
+                                ". Using " << flush_interval_ms << " ms");
+                    }
+                }
+                ret_val = create_SQLite3_async_persistence_service(filename, flush_interval_ms);
+            }
+            else
+            {
+                ret_val = create_SQLite3_persistence_service(filename);
+            }
         }
     }
 
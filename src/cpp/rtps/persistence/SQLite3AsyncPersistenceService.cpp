@@ -0,0 +1,228 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file SQLite3AsyncPersistenceService.cpp
+ *
+ */
+
+#include "SQLite3AsyncPersistenceService.h"
+#include <fastrtps/log/Log.h>
+
+#include "sqlite3.h"
+
+namespace eprosima {
+namespace fastrtps{
+namespace rtps {
+
+//! Number of queued operations that triggers a commit before the flush interval expires.
+static constexpr size_t max_pending_operations = 4096u;
+
+SQLite3AsyncPersistenceService::SQLite3AsyncPersistenceService(
+        sqlite3* db,
+        uint32_t flush_interval_ms)
+    : db_(db)
+    , sync_service_(db)
+    , flush_interval_(flush_interval_ms)
+    , flush_requested_(false)
+    , running_(true)
+{
+    thread_ = std::thread(&SQLite3AsyncPersistenceService::run, this);
+}
+
+SQLite3AsyncPersistenceService::~SQLite3AsyncPersistenceService()
+{
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        running_ = false;
+    }
+    queue_cond_.notify_one();
+    thread_.join();
+}
+
+bool SQLite3AsyncPersistenceService::load_writer_from_storage(
+        const std::string& persistence_guid,
+        const GUID_t& writer_guid,
+        std::vector<CacheChange_t*>& changes,
+        CacheChangePool* pool)
+{
+    flush();
+
+    std::lock_guard<std::mutex> lock(db_mutex_);
+    return sync_service_.load_writer_from_storage(persistence_guid, writer_guid, changes, pool);
+}
+
+bool SQLite3AsyncPersistenceService::add_writer_change_to_storage(
+        const std::string& persistence_guid,
+        const CacheChange_t& change)
+{
+    logInfo(RTPS_PERSISTENCE, "Writer " << change.writerGUID << " queuing change for seq " << change.sequenceNumber);
+
+    Operation operation;
+    operation.kind = Operation::ADD_WRITER_CHANGE;
+    operation.persistence_guid = persistence_guid;
+    operation.sequence_number = change.sequenceNumber;
+    operation.instance = change.instanceHandle;
+    operation.payload.assign(change.serializedPayload.data,
+            change.serializedPayload.data + change.serializedPayload.length);
+    queue(std::move(operation));
+    return true;
+}
+
+bool SQLite3AsyncPersistenceService::remove_writer_change_from_storage(
+        const std::string& persistence_guid,
+        const CacheChange_t& change)
+{
+    logInfo(RTPS_PERSISTENCE, "Writer " << change.writerGUID << " queuing removal for seq " << change.sequenceNumber);
+
+    Operation operation;
+    operation.kind = Operation::REMOVE_WRITER_CHANGE;
+    operation.persistence_guid = persistence_guid;
+    operation.sequence_number = change.sequenceNumber;
+    queue(std::move(operation));
+    return true;
+}
+
+bool SQLite3AsyncPersistenceService::load_reader_from_storage(
+        const std::string& reader_guid,
+        foonathan::memory::map<GUID_t, SequenceNumber_t, IPersistenceService::map_allocator_t>& seq_map)
+{
+    flush();
+
+    std::lock_guard<std::mutex> lock(db_mutex_);
+    return sync_service_.load_reader_from_storage(reader_guid, seq_map);
+}
+
+bool SQLite3AsyncPersistenceService::update_writer_seq_on_storage(
+        const std::string& reader_guid,
+        const GUID_t& writer_guid,
+        const SequenceNumber_t& seq_number)
+{
+    logInfo(RTPS_PERSISTENCE, "Reader " << reader_guid << " queuing seq for writer " << writer_guid << " to " << seq_number);
+
+    Operation operation;
+    operation.kind = Operation::UPDATE_WRITER_SEQ;
+    operation.persistence_guid = reader_guid;
+    operation.writer_guid = writer_guid;
+    operation.sequence_number = seq_number;
+    queue(std::move(operation));
+    return true;
+}
+
+void SQLite3AsyncPersistenceService::flush()
+{
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    if (pending_.empty() && committing_.empty())
+    {
+        return;
+    }
+
+    flush_requested_ = true;
+    queue_cond_.notify_one();
+    flushed_cond_.wait(lock, [this]()
+            {
+                return pending_.empty() && committing_.empty();
+            });
+}
+
+void SQLite3AsyncPersistenceService::queue(Operation&& operation)
+{
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    pending_.push_back(std::move(operation));
+    if (pending_.size() >= max_pending_operations)
+    {
+        queue_cond_.notify_one();
+    }
+}
+
+void SQLite3AsyncPersistenceService::run()
+{
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    while (running_)
+    {
+        queue_cond_.wait_for(lock, flush_interval_, [this]()
+                {
+                    return !running_ || flush_requested_ || pending_.size() >= max_pending_operations;
+                });
+        commit_pending(lock);
+    }
+
+    // Commit whatever was queued before destruction
+    commit_pending(lock);
+}
+
+void SQLite3AsyncPersistenceService::commit_pending(std::unique_lock<std::mutex>& lock)
+{
+    flush_requested_ = false;
+
+    if (!pending_.empty())
+    {
+        committing_.swap(pending_);
+        lock.unlock();
+
+        {
+            std::lock_guard<std::mutex> db_lock(db_mutex_);
+            sqlite3_exec(db_, "BEGIN TRANSACTION;", 0, 0, 0);
+            for (const Operation& operation : committing_)
+            {
+                apply(operation);
+            }
+            if (sqlite3_exec(db_, "COMMIT TRANSACTION;", 0, 0, 0) != SQLITE_OK)
+            {
+                logError(RTPS_PERSISTENCE, "Error committing " << committing_.size() << " operations: " <<
+                        sqlite3_errmsg(db_));
+                sqlite3_exec(db_, "ROLLBACK TRANSACTION;", 0, 0, 0);
+            }
+        }
+
+        lock.lock();
+        committing_.clear();
+    }
+
+    flushed_cond_.notify_all();
+}
+
+void SQLite3AsyncPersistenceService::apply(const Operation& operation)
+{
+    bool ret_val = false;
+
+    switch (operation.kind)
+    {
+        case Operation::ADD_WRITER_CHANGE:
+            ret_val = sync_service_.add_writer_change_to_storage(operation.persistence_guid,
+                    operation.sequence_number, operation.instance, operation.payload.data(),
+                    static_cast<uint32_t>(operation.payload.size()));
+            break;
+
+        case Operation::REMOVE_WRITER_CHANGE:
+            ret_val = sync_service_.remove_writer_change_from_storage(operation.persistence_guid,
+                    operation.sequence_number);
+            break;
+
+        case Operation::UPDATE_WRITER_SEQ:
+            ret_val = sync_service_.update_writer_seq_on_storage(operation.persistence_guid,
+                    operation.writer_guid, operation.sequence_number);
+            break;
+    }
+
+    if (!ret_val)
+    {
+        logWarning(RTPS_PERSISTENCE, "Could not store operation for " << operation.persistence_guid <<
+                " and seq " << operation.sequence_number);
+    }
+}
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
@@ -0,0 +1,158 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+* @file SQLite3AsyncPersistenceService.h
+*/
+
+#ifndef SQLITE3ASYNCPERSISTENCESERVICE_H_
+#define SQLITE3ASYNCPERSISTENCESERVICE_H_
+
+#include "SQLite3PersistenceService.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+* Persistence service implementation over SQLite3 that stores data on a background thread.
+*
+* Operations are queued and committed in a single transaction every flush interval. Data not yet committed
+* is lost if the process crashes, so an operation returning true only means it has been queued.
+* Loading operations wait for all queued operations to be committed.
+* @ingroup RTPS_PERSISTENCE_MODULE
+*/
+class SQLite3AsyncPersistenceService : public IPersistenceService
+{
+public:
+    SQLite3AsyncPersistenceService(
+            sqlite3* db,
+            uint32_t flush_interval_ms);
+    virtual ~SQLite3AsyncPersistenceService() override;
+
+    /**
+     * Get all data stored for a writer.
+     * @param writer_guid GUID of the writer to load.
+     * @return True if operation was successful.
+     */
+    virtual bool load_writer_from_storage(
+            const std::string& persistence_guid,
+            const GUID_t& writer_guid,
+            std::vector<CacheChange_t*>& changes,
+            CacheChangePool* pool) final;
+
+    /**
+     * Queue a change to be added to storage.
+     * @param change The cache change to add.
+     * @return True if operation was queued.
+     */
+    virtual bool add_writer_change_to_storage(
+            const std::string& persistence_guid,
+            const CacheChange_t& change) final;
+
+    /**
+     * Queue a change to be removed from storage.
+     * @param change The cache change to remove.
+     * @return True if operation was queued.
+     */
+    virtual bool remove_writer_change_from_storage(
+            const std::string& persistence_guid,
+            const CacheChange_t& change) final;
+
+    /**
+     * Get all data stored for a reader.
+     * @param reader_guid GUID of the reader to load.
+     * @return True if operation was successful.
+     */
+    virtual bool load_reader_from_storage(
+            const std::string& reader_guid,
+            foonathan::memory::map<GUID_t, SequenceNumber_t, map_allocator_t>& seq_map) final;
+
+    /**
+     * Queue an update of the sequence number associated to a writer on a reader.
+     * @param reader_guid GUID of the reader to update.
+     * @param writer_guid GUID of the associated writer to update.
+     * @param seq_number New sequence number value to set for the associated writer.
+     * @return True if operation was queued.
+     */
+    virtual bool update_writer_seq_on_storage(
+            const std::string& reader_guid,
+            const GUID_t& writer_guid,
+            const SequenceNumber_t& seq_number) final;
+
+    /**
+     * Block until all queued operations have been committed.
+     */
+    void flush();
+
+private:
+
+    struct Operation
+    {
+        enum Kind
+        {
+            ADD_WRITER_CHANGE,
+            REMOVE_WRITER_CHANGE,
+            UPDATE_WRITER_SEQ
+        };
+
+        Kind kind;
+        //! Persistence GUID of the writer, or GUID of the reader.
+        std::string persistence_guid;
+        //! Remote writer GUID, only for UPDATE_WRITER_SEQ.
+        GUID_t writer_guid;
+        SequenceNumber_t sequence_number;
+        InstanceHandle_t instance;
+        std::vector<octet> payload;
+    };
+
+    void queue(Operation&& operation);
+
+    void run();
+
+    //! Commits the pending operations. Called with queue_mutex_ locked.
+    void commit_pending(std::unique_lock<std::mutex>& lock);
+
+    void apply(const Operation& operation);
+
+    sqlite3* db_;
+    SQLite3PersistenceService sync_service_;
+    //! Protects the statements of sync_service_.
+    std::mutex db_mutex_;
+
+    std::chrono::milliseconds flush_interval_;
+
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cond_;
+    std::condition_variable flushed_cond_;
+    std::vector<Operation> pending_;
+    std::vector<Operation> committing_;
+    bool flush_requested_;
+    bool running_;
+
+    std::thread thread_;
+};
+
+} /* namespace rtps */
+} /* namespace fastrtps */
+} /* namespace eprosima */
+
+#endif /* SQLITE3ASYNCPERSISTENCESERVICE_H_ */
@@ -18,6 +18,7 @@
  */
 
 #include "SQLite3PersistenceService.h"
+#include "SQLite3AsyncPersistenceService.h"
 #include <fastrtps/log/Log.h>
 #include <fastrtps/rtps/history/CacheChangePool.h>
 
@@ -29,7 +30,7 @@ namespace eprosima {
 namespace fastrtps{
 namespace rtps {
 
-static sqlite3* open_or_create_database(const char* filename)
+static sqlite3* open_or_create_database(const char* filename, bool use_wal = false)
 {
     sqlite3* db = NULL;
     int rc;
@@ -44,6 +45,17 @@ static sqlite3* open_or_create_database(const char* filename)
         return NULL;
     }
 
+    // Write-ahead logging lets readers and the committing thread work concurrently, and only syncs on checkpoints
+    if (use_wal)
+    {
+        rc = sqlite3_exec(db, "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;", 0, 0, 0);
+        if (rc != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return NULL;
+        }
+    }
+
     // Create tables if they don't exist
     const char* create_statement = R"(
 CREATE TABLE IF NOT EXISTS writers(
@@ -88,6 +100,14 @@ IPersistenceService* create_SQLite3_persistence_service(const char* filename)
     return (db == NULL) ? nullptr : new SQLite3PersistenceService(db);
 }
 
+IPersistenceService* create_SQLite3_async_persistence_service(
+        const char* filename,
+        uint32_t flush_interval_ms)
+{
+    sqlite3* db = open_or_create_database(filename, true);
+    return (db == NULL) ? nullptr : new SQLite3AsyncPersistenceService(db, flush_interval_ms);
+}
+
 SQLite3PersistenceService::SQLite3PersistenceService(sqlite3* db):
     db_(db),
     load_writer_stmt_(NULL),
@@ -175,20 +195,31 @@ bool SQLite3PersistenceService::add_writer_change_to_storage(
 {
     logInfo(RTPS_PERSISTENCE, "Writer " << change.writerGUID << " storing change for seq " << change.sequenceNumber);
 
+    return add_writer_change_to_storage(persistence_guid, change.sequenceNumber, change.instanceHandle,
+            change.serializedPayload.data, change.serializedPayload.length);
+}
+
+bool SQLite3PersistenceService::add_writer_change_to_storage(
+        const std::string& persistence_guid,
+        const SequenceNumber_t& seq_number,
+        const InstanceHandle_t& instance,
+        const octet* data,
+        uint32_t length)
+{
     if (add_writer_change_stmt_ != NULL)
     {
         sqlite3_reset(add_writer_change_stmt_);
         sqlite3_bind_text(add_writer_change_stmt_, 1, persistence_guid.c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_int64(add_writer_change_stmt_, 2, change.sequenceNumber.to64long());
-        if (change.instanceHandle.isDefined())
+        sqlite3_bind_int64(add_writer_change_stmt_, 2, seq_number.to64long());
+        if (instance.isDefined())
         {
-            sqlite3_bind_blob(add_writer_change_stmt_, 3, change.instanceHandle.value, 16, SQLITE_STATIC);
+            sqlite3_bind_blob(add_writer_change_stmt_, 3, instance.value, 16, SQLITE_STATIC);
         }
         else
         {
             sqlite3_bind_zeroblob(add_writer_change_stmt_, 3, 16);
         }
-        sqlite3_bind_blob(add_writer_change_stmt_, 4, change.serializedPayload.data, change.serializedPayload.length, SQLITE_STATIC);
+        sqlite3_bind_blob(add_writer_change_stmt_, 4, data, length, SQLITE_STATIC);
         return sqlite3_step(add_writer_change_stmt_) == SQLITE_DONE;
     }
 
@@ -206,11 +237,18 @@ bool SQLite3PersistenceService::remove_writer_change_from_storage(
 {
     logInfo(RTPS_PERSISTENCE, "Writer " << change.writerGUID << " removing change for seq " << change.sequenceNumber);
 
+    return remove_writer_change_from_storage(persistence_guid, change.sequenceNumber);
+}
+
+bool SQLite3PersistenceService::remove_writer_change_from_storage(
+        const std::string& persistence_guid,
+        const SequenceNumber_t& seq_number)
+{
     if (remove_writer_change_stmt_ != NULL)
     {
         sqlite3_reset(remove_writer_change_stmt_);
         sqlite3_bind_text(remove_writer_change_stmt_, 1, persistence_guid.c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_int64(remove_writer_change_stmt_, 2, change.sequenceNumber.to64long());
+        sqlite3_bind_int64(remove_writer_change_stmt_, 2, seq_number.to64long());
         return sqlite3_step(remove_writer_change_stmt_) == SQLITE_DONE;
     }
 
@@ -32,6 +32,16 @@ namespace rtps {
 */
 IPersistenceService* create_SQLite3_persistence_service(const char* filename);
 
+/**
+* Create a new SQLite3 implementation of persistence service that stores data asynchronously
+* @param filename Name of the database file.
+* @param flush_interval_ms Maximum time, in milliseconds, a change is kept in memory before being committed.
+* @ingroup RTPS_PERSISTENCE_MODULE
+*/
+IPersistenceService* create_SQLite3_async_persistence_service(
+        const char* filename,
+        uint32_t flush_interval_ms);
+
 
 /**
 * Persistence service implementation over SQLite3
@@ -93,6 +103,32 @@ public:
             const GUID_t& writer_guid,
             const SequenceNumber_t& seq_number) final;
 
+    /**
+     * Add a change to storage from its separate fields.
+     * @param persistence_guid Persistence GUID of the writer.
+     * @param seq_number Sequence number of the change.
+     * @param instance Instance handle of the change.
+     * @param data Serialized payload of the change.
+     * @param length Length of the serialized payload.
+     * @return True if operation was successful.
+     */
+    bool add_writer_change_to_storage(
+            const std::string& persistence_guid,
+            const SequenceNumber_t& seq_number,
+            const InstanceHandle_t& instance,
+            const octet* data,
+            uint32_t length);
+
+    /**
+     * Remove a change from storage given its sequence number.
+     * @param persistence_guid Persistence GUID of the writer.
+     * @param seq_number Sequence number of the change.
+     * @return True if operation was successful.
+     */
+    bool remove_writer_change_from_storage(
+            const std::string& persistence_guid,
+            const SequenceNumber_t& seq_number);
+
 private:
     sqlite3* db_;
 
@@ -16,31 +16,66 @@
 #include <fastrtps/rtps/common/CacheChange.h>
 #include <fastrtps/rtps/reader/RTPSReader.h>
 
+#include <algorithm>
+
 using namespace eprosima::fastrtps::rtps;
 
-CacheChange_t* FragmentedChangePitStop::process(CacheChange_t* incoming_change, uint32_t sampleSize, uint32_t fragmentStartingNum)
+static inline uint32_t lowest_bit_set(uint64_t bits)
 {
-    CacheChange_t* returnedValue = nullptr;
+#if _MSC_VER
+    unsigned long bit;
+    _BitScanForward64(&bit, bits);
+    return static_cast<uint32_t>(bit);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
+}
 
-    // Search CacheChange_t with the sample sequence number.
-    auto range = changes_.equal_range(ChangeInPit(incoming_change));
+void FragmentedChangePitStop::ChangeInPit::get_missing_fragments(FragmentNumberSet_t& missing) const
+{
+    // Skip the words of the bitmap whose fragments were all received.
+    size_t word = 0;
+    while (word < received_fragments_.size() && received_fragments_[word] == ~uint64_t(0))
+    {
+        ++word;
+    }
 
-    auto original_change_cit = range.first;
+    uint32_t index = word < received_fragments_.size() ?
+            static_cast<uint32_t>(word << 6) + lowest_bit_set(~received_fragments_[word]) : fragment_count_;
+    if (index >= fragment_count_)
+    {
+        missing.base(fragment_count_ + 1);
+        return;
+    }
 
-    // If there is a range, search the CacheChange_t with the same writer GUID_t.
-    if(original_change_cit != changes_.end())
+    // Fragment numbers start on 1.
+    missing.base(index + 1);
+    uint32_t last = std::min(fragment_count_, index + 256u);
+    for (; index < last; ++index)
     {
-        for(; original_change_cit != range.second; ++original_change_cit)
+        if (!is_received(index))
         {
-            if(original_change_cit->getChange()->writerGUID == incoming_change->writerGUID)
-                break;
+            missing.add(index + 1);
         }
     }
-    else
-        original_change_cit = range.second;
+}
+
+CacheChange_t* FragmentedChangePitStop::process(CacheChange_t* incoming_change, uint32_t sampleSize, uint32_t fragmentStartingNum)
+{
+    CacheChange_t* returnedValue = nullptr;
+
+    uint16_t fragment_size = incoming_change->getFragmentSize();
+    if (fragment_size == 0 || fragmentStartingNum == 0)
+    {
+        return nullptr;
+    }
+
+    // Search CacheChange_t with the sample writer GUID_t and sequence number.
+    ChangeKey key(incoming_change->writerGUID, incoming_change->sequenceNumber);
+    auto original_change_cit = changes_.find(key);
 
     // If not found an existing CacheChange_t, reserve one and insert.
-    if(original_change_cit == range.second)
+    if(original_change_cit == changes_.end())
     {
         CacheChange_t* original_change = nullptr;
 
@@ -57,57 +92,60 @@ CacheChange_t* FragmentedChangePitStop::process(CacheChange_t* incoming_change,
         original_change->copy_not_memcpy(incoming_change);
         // The length of the serialized payload has to be sample size.
         original_change->serializedPayload.length = sampleSize;
-        original_change->setFragmentSize(incoming_change->getFragmentSize());
+        original_change->setFragmentSize(fragment_size);
 
         // Insert
-        original_change_cit = changes_.insert(ChangeInPit(original_change));
+        original_change_cit = changes_.emplace(key, ChangeInPit(original_change,
+                    original_change->getFragmentCount())).first;
     }
 
-    bool was_updated = false;
-    for (uint32_t count = (fragmentStartingNum - 1); count < (fragmentStartingNum - 1) + incoming_change->getFragmentCount(); ++count)
+    ChangeInPit& pit = original_change_cit->second;
+    CacheChange_t* original_change = pit.getChange();
+
+    // Fragments of another size cannot be placed on the payload.
+    if (original_change->getFragmentSize() != fragment_size)
     {
-        if(original_change_cit->getChange()->getDataFragments()->at(count) == ChangeFragmentStatus_t::NOT_PRESENT)
-        {
-            size_t original_offset = size_t(count) * original_change_cit->getChange()->getFragmentSize();
-            size_t incoming_offset = size_t(count - (fragmentStartingNum - 1)) * incoming_change->getFragmentSize();
-
-            // All cases minus last fragment.
-            if (count + 1 != original_change_cit->getChange()->getFragmentCount())
-            {
-                memcpy(original_change_cit->getChange()->serializedPayload.data + original_offset,
-                        incoming_change->serializedPayload.data + incoming_offset,
-                        incoming_change->getFragmentSize());
-            }
-            // Last fragment is a special case when copying.
-            else
-            {
-                memcpy(original_change_cit->getChange()->serializedPayload.data + original_offset,
-                        incoming_change->serializedPayload.data + incoming_offset,
-                        original_change_cit->getChange()->serializedPayload.length - original_offset);
-            }
-
-            original_change_cit->getChange()->getDataFragments()->at(count) = ChangeFragmentStatus_t::PRESENT;
-
-            was_updated = true;
-        }
+        return nullptr;
     }
 
-    // If was updated, check if it is completed.
-    if(was_updated)
+    uint32_t first = fragmentStartingNum - 1;
+    uint32_t last = std::min(first + incoming_change->getFragmentCount(), pit.fragment_count());
+
+    // Fragments are consecutive on both payloads, so each run of not received fragments is copied at once.
+    uint32_t count = first;
+    while (count < last)
     {
-        auto fit = original_change_cit->getChange()->getDataFragments()->begin();
-        for(; fit != original_change_cit->getChange()->getDataFragments()->end(); ++fit)
+        if (pit.is_received(count))
         {
-            if(*fit == ChangeFragmentStatus_t::NOT_PRESENT)
-                break;
+            ++count;
+            continue;
         }
 
-        // If it is completed, return CacheChange_t and remove information.
-        if(fit == original_change_cit->getChange()->getDataFragments()->end())
+        uint32_t run_end = count;
+        do
         {
-            returnedValue = original_change_cit->getChange();
-            changes_.erase(original_change_cit);
-        }
+            pit.set_received(run_end);
+            ++run_end;
+        } while (run_end < last && !pit.is_received(run_end));
+
+        // Last fragment may be shorter than the others.
+        size_t original_offset = size_t(count) * fragment_size;
+        size_t incoming_offset = size_t(count - first) * fragment_size;
+        size_t run_size = std::min(size_t(run_end) * fragment_size,
+                size_t(original_change->serializedPayload.length)) - original_offset;
+        memcpy(original_change->serializedPayload.data + original_offset,
+                incoming_change->serializedPayload.data + incoming_offset,
+                run_size);
+
+        count = run_end;
+    }
+
+    // If it is completed, return CacheChange_t and remove information.
+    if (pit.missing_fragments() == 0)
+    {
+        returnedValue = original_change;
+        returnedValue->getDataFragments()->assign(pit.fragment_count(), ChangeFragmentStatus_t::PRESENT);
+        changes_.erase(original_change_cit);
     }
 
     return returnedValue;
@@ -115,53 +153,37 @@ CacheChange_t* FragmentedChangePitStop::process(CacheChange_t* incoming_change,
 
 CacheChange_t* FragmentedChangePitStop::find(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid)
 {
-    CacheChange_t* returnedValue = nullptr;
-
-    auto range = changes_.equal_range(ChangeInPit(sequence_number));
-
-    auto cit = range.first;
+    auto cit = changes_.find(ChangeKey(writer_guid, sequence_number));
+    return cit != changes_.end() ? cit->second.getChange() : nullptr;
+}
 
-    // If there is a range, search the CacheChange_t with the same writer GUID_t.
-    if(cit != changes_.end())
+bool FragmentedChangePitStop::get_missing_fragments(
+        const SequenceNumber_t& sequence_number,
+        const GUID_t& writer_guid,
+        FragmentNumberSet_t& missing) const
+{
+    auto cit = changes_.find(ChangeKey(writer_guid, sequence_number));
+    if (cit == changes_.end())
     {
-        for(; cit != range.second; ++cit)
-        {
-            if(cit->getChange()->writerGUID == writer_guid)
-            {
-                returnedValue = cit->getChange();
-                break;
-            }
-        }
+        return false;
     }
 
-    return returnedValue;
+    cit->second.get_missing_fragments(missing);
+    return true;
 }
 
 bool FragmentedChangePitStop::try_to_remove(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid)
 {
-    bool returnedValue = false;
-
-    auto range = changes_.equal_range(ChangeInPit(sequence_number));
-
-    auto cit = range.first;
-
-    // If there is a range, search the CacheChange_t with the same writer GUID_t.
-    if(cit != changes_.end())
+    auto cit = changes_.find(ChangeKey(writer_guid, sequence_number));
+    if (cit == changes_.end())
     {
-        for(; cit != range.second; ++cit)
-        {
-            if(cit->getChange()->writerGUID == writer_guid)
-            {
-                // Destroy CacheChange_t.
-                parent_->releaseCache(cit->getChange());
-                changes_.erase(cit);
-                returnedValue = true;
-                break;
-            }
-        }
+        return false;
     }
 
-    return returnedValue;
+    // Destroy CacheChange_t.
+    parent_->releaseCache(cit->second.getChange());
+    changes_.erase(cit);
+    return true;
 }
 
 bool FragmentedChangePitStop::try_to_remove_until(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid)
@@ -171,11 +193,11 @@ bool FragmentedChangePitStop::try_to_remove_until(const SequenceNumber_t& sequen
     auto cit = changes_.begin();
     while(cit != changes_.end())
     {
-        if(cit->getChange()->sequenceNumber < sequence_number &&
-                cit->getChange()->writerGUID == writer_guid)
+        if(cit->first.sequence_number_ < sequence_number &&
+                cit->first.writer_guid_ == writer_guid)
         {
             // Destroy CacheChange_t.
-            parent_->releaseCache(cit->getChange());
+            parent_->releaseCache(cit->second.getChange());
             cit = changes_.erase(cit);
             returnedValue = true;
         }
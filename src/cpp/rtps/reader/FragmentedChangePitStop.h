@@ -20,8 +20,10 @@
 
 #include <fastrtps/fastrtps_dll.h>
 #include <fastrtps/rtps/common/CacheChange.h>
+#include <fastrtps/rtps/common/FragmentNumber.h>
 
-#include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 namespace eprosima {
 namespace fastrtps {
@@ -38,6 +40,7 @@ class FragmentedChangePitStop
 {
     /*!
      * @brief Objects used by FragmentedChangePitStop internally.
+     * Keeps which fragments of a CacheChange_t have been received on a bitmap, with one bit per fragment.
      */
     class ChangeInPit
     {
@@ -45,57 +48,96 @@ class FragmentedChangePitStop
 
         /*!
          * @brief Relates a CacheChange_t with this ChangeInPit.
-         * This constructor has to be used if the ChangeInPit will be used to be stored in a container.
          * @param change Related CacheChange_t.
+         * @param fragment_count Number of fragments of the change.
          */
-        ChangeInPit(CacheChange_t* change)
-            : sequence_number_(change->sequenceNumber)
-            , change_(change)
+        ChangeInPit(
+                CacheChange_t* change,
+                uint32_t fragment_count)
+            : change_(change)
+            , fragment_count_(fragment_count)
+            , missing_fragments_(fragment_count)
+            , received_fragments_((fragment_count + 63u) / 64u, 0u)
         {
         }
 
+        CacheChange_t* getChange() const { return change_; }
+
+        uint32_t fragment_count() const { return fragment_count_; }
+
+        //! Number of fragments not received yet.
+        uint32_t missing_fragments() const { return missing_fragments_; }
+
         /*!
-         * @brief Constructor used to generated a simple key for searching in a container.
-         * @param sequence_number SequenceNumber_t used as key.
-         * @remarks Not use this constructor if the object will be stored in a container.
+         * @param index Zero-based index of the fragment.
+         * @return Whether the fragment was already received.
          */
-        ChangeInPit(const SequenceNumber_t &sequence_number)
-            : sequence_number_(sequence_number)
-            , change_(nullptr)
+        bool is_received(uint32_t index) const
         {
+            return (received_fragments_[index >> 6] & (uint64_t(1) << (index & 63u))) != 0;
         }
 
-        ChangeInPit(const ChangeInPit& cip)
-            : sequence_number_(cip.sequence_number_)
-            , change_(cip.change_)
+        /*!
+         * @brief Marks a fragment as received. It should not be already received.
+         * @param index Zero-based index of the fragment.
+         */
+        void set_received(uint32_t index)
         {
+            received_fragments_[index >> 6] |= uint64_t(1) << (index & 63u);
+            --missing_fragments_;
         }
 
-        CacheChange_t* getChange() const { return change_; }
+        /*!
+         * @brief Fills a FragmentNumberSet_t with the missing fragments, starting on the first one.
+         * @param missing FragmentNumberSet_t to fill.
+         */
+        void get_missing_fragments(FragmentNumberSet_t& missing) const;
 
-        bool operator==(const ChangeInPit& cip) const
+    private:
+
+        CacheChange_t* change_;
+        uint32_t fragment_count_;
+        uint32_t missing_fragments_;
+        std::vector<uint64_t> received_fragments_;
+    };
+
+    /*!
+     * @brief Identifies a change on the pit by its writer and sequence number.
+     */
+    struct ChangeKey
+    {
+        ChangeKey(
+                const GUID_t& writer_guid,
+                const SequenceNumber_t& sequence_number)
+            : writer_guid_(writer_guid)
+            , sequence_number_(sequence_number)
         {
-            return sequence_number_ == cip.sequence_number_;
         }
 
-    private:
-
-        ChangeInPit& operator=(const ChangeInPit& cip) = delete;
+        bool operator==(const ChangeKey& key) const
+        {
+            return sequence_number_ == key.sequence_number_ && writer_guid_ == key.writer_guid_;
+        }
 
-        const SequenceNumber_t sequence_number_;
-        CacheChange_t* change_;
+        GUID_t writer_guid_;
+        SequenceNumber_t sequence_number_;
+    };
 
-    public:
-        /*!
-         * @brief Defined the STD hash function for ChangeInPit.
-         */
-        struct ChangeInPitHash
+    /*!
+     * @brief Defined the STD hash function for ChangeKey.
+     */
+    struct ChangeKeyHash
+    {
+        std::size_t operator()(const ChangeKey& key) const
         {
-            std::size_t operator()(const ChangeInPit& cip) const
-            {
-                return SequenceNumberHash{}(cip.sequence_number_);
-            }
-        };
+            // Writers of the same participant only differ on their entity id.
+            const octet* entity = key.writer_guid_.entityId.value;
+            std::size_t entity_hash = (static_cast<std::size_t>(entity[0]) << 24) |
+                    (static_cast<std::size_t>(entity[1]) << 16) |
+                    (static_cast<std::size_t>(entity[2]) << 8) |
+                    static_cast<std::size_t>(entity[3]);
+            return SequenceNumberHash{}(key.sequence_number_) ^ (entity_hash << 8);
+        }
     };
 
     public:
@@ -126,6 +168,19 @@ CacheChange_t* process(CacheChange_t* incoming_change, uint32_t sampleSize, uint
  */
 CacheChange_t* find(const SequenceNumber_t& sequence_number, const GUID_t& writer_guid);
 
+/*!
+ * @brief Gets the fragments not received yet of a CacheChange_t waiting to be completed, giving SequenceNumber_t
+ * and writer GUID_t. Used to fill NACK_FRAG submessages.
+ * @param sequence_number SequenceNumber_t of the searched CacheChange_t.
+ * @param writer_guid writer GUID_t of the searched CacheChange_t.
+ * @param missing FragmentNumberSet_t where the missing fragments are stored, starting on the first one.
+ * @return True if the CacheChange_t was found.
+ */
+bool get_missing_fragments(
+        const SequenceNumber_t& sequence_number,
+        const GUID_t& writer_guid,
+        FragmentNumberSet_t& missing) const;
+
 /*!
  * @brief Checks if there is a CacheChange_t, giving SequenceNumber_t and writer GUID_t.
  * In case there is, it will be removed.
@@ -148,7 +203,7 @@ bool try_to_remove_until(const SequenceNumber_t& sequence_number, const GUID_t&
 
 private:
 
-std::unordered_multiset<ChangeInPit, ChangeInPit::ChangeInPitHash> changes_;
+std::unordered_map<ChangeKey, ChangeInPit, ChangeKeyHash> changes_;
 
 RTPSReader* parent_;
 
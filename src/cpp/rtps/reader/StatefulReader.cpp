@@ -286,6 +286,21 @@ bool StatefulReader::matched_writer_lookup(
     return returnedValue;
 }
 
+bool StatefulReader::acknowledgement_base(
+        const GUID_t& writer_guid,
+        SequenceNumber_t& seq_num)
+{
+    std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
+    WriterProxy* wp = nullptr;
+    if (!is_alive_ || !findWriterProxy(writer_guid, &wp))
+    {
+        return false;
+    }
+
+    seq_num = wp->available_changes_max() + 1;
+    return true;
+}
+
 bool StatefulReader::findWriterProxy(
         const GUID_t& writerGUID,
         WriterProxy** WP) const
@@ -382,15 +397,18 @@ bool StatefulReader::processDataMsg(CacheChange_t *change)
             {
                 logInfo(RTPS_MSG_IN,IDSTRING"MessageReceiver not add change "<<change_to_add->sequenceNumber);
                 releaseCache(change_to_add);
+                return false;
             }
         }
         else if (pWP != nullptr && getGuid().entityId == c_EntityId_SPDPReader)
         {
             mp_RTPSParticipant->assertRemoteRTPSParticipantLiveliness(change->writerGUID.guidPrefix);
         }
+
+        return true;
     }
 
-    return true;
+    return false;
 }
 
 bool StatefulReader::processDataFragMsg(
@@ -537,9 +555,11 @@ bool StatefulReader::processHeartbeatMsg(
             // Maybe now we have to notify user from new CacheChanges.
             NotifyChanges(writer);
         }
+
+        return true;
     }
 
-    return true;
+    return false;
 }
 
 bool StatefulReader::processGapMsg(
@@ -578,9 +598,11 @@ bool StatefulReader::processGapMsg(
 
         // Maybe now we have to notify user from new CacheChanges.
         NotifyChanges(pWP);
+
+        return true;
     }
 
-    return true;
+    return false;
 }
 
 bool StatefulReader::acceptMsgFrom(
@@ -696,7 +718,7 @@ bool StatefulReader::change_received(
             fragmentedChangePitStop_->try_to_remove_until(aux_change->sequenceNumber, proxGUID);
         }
 
-        NotifyChanges(prox);
+        NotifyChanges(prox, a_change);
 
         return ret;
     }
@@ -704,7 +726,9 @@ bool StatefulReader::change_received(
     return false;
 }
 
-void StatefulReader::NotifyChanges(WriterProxy* prox)
+void StatefulReader::NotifyChanges(
+        WriterProxy* prox,
+        CacheChange_t* received_change)
 {
     GUID_t proxGUID = prox->guid();
     update_last_notified(proxGUID, prox->available_changes_max());
@@ -713,8 +737,20 @@ void StatefulReader::NotifyChanges(WriterProxy* prox)
     {
         CacheChange_t* ch_to_give = nullptr;
 
-        if (mp_history->get_change(nextChangeToNotify, proxGUID, &ch_to_give))
+        if (received_change != nullptr && received_change->sequenceNumber == nextChangeToNotify)
+        {
+            ch_to_give = received_change;
+        }
+        else
         {
+            mp_history->get_change(nextChangeToNotify, proxGUID, &ch_to_give);
+        }
+
+        if (ch_to_give != nullptr)
+        {
+            // Made available before calling the listener, as it may take the change.
+            prox->change_made_available(ch_to_give);
+
             if (!ch_to_give->isRead)
             {
                 ++total_unread_;
@@ -746,53 +782,41 @@ bool StatefulReader::nextUntakenCache(
         return false;
     }
 
-    std::vector<CacheChange_t*> toremove;
-    bool takeok = false;
-    for(std::vector<CacheChange_t*>::iterator it = mp_history->changesBegin();
-            it!=mp_history->changesEnd();++it)
+    // Each proxy keeps its available changes in order, so only the first one of each writer is checked.
+    CacheChange_t* first_change = nullptr;
+    WriterProxy* first_writer = nullptr;
+    for (WriterProxy* wp : matched_writers_)
     {
-        WriterProxy* wp;
-        if(this->matched_writer_lookup((*it)->writerGUID, &wp))
+        CacheChange_t* candidate = wp->first_available_change();
+        if (candidate != nullptr &&
+                (first_change == nullptr || candidate->sourceTimestamp < first_change->sourceTimestamp))
         {
-            // TODO Revisar la comprobacion
-            SequenceNumber_t seq = wp->available_changes_max();
-            if(seq >= (*it)->sequenceNumber)
-            {
-                *change = *it;
-
-                if(!(*change)->isRead)
-                {
-                    if (0 < total_unread_)
-                    {
-                        --total_unread_;
-                    }
-                }
-
-                (*change)->isRead = true;
+            first_change = candidate;
+            first_writer = wp;
+        }
+    }
 
-                if(wpout !=nullptr)
-                    *wpout = wp;
+    if (first_change == nullptr)
+    {
+        return false;
+    }
 
-                takeok = true;
-                break;
-            }
-        }
-        else
-        {
-            toremove.push_back((*it));
-        }
+    if (!first_change->isRead && 0 < total_unread_)
+    {
+        --total_unread_;
     }
 
-    for(std::vector<CacheChange_t*>::iterator it = toremove.begin();
-            it!=toremove.end();++it)
+    first_change->isRead = true;
+    *change = first_change;
+
+    if (wpout != nullptr)
     {
-        logWarning(RTPS_READER,"Removing change "<<(*it)->sequenceNumber << " from " << (*it)->writerGUID << " because is no longer paired");
-        mp_history->remove_change(*it);
+        *wpout = first_writer;
     }
-    return takeok;
+
+    return true;
 }
 
-// TODO Porque elimina aqui y no cuando hay unpairing
 bool StatefulReader::nextUnreadCache(
         CacheChange_t** change,
         WriterProxy** wpout)
@@ -803,51 +827,70 @@ bool StatefulReader::nextUnreadCache(
         return false;
     }
 
-    std::vector<CacheChange_t*> toremove;
-    bool readok = false;
-    for(std::vector<CacheChange_t*>::iterator it = mp_history->changesBegin();
-            it!=mp_history->changesEnd();++it)
+    // Each proxy keeps a cursor to its first unread change, so read changes are not visited again.
+    CacheChange_t* first_change = nullptr;
+    WriterProxy* first_writer = nullptr;
+    for (WriterProxy* wp : matched_writers_)
     {
-        if((*it)->isRead)
-            continue;
-
-        WriterProxy* wp;
-        if(this->matched_writer_lookup((*it)->writerGUID,&wp))
+        CacheChange_t* candidate = wp->first_unread_change();
+        if (candidate != nullptr &&
+                (first_change == nullptr || candidate->sourceTimestamp < first_change->sourceTimestamp))
         {
-            SequenceNumber_t seq;
-            seq = wp->available_changes_max();
-            if(seq >= (*it)->sequenceNumber)
-            {
-                *change = *it;
+            first_change = candidate;
+            first_writer = wp;
+        }
+    }
 
-                if (0 < total_unread_)
-                {
-                    --total_unread_;
-                }
+    if (first_change == nullptr)
+    {
+        return false;
+    }
 
-                (*change)->isRead = true;
+    if (0 < total_unread_)
+    {
+        --total_unread_;
+    }
 
-                if(wpout !=nullptr)
-                    *wpout = wp;
+    first_change->isRead = true;
+    *change = first_change;
 
-                readok = true;
-                break;
-            }
-        }
-        else
-        {
-            toremove.push_back((*it));
-        }
+    if (wpout != nullptr)
+    {
+        *wpout = first_writer;
+    }
+
+    return true;
+}
+
+bool StatefulReader::readCache(
+        CacheChange_t* change,
+        WriterProxy** wpout)
+{
+    std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
+    if (!is_alive_)
+    {
+        return false;
     }
 
-    for(std::vector<CacheChange_t*>::iterator it = toremove.begin();
-            it!=toremove.end();++it)
+    WriterProxy* wp = nullptr;
+    if (!findWriterProxy(change->writerGUID, &wp) || wp->available_changes_max() < change->sequenceNumber)
+    {
+        return false;
+    }
+
+    if (!change->isRead && 0 < total_unread_)
+    {
+        --total_unread_;
+    }
+
+    change->isRead = true;
+
+    if (wpout != nullptr)
     {
-        logWarning(RTPS_READER,"Removing change "<<(*it)->sequenceNumber << " from " << (*it)->writerGUID << " because is no longer paired");
-        mp_history->remove_change(*it);
+        *wpout = wp;
     }
 
-    return readok;
+    return true;
 }
 
 bool StatefulReader::updateTimes(const ReaderTimes& ti)
@@ -924,8 +967,8 @@ void StatefulReader::send_acknack(
     }
 
     SequenceNumberSet_t missing_changes = writer->missing_changes();
-    // Stores missing changes but there is some fragments received.
-    std::vector<CacheChange_t*> uncompleted_changes;
+    // Stores missing changes but there is some fragments received, together with their missing fragments.
+    std::vector<std::pair<SequenceNumber_t, FragmentNumberSet_t>> uncompleted_changes;
 
     try
     {
@@ -934,13 +977,13 @@ void StatefulReader::send_acknack(
         {
             GUID_t guid = sender.remote_guids().at(0);
             SequenceNumberSet_t sns(writer->available_changes_max() + 1);
+            FragmentNumberSet_t frag_sns;
 
             missing_changes.for_each(
                 [&](const SequenceNumber_t& seq)
                 {
                     // Check if the CacheChange_t is uncompleted.
-                    CacheChange_t* uncomplete_change = findCacheInFragmentedCachePitStop(seq, guid);
-                    if (uncomplete_change == nullptr)
+                    if (!fragmentedChangePitStop_->get_missing_fragments(seq, guid, frag_sns))
                     {
                         if (!sns.add(seq))
                         {
@@ -950,7 +993,7 @@ void StatefulReader::send_acknack(
                     }
                     else
                     {
-                        uncompleted_changes.push_back(uncomplete_change);
+                        uncompleted_changes.emplace_back(seq, frag_sns);
                     }
 
                 });
@@ -963,43 +1006,12 @@ void StatefulReader::send_acknack(
         }
 
         // Now generage NACK_FRAGS
-        if (!uncompleted_changes.empty())
+        for (auto& uncompleted : uncompleted_changes)
         {
-            for (auto cit : uncompleted_changes)
-            {
-                FragmentNumberSet_t frag_sns;
-
-                //  Search first fragment not present.
-                uint32_t frag_num = 0;
-                auto fit = cit->getDataFragments()->begin();
-                for (; fit != cit->getDataFragments()->end(); ++fit)
-                {
-                    ++frag_num;
-                    if (*fit == ChangeFragmentStatus_t::NOT_PRESENT)
-                        break;
-                }
-
-                // Never should happend.
-                assert(frag_num != 0);
-                assert(fit != cit->getDataFragments()->end());
-
-                // Store FragmentNumberSet_t base.
-                frag_sns.base(frag_num);
+            ++nackfrag_count_;
+            logInfo(RTPS_READER, "Sending NACKFRAG for sample" << uncompleted.first << ": " << uncompleted.second;);
 
-                // Fill the FragmentNumberSet_t bitmap.
-                for (; fit != cit->getDataFragments()->end(); ++fit)
-                {
-                    if (*fit == ChangeFragmentStatus_t::NOT_PRESENT)
-                        frag_sns.add(frag_num);
-
-                    ++frag_num;
-                }
-
-                ++nackfrag_count_;
-                logInfo(RTPS_READER, "Sending NACKFRAG for sample" << cit->sequenceNumber << ": " << frag_sns;);
-
-                group.add_nackfrag(cit->sequenceNumber, frag_sns, nackfrag_count_);
-            }
+            group.add_nackfrag(uncompleted.first, uncompleted.second, nackfrag_count_);
         }
     }
     catch(const RTPSMessageGroup::timeout&)
@@ -1009,9 +1021,10 @@ void StatefulReader::send_acknack(
 }
 
 bool StatefulReader::send_sync_nts(
-        CDRMessage_t* message,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
         const Locator_t& locator,
         std::chrono::steady_clock::time_point& max_blocking_time_point)
 {
-    return mp_RTPSParticipant->sendSync(message, locator, max_blocking_time_point);
+    return mp_RTPSParticipant->sendSync(buffers, total_bytes, locator, max_blocking_time_point);
 }
@@ -237,6 +237,23 @@ bool StatelessReader::nextUnreadCache(
 }
 
 
+bool StatelessReader::readCache(
+        CacheChange_t* change,
+        WriterProxy** /*wpout*/)
+{
+    std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
+    if (!change->isRead)
+    {
+        if (0 < total_unread_)
+        {
+            --total_unread_;
+        }
+    }
+
+    change->isRead = true;
+    return true;
+}
+
 bool StatelessReader::change_removed_by_history(
         CacheChange_t* ch,
         WriterProxy* /*prox*/)
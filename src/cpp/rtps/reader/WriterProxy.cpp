@@ -32,6 +32,8 @@
 #include <foonathan/memory/namespace_alias.hpp>
 #include <fastrtps/utils/collections/foonathan_memory_helpers.hpp>
 
+#include <algorithm>
+
 #if !defined(NDEBUG) && defined(FASTRTPS_SOURCE) && defined(__linux__)
 #include <sys/syscall.h>
 #include <unistd.h>
@@ -120,9 +122,13 @@ WriterProxy::WriterProxy(
             changes_node_size,
             memory_pool_block_size<pool_allocator_t>(changes_node_size, changes_allocation))
     , changes_from_writer_(changes_pool_)
+    , read_changes_(0)
     , guid_as_vector_(ResourceLimitedContainerConfig::fixed_size_configuration(1u))
     , guid_prefix_as_vector_(ResourceLimitedContainerConfig::fixed_size_configuration(1u))
 {
+    // Available changes are on the reader's history, whose limits also size changes_allocation.
+    available_changes_.reserve(changes_allocation.initial);
+
     //Create Events
     heartbeat_response_ = new TimedEvent(reader_->getRTPSParticipant()->getEventResource(),
             [&](TimedEvent::EventCode code) -> bool
@@ -191,6 +197,8 @@ void WriterProxy::clear()
     changes_from_writer_.clear();
     last_notified_ = SequenceNumber_t();
     changes_from_writer_low_mark_ = last_notified_;
+    available_changes_.clear();
+    read_changes_ = 0;
 }
 
 void WriterProxy::loaded_from_storage(const SequenceNumber_t& seq_num)
@@ -440,6 +448,21 @@ void WriterProxy::change_removed_from_history(const SequenceNumber_t& seq_num)
     assert(get_mutex_owner() == get_thread_id());
 #endif
 
+    // Changes are usually removed in the same order they were made available.
+    auto available_it = std::find_if(available_changes_.begin(), available_changes_.end(),
+            [&seq_num](const CacheChange_t* change)
+            {
+                return change->sequenceNumber == seq_num;
+            });
+    if (available_it != available_changes_.end())
+    {
+        if (static_cast<size_t>(available_it - available_changes_.begin()) < read_changes_)
+        {
+            --read_changes_;
+        }
+        available_changes_.erase(available_it);
+    }
+
     // Check sequence number is in the container, because it was not clean up.
     if (seq_num <= changes_from_writer_low_mark_)
     {
@@ -461,6 +484,32 @@ void WriterProxy::change_removed_from_history(const SequenceNumber_t& seq_num)
     ch.notValid();
 }
 
+void WriterProxy::change_made_available(CacheChange_t* change)
+{
+#if defined(__DEBUG) && defined(__linux__)
+    assert(get_mutex_owner() == get_thread_id());
+#endif
+
+    assert(available_changes_.empty() || available_changes_.back()->sequenceNumber < change->sequenceNumber);
+    available_changes_.push_back(change);
+}
+
+CacheChange_t* WriterProxy::first_available_change() const
+{
+    return available_changes_.empty() ? nullptr : available_changes_.front();
+}
+
+CacheChange_t* WriterProxy::first_unread_change()
+{
+    // Every change before read_changes_ has been read, so the search resumes from there.
+    while (read_changes_ < available_changes_.size() && available_changes_[read_changes_]->isRead)
+    {
+        ++read_changes_;
+    }
+
+    return read_changes_ < available_changes_.size() ? available_changes_[read_changes_] : nullptr;
+}
+
 void WriterProxy::cleanup()
 {
     ChangeIterator chit = changes_from_writer_.begin();
@@ -610,12 +659,13 @@ void WriterProxy::update_heartbeat_response_interval(const Duration_t& interval)
 }
 
 bool WriterProxy::send(
-        CDRMessage_t* message,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
         std::chrono::steady_clock::time_point& max_blocking_time_point) const
 {
     for (const Locator_t& locator : remote_locators_shrinked())
     {
-        if (!reader_->send_sync_nts(message, locator, max_blocking_time_point))
+        if (!reader_->send_sync_nts(buffers, total_bytes, locator, max_blocking_time_point))
         {
             return false;
         }
@@ -26,6 +26,7 @@
 #include <fastrtps/rtps/attributes/ReaderAttributes.h>
 #include <fastrtps/rtps/attributes/RTPSParticipantAllocationAttributes.hpp>
 #include <fastrtps/rtps/messages/RTPSMessageSenderInterface.hpp>
+#include <fastrtps/utils/collections/HeadIndexedVector.hpp>
 #include <fastrtps/utils/collections/ResourceLimitedVector.hpp>
 #include <fastrtps/rtps/builtin/data/WriterProxyData.h>
 
@@ -133,6 +134,25 @@ public:
      */
     void change_removed_from_history(const SequenceNumber_t& seq_num);
 
+    /**
+     * Called when a change of this writer on the reader's history is made available to the user.
+     * Changes should be informed in sequence number order.
+     * @param change Pointer to the change made available.
+     */
+    void change_made_available(CacheChange_t* change);
+
+    /**
+     * Get the first change of this writer on the reader's history available to the user.
+     * @return Pointer to the change, nullptr if there is no change available.
+     */
+    CacheChange_t* first_available_change() const;
+
+    /**
+     * Get the first change of this writer on the reader's history available to the user and not read yet.
+     * @return Pointer to the change, nullptr if all the available changes were read.
+     */
+    CacheChange_t* first_unread_change();
+
     /**
      * Check if this proxy has any missing change.
      * @return true when there is at least one missing change on this proxy.
@@ -301,11 +321,13 @@ public:
     /**
      * Send a message through this interface.
      *
-     * @param message Pointer to the buffer with the message already serialized.
+     * @param buffers List of slices that make up the message, already serialized.
+     * @param total_bytes Sum of the sizes of all the slices.
      * @param max_blocking_time_point Future timepoint where blocking send should end.
      */
     virtual bool send(
-            CDRMessage_t* message,
+            const std::vector<NetworkBuffer>& buffers,
+            uint32_t total_bytes,
             std::chrono::steady_clock::time_point& max_blocking_time_point) const override;
 
 private:
@@ -355,6 +377,10 @@ private:
     SequenceNumber_t changes_from_writer_low_mark_;
     //! Store last ChacheChange_t notified.
     SequenceNumber_t last_notified_;
+    //! Changes on the reader's history already notified, ordered by sequence number. Taken from the front.
+    HeadIndexedVector<CacheChange_t*> available_changes_;
+    //! Number of changes at the beginning of available_changes_ known to be read.
+    size_t read_changes_;
     //!To fool RTPSMessageGroup when using this proxy as single destination
     ResourceLimitedVector<GUID_t> guid_as_vector_;
     //!To fool RTPSMessageGroup when using this proxy as single destination
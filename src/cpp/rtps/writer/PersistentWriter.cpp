@@ -37,8 +37,13 @@ PersistentWriter::PersistentWriter(GUID_t& guid,WriterAttributes& att,WriterHist
      ss << p_guid;
      persistence_guid_ = ss.str();
 
-     if (persistence_->load_writer_from_storage(persistence_guid_, guid, hist->m_changes, &(hist->m_changePool)))
+     std::vector<CacheChange_t*> changes;
+     if (persistence_->load_writer_from_storage(persistence_guid_, guid, changes, &(hist->m_changePool)))
      {
+         for (CacheChange_t* change : changes)
+         {
+             hist->m_changes.push_back(change);
+         }
          hist->updateMaxMinSeqNum();
          CacheChange_t* max_change;
          if (hist->get_max_change(&max_change))
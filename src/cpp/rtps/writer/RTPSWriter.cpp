@@ -24,6 +24,7 @@
 #include "../participant/RTPSParticipantImpl.h"
 #include "../flowcontrol/FlowController.h"
 
+#include <algorithm>
 #include <mutex>
 
 namespace eprosima {
@@ -231,7 +232,8 @@ bool RTPSWriter::encrypt_cachechange(CacheChange_t* change)
             +20 /*SecureDataHeader*/ + 4 + ((2 * 16) /*EVP_MAX_IV_LENGTH max block size*/ - 1) /* SecureDataBodey*/
             + 16 + 4 /*SecureDataTag*/ &&
             (mp_history->m_att.memoryPolicy == MemoryManagementPolicy_t::PREALLOCATED_WITH_REALLOC_MEMORY_MODE ||
-                mp_history->m_att.memoryPolicy == MemoryManagementPolicy_t::DYNAMIC_RESERVE_MEMORY_MODE))
+                mp_history->m_att.memoryPolicy == MemoryManagementPolicy_t::DYNAMIC_RESERVE_MEMORY_MODE ||
+                mp_history->m_att.memoryPolicy == MemoryManagementPolicy_t::SIZE_CLASS_MEMORY_MODE))
         {
             encrypt_payload_.data = (octet*)realloc(encrypt_payload_.data, change->serializedPayload.length +
                     // In future v2 changepool is in writer, and writer set this value to cachechagepool.
@@ -291,22 +293,29 @@ const std::vector<GUID_t>& RTPSWriter::remote_guids() const
 }
 
 bool RTPSWriter::send(
-        CDRMessage_t* message,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
         std::chrono::steady_clock::time_point& max_blocking_time_point) const
 {
-    bool ret_val = true;
+    send_locators_.clear();
+    locator_selector_.for_each([this](const Locator_t& loc)
+            {
+                send_locators_.push_back(loc);
+            });
 
-    RTPSParticipantImpl* participant = getRTPSParticipant();
-    locator_selector_.for_each(
-        [participant, message, & max_blocking_time_point, & ret_val](const Locator_t& loc)
-        {
-            if(ret_val)
+    if (send_locators_.empty())
+    {
+        return true;
+    }
+
+    // Transports get the destinations of their kind in a single call, so they can send the datagrams at once.
+    std::sort(send_locators_.begin(), send_locators_.end(), [](const Locator_t& a, const Locator_t& b)
             {
-                ret_val = participant->sendSync(message, loc, max_blocking_time_point);
-            }
-        });
+                return a.kind < b.kind;
+            });
 
-    return ret_val;
+    return getRTPSParticipant()->sendSync(buffers, total_bytes, send_locators_.data(), send_locators_.size(),
+                   max_blocking_time_point);
 }
 
 const LivelinessQosPolicyKind& RTPSWriter::get_liveliness_kind() const
@@ -22,7 +22,11 @@
 #include <fastrtps/rtps/common/SequenceNumber.h>
 #include <fastrtps/rtps/common/FragmentNumber.h>
 #include <fastrtps/rtps/common/CacheChange.h>
+#include <fastrtps/utils/collections/ResourceLimitedVector.hpp>
 
+#include <algorithm>
+#include <deque>
+#include <utility>
 #include <vector>
 #include <cassert>
 
@@ -30,6 +34,14 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+/**
+ * Collects the changes (or fragments of changes) a writer has pending to send, together with the remote readers
+ * each of them is addressed to, ordered by sequence number and fragment number.
+ *
+ * Items are kept in a pool that is never shrunk, and the ordering is kept on a vector of pointers to them.
+ * A collector is meant to be reused across calls by calling clear(), so once it has grown up to the
+ * high-water mark of pending changes, collecting and popping items performs no dynamic allocations.
+ */
 template<class T>
 class RTPSWriterCollector
 {
@@ -37,14 +49,13 @@ class RTPSWriterCollector
 
         struct Item
         {
-            Item(SequenceNumber_t seqNum, FragmentNumber_t fragNum,
-                    CacheChange_t* c) : sequenceNumber(seqNum),
-                                        fragmentNumber(fragNum),
-                                        cacheChange(c)
-
+            Item(const ResourceLimitedContainerConfig& readers_allocation)
+                : fragmentNumber(0)
+                , cacheChange(nullptr)
+                , remoteReaders(readers_allocation)
             {
-                assert(seqNum == c->sequenceNumber);
             }
+
             //! Sequence number of the CacheChange.
             SequenceNumber_t sequenceNumber;
             /*!
@@ -55,74 +66,146 @@ class RTPSWriterCollector
 
             CacheChange_t* cacheChange;
 
-            mutable std::vector<T> remoteReaders;
+            ResourceLimitedVector<T> remoteReaders;
         };
 
-        struct ItemCmp
+        typedef std::vector<Item*> ItemList;
+        typedef typename ItemList::iterator iterator;
+
+        /**
+         * Constructor.
+         * @param readers_allocation Allocation configuration for the list of remote readers of each item.
+         * @param initial_items Number of items to preallocate.
+         */
+        RTPSWriterCollector(
+                const ResourceLimitedContainerConfig& readers_allocation = ResourceLimitedContainerConfig(),
+                size_t initial_items = 0)
+            : mReadersAllocation_(readers_allocation)
+            , mUsedItems_(0)
+            , mFirst_(0)
         {
-            bool operator()(const Item& a, const Item& b) const
+            for(size_t n = 0; n < initial_items; ++n)
             {
-                if(a.sequenceNumber < b.sequenceNumber)
-                    return true;
-                else if(a.sequenceNumber == b.sequenceNumber)
-                    if(a.fragmentNumber < b.fragmentNumber)
-                        return true;
-
-                return false;
+                mPool_.emplace_back(mReadersAllocation_);
             }
-        };
-
-        typedef std::set<Item, ItemCmp> ItemSet;
+            mOrder_.reserve(initial_items);
+        }
 
-        void add_change(CacheChange_t* change, const T& remoteReader, const FragmentNumberSet_t optionalFragmentsNotSent)
+        void add_change(CacheChange_t* change, const T& remoteReader, const FragmentNumberSet_t& optionalFragmentsNotSent)
         {
             if(change->getFragmentSize() > 0)
             {
-                optionalFragmentsNotSent.for_each([this, change, remoteReader](FragmentNumber_t sn)
+                optionalFragmentsNotSent.for_each([this, change, &remoteReader](FragmentNumber_t sn)
                 {
                     assert(sn <= change->getDataFragments()->size());
-                    auto it = mItems_.emplace(change->sequenceNumber, sn, change);
-                    it.first->remoteReaders.push_back(remoteReader);
+                    add_item(change, sn, remoteReader);
                 });
             }
             else
             {
-                auto it = mItems_.emplace(change->sequenceNumber, 0, change);
-                it.first->remoteReaders.push_back(remoteReader);
+                add_item(change, 0, remoteReader);
             }
         }
 
-        bool empty()
+        bool empty() const
         {
-            return mItems_.empty();
+            return mFirst_ == mOrder_.size();
         }
 
-        size_t size()
+        size_t size() const
         {
-            return mItems_.size();
+            return mOrder_.size() - mFirst_;
         }
 
-        Item pop()
+        /**
+         * Removes the first item of the collection.
+         * @return Reference to the removed item. It remains valid until the collector is cleared.
+         */
+        Item& pop()
         {
-            auto it = mItems_.begin();
-            Item ret = *it;
-            mItems_.erase(it);
-            return ret;
+            assert(!empty());
+            return *mOrder_[mFirst_++];
         }
 
+        //! Removes all items, keeping the allocated resources for reuse.
         void clear()
         {
-            return mItems_.clear();
+            mOrder_.clear();
+            mUsedItems_ = 0;
+            mFirst_ = 0;
         }
 
-        ItemSet& items()
+        //! @return Iterator to the first pending item.
+        iterator begin()
         {
-            return mItems_;
+            return mOrder_.begin() + mFirst_;
+        }
+
+        //! @return Iterator past the last pending item.
+        iterator end()
+        {
+            return mOrder_.end();
+        }
+
+        //! Removes pending items in the range [first, last).
+        void erase(iterator first, iterator last)
+        {
+            mOrder_.erase(first, last);
         }
 
     private:
 
-        ItemSet mItems_;
+        static bool item_less(const Item* item, const std::pair<SequenceNumber_t, FragmentNumber_t>& key)
+        {
+            return item->sequenceNumber < key.first ||
+                (item->sequenceNumber == key.first && item->fragmentNumber < key.second);
+        }
+
+        void add_item(CacheChange_t* change, FragmentNumber_t fragNum, const T& remoteReader)
+        {
+            const std::pair<SequenceNumber_t, FragmentNumber_t> key(change->sequenceNumber, fragNum);
+            iterator it = end();
+
+            // Readers usually traverse their changes in order, so most items are appended or found at the back.
+            if(!empty() && !item_less(mOrder_.back(), key))
+            {
+                it = std::lower_bound(begin(), end(), key, item_less);
+            }
+
+            if(it == end() || (*it)->sequenceNumber != key.first || (*it)->fragmentNumber != key.second)
+            {
+                it = mOrder_.insert(it, get_free_item(change, fragNum));
+            }
+
+            // Readers list is limited as the matched readers of the writer, so there is always room here.
+            (*it)->remoteReaders.push_back(remoteReader);
+        }
+
+        Item* get_free_item(CacheChange_t* change, FragmentNumber_t fragNum)
+        {
+            if(mUsedItems_ == mPool_.size())
+            {
+                mPool_.emplace_back(mReadersAllocation_);
+            }
+
+            Item* item = &mPool_[mUsedItems_++];
+            item->sequenceNumber = change->sequenceNumber;
+            item->fragmentNumber = fragNum;
+            item->cacheChange = change;
+            item->remoteReaders.clear();
+            return item;
+        }
+
+        //! Allocation configuration for the list of remote readers of each item.
+        ResourceLimitedContainerConfig mReadersAllocation_;
+        //! Storage of items. A deque is used so pointers to items are not invalidated when growing.
+        std::deque<Item> mPool_;
+        //! Number of items of the pool currently in use.
+        size_t mUsedItems_;
+        //! Items in use, ordered by sequence number and fragment number.
+        ItemList mOrder_;
+        //! Position on mOrder_ of the next item to be popped.
+        size_t mFirst_;
 };
 
 } // namespace rtps
@@ -108,30 +108,21 @@ bool ReaderLocator::stop(const GUID_t& remote_guid)
 }
 
 bool ReaderLocator::send(
-        CDRMessage_t* message,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
         std::chrono::steady_clock::time_point& max_blocking_time_point) const
 {
     if (locator_info_.remote_guid != c_Guid_Unknown)
     {
         if (locator_info_.unicast.size() > 0)
         {
-            for (const Locator_t& locator : locator_info_.unicast)
-            {
-                if (!owner_->sendSync(message, locator, max_blocking_time_point))
-                {
-                    return false;
-                }
-            }
+            return owner_->sendSync(buffers, total_bytes, &locator_info_.unicast[0], locator_info_.unicast.size(),
+                    max_blocking_time_point);
         }
-        else
+        else if (locator_info_.multicast.size() > 0)
         {
-            for (const Locator_t& locator : locator_info_.multicast)
-            {
-                if (!owner_->sendSync(message, locator, max_blocking_time_point))
-                {
-                    return false;
-                }
-            }
+            return owner_->sendSync(buffers, total_bytes, &locator_info_.multicast[0],
+                    locator_info_.multicast.size(), max_blocking_time_point);
         }
     }
 
@@ -30,6 +30,7 @@
 #include <mutex>
 #include <cassert>
 #include <algorithm>
+#include <limits>
 
 #include "../history/HistoryAttributesExtension.hpp"
 
@@ -37,6 +38,35 @@ namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+static inline size_t lowest_bit_set(uint64_t bits)
+{
+#if _MSC_VER
+    unsigned long bit;
+    _BitScanForward64(&bit, bits);
+    return static_cast<size_t>(bit);
+#else
+    return static_cast<size_t>(__builtin_ctzll(bits));
+#endif
+}
+
+static inline size_t ring_size_for(uint64_t min_slots)
+{
+    // Bitmaps are handled by 64-bit words, so the ring never has less slots than a word.
+    size_t size = 64u;
+    while (size < min_slots)
+    {
+        size <<= 1;
+    }
+    return size;
+}
+
+static inline bool sequence_number_before(
+        const ChangeForReader_t& change,
+        const SequenceNumber_t& seq_num)
+{
+    return change.getSequenceNumber() < seq_num;
+}
+
 ReaderProxy::ReaderProxy(
         const WriterTimes& times,
         const RemoteLocatorsAllocationAttributes& loc_alloc,
@@ -45,7 +75,11 @@ ReaderProxy::ReaderProxy(
     , locator_info_(writer->getRTPSParticipant(), loc_alloc.max_unicast_locators, loc_alloc.max_multicast_locators)
     , reader_attributes_(loc_alloc.max_unicast_locators, loc_alloc.max_multicast_locators)
     , writer_(writer)
-    , changes_for_reader_(resource_limits_from_history(writer->mp_history->m_att, 0))
+    , is_local_reader_(false)
+    , local_reader_(nullptr)
+    , present_count_(0)
+    , changes_head_(0)
+    , changes_span_(0)
     , nack_supression_event_(nullptr)
     , timers_enabled_(false)
     , last_acknack_count_(0)
@@ -63,6 +97,20 @@ ReaderProxy::ReaderProxy(
             },
             TimeConv::Time_t2MilliSecondsDouble(times.nackSupressionDuration));
 
+    ResourceLimitedContainerConfig limits = resource_limits_from_history(writer->mp_history->m_att, 0);
+    size_t initial_slots = ring_size_for(limits.initial);
+    max_ring_slots_ = 0;
+    if (limits.maximum < std::numeric_limits<size_t>::max())
+    {
+        max_ring_slots_ = std::max(initial_slots, ring_size_for(limits.maximum));
+    }
+    changes_for_reader_.resize(initial_slots);
+    present_bits_.resize(initial_slots / 64u);
+    for (std::vector<uint64_t>& bits : status_bits_)
+    {
+        bits.resize(initial_slots / 64u);
+    }
+
     stop();
 }
 
@@ -75,7 +123,9 @@ ReaderProxy::~ReaderProxy()
     }
 }
 
-void ReaderProxy::start(const ReaderProxyData& reader_attributes)
+void ReaderProxy::start(
+        const ReaderProxyData& reader_attributes,
+        RTPSReader* local_reader)
 {
     locator_info_.start(
         reader_attributes.guid(),
@@ -85,6 +135,8 @@ void ReaderProxy::start(const ReaderProxyData& reader_attributes)
 
     is_active_ = true;
     reader_attributes_ = reader_attributes;
+    is_local_reader_ = local_reader != nullptr;
+    local_reader_ = local_reader;
 
     timers_enabled_.store(reader_attributes_.m_qos.m_reliability.kind == RELIABLE_RELIABILITY_QOS);
 
@@ -115,9 +167,21 @@ void ReaderProxy::stop()
     locator_info_.stop(reader_attributes_.guid());
     is_active_ = false;
     reader_attributes_.guid(c_Guid_Unknown);
+    is_local_reader_ = false;
+    local_reader_ = nullptr;
     disable_timers();
 
-    changes_for_reader_.clear();
+    std::fill(present_bits_.begin(), present_bits_.end(), 0u);
+    for (std::vector<uint64_t>& bits : status_bits_)
+    {
+        std::fill(bits.begin(), bits.end(), 0u);
+    }
+    std::fill(std::begin(status_count_), std::end(status_count_), 0u);
+    present_count_ = 0;
+    sparse_changes_.clear();
+    changes_head_ = 0;
+    changes_span_ = 0;
+    changes_base_ = SequenceNumber_t();
     last_acknack_count_ = 0;
     last_nackfrag_count_ = 0;
     changes_low_mark_ = SequenceNumber_t();
@@ -165,11 +229,12 @@ void ReaderProxy::add_change(
         const ChangeForReader_t& change)
 {
     assert(change.getSequenceNumber() > changes_low_mark_);
-    assert(changes_for_reader_.empty() ? true :
-        change.getSequenceNumber() > changes_for_reader_.back().getSequenceNumber());
+    assert(0 == present_count_ ?
+        sparse_changes_.empty() || change.getSequenceNumber() > sparse_changes_.back().getSequenceNumber() :
+        change.getSequenceNumber() >= changes_base_ + static_cast<uint32_t>(changes_span_));
 
     // For best effort readers, changes are acked when being sent
-    if (changes_for_reader_.empty() && change.getStatus() == ACKNOWLEDGED)
+    if (!has_changes() && change.getStatus() == ACKNOWLEDGED)
     {
         changes_low_mark_ = change.getSequenceNumber();
         return;
@@ -181,37 +246,32 @@ void ReaderProxy::add_change(
         return;
     }
 
-    if (changes_for_reader_.push_back(change) == nullptr)
-    {
-        // This should never happen
-        assert(false);
-        logError(RTPS_WRITER, "Error adding change " << change.getSequenceNumber() << " to reader proxy " << \
-            reader_attributes_.guid());
-    }
+    insert_change(change);
 }
 
 bool ReaderProxy::has_changes() const
 {
-    return !changes_for_reader_.empty();
+    return 0 < present_count_ || !sparse_changes_.empty();
 }
 
 bool ReaderProxy::change_is_acked(const SequenceNumber_t& seq_num) const
 {
-    if (seq_num <= changes_low_mark_ || changes_for_reader_.empty())
+    if (seq_num <= changes_low_mark_ || !has_changes())
     {
         return true;
     }
 
-    ChangeConstIterator chit = find_change(seq_num);
-    if (chit == changes_for_reader_.end())
+    size_t slot = find_change(seq_num);
+    if (slot == no_change)
     {
         // There is a hole in changes_for_reader_
         // This means a change was removed.
-        // The case is equivalent to the !chit->isRelevant() code below
+        // The case is equivalent to the !isRelevant() code below
         return true;
     }
 
-    return !chit->isRelevant() || chit->getStatus() == ACKNOWLEDGED;
+    const ChangeForReader_t& change = change_at(slot);
+    return !change.isRelevant() || change.getStatus() == ACKNOWLEDGED;
 }
 
 void ReaderProxy::acked_changes_set(const SequenceNumber_t& seq_num)
@@ -220,8 +280,34 @@ void ReaderProxy::acked_changes_set(const SequenceNumber_t& seq_num)
 
     if (seq_num > changes_low_mark_)
     {
-        ChangeIterator chit = find_change(seq_num, false);
-        changes_for_reader_.erase(changes_for_reader_.begin(), chit);
+        // Changes out of the ring are the oldest ones.
+        std::vector<ChangeForReader_t>::iterator acked_end = std::lower_bound(sparse_changes_.begin(),
+                sparse_changes_.end(), seq_num, sequence_number_before);
+        for (std::vector<ChangeForReader_t>::iterator it = sparse_changes_.begin(); it != acked_end; ++it)
+        {
+            --status_count_[it->getStatus()];
+        }
+        sparse_changes_.erase(sparse_changes_.begin(), acked_end);
+
+        // Every change before seq_num is dropped from the front of the ring.
+        if (0 < present_count_ && seq_num > changes_base_)
+        {
+            uint64_t acked = (seq_num - changes_base_).to64long();
+            size_t count = acked < changes_span_ ? static_cast<size_t>(acked) : changes_span_;
+            for (size_t offset = 0; offset < count && 0 < present_count_; ++offset)
+            {
+                size_t slot = slot_of(offset);
+                if (is_present(slot))
+                {
+                    clear_slot(slot);
+                }
+            }
+
+            changes_head_ = slot_of(count);
+            changes_base_ = changes_base_ + static_cast<uint32_t>(count);
+            changes_span_ -= count;
+            trim_holes();
+        }
     }
     else
     {
@@ -236,37 +322,22 @@ void ReaderProxy::acked_changes_set(const SequenceNumber_t& seq_num)
         }
         future_low_mark = current_sequence;
 
-        bool should_sort = false;
         for (; current_sequence <= changes_low_mark_; ++current_sequence)
         {
-            // Skip all consecutive changes already in the collection
-            ChangeConstIterator it = find_change(current_sequence);
-            while( it != changes_for_reader_.end() &&
-                current_sequence <= changes_low_mark_ &&
-                it->getSequenceNumber() == current_sequence)
+            // Skip changes already in the collection
+            if (find_change(current_sequence) != no_change)
             {
-                ++current_sequence;
-                ++it;
+                continue;
             }
 
-            if (current_sequence <= changes_low_mark_)
+            CacheChange_t* change = nullptr;
+            if (writer_->mp_history->get_change(current_sequence, writer_->getGuid(), &change))
             {
-                CacheChange_t* change = nullptr;
-                if (writer_->mp_history->get_change(current_sequence, writer_->getGuid(), &change))
-                {
-                    should_sort = true;
-                    ChangeForReader_t cr(change);
-                    cr.setStatus(UNACKNOWLEDGED);
-                    changes_for_reader_.push_back(cr);
-                }
+                ChangeForReader_t cr(change);
+                cr.setStatus(UNACKNOWLEDGED);
+                insert_change(cr);
             }
         }
-
-        // Keep changes sorted by sequence number
-        if (should_sort)
-        {
-            std::sort(changes_for_reader_.begin(), changes_for_reader_.end(), ChangeForReaderCmp());
-        }
     }
 
     changes_low_mark_ = future_low_mark - 1;
@@ -278,11 +349,11 @@ bool ReaderProxy::requested_changes_set(const SequenceNumberSet_t& seq_num_set)
 
     seq_num_set.for_each([&](SequenceNumber_t sit)
     {
-        ChangeIterator chit = find_change(sit, true);
-        if (chit != changes_for_reader_.end() && UNACKNOWLEDGED == chit->getStatus())
+        size_t slot = find_change(sit);
+        if (slot != no_change && UNACKNOWLEDGED == change_at(slot).getStatus())
         {
-            chit->setStatus(REQUESTED);
-            chit->markAllFragmentsAsUnsent();
+            set_status(slot, REQUESTED);
+            change_at(slot).markAllFragmentsAsUnsent();
             isSomeoneWasSetRequested = true;
         }
     });
@@ -311,7 +382,7 @@ bool ReaderProxy::set_change_to_status(
         return false;
     }
 
-    ChangeIterator it = find_change(seq_num, true);
+    size_t slot = find_change(seq_num);
     bool change_was_modified = false;
 
     // If the status is UNDERWAY (change was right now sent) and the reader is besteffort,
@@ -330,20 +401,20 @@ bool ReaderProxy::set_change_to_status(
         change_was_modified = true;
     }
 
-    if (it != changes_for_reader_.end())
+    if (slot != no_change)
     {
         if (status == ACKNOWLEDGED && changes_low_mark_ == seq_num)
         {
             // Erase the first change when it is acknowledged
-            assert(it == changes_for_reader_.begin());
-            changes_for_reader_.erase(it);
+            assert(slot == (sparse_changes_.empty() ? changes_head_ : changes_for_reader_.size()));
+            remove_change(slot);
         }
         else
         {
             // Otherwise change status
-            if (it->getStatus() != status)
+            if (change_at(slot).getStatus() != status)
             {
-                it->setStatus(status);
+                set_status(slot, status);
                 change_was_modified = true;
             }
         }
@@ -365,13 +436,13 @@ bool ReaderProxy::mark_fragment_as_sent_for_change(
     }
 
     bool change_found = false;
-    ChangeIterator it = find_change(seq_num, true);
+    size_t slot = find_change(seq_num);
 
-    if (it != changes_for_reader_.end())
+    if (slot != no_change)
     {
         change_found = true;
-        it->markFragmentsAsSent(frag_num);
-        was_last_fragment = it->getUnsentFragments().empty();
+        change_at(slot).markFragmentsAsSent(frag_num);
+        was_last_fragment = change_at(slot).getUnsentFragments().empty();
     }
 
     return change_found;
@@ -396,43 +467,58 @@ bool ReaderProxy::convert_status_on_all_changes(
     // NOTE: This is only called for REQUESTED=>UNSENT (acknack response) or
     //       UNDERWAY=>UNACKNOWLEDGED (nack supression)
 
-    bool at_least_one_modified = false;
-    for(ChangeForReader_t& change : changes_for_reader_)
+    if (0 == status_count_[previous])
+    {
+        return false;
+    }
+
+    // Whole words of the bitmap are moved at once, only the changes themselves are visited one by one.
+    std::vector<uint64_t>& previous_bits = status_bits_[previous];
+    std::vector<uint64_t>& next_bits = status_bits_[next];
+    for (size_t word = 0; word < previous_bits.size(); ++word)
+    {
+        uint64_t bits = previous_bits[word];
+        if (0 == bits)
+        {
+            continue;
+        }
+
+        previous_bits[word] = 0;
+        next_bits[word] |= bits;
+        while (bits)
+        {
+            changes_for_reader_[(word << 6) + lowest_bit_set(bits)].setStatus(next);
+            bits &= bits - 1;
+        }
+    }
+
+    for (ChangeForReader_t& change : sparse_changes_)
     {
         if (change.getStatus() == previous)
         {
-            at_least_one_modified = true;
             change.setStatus(next);
         }
     }
 
-    return at_least_one_modified;
+    status_count_[next] += status_count_[previous];
+    status_count_[previous] = 0;
+    return true;
 }
 
 void ReaderProxy::change_has_been_removed(const SequenceNumber_t& seq_num)
 {
-    // Check sequence number is in the container, because it was not clean up.
-    if (changes_for_reader_.empty() || seq_num < changes_for_reader_.begin()->getSequenceNumber())
+    // Element may not be in the container when marked as irrelevant or already acknowledged.
+    size_t slot = find_change(seq_num);
+    if (slot != no_change)
     {
-        return;
+        remove_change(slot);
     }
-
-    // Element may not be in the container when marked as irrelevant.
-    auto chit = find_change(seq_num);
-    changes_for_reader_.erase(chit);
 }
 
 bool ReaderProxy::has_unacknowledged() const
 {
-    for (const ChangeForReader_t& it : changes_for_reader_)
-    {
-        if (it.isRelevant() && it.getStatus() == UNACKNOWLEDGED)
-        {
-            return true;
-        }
-    }
-
-    return false;
+    // Irrelevant changes are never kept on the collection.
+    return 0 < status_count_[UNACKNOWLEDGED];
 }
 
 bool ReaderProxy::requested_fragment_set(
@@ -440,18 +526,18 @@ bool ReaderProxy::requested_fragment_set(
         const FragmentNumberSet_t& frag_set)
 {
     // Locate the outbound change referenced by the NACK_FRAG
-    ChangeIterator changeIter = find_change(seq_num, true);
-    if (changeIter == changes_for_reader_.end())
+    size_t slot = find_change(seq_num);
+    if (slot == no_change)
     {
         return false;
     }
 
-    changeIter->markFragmentsAsUnsent(frag_set);
+    change_at(slot).markFragmentsAsUnsent(frag_set);
 
     // If it was UNSENT, we shouldn't switch back to REQUESTED to prevent stalling.
-    if (changeIter->getStatus() != UNSENT)
+    if (change_at(slot).getStatus() != UNSENT)
     {
-        changeIter->setStatus(REQUESTED);
+        set_status(slot, REQUESTED);
     }
 
     return true;
@@ -478,43 +564,267 @@ bool ReaderProxy::process_nack_frag(
     return false;
 }
 
-static bool change_less_than_sequence(
-    const ChangeForReader_t& change,
-    const SequenceNumber_t& seq_num)
+size_t ReaderProxy::find_change(const SequenceNumber_t& seq_num) const
 {
-    return change.getSequenceNumber() < seq_num;
+    if (0 == present_count_ || seq_num < changes_base_)
+    {
+        std::vector<ChangeForReader_t>::const_iterator it = std::lower_bound(sparse_changes_.begin(),
+                sparse_changes_.end(), seq_num, sequence_number_before);
+        if (it == sparse_changes_.end() || it->getSequenceNumber() != seq_num)
+        {
+            return no_change;
+        }
+        return changes_for_reader_.size() + static_cast<size_t>(it - sparse_changes_.begin());
+    }
+
+    uint64_t offset = (seq_num - changes_base_).to64long();
+    if (offset >= changes_span_)
+    {
+        return no_change;
+    }
+
+    size_t slot = slot_of(static_cast<size_t>(offset));
+    return is_present(slot) ? slot : no_change;
+}
+
+size_t ReaderProxy::next_unsent_or_hole(size_t offset) const
+{
+    const std::vector<uint64_t>& unsent_bits = status_bits_[UNSENT];
+
+    // The ring size is a multiple of 64, so a word never wraps around the end of the ring.
+    while (offset < changes_span_)
+    {
+        size_t slot = slot_of(offset);
+        size_t word = slot >> 6;
+        size_t bit = slot & 63;
+        uint64_t bits = (unsent_bits[word] | ~present_bits_[word]) >> bit;
+        if (0 != bits)
+        {
+            return offset + lowest_bit_set(bits);
+        }
+
+        offset += 64 - bit;
+    }
+
+    return changes_span_;
 }
 
-ReaderProxy::ChangeIterator ReaderProxy::find_change(
+void ReaderProxy::insert_change(const ChangeForReader_t& change)
+{
+    const SequenceNumber_t& seq_num = change.getSequenceNumber();
+    size_t offset = 0;
+
+    if (!sparse_changes_.empty() && seq_num < sparse_changes_.back().getSequenceNumber())
+    {
+        insert_sparse_change(change);
+        return;
+    }
+
+    if (0 < present_count_ && seq_num >= changes_base_)
+    {
+        uint64_t new_offset = (seq_num - changes_base_).to64long();
+        if (new_offset >= changes_for_reader_.size())
+        {
+            size_t max_slots = ring_limit();
+            if (ring_size_for(new_offset + 1) > max_slots)
+            {
+                move_front_to_sparse(seq_num, max_slots);
+            }
+        }
+    }
+
+    if (0 == present_count_)
+    {
+        changes_base_ = seq_num;
+        changes_span_ = 1;
+    }
+    else if (seq_num >= changes_base_)
+    {
+        uint64_t new_offset = (seq_num - changes_base_).to64long();
+        if (new_offset >= changes_for_reader_.size())
+        {
+            grow(new_offset + 1);
+        }
+        offset = static_cast<size_t>(new_offset);
+        if (offset >= changes_span_)
+        {
+            changes_span_ = offset + 1;
+        }
+    }
+    else
+    {
+        // Ring is extended backwards, unless it would grow beyond its limit.
+        uint64_t extra = (changes_base_ - seq_num).to64long();
+        if (changes_span_ + extra > changes_for_reader_.size())
+        {
+            if (ring_size_for(changes_span_ + extra) > ring_limit())
+            {
+                insert_sparse_change(change);
+                return;
+            }
+            grow(changes_span_ + extra);
+        }
+        changes_head_ = (changes_head_ - static_cast<size_t>(extra)) & (changes_for_reader_.size() - 1);
+        changes_base_ = seq_num;
+        changes_span_ += static_cast<size_t>(extra);
+    }
+
+    size_t slot = slot_of(offset);
+    assert(!is_present(slot));
+    changes_for_reader_[slot] = change;
+    present_bits_[slot >> 6] |= uint64_t(1) << (slot & 63);
+    status_bits_[change.getStatus()][slot >> 6] |= uint64_t(1) << (slot & 63);
+    ++status_count_[change.getStatus()];
+    ++present_count_;
+}
+
+void ReaderProxy::insert_sparse_change(const ChangeForReader_t& change)
+{
+    std::vector<ChangeForReader_t>::iterator it = std::lower_bound(sparse_changes_.begin(),
+            sparse_changes_.end(), change.getSequenceNumber(), sequence_number_before);
+    sparse_changes_.insert(it, change);
+    ++status_count_[change.getStatus()];
+}
+
+void ReaderProxy::move_front_to_sparse(
         const SequenceNumber_t& seq_num,
-        bool exact)
+        size_t max_slots)
+{
+    // The first slot of the ring always holds a change.
+    while (0 < present_count_ && (seq_num - changes_base_).to64long() >= max_slots)
+    {
+        sparse_changes_.push_back(changes_for_reader_[changes_head_]);
+        ++status_count_[sparse_changes_.back().getStatus()];
+        remove_change(changes_head_);
+    }
+}
+
+size_t ReaderProxy::ring_limit() const
 {
-    ReaderProxy::ChangeIterator it;
-    ReaderProxy::ChangeIterator end = changes_for_reader_.end();
-    it = std::lower_bound(changes_for_reader_.begin(), end, seq_num, change_less_than_sequence);
+    if (0 < max_ring_slots_)
+    {
+        return max_ring_slots_;
+    }
 
-    return (!exact)
-        ? it
-        : it == end
-            ? it
-            : it->getSequenceNumber() == seq_num ? it : end;
+    return ring_size_for(2u * (present_count_ + sparse_changes_.size() + 1u));
 }
 
-ReaderProxy::ChangeConstIterator ReaderProxy::find_change(const SequenceNumber_t& seq_num) const
+void ReaderProxy::set_status(
+        size_t slot,
+        ChangeForReaderStatus_t status)
 {
-    ReaderProxy::ChangeConstIterator it;
-    ReaderProxy::ChangeConstIterator end = changes_for_reader_.end();
-    it = std::lower_bound(changes_for_reader_.begin(), end, seq_num, change_less_than_sequence);
+    if (is_sparse(slot))
+    {
+        ChangeForReader_t& change = change_at(slot);
+        --status_count_[change.getStatus()];
+        ++status_count_[status];
+        change.setStatus(status);
+        return;
+    }
 
-    return it == end
-        ? it
-        : it->getSequenceNumber() == seq_num ? it : end;
+    ChangeForReader_t& change = changes_for_reader_[slot];
+    uint64_t mask = uint64_t(1) << (slot & 63);
+
+    status_bits_[change.getStatus()][slot >> 6] &= ~mask;
+    --status_count_[change.getStatus()];
+    status_bits_[status][slot >> 6] |= mask;
+    ++status_count_[status];
+    change.setStatus(status);
+}
+
+void ReaderProxy::remove_change(size_t slot)
+{
+    if (is_sparse(slot))
+    {
+        size_t index = slot - changes_for_reader_.size();
+        --status_count_[sparse_changes_[index].getStatus()];
+        sparse_changes_.erase(sparse_changes_.begin() + index);
+        return;
+    }
+
+    clear_slot(slot);
+    trim_holes();
+}
+
+void ReaderProxy::clear_slot(size_t slot)
+{
+    ChangeForReader_t& change = changes_for_reader_[slot];
+    uint64_t mask = ~(uint64_t(1) << (slot & 63));
+
+    present_bits_[slot >> 6] &= mask;
+    status_bits_[change.getStatus()][slot >> 6] &= mask;
+    --status_count_[change.getStatus()];
+    --present_count_;
+}
+
+void ReaderProxy::trim_holes()
+{
+    if (0 == present_count_)
+    {
+        changes_span_ = 0;
+        return;
+    }
+
+    size_t skipped = 0;
+    while (!is_present(slot_of(skipped)))
+    {
+        ++skipped;
+    }
+    changes_head_ = slot_of(skipped);
+    changes_base_ = changes_base_ + static_cast<uint32_t>(skipped);
+    changes_span_ -= skipped;
+
+    while (!is_present(slot_of(changes_span_ - 1)))
+    {
+        --changes_span_;
+    }
+}
+
+void ReaderProxy::grow(uint64_t min_slots)
+{
+    size_t new_size = ring_size_for(min_slots);
+    std::vector<ChangeForReader_t> new_changes(new_size);
+    std::vector<uint64_t> new_present(new_size / 64u, 0u);
+    std::vector<uint64_t> new_status[UNDERWAY + 1];
+
+    for (std::vector<uint64_t>& bits : new_status)
+    {
+        bits.resize(new_size / 64u, 0u);
+    }
+
+    // Changes are moved so the first one lands on the first slot.
+    for (size_t offset = 0; offset < changes_span_; ++offset)
+    {
+        size_t slot = slot_of(offset);
+        if (is_present(slot))
+        {
+            uint64_t mask = uint64_t(1) << (offset & 63);
+            new_changes[offset] = changes_for_reader_[slot];
+            new_present[offset >> 6] |= mask;
+            new_status[changes_for_reader_[slot].getStatus()][offset >> 6] |= mask;
+        }
+    }
+
+    changes_for_reader_.swap(new_changes);
+    present_bits_.swap(new_present);
+    for (size_t i = 0; i <= UNDERWAY; ++i)
+    {
+        status_bits_[i].swap(new_status[i]);
+    }
+    changes_head_ = 0;
 }
 
 bool ReaderProxy::are_there_gaps()
 {
-    return (0 < changes_for_reader_.size() &&
-            changes_low_mark_ + uint32_t(changes_for_reader_.size()) != changes_for_reader_.rbegin()->getSequenceNumber());
+    size_t count = present_count_ + sparse_changes_.size();
+    if (0 == count)
+    {
+        return false;
+    }
+
+    SequenceNumber_t last_seq = 0 < present_count_ ?
+            changes_base_ + uint32_t(changes_span_ - 1) : sparse_changes_.back().getSequenceNumber();
+    return changes_low_mark_ + uint32_t(count) != last_seq;
 }
 
 }   // namespace rtps
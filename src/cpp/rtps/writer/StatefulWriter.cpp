@@ -29,6 +29,9 @@
 #include <fastrtps/rtps/messages/RTPSMessageGroup.h>
 
 #include <fastrtps/rtps/participant/RTPSParticipant.h>
+#include <fastrtps/rtps/reader/RTPSReader.h>
+#include <fastrtps/rtps/reader/StatefulReader.h>
+#include <fastrtps/rtps/RTPSDomain.h>
 #include <fastrtps/rtps/resources/ResourceEvent.h>
 #include <fastrtps/rtps/resources/TimedEvent.h>
 
@@ -42,6 +45,7 @@
 
 #include "RTPSWriterCollector.h"
 #include "StatefulWriterOrganizer.h"
+#include "../history/HistoryAttributesExtension.hpp"
 
 #include <mutex>
 #include <vector>
@@ -51,6 +55,34 @@ using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
 using namespace std::chrono;
 
+namespace {
+
+/**
+ * Hands the data queued for the readers of this process when leaving a scope.
+ * Declared before the lock of the writer, so the listeners of the readers run with the writer unlocked.
+ */
+class LocalDeliveryGuard
+{
+public:
+
+    explicit LocalDeliveryGuard(
+            RTPSWriter& writer)
+        : writer_(writer)
+    {
+    }
+
+    ~LocalDeliveryGuard()
+    {
+        writer_.deliver_to_local_readers();
+    }
+
+private:
+
+    RTPSWriter& writer_;
+};
+
+} // namespace
+
 StatefulWriter::StatefulWriter(
         RTPSParticipantImpl* pimpl,
         const GUID_t& guid,
@@ -76,9 +108,21 @@ StatefulWriter::StatefulWriter(
     , sendBufferSize_(pimpl->get_min_network_send_buffer_size())
     , currentUsageSendBufferSize_(static_cast<int32_t>(pimpl->get_min_network_send_buffer_size()))
     , m_controllers()
+    , relevant_changes_(new RTPSWriterCollector<ReaderProxy*>(att.matched_readers_allocation,
+                resource_limits_from_history(hist->m_att).initial))
+    , not_relevant_changes_(new StatefulWriterOrganizer(att.matched_readers_allocation))
+    , intraprocess_delivery_(pimpl->getRTPSParticipantAttributes().intraprocessDelivery)
+    , local_delivery_running_(false)
 {
     m_heartbeatCount = 0;
 
+    if (intraprocess_delivery_)
+    {
+        size_t initial_deliveries = resource_limits_from_history(hist->m_att).initial;
+        local_deliveries_.reserve(initial_deliveries);
+        local_deliveries_in_progress_.reserve(initial_deliveries);
+    }
+
     const RTPSParticipantAttributes& part_att = pimpl->getRTPSParticipantAttributes();
 
     periodic_hb_event_ = new TimedEvent(pimpl->getEventResource(), [&](TimedEvent::EventCode code) -> bool
@@ -131,6 +175,19 @@ StatefulWriter::~StatefulWriter()
 {
     logInfo(RTPS_WRITER,"StatefulWriter destructor");
 
+    {
+        // Changes kept for deliveries never performed go back to the history.
+        std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
+        for (const LocalDelivery& delivery : local_deliveries_)
+        {
+            if (delivery.release_change)
+            {
+                mp_history->release_Cache(delivery.change);
+            }
+        }
+        local_deliveries_.clear();
+    }
+
     for (std::unique_ptr<FlowController>& controller : m_controllers)
     {
         controller->disable();
@@ -198,6 +255,7 @@ void StatefulWriter::unsent_change_added_to_history(
         {
             //TODO(Ricardo) Temporal.
             bool expectsInlineQos = false;
+            bool has_local_readers = false;
 
             // First step is to add the new CacheChange_t to all reader proxies.
             // It has to be done before sending, because if a timeout is catched, we will not include the
@@ -206,7 +264,13 @@ void StatefulWriter::unsent_change_added_to_history(
             {
                 ChangeForReader_t changeForReader(change);
 
-                if(m_pushMode)
+                if (it->is_local_reader())
+                {
+                    // Handed to the reader below.
+                    changeForReader.setStatus(UNSENT);
+                    has_local_readers = true;
+                }
+                else if(m_pushMode)
                 {
                     if(it->is_reliable())
                     {
@@ -224,7 +288,18 @@ void StatefulWriter::unsent_change_added_to_history(
 
                 changeForReader.setRelevance(it->rtps_is_relevant(change));
                 it->add_change(changeForReader, true, max_blocking_time);
-                expectsInlineQos |= it->expects_inline_qos();
+                expectsInlineQos |= !it->is_local_reader() && it->expects_inline_qos();
+            }
+
+            if (has_local_readers)
+            {
+                for (ReaderProxy* it : matched_readers_)
+                {
+                    if (it->is_local_reader())
+                    {
+                        send_unsent_changes_to_local_reader_nts(*it, change->sequenceNumber + 1);
+                    }
+                }
             }
 
             try
@@ -232,20 +307,28 @@ void StatefulWriter::unsent_change_added_to_history(
                 //At this point we are sure all information was stores. We now can send data.
                 if (!m_separateSendingEnabled)
                 {
-                    RTPSMessageGroup group(mp_RTPSParticipant, this, m_cdrmessages, *this, max_blocking_time);
-                    if (!group.add_data(*change, expectsInlineQos))
+                    if (!all_remote_readers_.empty())
                     {
-                        logError(RTPS_WRITER, "Error sending change " << change->sequenceNumber);
-                    }
+                        RTPSMessageGroup group(mp_RTPSParticipant, this, m_cdrmessages, *this, max_blocking_time);
+                        if (!group.add_data(*change, expectsInlineQos))
+                        {
+                            logError(RTPS_WRITER, "Error sending change " << change->sequenceNumber);
+                        }
 
-                    // Heartbeat piggyback.
-                    uint32_t last_processed = 0;
-                    send_heartbeat_piggyback_nts_(nullptr, group, last_processed);
+                        // Heartbeat piggyback.
+                        uint32_t last_processed = 0;
+                        send_heartbeat_piggyback_nts_(nullptr, group, last_processed);
+                    }
                 }
                 else
                 {
                     for (ReaderProxy* it : matched_readers_)
                     {
+                        if (it->is_local_reader())
+                        {
+                            continue;
+                        }
+
                         RTPSMessageGroup group(mp_RTPSParticipant, this, m_cdrmessages, it->message_sender(),
                                 max_blocking_time);
                         if (!group.add_data(*change, it->expects_inline_qos()))
@@ -258,7 +341,12 @@ void StatefulWriter::unsent_change_added_to_history(
                 }
 
                 periodic_hb_event_->restart_timer(max_blocking_time);
-                if ( (mp_listener != nullptr) && this->is_acked_by_all(change) )
+                if (has_local_readers)
+                {
+                    // Local readers may have acknowledged the change already.
+                    check_acked_status();
+                }
+                else if ( (mp_listener != nullptr) && this->is_acked_by_all(change) )
                 {
                     mp_listener->onWriterChangeReceivedByAll(this, change);
                 }
@@ -279,7 +367,7 @@ void StatefulWriter::unsent_change_added_to_history(
             {
                 ChangeForReader_t changeForReader(change);
 
-                if(m_pushMode)
+                if(m_pushMode || it->is_local_reader())
                 {
                     changeForReader.setStatus(UNSENT);
                 }
@@ -349,11 +437,21 @@ bool StatefulWriter::change_removed_by_history(CacheChange_t* a_change)
 
 void StatefulWriter::send_any_unsent_changes()
 {
+    LocalDeliveryGuard local_delivery(*this);
     std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
 
     bool activateHeartbeatPeriod = false;
     SequenceNumber_t max_sequence = mp_history->next_sequence_number();
 
+    // Readers of this process receive the changes directly, without the transports.
+    for (ReaderProxy* remoteReader : matched_readers_)
+    {
+        if (remoteReader->is_local_reader())
+        {
+            activateHeartbeatPeriod |= send_unsent_changes_to_local_reader_nts(*remoteReader, max_sequence);
+        }
+    }
+
     // Separate sending for asynchronous writers
     if (m_pushMode && m_separateSendingEnabled)
     {
@@ -361,6 +459,11 @@ void StatefulWriter::send_any_unsent_changes()
         {
             for (ReaderProxy* remoteReader : matched_readers_)
             {
+                if (remoteReader->is_local_reader())
+                {
+                    continue;
+                }
+
                 try
                 {
                     // For possible GAP
@@ -420,8 +523,10 @@ void StatefulWriter::send_any_unsent_changes()
     }
     else
     {
-        RTPSWriterCollector<ReaderProxy*> relevantChanges;
-        StatefulWriterOrganizer notRelevantChanges;
+        RTPSWriterCollector<ReaderProxy*>& relevantChanges = *relevant_changes_;
+        StatefulWriterOrganizer& notRelevantChanges = *not_relevant_changes_;
+        relevantChanges.clear();
+        notRelevantChanges.clear();
 
         NetworkFactory& network = mp_RTPSParticipant->network_factory();
         locator_selector_.reset(true);
@@ -430,6 +535,11 @@ void StatefulWriter::send_any_unsent_changes()
 
         for (ReaderProxy* remoteReader : matched_readers_)
         {
+            if (remoteReader->is_local_reader())
+            {
+                continue;
+            }
+
             auto unsent_change_process = [&](const SequenceNumber_t& seq_num, const ChangeForReader_t* unsentChange)
             {
                 if (unsentChange != nullptr && unsentChange->isRelevant() && unsentChange->isValid())
@@ -474,7 +584,7 @@ void StatefulWriter::send_any_unsent_changes()
 
                 while (!relevantChanges.empty())
                 {
-                    RTPSWriterCollector<ReaderProxy*>::Item changeToSend = relevantChanges.pop();
+                    RTPSWriterCollector<ReaderProxy*>::Item& changeToSend = relevantChanges.pop();
                     bool expectsInlineQos = false;
                     locator_selector_.reset(false);
 
@@ -562,11 +672,12 @@ void StatefulWriter::send_any_unsent_changes()
                     send_heartbeat_piggyback_nts_(nullptr, group, lastBytesProcessed);
                 }
 
-                for (std::pair<std::vector<ReaderProxy*>, std::set<SequenceNumber_t>> pair : notRelevantChanges.elements())
+                notRelevantChanges.organize();
+                for (StatefulWriterOrganizer::Element& element : notRelevantChanges)
                 {
                     locator_selector_.reset(false);
 
-                    for (const ReaderProxy* remoteReader : pair.first)
+                    for (const ReaderProxy* remoteReader : element.readers)
                     {
                         locator_selector_.enable(remoteReader->guid());
                     }
@@ -576,7 +687,7 @@ void StatefulWriter::send_any_unsent_changes()
                         network.select_locators(locator_selector_);
                         compute_selected_guids();
                     }
-                    group.add_gap(pair.second);
+                    group.add_gap(element.sequence_numbers);
                 }
             }
             catch(const RTPSMessageGroup::timeout&)
@@ -639,6 +750,7 @@ bool StatefulWriter::matched_reader_add(const ReaderProxyData& rdata)
         return false;
     }
 
+    LocalDeliveryGuard local_delivery(*this);
     std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
 
     // Check if it is already matched.
@@ -679,7 +791,18 @@ bool StatefulWriter::matched_reader_add(const ReaderProxyData& rdata)
     }
 
     // Add info of new datareader.
-    rp->start(rdata);
+    // The local reader is looked up with the mutex taken, so RTPSDomain cannot miss it when the reader is removed.
+    rp->start(rdata, intraprocess_delivery_ ? RTPSDomain::find_local_reader(rdata.guid()) : nullptr);
+    if (rp->is_local_reader())
+    {
+        // Data is handed to the reader directly, so it is not a destination for the transports.
+        matched_local_reader_add_nts(rp);
+        matched_readers_.push_back(rp);
+
+        logInfo(RTPS_WRITER, "Local Reader Proxy " << rp->guid() << " added to " << this->m_guid.entityId);
+        return true;
+    }
+
     locator_selector_.add_entry(rp->locator_selector_entry());
     update_reader_info(true);
 
@@ -769,6 +892,49 @@ bool StatefulWriter::matched_reader_add(const ReaderProxyData& rdata)
     return true;
 }
 
+void StatefulWriter::matched_local_reader_add_nts(ReaderProxy* rp)
+{
+    // Changes not in the history are informed as irrelevant with the heartbeat.
+    SequenceNumber_t first_seq = get_seq_num_min();
+    if (first_seq == SequenceNumber_t::unknown())
+    {
+        first_seq = next_sequence_number();
+    }
+    rp->acked_changes_set(first_seq);
+
+    bool send_history = rp->durability_kind() >= TRANSIENT_LOCAL &&
+            this->getAttributes().durabilityKind >= TRANSIENT_LOCAL;
+    for (std::vector<CacheChange_t*>::iterator cit = mp_history->changesBegin();
+            cit != mp_history->changesEnd(); ++cit)
+    {
+        ChangeForReader_t changeForReader(*cit);
+        changeForReader.setRelevance(send_history && rp->rtps_is_relevant(*cit));
+        changeForReader.setStatus(UNSENT);
+        rp->add_change(changeForReader, false);
+    }
+
+    bool unacked_changes = send_unsent_changes_to_local_reader_nts(*rp, next_sequence_number());
+    intraprocess_heartbeat(*rp);
+
+    if (unacked_changes)
+    {
+        periodic_hb_event_->restart_timer();
+    }
+}
+
+void StatefulWriter::local_reader_removed(const GUID_t& reader_guid)
+{
+    std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
+    for (ReaderProxy* it : matched_readers_)
+    {
+        if (it->guid() == reader_guid && it->is_local_reader())
+        {
+            it->local_reader_removed();
+            return;
+        }
+    }
+}
+
 bool StatefulWriter::matched_reader_remove(const GUID_t& reader_guid)
 {
     ReaderProxy *rproxy = nullptr;
@@ -1047,6 +1213,7 @@ bool StatefulWriter::send_periodic_heartbeat(
         bool final,
         bool liveliness)
 {
+    LocalDeliveryGuard local_delivery(*this);
     std::lock_guard<RecursiveTimedMutex> guardW(mp_mutex);
 
     bool unacked_changes = false;
@@ -1076,13 +1243,24 @@ bool StatefulWriter::send_periodic_heartbeat(
         {
             assert(firstSeq <= lastSeq);
 
-            unacked_changes = std::any_of(matched_readers_.begin(), matched_readers_.end(),
-                [](const ReaderProxy* reader)
+            bool remote_unacked_changes = false;
+            for (ReaderProxy* it : matched_readers_)
+            {
+                if (it->has_unacknowledged())
                 {
-                    return reader->has_unacknowledged();
-                });
+                    unacked_changes = true;
+                    if (it->is_local_reader())
+                    {
+                        intraprocess_heartbeat(*it);
+                    }
+                    else
+                    {
+                        remote_unacked_changes = true;
+                    }
+                }
+            }
 
-            if (unacked_changes)
+            if (remote_unacked_changes)
             {
                 try
                 {
@@ -1099,6 +1277,14 @@ bool StatefulWriter::send_periodic_heartbeat(
     else
     {
         // This is a liveliness heartbeat, we don't care about checking sequence numbers
+        for (ReaderProxy* it : matched_readers_)
+        {
+            if (it->is_local_reader())
+            {
+                intraprocess_heartbeat(*it, true);
+            }
+        }
+
         try
         {
             RTPSMessageGroup group(mp_RTPSParticipant, this, m_cdrmessages, *this);
@@ -1117,6 +1303,12 @@ void StatefulWriter::send_heartbeat_to_nts(
         ReaderProxy& remoteReaderProxy,
         bool liveliness)
 {
+    if (remoteReaderProxy.is_local_reader())
+    {
+        intraprocess_heartbeat(remoteReaderProxy, liveliness);
+        return;
+    }
+
     try
     {
         RTPSMessageGroup group(mp_RTPSParticipant, this, m_cdrmessages, remoteReaderProxy.message_sender());
@@ -1242,6 +1434,7 @@ bool StatefulWriter::process_acknack(
         bool final_flag,
         bool &result)
 {
+    LocalDeliveryGuard local_delivery(*this);
     std::unique_lock<RecursiveTimedMutex> lock(mp_mutex);
     result = (m_guid == writer_guid);
     if (result)
@@ -1253,7 +1446,11 @@ bool StatefulWriter::process_acknack(
                 if (remote_reader->check_and_set_acknack_count(ack_count))
                 {
                     // Sequence numbers before Base are set as Acknowledged.
-                    remote_reader->acked_changes_set(sn_set.base());
+                    // Local readers acknowledge on delivery, so their preemptive ACKNACK may arrive after that.
+                    if (!remote_reader->is_local_reader() || sn_set.base() > remote_reader->changes_low_mark())
+                    {
+                        remote_reader->acked_changes_set(sn_set.base());
+                    }
                     if (sn_set.base() > SequenceNumber_t(0, 0))
                     {
                         if (remote_reader->requested_changes_set(sn_set) || remote_reader->are_there_gaps())
@@ -1357,3 +1554,256 @@ bool StatefulWriter::ack_timer_expired()
     ack_event_->update_interval_millisec((double)duration_cast<milliseconds>(interval).count());
     return true;
 }
+
+void StatefulWriter::intraprocess_delivery(
+        CacheChange_t* change,
+        ReaderProxy& reader_proxy)
+{
+    LocalDelivery delivery;
+    delivery.kind = LocalDelivery::DATA;
+    delivery.reader_guid = reader_proxy.guid();
+    delivery.change = change;
+    delivery.release_change = false;
+    local_deliveries_.push_back(delivery);
+}
+
+void StatefulWriter::intraprocess_gap(
+        ReaderProxy& reader_proxy,
+        const SequenceNumber_t& first_seq,
+        const SequenceNumber_t& last_seq)
+{
+    LocalDelivery delivery;
+    delivery.kind = LocalDelivery::GAP;
+    delivery.reader_guid = reader_proxy.guid();
+    delivery.change = nullptr;
+    delivery.first_seq = first_seq;
+    delivery.last_seq = last_seq;
+    delivery.release_change = false;
+    local_deliveries_.push_back(delivery);
+}
+
+void StatefulWriter::intraprocess_heartbeat(
+        ReaderProxy& reader_proxy,
+        bool liveliness)
+{
+    if (reader_proxy.local_reader() == nullptr)
+    {
+        return;
+    }
+
+    SequenceNumber_t first_seq = get_seq_num_min();
+    SequenceNumber_t last_seq = get_seq_num_max();
+    if (first_seq == c_SequenceNumber_Unknown || last_seq == c_SequenceNumber_Unknown)
+    {
+        first_seq = next_sequence_number();
+        last_seq = first_seq - 1;
+    }
+
+    incrementHBCount();
+    LocalDelivery delivery;
+    delivery.kind = LocalDelivery::HEARTBEAT;
+    delivery.reader_guid = reader_proxy.guid();
+    delivery.change = nullptr;
+    delivery.first_seq = first_seq;
+    delivery.last_seq = last_seq;
+    delivery.heartbeat_count = m_heartbeatCount;
+    delivery.liveliness = liveliness;
+    delivery.release_change = false;
+    local_deliveries_.push_back(delivery);
+}
+
+void StatefulWriter::deliver_to_local_readers()
+{
+    if (!intraprocess_delivery_)
+    {
+        return;
+    }
+
+    std::unique_lock<RecursiveTimedMutex> lock(mp_mutex);
+    // A listener writing again, or another thread, finds the deliveries already being handed. The running thread
+    // also hands the ones queued meanwhile, keeping them in order.
+    if (local_delivery_running_)
+    {
+        return;
+    }
+
+    local_delivery_running_ = true;
+    while (!local_deliveries_.empty())
+    {
+        local_deliveries_in_progress_.swap(local_deliveries_);
+        lock.unlock();
+
+        for (LocalDelivery& delivery : local_deliveries_in_progress_)
+        {
+            deliver_to_local_reader(delivery);
+        }
+
+        lock.lock();
+        for (LocalDelivery& delivery : local_deliveries_in_progress_)
+        {
+            if (delivery.acknowledged)
+            {
+                local_reader_acknowledged_nts(delivery.reader_guid, delivery.ack_base);
+            }
+        }
+        // Acknowledging may remove changes, which are released here if already handed.
+        for (LocalDelivery& delivery : local_deliveries_in_progress_)
+        {
+            if (delivery.release_change)
+            {
+                mp_history->release_Cache(delivery.change);
+            }
+        }
+        local_deliveries_in_progress_.clear();
+    }
+    local_delivery_running_ = false;
+}
+
+void StatefulWriter::deliver_to_local_reader(
+        LocalDelivery& delivery)
+{
+    delivery.acknowledged = false;
+
+    // The reader cannot be destroyed until it is released.
+    RTPSReader* reader = RTPSDomain::acquire_local_reader(delivery.reader_guid);
+    if (reader == nullptr)
+    {
+        return;
+    }
+
+    switch (delivery.kind)
+    {
+        case LocalDelivery::DATA:
+            // The reader copies the payload of the change of the history into its own pool.
+            local_delivery_view_.copy_not_memcpy(delivery.change);
+            local_delivery_view_.serializedPayload.data = delivery.change->serializedPayload.data;
+            local_delivery_view_.serializedPayload.length = delivery.change->serializedPayload.length;
+            local_delivery_view_.serializedPayload.max_size = delivery.change->serializedPayload.max_size;
+            // Readers see the related sample identity sent by the writer as the identity of the sample.
+            local_delivery_view_.write_params.sample_identity(
+                delivery.change->write_params.related_sample_identity());
+            reader->processDataMsg(&local_delivery_view_);
+            local_delivery_view_.serializedPayload.data = nullptr;
+            local_delivery_view_.serializedPayload.length = 0;
+            local_delivery_view_.serializedPayload.max_size = 0;
+            break;
+        case LocalDelivery::GAP:
+            reader->processGapMsg(m_guid, delivery.first_seq, SequenceNumberSet_t(delivery.last_seq + 1));
+            break;
+        case LocalDelivery::HEARTBEAT:
+            reader->processHeartbeatMsg(m_guid, delivery.heartbeat_count, delivery.first_seq, delivery.last_seq,
+                    true, delivery.liveliness);
+            break;
+    }
+
+    // Readers keeping state acknowledge what they have, as they would with an ACKNACK. A listener of the reader
+    // may have removed it, so it is looked up again.
+    if (RTPSDomain::find_local_reader(delivery.reader_guid) != nullptr)
+    {
+        StatefulReader* stateful_reader = dynamic_cast<StatefulReader*>(reader);
+        delivery.acknowledged = stateful_reader != nullptr &&
+                stateful_reader->acknowledgement_base(m_guid, delivery.ack_base);
+    }
+    RTPSDomain::release_local_reader(delivery.reader_guid);
+}
+
+bool StatefulWriter::change_can_be_released(
+        CacheChange_t* a_change)
+{
+    std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
+
+    // The last delivery of the change gives it back to the history.
+    for (auto it = local_deliveries_.rbegin(); it != local_deliveries_.rend(); ++it)
+    {
+        if (it->change == a_change)
+        {
+            it->release_change = true;
+            return false;
+        }
+    }
+    for (auto it = local_deliveries_in_progress_.rbegin(); it != local_deliveries_in_progress_.rend(); ++it)
+    {
+        if (it->change == a_change)
+        {
+            it->release_change = true;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void StatefulWriter::local_reader_acknowledged_nts(
+        const GUID_t& reader_guid,
+        const SequenceNumber_t& seq_num)
+{
+    for (ReaderProxy* it : matched_readers_)
+    {
+        if (it->guid() == reader_guid)
+        {
+            if (it->is_local_reader() && seq_num > it->changes_low_mark())
+            {
+                it->acked_changes_set(seq_num);
+                check_acked_status();
+            }
+            return;
+        }
+    }
+}
+
+bool StatefulWriter::send_unsent_changes_to_local_reader_nts(
+        ReaderProxy& reader_proxy,
+        const SequenceNumber_t& max_sequence)
+{
+    // Statuses are updated after collecting the changes, as updating them may remove them from the proxy.
+    local_unsent_changes_.clear();
+    reader_proxy.for_each_unsent_change(max_sequence,
+            [this](const SequenceNumber_t& seq_num, const ChangeForReader_t* unsent_change)
+            {
+                bool relevant = unsent_change != nullptr && unsent_change->isRelevant() && unsent_change->isValid();
+                local_unsent_changes_.emplace_back(seq_num, relevant ? unsent_change->getChange() : nullptr);
+            });
+
+    if (local_unsent_changes_.empty())
+    {
+        return false;
+    }
+
+    // Once removed, the reader requests nothing, so its changes are simply left unacknowledged.
+    bool deliver = reader_proxy.local_reader() != nullptr;
+    auto it = local_unsent_changes_.begin();
+    while (it != local_unsent_changes_.end())
+    {
+        if (it->second != nullptr)
+        {
+            if (deliver)
+            {
+                intraprocess_delivery(it->second, reader_proxy);
+            }
+            reader_proxy.set_change_to_status(it->first, UNDERWAY, true);
+            ++it;
+        }
+        else
+        {
+            // Consecutive irrelevant changes are informed at once.
+            auto last = it;
+            while ((last + 1) != local_unsent_changes_.end() && (last + 1)->second == nullptr &&
+                    (last + 1)->first == last->first + 1)
+            {
+                ++last;
+            }
+
+            if (deliver)
+            {
+                intraprocess_gap(reader_proxy, it->first, last->first);
+            }
+            for (++last; it != last; ++it)
+            {
+                reader_proxy.set_change_to_status(it->first, UNDERWAY, true);
+            }
+        }
+    }
+
+    // Changes are acknowledged once the reader has processed them, after the mutex is released.
+    return reader_proxy.is_reliable();
+}
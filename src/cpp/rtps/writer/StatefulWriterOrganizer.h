@@ -19,71 +19,132 @@
 #ifndef _RTPS_WRITER_STATEFULWRITERORGANIZER_H_
 #define _RTPS_WRITER_STATEFULWRITERORGANIZER_H_
 
+#include <fastrtps/rtps/common/SequenceNumber.h>
+#include <fastrtps/utils/collections/ResourceLimitedVector.hpp>
+
+#include <deque>
 #include <vector>
-#include <set>
 #include <assert.h>
 
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
 
+class ReaderProxy;
+
+/**
+ * Groups the remote readers that share the same list of not relevant sequence numbers, so a single GAP can be
+ * sent to all of them.
+ *
+ * Like RTPSWriterCollector, it is meant to be reused across calls by calling clear(). Groups are kept in a pool
+ * that is never shrunk, so no dynamic allocations are performed once it has grown up to its high-water mark.
+ */
 class StatefulWriterOrganizer
 {
     public:
-        
-        StatefulWriterOrganizer() : mLastReader_(nullptr) {}
 
+        struct Element
+        {
+            Element(const ResourceLimitedContainerConfig& readers_allocation)
+                : readers(readers_allocation)
+            {
+            }
+
+            //! Remote readers the sequence numbers are addressed to.
+            ResourceLimitedVector<ReaderProxy*> readers;
+            //! Sequence numbers, in ascending order.
+            std::vector<SequenceNumber_t> sequence_numbers;
+        };
+
+        typedef std::deque<Element>::iterator iterator;
+
+        StatefulWriterOrganizer(
+                const ResourceLimitedContainerConfig& readers_allocation = ResourceLimitedContainerConfig())
+            : mReadersAllocation_(readers_allocation)
+            , mLastReader_(nullptr)
+            , mUsedElements_(0)
+        {
+        }
+
+        /**
+         * Adds a sequence number for a remote reader.
+         * Sequence numbers of a reader should be added consecutively and in ascending order.
+         */
         void add_sequence_number(const SequenceNumber_t& seqNum, ReaderProxy* remoteReader)
         {
-            if(mLastGuid_ != remoteReader->guid())
+            if(mLastReader_ != remoteReader)
                 organize();
 
-            mLastGuid_ = remoteReader->guid();
+            assert(mLastSeqList_.empty() || mLastSeqList_.back() < seqNum);
             mLastReader_ = remoteReader;
-            mLastSeqList_.insert(seqNum);
+            mLastSeqList_.push_back(seqNum);
         }
 
+        //! Moves the sequence numbers of the last reader to its group.
         void organize()
         {
-            if(mLastGuid_ != GUID_t::unknown())
+            if(mLastReader_ != nullptr)
             {
-                assert(mLastReader_ != nullptr);
-
                 bool inserted = false;
 
-                for(auto pair : mElements_)
+                for(iterator it = mElements_.begin(); it != end(); ++it)
                 {
-                    if(pair.second == mLastSeqList_)
+                    if(it->sequence_numbers == mLastSeqList_)
                     {
-                        pair.first.push_back(mLastReader_);
-                        mLastSeqList_.clear();
+                        it->readers.push_back(mLastReader_);
                         inserted = true;
                         break;
                     }
                 }
 
                 if(!inserted)
-                    mElements_.push_back(std::pair<std::vector<ReaderProxy*>, std::set<SequenceNumber_t>>({mLastReader_}, std::move(mLastSeqList_)));
+                {
+                    if(mUsedElements_ == mElements_.size())
+                        mElements_.emplace_back(mReadersAllocation_);
+
+                    Element& element = mElements_[mUsedElements_++];
+                    element.readers.clear();
+                    element.readers.push_back(mLastReader_);
+                    // Swapping keeps the buffers of both vectors alive for the next uses.
+                    element.sequence_numbers.swap(mLastSeqList_);
+                }
 
-                mLastGuid_ = GUID_t::unknown();
+                mLastSeqList_.clear();
                 mLastReader_ = nullptr;
             }
         }
 
-    private:
+        //! Removes all groups, keeping the allocated resources for reuse.
+        void clear()
+        {
+            mLastSeqList_.clear();
+            mLastReader_ = nullptr;
+            mUsedElements_ = 0;
+        }
+
+        //! @return Iterator to the first group. organize() should be called before iterating.
+        iterator begin()
+        {
+            return mElements_.begin();
+        }
 
-        GUID_t mLastGuid_;
+        //! @return Iterator past the last group.
+        iterator end()
+        {
+            return mElements_.begin() + mUsedElements_;
+        }
 
-        ReaderProxy* mLastReader_;
+    private:
 
-        std::set<SequenceNumber_t> mLastSeqList_;
+        ResourceLimitedContainerConfig mReadersAllocation_;
 
-        std::vector<std::pair<std::vector<ReaderProxy*>, std::set<SequenceNumber_t>>> mElements_;
+        ReaderProxy* mLastReader_;
 
-    public:
+        std::vector<SequenceNumber_t> mLastSeqList_;
 
-        decltype(mElements_)& elements() { organize(); return mElements_; }
+        std::deque<Element> mElements_;
 
+        size_t mUsedElements_;
 };
 
 } // namespace rtps
@@ -53,6 +53,10 @@ StatelessWriter::StatelessWriter(
           listener)
     , matched_readers_(attributes.matched_readers_allocation)
     , unsent_changes_(resource_limits_from_history(history->m_att))
+    , changes_to_send_(new RTPSWriterCollector<ReaderLocator*>(
+                ResourceLimitedContainerConfig::fixed_size_configuration(1u),
+                resource_limits_from_history(history->m_att).initial))
+    , changes_acked_by_all_(resource_limits_from_history(history->m_att))
 {
     get_builtin_guid();
 
@@ -284,7 +288,8 @@ void StatelessWriter::send_any_unsent_changes()
     //TODO(Mcc) Separate sending for asynchronous writers
     std::lock_guard<RecursiveTimedMutex> guard(mp_mutex);
 
-    RTPSWriterCollector<ReaderLocator*> changesToSend;
+    RTPSWriterCollector<ReaderLocator*>& changesToSend = *changes_to_send_;
+    changesToSend.clear();
 
     for (const ChangeForReader_t& unsentChange : unsent_changes_)
     {
@@ -303,14 +308,18 @@ void StatelessWriter::send_any_unsent_changes()
         (*controller)(changesToSend);
     }
 
+    // The group may reference the payloads of the changes until it is flushed, so the listener is only told
+    // about the changes received by all once the group has gone out of scope, as it could release them.
+    changes_acked_by_all_.clear();
+    bool bHasListener = mp_listener != nullptr;
+
     try
     {
         RTPSMessageGroup group(mp_RTPSParticipant, this,  m_cdrmessages, *this);
 
-        bool bHasListener = mp_listener != nullptr;
         while(!changesToSend.empty())
         {
-            RTPSWriterCollector<ReaderLocator*>::Item changeToSend = changesToSend.pop();
+            RTPSWriterCollector<ReaderLocator*>::Item& changeToSend = changesToSend.pop();
 
             // Remove the messages selected for sending from the original list,
             // and update those that were fragmented with the new sent index
@@ -338,7 +347,7 @@ void StatelessWriter::send_any_unsent_changes()
 
             if (bHasListener && is_acked_by_all(changeToSend.cacheChange))
             {
-                mp_listener->onWriterChangeReceivedByAll(this, changeToSend.cacheChange);
+                changes_acked_by_all_.push_back(changeToSend.cacheChange);
             }
         }
     }
@@ -347,6 +356,11 @@ void StatelessWriter::send_any_unsent_changes()
         logError(RTPS_WRITER, "Max blocking time reached");
     }
 
+    for (CacheChange_t* change : changes_acked_by_all_)
+    {
+        mp_listener->onWriterChangeReceivedByAll(this, change);
+    }
+
     logInfo(RTPS_WRITER, "Finish sending unsent changes";);
 }
 
@@ -497,23 +511,22 @@ void StatelessWriter::add_flow_controller(std::unique_ptr<FlowController> contro
 }
 
 bool StatelessWriter::send(
-        CDRMessage_t* message,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
         std::chrono::steady_clock::time_point& max_blocking_time_point) const
 {
-    if (!RTPSWriter::send(message, max_blocking_time_point))
+    if (!RTPSWriter::send(buffers, total_bytes, max_blocking_time_point))
     {
         return false;
     }
 
-    for (const Locator_t& locator : fixed_locators_)
+    if (fixed_locators_.empty())
     {
-        if (!mp_RTPSParticipant->sendSync(message, locator, max_blocking_time_point))
-        {
-            return false;
-        }
+        return true;
     }
 
-    return true;
+    return mp_RTPSParticipant->sendSync(buffers, total_bytes, &*fixed_locators_.begin(), fixed_locators_.size(),
+            max_blocking_time_point);
 }
 
 } /* namespace rtps */
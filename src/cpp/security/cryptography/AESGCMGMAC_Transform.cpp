@@ -59,6 +59,67 @@ static KeyMaterial_AES_GCM_GMAC* find_key(KeyMaterial_AES_GCM_GMAC_Seq& keys, co
     return nullptr;
 }
 
+// Cipher contexts are reused between messages instead of allocating one for each of them. Encoding and
+// decoding run concurrently on different threads, so every thread owns a context for each direction.
+class CipherContext
+{
+public:
+
+    CipherContext() : ctx_(EVP_CIPHER_CTX_new())
+    {
+    }
+
+    ~CipherContext()
+    {
+        if (ctx_ != nullptr)
+        {
+            EVP_CIPHER_CTX_free(ctx_);
+        }
+    }
+
+    CipherContext(const CipherContext&) = delete;
+    CipherContext& operator=(const CipherContext&) = delete;
+
+    EVP_CIPHER_CTX* get()
+    {
+        return ctx_;
+    }
+
+private:
+
+    EVP_CIPHER_CTX* ctx_;
+};
+
+static EVP_CIPHER_CTX* thread_encrypt_context()
+{
+    static thread_local CipherContext context;
+    return context.get();
+}
+
+static EVP_CIPHER_CTX* thread_decrypt_context()
+{
+    static thread_local CipherContext context;
+    return context.get();
+}
+
+/*
+ * Prepares a reused context for a new message.
+ * Passing the cipher again would free and allocate its internal data, so it is only given when it changes and
+ * otherwise just the key and the IV are set.
+ */
+static int init_cipher_context(EVP_CIPHER_CTX* ctx, const EVP_CIPHER* cipher, const unsigned char* key,
+        const unsigned char* iv, int enc)
+{
+    if (ctx == nullptr)
+    {
+        return 0;
+    }
+
+    const EVP_CIPHER* current_cipher = EVP_CIPHER_CTX_cipher(ctx);
+    bool same_cipher = (current_cipher != nullptr) && (EVP_CIPHER_nid(current_cipher) == EVP_CIPHER_nid(cipher));
+    return EVP_CipherInit_ex(ctx, same_cipher ? nullptr : cipher, nullptr, key, iv, enc);
+}
+
 AESGCMGMAC_Transform::AESGCMGMAC_Transform()
 {
 }
@@ -669,7 +730,7 @@ bool AESGCMGMAC_Transform::decode_rtps_message(
 
     //Sessionkey
     std::array<uint8_t, 32> session_key;
-    compute_sessionkey(session_key,
+    get_received_sessionkey(session_key, sending_participant->ReceivedSessionKeys,
             sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0),
             session_id);
     //IV
@@ -757,7 +818,7 @@ bool AESGCMGMAC_Transform::decode_rtps_message(
                 sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0).receiver_specific_key_id,
                 sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0).master_receiver_specific_key,
                 sending_participant->RemoteParticipant2ParticipantKeyMaterial.at(0).master_salt,
-                initialization_vector, session_id, exception))
+                initialization_vector, session_id, sending_participant->ReceivedSessionKeys, exception))
         {
             return false;
         }
@@ -1041,7 +1102,7 @@ bool AESGCMGMAC_Transform::decode_datawriter_submessage(
     memcpy(&session_id,header.session_id.data(),4);
     //Sessionkey
     std::array<uint8_t, 32> session_key;
-    compute_sessionkey(session_key, *keyMat, session_id);
+    get_received_sessionkey(session_key, sending_writer->ReceivedSessionKeys, *keyMat, session_id);
     //IV
     std::array<uint8_t,12> initialization_vector;
     memcpy(initialization_vector.data(), header.session_id.data(), 4);
@@ -1099,7 +1160,7 @@ bool AESGCMGMAC_Transform::decode_datawriter_submessage(
                 keyMat->receiver_specific_key_id,
                 keyMat->master_receiver_specific_key,
                 keyMat->master_salt,
-                initialization_vector, session_id, exception))
+                initialization_vector, session_id, sending_writer->ReceivedSessionKeys, exception))
         {
             return false;
         }
@@ -1219,7 +1280,7 @@ bool AESGCMGMAC_Transform::decode_datareader_submessage(
     memcpy(&session_id,header.session_id.data(),4);
     //Sessionkey
     std::array<uint8_t, 32> session_key;
-    compute_sessionkey(session_key, *keyMat, session_id);
+    get_received_sessionkey(session_key, sending_reader->ReceivedSessionKeys, *keyMat, session_id);
     //IV
     std::array<uint8_t,12> initialization_vector;
     memcpy(initialization_vector.data(), header.session_id.data(), 4);
@@ -1277,7 +1338,7 @@ bool AESGCMGMAC_Transform::decode_datareader_submessage(
                 keyMat->receiver_specific_key_id,
                 keyMat->master_receiver_specific_key,
                 keyMat->master_salt,
-                initialization_vector, session_id, exception))
+                initialization_vector, session_id, sending_reader->ReceivedSessionKeys, exception))
         {
             return false;
         }
@@ -1373,7 +1434,7 @@ bool AESGCMGMAC_Transform::decode_serialized_payload(
 
     //Sessionkey
     std::array<uint8_t, 32> session_key;
-    compute_sessionkey(session_key, *keyMat, session_id);
+    get_received_sessionkey(session_key, sending_writer->ReceivedSessionKeys, *keyMat, session_id);
     //IV
     std::array<uint8_t,12> initialization_vector;
     memcpy(initialization_vector.data(), header.session_id.data(), 4);
@@ -1412,7 +1473,7 @@ bool AESGCMGMAC_Transform::decode_serialized_payload(
     // Tag
     try
     {
-        deserialize_SecureDataTag(decoder, tag, {}, {}, {}, {}, {}, 0, exception);
+        deserialize_SecureDataTag(decoder, tag, {}, {}, {}, {}, {}, 0, sending_writer->ReceivedSessionKeys, exception);
     }
     catch(eprosima::fastcdr::exception::NotEnoughMemoryException&)
     {
@@ -1492,6 +1553,55 @@ void AESGCMGMAC_Transform::compute_sessionkey(std::array<uint8_t, 32>& session_k
 #endif
 }
 
+void AESGCMGMAC_Transform::get_received_sessionkey(std::array<uint8_t, 32>& session_key,
+    SessionKeyCache& cache, const KeyMaterial_AES_GCM_GMAC& key_mat, const uint32_t session_id)
+{
+    bool use_256_bits = (key_mat.transformation_kind == c_transfrom_kind_aes256_gcm ||
+        key_mat.transformation_kind == c_transfrom_kind_aes256_gmac);
+    int key_len = use_256_bits ? 32 : 16;
+
+    get_received_sessionkey(session_key, cache, false, key_mat.sender_key_id, key_mat.master_sender_key,
+        key_mat.master_salt, session_id, key_len);
+}
+
+void AESGCMGMAC_Transform::get_received_sessionkey(std::array<uint8_t, 32>& session_key,
+    SessionKeyCache& cache, bool receiver_specific, const CryptoTransformKeyId& key_id,
+    const std::array<uint8_t, 32>& master_key, const std::array<uint8_t, 32>& master_salt,
+    const uint32_t session_id, int key_len)
+{
+    std::lock_guard<std::mutex> lock(cache.mutex_);
+
+    for (size_t i = 0; i < cache.num_entries; ++i)
+    {
+        const DerivedSessionKey& entry = cache.entries[i];
+
+        // Master keys are compared too, as they change when the remote element sends new key material.
+        if (entry.session_id == session_id && entry.receiver_specific == receiver_specific &&
+            entry.key_len == key_len && entry.key_id == key_id &&
+            entry.master_key == master_key && entry.master_salt == master_salt)
+        {
+            session_key = entry.SessionKey;
+            return;
+        }
+    }
+
+    DerivedSessionKey& entry = cache.entries[cache.next_entry];
+    cache.next_entry = (cache.next_entry + 1) % cache.entries.size();
+    if (cache.num_entries < cache.entries.size())
+    {
+        ++cache.num_entries;
+    }
+
+    compute_sessionkey(entry.SessionKey, receiver_specific, master_key, master_salt, session_id, key_len);
+    entry.receiver_specific = receiver_specific;
+    entry.key_len = key_len;
+    entry.session_id = session_id;
+    entry.key_id = key_id;
+    entry.master_key = master_key;
+    entry.master_salt = master_salt;
+    session_key = entry.SessionKey;
+}
+
 void AESGCMGMAC_Transform::serialize_SecureDataHeader(eprosima::fastcdr::Cdr& serializer,
         const CryptoTransformKind& transformation_kind, const CryptoTransformKeyId& transformation_key_id,
         const std::array<uint8_t, 4>& session_id, const std::array<uint8_t, 8>& initialization_vector_suffix)
@@ -1512,14 +1622,13 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
 
     // AES_BLOCK_SIZE = 16
     int cipher_block_size = 0, actual_size = 0, final_size = 0;
-    EVP_CIPHER_CTX* e_ctx = EVP_CIPHER_CTX_new();
+    EVP_CIPHER_CTX* e_ctx = thread_encrypt_context();
     if (!use_256_bits)
     {
-        if (!EVP_EncryptInit(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(session_key.data()),
-            initialization_vector.data()))
+        if (!init_cipher_context(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(session_key.data()),
+            initialization_vector.data(), 1))
         {
-            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
+            logError(SECURITY_CRYPTO, "Unable to encode the payload. init_cipher_context function returns an error");
             return false;
         }
 
@@ -1527,11 +1636,10 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
     }
     else
     {
-        if (!EVP_EncryptInit(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(session_key.data()),
-            initialization_vector.data()))
+        if (!init_cipher_context(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(session_key.data()),
+            initialization_vector.data(), 1))
         {
-            logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
+            logError(SECURITY_CRYPTO, "Unable to encode the payload. init_cipher_context function returns an error");
             return false;
         }
 
@@ -1545,7 +1653,6 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
             plain_buffer_len)
         {
             logError(SECURITY_CRYPTO, "Not enough memory to copy payload");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
         memcpy(serializer.getCurrentPosition(), plain_buffer, plain_buffer_len);
@@ -1554,14 +1661,12 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
         if (!EVP_EncryptUpdate(e_ctx, nullptr, &actual_size, plain_buffer, static_cast<int>(plain_buffer_len)))
         {
             logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
 
-        if (!EVP_EncryptFinal(e_ctx, nullptr, &final_size))
+        if (!EVP_EncryptFinal_ex(e_ctx, nullptr, &final_size))
         {
             logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptFinal function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
     }
@@ -1602,7 +1707,6 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
             (plain_buffer_len + (2 * cipher_block_size) - 1))
         {
             logError(SECURITY_CRYPTO, "Not enough memory to cipher payload");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
 
@@ -1610,14 +1714,12 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
             static_cast<int>(plain_buffer_len)))
         {
             logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
 
-        if (!EVP_EncryptFinal(e_ctx, output_buffer_raw, &final_size))
+        if (!EVP_EncryptFinal_ex(e_ctx, output_buffer_raw, &final_size))
         {
             logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptFinal function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             return false;
         }
 
@@ -1642,7 +1744,6 @@ bool AESGCMGMAC_Transform::serialize_SecureDataBody(eprosima::fastcdr::Cdr& seri
 
     // Get commmon_mac
     EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, AES_BLOCK_SIZE, tag.common_mac.data());
-    EVP_CIPHER_CTX_free(e_ctx);
 
     if (submessage)
     {
@@ -1719,45 +1820,46 @@ bool AESGCMGMAC_Transform::serialize_SecureDataTag(eprosima::fastcdr::Cdr& seria
 
         //Obtain MAC using ReceiverSpecificKey and the same Initialization Vector as before
         int actual_size = 0, final_size = 0;
-        EVP_CIPHER_CTX* e_ctx = EVP_CIPHER_CTX_new();
+        EVP_CIPHER_CTX* e_ctx = thread_encrypt_context();
         if(transformation_kind == c_transfrom_kind_aes128_gcm ||
                 transformation_kind == c_transfrom_kind_aes128_gmac)
         {
-            if(!EVP_EncryptInit(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(remote_entity->Sessions[sessionIndex].SessionKey.data()),
-                        initialization_vector.data()))
+            if(!init_cipher_context(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(remote_entity->Sessions[sessionIndex].SessionKey.data()),
+                        initialization_vector.data(), 1))
             {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                EVP_CIPHER_CTX_free(e_ctx);
+                logError(SECURITY_CRYPTO, "Unable to encode the payload. init_cipher_context function returns an error");
                 continue;
             }
         }
         else if(transformation_kind == c_transfrom_kind_aes256_gcm ||
                 transformation_kind == c_transfrom_kind_aes256_gmac)
         {
-            if(!EVP_EncryptInit(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(remote_entity->Sessions[sessionIndex].SessionKey.data()),
-                        initialization_vector.data()))
+            if(!init_cipher_context(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(remote_entity->Sessions[sessionIndex].SessionKey.data()),
+                        initialization_vector.data(), 1))
             {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                EVP_CIPHER_CTX_free(e_ctx);
+                logError(SECURITY_CRYPTO, "Unable to encode the payload. init_cipher_context function returns an error");
                 continue;
             }
         }
+        else
+        {
+            // The cipher context is reused, so it must not be updated with the key of a previous message.
+            logError(SECURITY_CRYPTO, "Invalid transformation kind");
+            continue;
+        }
         if(!EVP_EncryptUpdate(e_ctx, NULL, &actual_size, tag.common_mac.data(), 16))
         {
             logError(SECURITY_CRYPTO, "Unable to create authentication for the datawriter submessage. EVP_EncryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             continue;
         }
-        if(!EVP_EncryptFinal(e_ctx, NULL, &final_size))
+        if(!EVP_EncryptFinal_ex(e_ctx, NULL, &final_size))
         {
             logError(SECURITY_CRYPTO, "Unable to create authentication for the datawriter submessage. EVP_EncryptFinal function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             continue;
         }
         serializer << remote_entity->Remote2EntityKeyMaterial.at(0).receiver_specific_key_id;
         EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, 16, serializer.getCurrentPosition());
         serializer.jump(16);
-        EVP_CIPHER_CTX_free(e_ctx);
 
         ++length;
     }
@@ -1823,46 +1925,47 @@ bool AESGCMGMAC_Transform::serialize_SecureDataTag(eprosima::fastcdr::Cdr& seria
 
         //Obtain MAC using ReceiverSpecificKey and the same Initialization Vector as before
         int actual_size = 0, final_size = 0;
-        EVP_CIPHER_CTX* e_ctx = EVP_CIPHER_CTX_new();
+        EVP_CIPHER_CTX* e_ctx = thread_encrypt_context();
         auto& trans_kind = remote_participant->Participant2ParticipantKeyMaterial.at(0).transformation_kind;
         if(trans_kind == c_transfrom_kind_aes128_gcm ||
             trans_kind == c_transfrom_kind_aes128_gmac)
         {
-            if(!EVP_EncryptInit(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(remote_participant->SessionKey.data()),
-                        initialization_vector.data()))
+            if(!init_cipher_context(e_ctx, EVP_aes_128_gcm(), (const unsigned char*)(remote_participant->SessionKey.data()),
+                        initialization_vector.data(), 1))
             {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                EVP_CIPHER_CTX_free(e_ctx);
+                logError(SECURITY_CRYPTO, "Unable to encode the payload. init_cipher_context function returns an error");
                 continue;
             }
         }
         else if(trans_kind == c_transfrom_kind_aes256_gcm ||
             trans_kind == c_transfrom_kind_aes256_gmac)
         {
-            if(!EVP_EncryptInit(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(remote_participant->SessionKey.data()),
-                        initialization_vector.data()))
+            if(!init_cipher_context(e_ctx, EVP_aes_256_gcm(), (const unsigned char*)(remote_participant->SessionKey.data()),
+                        initialization_vector.data(), 1))
             {
-                logError(SECURITY_CRYPTO, "Unable to encode the payload. EVP_EncryptInit function returns an error");
-                EVP_CIPHER_CTX_free(e_ctx);
+                logError(SECURITY_CRYPTO, "Unable to encode the payload. init_cipher_context function returns an error");
                 continue;
             }
         }
+        else
+        {
+            // The cipher context is reused, so it must not be updated with the key of a previous message.
+            logError(SECURITY_CRYPTO, "Invalid transformation kind");
+            continue;
+        }
         if(!EVP_EncryptUpdate(e_ctx, NULL, &actual_size, tag.common_mac.data(), 16))
         {
             logError(SECURITY_CRYPTO, "Unable to create authentication for the datawriter submessage. EVP_EncryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             continue;
         }
-        if(!EVP_EncryptFinal(e_ctx, NULL, &final_size))
+        if(!EVP_EncryptFinal_ex(e_ctx, NULL, &final_size))
         {
             logError(SECURITY_CRYPTO, "Unable to create authentication for the datawriter submessage. EVP_EncryptFinal function returns an error");
-            EVP_CIPHER_CTX_free(e_ctx);
             continue;
         }
         serializer << remote_participant->Participant2ParticipantKeyMaterial.at(0).receiver_specific_key_id;
         EVP_CIPHER_CTX_ctrl(e_ctx, EVP_CTRL_GCM_GET_TAG, 16, serializer.getCurrentPosition());
         serializer.jump(16);
-        EVP_CIPHER_CTX_free(e_ctx);
 
         ++length;
     }
@@ -1898,15 +2001,14 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataBody(eprosima::fastcdr::Cdr& de
     bool use_256_bits = (transformation_kind == c_transfrom_kind_aes256_gcm ||
         transformation_kind == c_transfrom_kind_aes256_gmac);
 
-    EVP_CIPHER_CTX *d_ctx = EVP_CIPHER_CTX_new();
+    EVP_CIPHER_CTX* d_ctx = thread_decrypt_context();
     int cipher_block_size = 0, actual_size = 0, final_size = 0;
 
     if(!use_256_bits)
     {
-        if(!EVP_DecryptInit(d_ctx, EVP_aes_128_gcm(), (const unsigned char *)session_key.data(), initialization_vector.data()))
+        if(!init_cipher_context(d_ctx, EVP_aes_128_gcm(), (const unsigned char *)session_key.data(), initialization_vector.data(), 0))
         {
-            logError(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptInit function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
+            logError(SECURITY_CRYPTO, "Unable to decode the payload. init_cipher_context function returns an error");
             return false;
         }
 
@@ -1914,10 +2016,9 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataBody(eprosima::fastcdr::Cdr& de
     }
     else
     {
-        if(!EVP_DecryptInit(d_ctx, EVP_aes_256_gcm(), (const unsigned char *)session_key.data(), initialization_vector.data()))
+        if(!init_cipher_context(d_ctx, EVP_aes_256_gcm(), (const unsigned char *)session_key.data(), initialization_vector.data(), 0))
         {
-            logError(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptInit function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
+            logError(SECURITY_CRYPTO, "Unable to decode the payload. init_cipher_context function returns an error");
             return false;
         }
 
@@ -1934,7 +2035,6 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataBody(eprosima::fastcdr::Cdr& de
         if (plain_buffer_len < (protected_len + cipher_block_size))
         {
             logWarning(SECURITY_CRYPTO, "Not enough memory to decode payload");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
     }
@@ -1944,19 +2044,16 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataBody(eprosima::fastcdr::Cdr& de
     if(!EVP_DecryptUpdate(d_ctx, output_buffer, &actual_size, input_buffer, protected_len))
     {
         logWarning(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptUpdate function returns an error");
-        EVP_CIPHER_CTX_free(d_ctx);
         return false;
     }
 
     EVP_CIPHER_CTX_ctrl(d_ctx, EVP_CTRL_GCM_SET_TAG, AES_BLOCK_SIZE, tag.common_mac.data());
 
-    if(!EVP_DecryptFinal(d_ctx, output_buffer, &final_size))
+    if(!EVP_DecryptFinal_ex(d_ctx, output_buffer, &final_size))
     {
         logWarning(SECURITY_CRYPTO, "Unable to decode the payload. EVP_DecryptFinal function returns an error");
-        EVP_CIPHER_CTX_free(d_ctx);
         return false;
     }
-    EVP_CIPHER_CTX_free(d_ctx);
 
     uint32_t cnt_len = do_encryption ? static_cast<uint32_t>(actual_size + final_size) : body_length;
     if (plain_buffer_len < cnt_len)
@@ -2017,7 +2114,7 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(eprosima::fastcdr::Cdr& dec
         const CryptoTransformKind& transformation_kind,
         const CryptoTransformKeyId& receiver_specific_key_id, const std::array<uint8_t, 32>& receiver_specific_key,
         const std::array<uint8_t,32>& master_salt, const std::array<uint8_t,12>& initialization_vector,
-        const uint32_t session_id, SecurityException& exception)
+        const uint32_t session_id, SessionKeyCache& session_keys, SecurityException& exception)
 {
     decoder >> tag.common_mac;
 
@@ -2050,14 +2147,15 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(eprosima::fastcdr::Cdr& dec
         }
 
         //Auth message - The point is that we cannot verify the authorship of the message with our receiver_specific_key the message could be crafted
-        EVP_CIPHER_CTX* d_ctx = EVP_CIPHER_CTX_new();
+        EVP_CIPHER_CTX* d_ctx = thread_decrypt_context();
         const EVP_CIPHER* d_cipher = nullptr;
 
         int actual_size = 0, final_size = 0;
 
         //Get ReceiverSpecificSessionKey
         std::array<uint8_t, 32> specific_session_key;
-        compute_sessionkey(specific_session_key, true, receiver_specific_key, master_salt, session_id);
+        get_received_sessionkey(specific_session_key, session_keys, true, receiver_specific_key_id,
+                receiver_specific_key, master_salt, session_id);
 
         //Verify specific MAC
         if(transformation_kind == c_transfrom_kind_aes128_gcm ||
@@ -2073,40 +2171,34 @@ bool AESGCMGMAC_Transform::deserialize_SecureDataTag(eprosima::fastcdr::Cdr& dec
         else
         {
             logError(SECURITY_CRYPTO, "Invalid transformation kind)");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
 
-        if(!EVP_DecryptInit(d_ctx, d_cipher, (const unsigned char *)specific_session_key.data(),
-                    initialization_vector.data()))
+        if(!init_cipher_context(d_ctx, d_cipher, (const unsigned char *)specific_session_key.data(),
+                    initialization_vector.data(), 0))
         {
-            logError(SECURITY_CRYPTO, "Unable to authenticate the message. EVP_DecryptInit function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
+            logError(SECURITY_CRYPTO, "Unable to authenticate the message. init_cipher_context function returns an error");
             return false;
         }
 
         if(!EVP_DecryptUpdate(d_ctx, NULL, &actual_size, tag.common_mac.data(), 16))
         {
             logError(SECURITY_CRYPTO, "Unable to authenticate the message. EVP_DecryptUpdate function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
 
         if (!EVP_CIPHER_CTX_ctrl(d_ctx, EVP_CTRL_GCM_SET_TAG, 16, tag.receiver_mac.data()))
         {
             logError(SECURITY_CRYPTO, "Unable to authenticate the message. EVP_CIPHER_CTX_ctrl function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
 
         if(!EVP_DecryptFinal_ex(d_ctx, NULL, &final_size))
         {
             logError(SECURITY_CRYPTO, "Unable to authenticate the message. EVP_DecryptFinal_ex function returns an error");
-            EVP_CIPHER_CTX_free(d_ctx);
             return false;
         }
 
-        EVP_CIPHER_CTX_free(d_ctx);
     }
 
     return true;
@@ -118,6 +118,23 @@ class AESGCMGMAC_Transform : public CryptoTransform
         const KeyMaterial_AES_GCM_GMAC& key, 
         const uint32_t session_id);
 
+    //Aux functions to obtain the session key of a received message, deriving it only on the first use
+    void get_received_sessionkey(
+        std::array<uint8_t, 32>& session_key,
+        SessionKeyCache& cache,
+        bool receiver_specific,
+        const CryptoTransformKeyId& key_id,
+        const std::array<uint8_t, 32>& master_key,
+        const std::array<uint8_t, 32>& master_salt,
+        const uint32_t session_id,
+        int key_len = 32);
+
+    void get_received_sessionkey(
+        std::array<uint8_t, 32>& session_key,
+        SessionKeyCache& cache,
+        const KeyMaterial_AES_GCM_GMAC& key,
+        const uint32_t session_id);
+
     //Serialization and deserialization of message components
     void serialize_SecureDataHeader(eprosima::fastcdr::Cdr& serializer,
             const CryptoTransformKind& transformation_kind, const CryptoTransformKeyId& transformation_key_id,
@@ -162,7 +179,7 @@ class AESGCMGMAC_Transform : public CryptoTransform
             const CryptoTransformKind& transformation_kind,
             const CryptoTransformKeyId& receiver_specific_key_id, const std::array<uint8_t, 32>& receiver_specific_key,
             const std::array<uint8_t,32>& master_salt, const std::array<uint8_t,12>& initialization_vector,
-            uint32_t session_id, SecurityException& exception);
+            uint32_t session_id, SessionKeyCache& session_keys, SecurityException& exception);
 
     uint32_t calculate_extra_size_for_rtps_message(uint32_t number_discovered_participants) const override;
 
@@ -135,6 +135,31 @@ struct KeySessionData
     KeySessionData() : session_id(std::numeric_limits<uint32_t>::max()), session_block_counter(0) {}
 };
 
+/* Session keys derived to decode messages from a remote element.
+ * A sender keeps its session_id during max_blocks_per_session blocks, so the keys of the last sessions are kept
+ * here instead of being derived again for every received message. Entries are replaced in round robin.
+ */
+struct DerivedSessionKey
+{
+    bool receiver_specific;
+    int key_len;
+    uint32_t session_id;
+    CryptoTransformKeyId key_id;
+    std::array<uint8_t, 32> master_key;
+    std::array<uint8_t, 32> master_salt;
+    std::array<uint8_t, 32> SessionKey;
+};
+
+struct SessionKeyCache
+{
+    SessionKeyCache() : num_entries(0), next_entry(0) {}
+
+    std::array<DerivedSessionKey, 4> entries;
+    size_t num_entries;
+    size_t next_entry;
+    std::mutex mutex_;
+};
+
 class  EntityKeyHandle
 {
     public:
@@ -166,6 +191,8 @@ class  EntityKeyHandle
         KeySessionData Sessions[2];
         uint64_t max_blocks_per_session;
         std::mutex mutex_;
+        //Session keys derived when decoding messages sent by this (remote) entity
+        mutable SessionKeyCache ReceivedSessionKeys;
 };
 typedef HandleImpl<EntityKeyHandle> AESGCMGMAC_WriterCryptoHandle;
 typedef HandleImpl<EntityKeyHandle> AESGCMGMAC_ReaderCryptoHandle;
@@ -204,6 +231,8 @@ class  ParticipantKeyHandle
         uint64_t session_block_counter;
         uint64_t max_blocks_per_session;
         std::mutex mutex_;
+        //Session keys derived when decoding messages sent by this (remote) participant
+        mutable SessionKeyCache ReceivedSessionKeys;
 };
 
 typedef HandleImpl<ParticipantKeyHandle> AESGCMGMAC_ParticipantCryptoHandle;
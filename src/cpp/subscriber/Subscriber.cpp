@@ -44,6 +44,43 @@ bool Subscriber::takeNextData(void* data,SampleInfo_t* info)
     return mp_impl->takeNextData(data,info);
 }
 
+bool Subscriber::take_loan(SampleLoan& loan, SampleInfo_t* info)
+{
+    return mp_impl->take_loan(loan, info);
+}
+
+bool Subscriber::return_loan(SampleLoan& loan)
+{
+    return mp_impl->return_loan(loan);
+}
+
+uint32_t Subscriber::read(
+        void* const* samples,
+        SampleInfo_t* infos,
+        uint32_t max_samples,
+        const InstanceHandle_t& handle)
+{
+    return mp_impl->read(samples, infos, max_samples, handle);
+}
+
+uint32_t Subscriber::take(
+        void* const* samples,
+        SampleInfo_t* infos,
+        uint32_t max_samples,
+        const InstanceHandle_t& handle)
+{
+    return mp_impl->take(samples, infos, max_samples, handle);
+}
+
+uint32_t Subscriber::take_loans(
+        SampleLoan* loans,
+        SampleInfo_t* infos,
+        uint32_t max_samples,
+        const InstanceHandle_t& handle)
+{
+    return mp_impl->take_loans(loans, infos, max_samples, handle);
+}
+
 bool Subscriber::updateAttributes(const SubscriberAttributes& att)
 {
     return mp_impl->updateAttributes(att);
@@ -26,6 +26,7 @@
 #include <fastrtps/TopicDataType.h>
 #include <fastrtps/log/Log.h>
 
+#include <algorithm>
 #include <mutex>
 
 using namespace eprosima::fastrtps;
@@ -66,6 +67,15 @@ SubscriberHistory::SubscriberHistory(
 
 SubscriberHistory::~SubscriberHistory()
 {
+    if (!loaned_changes_.empty())
+    {
+        logWarning(SUBSCRIBER, loaned_changes_.size() << " loaned samples were not returned");
+        for (CacheChange_t* change : loaned_changes_)
+        {
+            release_Cache(change);
+        }
+    }
+
     if (mp_subImpl->getType()->m_isGetKeyDefined)
     {
         mp_subImpl->getType()->deleteData(mp_getKeyObject);
@@ -371,32 +381,7 @@ bool SubscriberHistory::readNextData(
         if (this->mp_reader->nextUnreadCache(&change, &wp))
         {
             logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId << ": reading " << change->sequenceNumber);
-            if (change->kind == ALIVE)
-            {
-                this->mp_subImpl->getType()->deserialize(&change->serializedPayload, data);
-            }
-            if (info != nullptr)
-            {
-                info->sampleKind = change->kind;
-                info->sample_identity.writer_guid(change->writerGUID);
-                info->sample_identity.sequence_number(change->sequenceNumber);
-                info->sourceTimestamp = change->sourceTimestamp;
-                if (this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
-                {
-                    info->ownershipStrength = wp->ownership_strength();
-                }
-                if (this->mp_subImpl->getAttributes().topic.topicKind == WITH_KEY &&
-                    change->instanceHandle == c_InstanceHandle_Unknown && change->kind == ALIVE)
-                {
-                    bool is_key_protected = false;
-#if HAVE_SECURITY
-                    is_key_protected = mp_reader->getAttributes().security_attributes().is_key_protected;
-#endif
-                    this->mp_subImpl->getType()->getKey(data, &change->instanceHandle, is_key_protected);
-                }
-                info->iHandle = change->instanceHandle;
-                info->related_sample_identity = change->write_params.sample_identity();
-            }
+            get_sample(change, wp, data, info);
             return true;
         }
     }
@@ -425,38 +410,206 @@ bool SubscriberHistory::takeNextData(
         {
             logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId << ": taking seqNum" << change->sequenceNumber <<
                     " from writer: " << change->writerGUID);
-            if (change->kind == ALIVE)
+            get_sample(change, wp, data, info);
+            this->remove_change_sub(change);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SubscriberHistory::take_loan(
+        SampleLoan& loan,
+        SampleInfo_t* info,
+        std::chrono::steady_clock::time_point& max_blocking_time)
+{
+    if (mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY, "You need to create a Reader with this History before using it");
+        return false;
+    }
+
+    if (loan.is_loaned())
+    {
+        logError(SUBSCRIBER, "The loan already holds a sample. Return it before taking another one");
+        return false;
+    }
+
+    std::unique_lock<RecursiveTimedMutex> lock(*mp_mutex, std::defer_lock);
+
+    if(lock.try_lock_until(max_blocking_time))
+    {
+        CacheChange_t* change;
+        WriterProxy * wp;
+        if (this->mp_reader->nextUntakenCache(&change, &wp))
+        {
+            logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId << ": loaning seqNum" << change->sequenceNumber <<
+                    " from writer: " << change->writerGUID);
+            // Keyed changes always have their instance handle set by received_change
+            get_sample(change, wp, nullptr, info);
+
+            if (this->remove_change_sub(change, false))
             {
-                this->mp_subImpl->getType()->deserialize(&change->serializedPayload, data);
+                loaned_changes_.push_back(change);
+                loan.change_ = change;
+                loan.plain_ = change->kind == ALIVE && mp_subImpl->getType()->is_plain();
+                return true;
             }
-            if (info != nullptr)
+        }
+    }
+
+    return false;
+}
+
+uint32_t SubscriberHistory::read(
+        void* const* samples,
+        SampleInfo_t* infos,
+        uint32_t max_samples,
+        const InstanceHandle_t& handle,
+        std::chrono::steady_clock::time_point& max_blocking_time)
+{
+    if (mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY, "You need to create a Reader with this History before using it");
+        return 0;
+    }
+
+    std::unique_lock<RecursiveTimedMutex> lock(*mp_mutex, std::defer_lock);
+
+    uint32_t count = 0;
+    std::vector<CacheChange_t*>* instance_changes = nullptr;
+    if (lock.try_lock_until(max_blocking_time) && get_instance_changes(handle, &instance_changes))
+    {
+        CacheChange_t* change;
+        WriterProxy * wp;
+        size_t index = 0;
+        while (count < max_samples && next_change(instance_changes, index, true, &change, &wp))
+        {
+            logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId << ": reading " << change->sequenceNumber);
+            get_sample(change, wp, samples[count], infos != nullptr ? &infos[count] : nullptr);
+            ++count;
+            ++index;
+        }
+    }
+
+    return count;
+}
+
+uint32_t SubscriberHistory::take(
+        void* const* samples,
+        SampleInfo_t* infos,
+        uint32_t max_samples,
+        const InstanceHandle_t& handle,
+        std::chrono::steady_clock::time_point& max_blocking_time)
+{
+    if (mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY, "You need to create a Reader with this History before using it");
+        return 0;
+    }
+
+    std::unique_lock<RecursiveTimedMutex> lock(*mp_mutex, std::defer_lock);
+
+    uint32_t count = 0;
+    std::vector<CacheChange_t*>* instance_changes = nullptr;
+    if (lock.try_lock_until(max_blocking_time) && get_instance_changes(handle, &instance_changes))
+    {
+        CacheChange_t* change;
+        WriterProxy * wp;
+        size_t index = 0;
+        // Removing the change shifts the next one to the same index of the instance.
+        while (count < max_samples && next_change(instance_changes, index, false, &change, &wp))
+        {
+            logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId << ": taking seqNum" << change->sequenceNumber <<
+                    " from writer: " << change->writerGUID);
+            get_sample(change, wp, samples[count], infos != nullptr ? &infos[count] : nullptr);
+            this->remove_change_sub(change);
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+uint32_t SubscriberHistory::take_loans(
+        SampleLoan* loans,
+        SampleInfo_t* infos,
+        uint32_t max_samples,
+        const InstanceHandle_t& handle,
+        std::chrono::steady_clock::time_point& max_blocking_time)
+{
+    if (mp_reader == nullptr || mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY, "You need to create a Reader with this History before using it");
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < max_samples; ++i)
+    {
+        if (loans[i].is_loaned())
+        {
+            logError(SUBSCRIBER, "The loan already holds a sample. Return it before taking another one");
+            return 0;
+        }
+    }
+
+    std::unique_lock<RecursiveTimedMutex> lock(*mp_mutex, std::defer_lock);
+
+    uint32_t count = 0;
+    std::vector<CacheChange_t*>* instance_changes = nullptr;
+    if (lock.try_lock_until(max_blocking_time) && get_instance_changes(handle, &instance_changes))
+    {
+        CacheChange_t* change;
+        WriterProxy * wp;
+        size_t index = 0;
+        bool is_plain = mp_subImpl->getType()->is_plain();
+        while (count < max_samples && next_change(instance_changes, index, false, &change, &wp))
+        {
+            logInfo(SUBSCRIBER, this->mp_reader->getGuid().entityId << ": loaning seqNum" << change->sequenceNumber <<
+                    " from writer: " << change->writerGUID);
+            get_sample(change, wp, nullptr, infos != nullptr ? &infos[count] : nullptr);
+
+            if (!this->remove_change_sub(change, false))
             {
-                info->sampleKind = change->kind;
-                info->sample_identity.writer_guid(change->writerGUID);
-                info->sample_identity.sequence_number(change->sequenceNumber);
-                info->sourceTimestamp = change->sourceTimestamp;
-                if (this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
-                {
-                    info->ownershipStrength = wp->ownership_strength();
-                }
-                if (this->mp_subImpl->getAttributes().topic.topicKind == WITH_KEY &&
-                        change->instanceHandle == c_InstanceHandle_Unknown && change->kind == ALIVE)
-                {
-                    bool is_key_protected = false;
-#if HAVE_SECURITY
-                    is_key_protected = mp_reader->getAttributes().security_attributes().is_key_protected;
-#endif
-                    this->mp_subImpl->getType()->getKey(data, &change->instanceHandle, is_key_protected);
-                }
-                info->iHandle = change->instanceHandle;
-                info->related_sample_identity = change->write_params.sample_identity();
+                break;
             }
-            this->remove_change_sub(change);
-            return true;
+
+            loaned_changes_.push_back(change);
+            loans[count].change_ = change;
+            loans[count].plain_ = change->kind == ALIVE && is_plain;
+            ++count;
         }
     }
 
-    return false;
+    return count;
+}
+
+bool SubscriberHistory::return_loan(SampleLoan& loan)
+{
+    if (mp_mutex == nullptr)
+    {
+        logError(RTPS_HISTORY, "You need to create a Reader with this History before using it");
+        return false;
+    }
+
+    {
+        std::lock_guard<RecursiveTimedMutex> guard(*mp_mutex);
+        auto it = std::find(loaned_changes_.begin(), loaned_changes_.end(), loan.change_);
+        if (loan.change_ == nullptr || it == loaned_changes_.end())
+        {
+            logError(SUBSCRIBER, "Trying to return a sample not loaned by this Subscriber");
+            return false;
+        }
+
+        loaned_changes_.erase(it);
+    }
+
+    // Outside of the history lock, which release_Cache only takes when the pool needs it.
+    release_Cache(loan.change_);
+    loan.change_ = nullptr;
+    loan.plain_ = false;
+    return true;
 }
 
 bool SubscriberHistory::find_key(
@@ -482,6 +635,7 @@ bool SubscriberHistory::find_key(
         {
             if (vit->second.cache_changes.size() == 0)
             {
+                instance_deadlines_.erase(vit->first);
                 keyed_changes_.erase(vit);
                 *vit_out = keyed_changes_.insert(std::make_pair(a_change->instanceHandle, KeyedChanges())).first;
                 return true;
@@ -493,7 +647,90 @@ bool SubscriberHistory::find_key(
 }
 
 
-bool SubscriberHistory::remove_change_sub(CacheChange_t* change)
+bool SubscriberHistory::get_instance_changes(
+        const InstanceHandle_t& handle,
+        std::vector<CacheChange_t*>** instance_changes)
+{
+    *instance_changes = nullptr;
+    if (handle == c_InstanceHandle_Unknown || mp_subImpl->getAttributes().topic.getTopicKind() == NO_KEY)
+    {
+        return true;
+    }
+
+    t_m_Inst_Caches::iterator vit = keyed_changes_.find(handle);
+    if (vit == keyed_changes_.end())
+    {
+        return false;
+    }
+
+    *instance_changes = &vit->second.cache_changes;
+    return true;
+}
+
+bool SubscriberHistory::next_change(
+        std::vector<CacheChange_t*>* instance_changes,
+        size_t& index,
+        bool only_unread,
+        CacheChange_t** change,
+        WriterProxy** wp)
+{
+    if (instance_changes == nullptr)
+    {
+        return only_unread ? mp_reader->nextUnreadCache(change, wp) : mp_reader->nextUntakenCache(change, wp);
+    }
+
+    // Changes of an instance are kept in reception order, so they are visited as nextUnreadCache would.
+    for (; index < instance_changes->size(); ++index)
+    {
+        CacheChange_t* candidate = (*instance_changes)[index];
+        if ((!only_unread || !candidate->isRead) && mp_reader->readCache(candidate, wp))
+        {
+            *change = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SubscriberHistory::get_sample(
+        CacheChange_t* change,
+        WriterProxy* wp,
+        void* data,
+        SampleInfo_t* info)
+{
+    if (data != nullptr && change->kind == ALIVE)
+    {
+        this->mp_subImpl->getType()->deserialize(&change->serializedPayload, data);
+    }
+
+    if (info != nullptr)
+    {
+        info->sampleKind = change->kind;
+        info->sample_identity.writer_guid(change->writerGUID);
+        info->sample_identity.sequence_number(change->sequenceNumber);
+        info->sourceTimestamp = change->sourceTimestamp;
+        if (this->mp_subImpl->getAttributes().qos.m_ownership.kind == EXCLUSIVE_OWNERSHIP_QOS)
+        {
+            info->ownershipStrength = wp->ownership_strength();
+        }
+        if (data != nullptr && this->mp_subImpl->getAttributes().topic.topicKind == WITH_KEY &&
+                change->instanceHandle == c_InstanceHandle_Unknown && change->kind == ALIVE)
+        {
+            bool is_key_protected = false;
+#if HAVE_SECURITY
+            is_key_protected = mp_reader->getAttributes().security_attributes().is_key_protected;
+#endif
+            this->mp_subImpl->getType()->getKey(data, &change->instanceHandle, is_key_protected);
+        }
+        info->iHandle = change->instanceHandle;
+        info->related_sample_identity = change->write_params.sample_identity();
+    }
+}
+
+bool SubscriberHistory::remove_change_sub(
+        CacheChange_t* change,
+        bool release)
 {
     if (mp_reader == nullptr || mp_mutex == nullptr)
     {
@@ -504,7 +741,7 @@ bool SubscriberHistory::remove_change_sub(CacheChange_t* change)
     std::lock_guard<RecursiveTimedMutex> guard(*mp_mutex);
     if (mp_subImpl->getAttributes().topic.getTopicKind() == NO_KEY)
     {
-        if (this->remove_change(change))
+        if (this->remove_change(change, release))
         {
             m_isHistoryFull = false;
             return true;
@@ -523,7 +760,7 @@ bool SubscriberHistory::remove_change_sub(CacheChange_t* change)
         {
             if ((*chit)->sequenceNumber == change->sequenceNumber && (*chit)->writerGUID == change->writerGUID)
             {
-                if (remove_change(change))
+                if (remove_change(change, release))
                 {
                     vit->second.cache_changes.erase(chit);
                     m_isHistoryFull = false;
@@ -554,12 +791,14 @@ bool SubscriberHistory::set_next_deadline(
     }
     else if (mp_subImpl->getAttributes().topic.getTopicKind() == WITH_KEY)
     {
-        if (keyed_changes_.find(handle) == keyed_changes_.end())
+        auto it = keyed_changes_.find(handle);
+        if (it == keyed_changes_.end())
         {
             return false;
         }
 
-        keyed_changes_[handle].next_deadline_us = next_deadline_us;
+        it->second.next_deadline_us = next_deadline_us;
+        instance_deadlines_.update(handle, next_deadline_us);
         return true;
     }
 
@@ -584,14 +823,13 @@ bool SubscriberHistory::get_next_deadline(
     }
     else if (mp_subImpl->getAttributes().topic.getTopicKind() == WITH_KEY)
     {
-        auto min = std::min_element(keyed_changes_.begin(),
-                                    keyed_changes_.end(),
-                                    [](
-                                    const std::pair<InstanceHandle_t, KeyedChanges> &lhs,
-                                    const std::pair<InstanceHandle_t, KeyedChanges> &rhs)
-        { return lhs.second.next_deadline_us < rhs.second.next_deadline_us; });
-        handle = min->first;
-        next_deadline_us = min->second.next_deadline_us;
+        if (instance_deadlines_.empty())
+        {
+            return false;
+        }
+
+        handle = instance_deadlines_.top().second;
+        next_deadline_us = instance_deadlines_.top().first;
         return true;
     }
 
@@ -115,6 +115,51 @@ bool SubscriberImpl::takeNextData(void* data,SampleInfo_t* info)
     return this->m_history.takeNextData(data, info, max_blocking_time);
 }
 
+bool SubscriberImpl::take_loan(SampleLoan& loan, SampleInfo_t* info)
+{
+    auto max_blocking_time = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(::TimeConv::Time_t2MicroSecondsInt64(m_att.qos.m_reliability.max_blocking_time));
+    return this->m_history.take_loan(loan, info, max_blocking_time);
+}
+
+bool SubscriberImpl::return_loan(SampleLoan& loan)
+{
+    return this->m_history.return_loan(loan);
+}
+
+uint32_t SubscriberImpl::read(
+        void* const* samples,
+        SampleInfo_t* infos,
+        uint32_t max_samples,
+        const InstanceHandle_t& handle)
+{
+    auto max_blocking_time = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(::TimeConv::Time_t2MicroSecondsInt64(m_att.qos.m_reliability.max_blocking_time));
+    return this->m_history.read(samples, infos, max_samples, handle, max_blocking_time);
+}
+
+uint32_t SubscriberImpl::take(
+        void* const* samples,
+        SampleInfo_t* infos,
+        uint32_t max_samples,
+        const InstanceHandle_t& handle)
+{
+    auto max_blocking_time = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(::TimeConv::Time_t2MicroSecondsInt64(m_att.qos.m_reliability.max_blocking_time));
+    return this->m_history.take(samples, infos, max_samples, handle, max_blocking_time);
+}
+
+uint32_t SubscriberImpl::take_loans(
+        SampleLoan* loans,
+        SampleInfo_t* infos,
+        uint32_t max_samples,
+        const InstanceHandle_t& handle)
+{
+    auto max_blocking_time = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(::TimeConv::Time_t2MicroSecondsInt64(m_att.qos.m_reliability.max_blocking_time));
+    return this->m_history.take_loans(loans, infos, max_samples, handle, max_blocking_time);
+}
+
 const GUID_t& SubscriberImpl::getGuid()
 {
     return mp_reader->getGuid();
@@ -85,6 +85,27 @@ class SubscriberImpl
 
     ///@}
 
+    bool take_loan(SampleLoan& loan, SampleInfo_t* info);
+    bool return_loan(SampleLoan& loan);
+
+    uint32_t read(
+            void* const* samples,
+            SampleInfo_t* infos,
+            uint32_t max_samples,
+            const rtps::InstanceHandle_t& handle);
+
+    uint32_t take(
+            void* const* samples,
+            SampleInfo_t* infos,
+            uint32_t max_samples,
+            const rtps::InstanceHandle_t& handle);
+
+    uint32_t take_loans(
+            SampleLoan* loans,
+            SampleInfo_t* infos,
+            uint32_t max_samples,
+            const rtps::InstanceHandle_t& handle);
+
     /**
      * Update the Attributes of the subscriber;
      * @param att Reference to a SubscriberAttributes object to update the parameters;
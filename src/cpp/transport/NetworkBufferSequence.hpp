@@ -0,0 +1,100 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __TRANSPORT_NETWORKBUFFERSEQUENCE_HPP__
+#define __TRANSPORT_NETWORKBUFFERSEQUENCE_HPP__
+
+#include <asio.hpp>
+#include <fastrtps/transport/NetworkBuffer.h>
+
+#include <array>
+#include <cassert>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Adapts a list of NetworkBuffer to an asio ConstBufferSequence, so it can be given to
+ * send_to / write and end up in a single sendmsg / writev call.
+ *
+ * The adapter lives on the stack and never allocates. Asio gathers at most
+ * max_buffers slices in one system call, so longer lists are rejected by assign()
+ * and the caller should coalesce them instead.
+ */
+class NetworkBufferSequence
+{
+    public:
+
+        typedef asio::const_buffer value_type;
+        typedef const asio::const_buffer* const_iterator;
+
+        //! Maximum number of slices gathered in one call.
+        static constexpr size_t max_buffers = 64;
+
+        NetworkBufferSequence() = default;
+
+        /**
+         * Appends a single slice (i.e. a transport header) to the sequence.
+         */
+        void push_back(
+                const void* data,
+                size_t size)
+        {
+            assert(count_ < max_buffers);
+            buffers_[count_++] = asio::const_buffer(data, size);
+        }
+
+        /**
+         * Appends all the slices in a list.
+         * @return false when the list does not fit in the sequence.
+         */
+        bool assign(const std::vector<NetworkBuffer>& buffers)
+        {
+            if (buffers.size() > max_buffers - count_)
+            {
+                return false;
+            }
+
+            for (const NetworkBuffer& buf : buffers)
+            {
+                buffers_[count_++] = asio::const_buffer(buf.buffer, buf.size);
+            }
+
+            return true;
+        }
+
+        const_iterator begin() const
+        {
+            return buffers_.data();
+        }
+
+        const_iterator end() const
+        {
+            return buffers_.data() + count_;
+        }
+
+    private:
+
+        std::array<asio::const_buffer, max_buffers> buffers_;
+
+        size_t count_ = 0;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // __TRANSPORT_NETWORKBUFFERSEQUENCE_HPP__
@@ -0,0 +1,801 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/transport/SharedMemTransport.h>
+#include <fastrtps/log/Log.h>
+#include <fastrtps/utils/IPLocator.h>
+
+#include "shared_mem/SharedMemChannelResource.hpp"
+#include "shared_mem/SharedMemPort.hpp"
+#include "shared_mem/SharedMemSegment.hpp"
+#include "shared_mem/SharedMemSenderResource.hpp"
+
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+namespace {
+
+//! Header placed before each message in the segment of its sender.
+struct BufferHeader
+{
+    //! Number of holders of the buffer: the sender while queuing it, plus every listener it was queued on.
+    std::atomic<uint32_t> references;
+    //! Size of the whole block, header included.
+    uint32_t block_size;
+};
+
+const uint32_t buffer_alignment = 64;
+
+uint32_t round_up(
+        uint32_t value,
+        uint32_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+const char* const segment_name_prefix = "/fastrtps_";
+
+std::string segment_name(uint64_t segment_id)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%s%016llx", segment_name_prefix, static_cast<unsigned long long>(segment_id));
+    return name;
+}
+
+//! Removes the segments of transports whose process is not running anymore.
+void remove_stale_segments()
+{
+    size_t prefix_length = strlen(segment_name_prefix);
+    for (const std::string& name : SharedMemSegment::list(segment_name_prefix))
+    {
+        // Segment identifiers have the process in their upper half. Ports and other objects do not parse.
+        const char* id_text = name.c_str() + prefix_length;
+        char* id_end = nullptr;
+        uint64_t segment_id = strtoull(id_text, &id_end, 16);
+        if (name.size() == prefix_length + 16 && *id_end == 0 && isxdigit(static_cast<unsigned char>(*id_text)) &&
+                !SharedMemSegment::is_process_alive(static_cast<uint32_t>(segment_id >> 32)))
+        {
+            logInfo(RTPS_TRANSPORT_SHM, "Removing shared memory segment " << name);
+            SharedMemSegment::remove(name);
+        }
+    }
+
+    SharedMemPort::remove_stale_ports();
+}
+
+BufferHeader* buffer_header(
+        void* base,
+        uint32_t offset)
+{
+    return reinterpret_cast<BufferHeader*>(static_cast<octet*>(base) + offset);
+}
+
+octet* buffer_payload(
+        void* base,
+        uint32_t offset)
+{
+    return static_cast<octet*>(base) + offset + sizeof(BufferHeader);
+}
+
+uint32_t locator_host(const Locator_t& locator)
+{
+    return (static_cast<uint32_t>(locator.address[12]) << 24) |
+           (static_cast<uint32_t>(locator.address[13]) << 16) |
+           (static_cast<uint32_t>(locator.address[14]) << 8) |
+           static_cast<uint32_t>(locator.address[15]);
+}
+
+} // namespace
+
+SharedMemTransportDescriptor::SharedMemTransportDescriptor()
+    : TransportDescriptorInterface(s_maximumMessageSize, s_maximumInitialPeersRange)
+    , segment_size(s_defaultSharedMemSegmentSize)
+    , port_queue_capacity(s_defaultSharedMemPortQueueCapacity)
+    , permissions(s_defaultSharedMemPermissions)
+{
+}
+
+SharedMemTransportDescriptor::SharedMemTransportDescriptor(const SharedMemTransportDescriptor& t)
+    : TransportDescriptorInterface(t)
+    , segment_size(t.segment_size)
+    , port_queue_capacity(t.port_queue_capacity)
+    , permissions(t.permissions)
+{
+}
+
+TransportInterface* SharedMemTransportDescriptor::create_transport() const
+{
+    return new SharedMemTransport(*this);
+}
+
+SharedMemTransport::SharedMemTransport(const SharedMemTransportDescriptor& descriptor)
+    : TransportInterface(LOCATOR_KIND_SHM)
+    , configuration_(descriptor)
+    , host_id_(0)
+    , segment_id_(0)
+    , allocation_head_(0)
+    , allocation_tail_(0)
+    , allocation_used_(0)
+{
+}
+
+SharedMemTransport::~SharedMemTransport()
+{
+    {
+        std::lock_guard<std::mutex> lock(input_channels_mutex_);
+        input_channels_.clear();
+    }
+
+    output_ports_.clear();
+
+    if (segment_)
+    {
+        // Listeners that already mapped the segment keep it until they unmap it.
+        SharedMemSegment::remove(segment_->name());
+    }
+}
+
+bool SharedMemTransport::init()
+{
+    if (!SharedMemSegment::is_supported())
+    {
+        logError(RTPS_TRANSPORT_SHM, "Shared memory transport is not supported on this platform");
+        return false;
+    }
+
+    uint32_t segment_size = round_up(configuration_.segment_size, buffer_alignment);
+    if (configuration_.max_message_size() == 0 ||
+            round_up(configuration_.max_message_size() + sizeof(BufferHeader), buffer_alignment) > segment_size)
+    {
+        logError(RTPS_TRANSPORT_SHM, "segment_size (" << configuration_.segment_size <<
+                ") must be greater than maxMessageSize (" << configuration_.max_message_size() << ")");
+        return false;
+    }
+
+    if (configuration_.port_queue_capacity == 0)
+    {
+        logError(RTPS_TRANSPORT_SHM, "port_queue_capacity cannot be 0");
+        return false;
+    }
+
+    host_id_ = SharedMemSegment::host_id();
+
+    // Processes that crashed left their objects behind.
+    remove_stale_segments();
+
+    std::random_device random;
+    uint64_t process_id = SharedMemSegment::current_process_id();
+    for (uint32_t tries = 0; tries < 10 && !segment_; ++tries)
+    {
+        segment_id_ = (process_id << 32) | static_cast<uint32_t>(random());
+        segment_ = SharedMemSegment::create(segment_name(segment_id_), segment_size, configuration_.permissions);
+    }
+
+    if (!segment_)
+    {
+        logError(RTPS_TRANSPORT_SHM, "Cannot create the shared memory segment of the transport");
+        return false;
+    }
+
+    return true;
+}
+
+SharedMemTransport::PortKey SharedMemTransport::port_key(const Locator_t& locator)
+{
+    return PortKey(locator.port, IPLocator::isMulticast(locator));
+}
+
+void SharedMemTransport::fill_locator(
+        Locator_t& locator,
+        uint32_t port,
+        bool is_multicast) const
+{
+    locator.kind = LOCATOR_KIND_SHM;
+    locator.port = port;
+    LOCATOR_ADDRESS_INVALID(locator.address);
+    if (is_multicast)
+    {
+        locator.address[0] = 0xFF;
+    }
+    locator.address[12] = static_cast<octet>(host_id_ >> 24);
+    locator.address[13] = static_cast<octet>(host_id_ >> 16);
+    locator.address[14] = static_cast<octet>(host_id_ >> 8);
+    locator.address[15] = static_cast<octet>(host_id_);
+}
+
+bool SharedMemTransport::IsInputChannelOpen(const Locator_t& locator) const
+{
+    std::lock_guard<std::mutex> lock(input_channels_mutex_);
+    return IsLocatorSupported(locator) && input_channels_.find(port_key(locator)) != input_channels_.end();
+}
+
+bool SharedMemTransport::IsLocatorSupported(const Locator_t& locator) const
+{
+    return locator.kind == transport_kind_;
+}
+
+bool SharedMemTransport::is_locator_allowed(const Locator_t& locator) const
+{
+    return IsLocatorSupported(locator) && (IPLocator::isMulticast(locator) || locator_host(locator) == host_id_);
+}
+
+Locator_t SharedMemTransport::RemoteToMainLocal(const Locator_t&) const
+{
+    Locator_t locator;
+    fill_locator(locator, 0, false);
+    return locator;
+}
+
+bool SharedMemTransport::transform_remote_locator(
+        const Locator_t& remote_locator,
+        Locator_t& result_locator) const
+{
+    if (!is_locator_allowed(remote_locator))
+    {
+        return false;
+    }
+
+    result_locator = remote_locator;
+    return true;
+}
+
+bool SharedMemTransport::OpenOutputChannel(
+        SendResourceList& sender_resource_list,
+        const Locator_t& locator)
+{
+    if (!IsLocatorSupported(locator))
+    {
+        return false;
+    }
+
+    for (auto& sender_resource : sender_resource_list)
+    {
+        if (SharedMemSenderResource::cast(*this, sender_resource.get()) != nullptr)
+        {
+            return true;
+        }
+    }
+
+    sender_resource_list.emplace_back(
+        static_cast<SenderResource*>(new SharedMemSenderResource(*this)));
+    return true;
+}
+
+bool SharedMemTransport::OpenInputChannel(
+        const Locator_t& locator,
+        TransportReceiverInterface* receiver,
+        uint32_t)
+{
+    if (!is_locator_allowed(locator))
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(input_channels_mutex_);
+    PortKey key = port_key(locator);
+    if (input_channels_.find(key) != input_channels_.end())
+    {
+        return false;
+    }
+
+    std::unique_ptr<SharedMemPort> port = SharedMemPort::open(locator.port, key.second,
+                    configuration_.port_queue_capacity, configuration_.permissions);
+    if (!port)
+    {
+        return false;
+    }
+
+    int32_t listener = port->register_listener([this](const SharedMemBufferDescriptor& descriptor)
+                    {
+                        release_pending_buffer(descriptor);
+                    });
+    if (listener < 0)
+    {
+        logInfo(RTPS_TRANSPORT_SHM, "Shared memory port " << locator << " is in use");
+        return false;
+    }
+
+    input_channels_[key].reset(new SharedMemChannelResource(this, std::move(port), static_cast<uint32_t>(listener),
+            locator, receiver));
+    return true;
+}
+
+bool SharedMemTransport::CloseInputChannel(const Locator_t& locator)
+{
+    std::unique_ptr<SharedMemChannelResource> channel;
+
+    {
+        std::lock_guard<std::mutex> lock(input_channels_mutex_);
+        auto it = input_channels_.find(port_key(locator));
+        if (it == input_channels_.end())
+        {
+            return false;
+        }
+
+        channel = std::move(it->second);
+        input_channels_.erase(it);
+    }
+
+    // Joins the thread of the channel, which may be delivering a message right now.
+    channel.reset();
+    return true;
+}
+
+bool SharedMemTransport::DoInputLocatorsMatch(
+        const Locator_t& left,
+        const Locator_t& right) const
+{
+    return IsLocatorSupported(left) && IsLocatorSupported(right) && port_key(left) == port_key(right);
+}
+
+LocatorList_t SharedMemTransport::NormalizeLocator(const Locator_t& locator)
+{
+    LocatorList_t list;
+
+    if (!IPLocator::isMulticast(locator) && !IsAddressDefined(locator))
+    {
+        Locator_t normalized;
+        fill_locator(normalized, locator.port, false);
+        list.push_back(normalized);
+    }
+    else
+    {
+        list.push_back(locator);
+    }
+
+    return list;
+}
+
+void SharedMemTransport::select_locators(LocatorSelector& selector) const
+{
+    ResourceLimitedVector<LocatorSelectorEntry*>& entries = selector.transport_starts();
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        LocatorSelectorEntry* entry = entries[i];
+        if (entry->transport_should_process)
+        {
+            bool selected = false;
+            bool has_unicast = false;
+
+            for (size_t j = 0; j < entry->unicast.size(); ++j)
+            {
+                if (IsLocatorSupported(entry->unicast[j]))
+                {
+                    has_unicast = true;
+                    if (is_locator_allowed(entry->unicast[j]) && !selector.is_selected(entry->unicast[j]))
+                    {
+                        entry->state.unicast.push_back(j);
+                        selected = true;
+                    }
+                }
+            }
+
+            // Entries of other hosts are not reachable through multicast either.
+            if (!has_unicast)
+            {
+                for (size_t j = 0; j < entry->multicast.size() && !selected; ++j)
+                {
+                    if (IsLocatorSupported(entry->multicast[j]) && !selector.is_selected(entry->multicast[j]))
+                    {
+                        entry->state.multicast.push_back(j);
+                        selected = true;
+                    }
+                }
+            }
+
+            if (selected)
+            {
+                selector.select(i);
+            }
+        }
+    }
+}
+
+bool SharedMemTransport::is_local_locator(const Locator_t& locator) const
+{
+    return is_locator_allowed(locator);
+}
+
+void SharedMemTransport::AddDefaultOutputLocator(LocatorList_t&)
+{
+}
+
+bool SharedMemTransport::getDefaultMetatrafficMulticastLocators(
+        LocatorList_t& locators,
+        uint32_t metatraffic_multicast_port) const
+{
+    Locator_t locator;
+    fill_locator(locator, metatraffic_multicast_port, true);
+    locators.push_back(locator);
+    return true;
+}
+
+bool SharedMemTransport::getDefaultMetatrafficUnicastLocators(
+        LocatorList_t& locators,
+        uint32_t metatraffic_unicast_port) const
+{
+    Locator_t locator;
+    fill_locator(locator, metatraffic_unicast_port, false);
+    locators.push_back(locator);
+    return true;
+}
+
+bool SharedMemTransport::getDefaultUnicastLocators(
+        LocatorList_t& locators,
+        uint32_t unicast_port) const
+{
+    Locator_t locator;
+    fill_locator(locator, unicast_port, false);
+    locators.push_back(locator);
+    return true;
+}
+
+bool SharedMemTransport::fillMetatrafficMulticastLocator(
+        Locator_t& locator,
+        uint32_t metatraffic_multicast_port) const
+{
+    if (locator.port == 0)
+    {
+        locator.port = metatraffic_multicast_port;
+    }
+    return true;
+}
+
+bool SharedMemTransport::fillMetatrafficUnicastLocator(
+        Locator_t& locator,
+        uint32_t metatraffic_unicast_port) const
+{
+    if (locator.port == 0)
+    {
+        locator.port = metatraffic_unicast_port;
+    }
+    if (!IPLocator::isMulticast(locator) && !IsAddressDefined(locator))
+    {
+        fill_locator(locator, locator.port, false);
+    }
+    return true;
+}
+
+bool SharedMemTransport::configureInitialPeerLocator(
+        Locator_t& locator,
+        const PortParameters& port_params,
+        uint32_t domainId,
+        LocatorList_t& list) const
+{
+    if (locator.port == 0)
+    {
+        for (uint32_t i = 0; i < configuration_.maxInitialPeersRange; ++i)
+        {
+            Locator_t auxloc(locator);
+            auxloc.port = port_params.getUnicastPort(domainId, i);
+            list.push_back(auxloc);
+        }
+    }
+    else
+    {
+        list.push_back(locator);
+    }
+
+    return true;
+}
+
+bool SharedMemTransport::fillUnicastLocator(
+        Locator_t& locator,
+        uint32_t well_known_port) const
+{
+    if (locator.port == 0)
+    {
+        locator.port = well_known_port;
+    }
+    if (!IsAddressDefined(locator))
+    {
+        fill_locator(locator, locator.port, false);
+    }
+    return true;
+}
+
+bool SharedMemTransport::send(
+        const octet* send_buffer,
+        uint32_t send_buffer_size,
+        const Locator_t& remote_locator,
+        const std::chrono::microseconds& timeout)
+{
+    if (!is_locator_allowed(remote_locator) || send_buffer_size > configuration_.max_message_size())
+    {
+        return false;
+    }
+
+    SharedMemPort* port = output_port(remote_locator);
+    if (port == nullptr)
+    {
+        return false;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    uint32_t offset = 0;
+    if (!allocate_buffer(send_buffer_size, deadline, offset))
+    {
+        logWarning(RTPS_MSG_OUT, "Shared memory segment full. Message to " << remote_locator << " dropped");
+        return false;
+    }
+
+    memcpy(buffer_payload(segment_->base(), offset), send_buffer, send_buffer_size);
+    return deliver_buffer(port, offset, send_buffer_size, deadline);
+}
+
+bool SharedMemTransport::send(
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        const Locator_t& remote_locator,
+        const std::chrono::microseconds& timeout)
+{
+    if (!is_locator_allowed(remote_locator) || total_bytes > configuration_.max_message_size())
+    {
+        return false;
+    }
+
+    SharedMemPort* port = output_port(remote_locator);
+    if (port == nullptr)
+    {
+        return false;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    uint32_t offset = 0;
+    if (!allocate_buffer(total_bytes, deadline, offset))
+    {
+        logWarning(RTPS_MSG_OUT, "Shared memory segment full. Message to " << remote_locator << " dropped");
+        return false;
+    }
+
+    // The slices are gathered straight into shared memory.
+    octet* payload = buffer_payload(segment_->base(), offset);
+    uint32_t copied = 0;
+    for (const NetworkBuffer& buffer : buffers)
+    {
+        uint32_t size = std::min(buffer.size, total_bytes - copied);
+        memcpy(payload + copied, buffer.buffer, size);
+        copied += size;
+    }
+
+    return deliver_buffer(port, offset, total_bytes, deadline);
+}
+
+SharedMemPort* SharedMemTransport::output_port(const Locator_t& locator)
+{
+    std::lock_guard<std::mutex> lock(output_ports_mutex_);
+
+    PortKey key = port_key(locator);
+    auto it = output_ports_.find(key);
+    if (it != output_ports_.end())
+    {
+        return it->second.get();
+    }
+
+    std::unique_ptr<SharedMemPort> port = SharedMemPort::open(locator.port, key.second,
+                    configuration_.port_queue_capacity, configuration_.permissions);
+    SharedMemPort* returned_port = port.get();
+    if (port)
+    {
+        output_ports_[key] = std::move(port);
+    }
+    return returned_port;
+}
+
+bool SharedMemTransport::allocate_buffer(
+        uint32_t size,
+        const std::chrono::steady_clock::time_point& deadline,
+        uint32_t& offset)
+{
+    uint32_t segment_size = static_cast<uint32_t>(segment_->size());
+    uint32_t block_size = round_up(size + sizeof(BufferHeader), buffer_alignment);
+    if (block_size > segment_size)
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        {
+            std::lock_guard<std::mutex> lock(allocation_mutex_);
+            reclaim_buffers();
+
+            bool allocated = false;
+            if (allocation_used_ == 0)
+            {
+                allocation_head_ = allocation_tail_ = 0;
+            }
+
+            if (allocation_used_ == 0 || allocation_head_ > allocation_tail_)
+            {
+                // Free space is at the end of the segment, and before the oldest buffer.
+                if (segment_size - allocation_head_ >= block_size)
+                {
+                    allocated = true;
+                }
+                else if (allocation_tail_ >= block_size)
+                {
+                    // The end of the segment is skipped with a block nobody references.
+                    BufferHeader* padding = buffer_header(segment_->base(), allocation_head_);
+                    padding->references.store(0, std::memory_order_relaxed);
+                    padding->block_size = segment_size - allocation_head_;
+                    allocation_used_ += padding->block_size;
+                    allocation_head_ = 0;
+                    allocated = true;
+                }
+            }
+            else if (allocation_head_ < allocation_tail_)
+            {
+                allocated = allocation_tail_ - allocation_head_ >= block_size;
+            }
+
+            if (allocated)
+            {
+                offset = allocation_head_;
+                BufferHeader* header = buffer_header(segment_->base(), offset);
+                header->references.store(1, std::memory_order_relaxed);
+                header->block_size = block_size;
+                allocation_used_ += block_size;
+                allocation_head_ += block_size;
+                if (allocation_head_ == segment_size)
+                {
+                    allocation_head_ = 0;
+                }
+                return true;
+            }
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+void SharedMemTransport::reclaim_buffers()
+{
+    uint32_t segment_size = static_cast<uint32_t>(segment_->size());
+
+    while (allocation_used_ > 0)
+    {
+        BufferHeader* header = buffer_header(segment_->base(), allocation_tail_);
+        if (header->references.load(std::memory_order_acquire) != 0)
+        {
+            break;
+        }
+
+        allocation_used_ -= header->block_size;
+        allocation_tail_ += header->block_size;
+        if (allocation_tail_ >= segment_size)
+        {
+            allocation_tail_ = 0;
+        }
+    }
+}
+
+bool SharedMemTransport::deliver_buffer(
+        SharedMemPort* port,
+        uint32_t offset,
+        uint32_t size,
+        const std::chrono::steady_clock::time_point& deadline)
+{
+    BufferHeader* header = buffer_header(segment_->base(), offset);
+    SharedMemBufferDescriptor descriptor;
+    descriptor.segment_id = segment_id_;
+    descriptor.offset = offset;
+    descriptor.size = size;
+
+    for (uint32_t listener = 0; listener < port->max_listeners(); ++listener)
+    {
+        if (!port->is_listener_active(listener))
+        {
+            continue;
+        }
+
+        header->references.fetch_add(1, std::memory_order_relaxed);
+        bool pushed = port->push(listener, descriptor);
+        while (!pushed && port->is_listener_active(listener) && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::yield();
+            pushed = port->push(listener, descriptor);
+        }
+
+        if (!pushed)
+        {
+            header->references.fetch_sub(1, std::memory_order_release);
+
+            // A listener that does not take its messages may be dead.
+            port->remove_dead_listeners([this](const SharedMemBufferDescriptor& pending)
+                    {
+                        release_pending_buffer(pending);
+                    });
+        }
+    }
+
+    // Drop the reference of the sender.
+    header->references.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+SharedMemSegment* SharedMemTransport::find_segment(
+        std::map<uint64_t, std::unique_ptr<SharedMemSegment>>& segments,
+        uint64_t segment_id)
+{
+    auto it = segments.find(segment_id);
+    if (it != segments.end())
+    {
+        return it->second.get();
+    }
+
+    std::unique_ptr<SharedMemSegment> segment = SharedMemSegment::open(segment_name(segment_id));
+    SharedMemSegment* returned_segment = segment.get();
+    if (segment)
+    {
+        segments[segment_id] = std::move(segment);
+    }
+    return returned_segment;
+}
+
+const octet* SharedMemTransport::buffer_data(
+        SharedMemSegment* segment,
+        const SharedMemBufferDescriptor& descriptor)
+{
+    if (segment == nullptr ||
+            static_cast<uint64_t>(descriptor.offset) + sizeof(BufferHeader) + descriptor.size > segment->size())
+    {
+        return nullptr;
+    }
+
+    return buffer_payload(segment->base(), descriptor.offset);
+}
+
+void SharedMemTransport::release_buffer(
+        SharedMemSegment* segment,
+        const SharedMemBufferDescriptor& descriptor)
+{
+    if (segment == nullptr || static_cast<uint64_t>(descriptor.offset) + sizeof(BufferHeader) > segment->size())
+    {
+        return;
+    }
+
+    buffer_header(segment->base(), descriptor.offset)->references.fetch_sub(1, std::memory_order_release);
+}
+
+void SharedMemTransport::release_pending_buffer(const SharedMemBufferDescriptor& descriptor)
+{
+    if (descriptor.segment_id == segment_id_)
+    {
+        release_buffer(segment_.get(), descriptor);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(pending_segments_mutex_);
+    release_buffer(find_segment(pending_segments_, descriptor.segment_id), descriptor);
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
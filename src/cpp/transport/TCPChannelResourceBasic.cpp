@@ -17,6 +17,7 @@
 #include <fastrtps/transport/TCPTransportInterface.h>
 #include <fastrtps/utils/IPLocator.h>
 #include <fastrtps/utils/eClock.h>
+#include "NetworkBufferSequence.hpp"
 
 #include <future>
 
@@ -144,6 +145,43 @@ size_t TCPChannelResourceBasic::send(
         const octet* data,
         size_t size,
         asio::error_code& ec)
+{
+    NetworkBufferSequence buffers;
+    if (header_size > 0)
+    {
+        buffers.push_back(header, header_size);
+    }
+    buffers.push_back(data, size);
+
+    return send_sequence(buffers, ec);
+}
+
+size_t TCPChannelResourceBasic::send(
+        const octet* header,
+        size_t header_size,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        asio::error_code& ec)
+{
+    NetworkBufferSequence sequence;
+    if (header_size > 0)
+    {
+        sequence.push_back(header, header_size);
+    }
+
+    if (!sequence.assign(buffers))
+    {
+        std::vector<octet> contiguous;
+        coalesce_network_buffers(buffers, total_bytes, contiguous);
+        return send(header, header_size, contiguous.data(), total_bytes, ec);
+    }
+
+    return send_sequence(sequence, ec);
+}
+
+size_t TCPChannelResourceBasic::send_sequence(
+        const NetworkBufferSequence& buffers,
+        asio::error_code& ec)
 {
     size_t bytes_sent = 0;
 
@@ -151,16 +189,8 @@ size_t TCPChannelResourceBasic::send(
     {
         std::unique_lock<std::mutex> write_lock(write_mutex_);
 
-
-        if (header_size > 0)
-        {
-            bytes_sent = socket_->send(asio::buffer(header, header_size), 0, ec);
-        }
-
-        if (!ec)
-        {
-            bytes_sent += socket_->send(asio::buffer(data, size), 0, ec);
-        }
+        // Header and payload go out in a single gathered write.
+        bytes_sent = asio::write(*socket_, buffers, ec);
     }
 
     return  bytes_sent;
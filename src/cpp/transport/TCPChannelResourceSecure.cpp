@@ -16,6 +16,7 @@
 #include <fastrtps/transport/TCPTransportInterface.h>
 #include <fastrtps/utils/IPLocator.h>
 #include <fastrtps/utils/eClock.h>
+#include "NetworkBufferSequence.hpp"
 
 #include <future>
 
@@ -195,18 +196,48 @@ size_t TCPChannelResourceSecure::send(
         const octet* data,
         size_t size,
         asio::error_code& ec)
+{
+    NetworkBufferSequence buffers;
+    if(header_size > 0)
+    {
+        buffers.push_back(header, header_size);
+    }
+    buffers.push_back(data, size);
+
+    return send_sequence(buffers, ec);
+}
+
+size_t TCPChannelResourceSecure::send(
+        const octet* header,
+        size_t header_size,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        asio::error_code& ec)
+{
+    NetworkBufferSequence sequence;
+    if(header_size > 0)
+    {
+        sequence.push_back(header, header_size);
+    }
+
+    if (!sequence.assign(buffers))
+    {
+        std::vector<octet> contiguous;
+        coalesce_network_buffers(buffers, total_bytes, contiguous);
+        return send(header, header_size, contiguous.data(), total_bytes, ec);
+    }
+
+    return send_sequence(sequence, ec);
+}
+
+size_t TCPChannelResourceSecure::send_sequence(
+        const NetworkBufferSequence& buffers,
+        asio::error_code& ec)
 {
     size_t bytes_sent = 0;
 
     if (eConnecting < connection_status_)
     {
-        std::vector<asio::const_buffer> buffers;
-        if(header_size > 0)
-        {
-            buffers.push_back(asio::buffer(header, header_size));
-        }
-        buffers.push_back(asio::buffer(data, size));
-
         // Work around meanwhile
         std::promise<size_t> write_bytes_promise;
         auto bytes_future = write_bytes_promise.get_future();
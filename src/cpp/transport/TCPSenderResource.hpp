@@ -47,6 +47,15 @@ class TCPSenderResource : public SenderResource
                 {
                     return transport.send(data, dataSize, channel_, destination);
                 };
+
+            send_buffers_lambda_ = [this, &transport] (
+                    const std::vector<NetworkBuffer>& buffers,
+                    uint32_t total_bytes,
+                    const Locator_t& destination,
+                    const std::chrono::microseconds&)-> bool
+                {
+                    return transport.send(buffers, total_bytes, channel_, destination);
+                };
         }
 
         virtual ~TCPSenderResource()
@@ -281,17 +281,33 @@ bool TCPTransportInterface::create_acceptor_socket(const Locator_t& locator)
     return true;
 }
 
+void TCPTransportInterface::calculate_crc(
+        TCPHeader &header,
+        const std::vector<NetworkBuffer>& buffers) const
+{
+    uint32_t crc(0);
+    for (const NetworkBuffer& buffer : buffers)
+    {
+        const octet* data = static_cast<const octet*>(buffer.buffer);
+        for (uint32_t i = 0; i < buffer.size; ++i)
+        {
+            crc = RTCPMessageManager::addToCRC(crc, data[i]);
+        }
+    }
+    header.crc = crc;
+}
+
 void TCPTransportInterface::fill_rtcp_header(
         TCPHeader& header,
-        const octet* send_buffer,
-        uint32_t send_buffer_size,
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
         uint16_t logical_port) const
 {
-    header.length = send_buffer_size + static_cast<uint32_t>(TCPHeader::size());
+    header.length = total_bytes + static_cast<uint32_t>(TCPHeader::size());
     header.logical_port = logical_port;
     if (configuration()->calculate_crc)
     {
-        calculate_crc(header, send_buffer, send_buffer_size);
+        calculate_crc(header, buffers);
     }
 }
 
@@ -953,6 +969,16 @@ bool TCPTransportInterface::send(
         uint32_t send_buffer_size,
         std::shared_ptr<TCPChannelResource>& channel,
         const Locator_t& remote_locator)
+{
+    std::vector<NetworkBuffer> buffers(1, NetworkBuffer(send_buffer, send_buffer_size));
+    return send(buffers, send_buffer_size, channel, remote_locator);
+}
+
+bool TCPTransportInterface::send(
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        std::shared_ptr<TCPChannelResource>& channel,
+        const Locator_t& remote_locator)
 {
     bool locator_mismatch = false;
 
@@ -975,7 +1001,7 @@ bool TCPTransportInterface::send(
         }
     }
 
-    if (locator_mismatch || send_buffer_size > configuration()->sendBufferSize)
+    if (locator_mismatch || total_bytes > configuration()->sendBufferSize)
     {
         //std::cout << "ChannelLocator: " << IPLocator::to_string(channel->locator()) << std::endl;
         //std::cout << "RemoteLocator: " << IPLocator::to_string(remote_locator) << std::endl;
@@ -1008,21 +1034,21 @@ bool TCPTransportInterface::send(
             if (channel->is_logical_port_opened(logical_port))
             {
                 TCPHeader tcp_header;
-                fill_rtcp_header(tcp_header, send_buffer, send_buffer_size, logical_port);
+                fill_rtcp_header(tcp_header, buffers, total_bytes, logical_port);
 
                 {
                     asio::error_code ec;
                     size_t sent = channel->send(
                         (octet*)&tcp_header,
                         static_cast<uint32_t>(TCPHeader::size()),
-                        send_buffer,
-                        send_buffer_size,
+                        buffers,
+                        total_bytes,
                         ec);
 
-                    if (sent != static_cast<uint32_t>(TCPHeader::size() + send_buffer_size) || ec)
+                    if (sent != static_cast<uint32_t>(TCPHeader::size() + total_bytes) || ec)
                     {
                         logWarning(DEBUG, "Failed to send RTCP message (" << sent << " of " <<
-                                TCPHeader::size() + send_buffer_size << " b): " << ec.message());
+                                TCPHeader::size() + total_bytes << " b): " << ec.message());
                         success = false;
                     }
                     else
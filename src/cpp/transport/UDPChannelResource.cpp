@@ -18,6 +18,10 @@
 #include <fastrtps/rtps/messages/MessageReceiver.h>
 #include <fastrtps/utils/eClock.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
 namespace eprosima {
 namespace fastrtps {
 namespace rtps {
@@ -35,7 +39,44 @@ UDPChannelResource::UDPChannelResource(
     , only_multicast_purpose_(false)
     , interface_(sInterface)
     , transport_(transport)
+    , receive_batch_size_(std::max(transport->configuration()->receive_batch_size, 1u))
+    , use_receive_threads_(transport->configuration()->receive_threads > 0)
+    , input_locator_(locator)
+    , async_receive_pending_(false)
 {
+    if (use_receive_threads_)
+    {
+        async_receive_pending_ = true;
+        async_receive();
+        return;
+    }
+
+#if defined(__linux__)
+    if (receive_batch_size_ > 1)
+    {
+        batch_buffers_.reserve(receive_batch_size_);
+        batch_endpoints_.resize(receive_batch_size_);
+        batch_iovecs_.resize(receive_batch_size_);
+        batch_headers_.resize(receive_batch_size_);
+
+        // Buffers and endpoints don't move, so the scatter descriptors are filled only once.
+        for (uint32_t i = 0; i < receive_batch_size_; ++i)
+        {
+            batch_buffers_.emplace_back(maxMsgSize);
+            batch_iovecs_[i].iov_base = batch_buffers_[i].buffer;
+            batch_iovecs_[i].iov_len = batch_buffers_[i].max_size;
+
+            memset(&batch_headers_[i], 0, sizeof(struct mmsghdr));
+            batch_headers_[i].msg_hdr.msg_name = batch_endpoints_[i].data();
+            batch_headers_[i].msg_hdr.msg_iov = &batch_iovecs_[i];
+            batch_headers_[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        thread(std::thread(&UDPChannelResource::perform_batched_listen_operation, this, locator));
+        return;
+    }
+#endif
+
     thread(std::thread(&UDPChannelResource::perform_listen_operation, this, locator));
 }
 
@@ -44,6 +85,76 @@ UDPChannelResource::~UDPChannelResource()
     message_receiver_ = nullptr;
 }
 
+void UDPChannelResource::clear()
+{
+    if (use_receive_threads_)
+    {
+        alive_.store(false);
+        std::unique_lock<std::mutex> lock(async_receive_mutex_);
+        async_receive_cv_.wait(lock, [&]()
+        {
+            return !async_receive_pending_;
+        });
+    }
+
+    ChannelResource::clear();
+}
+
+void UDPChannelResource::async_receive()
+{
+    socket()->async_receive_from(asio::buffer(message_buffer_.buffer, message_buffer_.max_size),
+        async_remote_endpoint_,
+        [this](const asio::error_code& error, std::size_t bytes_received)
+        {
+            on_async_receive(error, bytes_received);
+        });
+}
+
+void UDPChannelResource::on_async_receive(
+        const asio::error_code& error,
+        std::size_t bytes_received)
+{
+    if (!error)
+    {
+        CDRMessage_t& msg = message_buffer();
+        msg.length = static_cast<uint32_t>(bytes_received);
+
+        // This is not necessary anymore but it's left here for back compatibility with versions older than 1.8.1
+        if (msg.length > 0 && !(msg.length == 13 && memcmp(msg.buffer, "EPRORTPSCLOSE", 13) == 0))
+        {
+            Locator_t remote_locator;
+            transport_->endpoint_to_locator(async_remote_endpoint_, remote_locator);
+
+            // Processes the data through the CDR Message interface.
+            if (message_receiver() != nullptr)
+            {
+                message_receiver()->OnDataReceived(msg.buffer, msg.length, input_locator_, remote_locator);
+            }
+            else if (alive())
+            {
+                logWarning(RTPS_MSG_IN, "Received Message, but no receiver attached");
+            }
+        }
+    }
+    else if (error != asio::error::operation_aborted && alive())
+    {
+        logWarning(RTPS_MSG_IN, "Error receiving data: " << error.message() << " - " << message_receiver()
+            << " (" << this << ")");
+    }
+
+    std::unique_lock<std::mutex> lock(async_receive_mutex_);
+    if (alive() && error != asio::error::bad_descriptor)
+    {
+        async_receive();
+    }
+    else
+    {
+        message_receiver(nullptr);
+        async_receive_pending_ = false;
+        async_receive_cv_.notify_all();
+    }
+}
+
 void UDPChannelResource::perform_listen_operation(Locator_t input_locator)
 {
     Locator_t remote_locator;
@@ -103,6 +214,75 @@ bool UDPChannelResource::Receive(
     }
 }
 
+#if defined(__linux__)
+void UDPChannelResource::perform_batched_listen_operation(Locator_t input_locator)
+{
+    Locator_t remote_locator;
+
+    while (alive())
+    {
+        // Blocking receive of a batch of datagrams.
+        uint32_t received = ReceiveBatch();
+
+        // Processes the datagrams through the CDR Message interface, keeping the arrival order.
+        for (uint32_t i = 0; i < received; ++i)
+        {
+            CDRMessage_t& msg = batch_buffers_[i];
+
+            // This is not necessary anymore but it's left here for back compatibility with versions older than 1.8.1
+            if (msg.length == 0 || (msg.length == 13 && memcmp(msg.buffer, "EPRORTPSCLOSE", 13) == 0))
+            {
+                continue;
+            }
+
+            transport_->endpoint_to_locator(batch_endpoints_[i], remote_locator);
+
+            if (message_receiver() != nullptr)
+            {
+                message_receiver()->OnDataReceived(msg.buffer, msg.length, input_locator, remote_locator);
+            }
+            else if (alive())
+            {
+                logWarning(RTPS_MSG_IN, "Received Message, but no receiver attached");
+            }
+        }
+    }
+
+    message_receiver(nullptr);
+}
+
+uint32_t UDPChannelResource::ReceiveBatch()
+{
+    // The kernel overwrites the address length with the one of the received datagram.
+    for (uint32_t i = 0; i < receive_batch_size_; ++i)
+    {
+        batch_headers_[i].msg_hdr.msg_namelen = static_cast<socklen_t>(batch_endpoints_[i].capacity());
+        batch_headers_[i].msg_len = 0;
+    }
+
+    int received = recvmmsg(socket()->native_handle(), batch_headers_.data(), receive_batch_size_,
+            MSG_WAITFORONE, nullptr);
+
+    if (received < 0)
+    {
+        if (errno != EINTR && alive())
+        {
+            logWarning(RTPS_MSG_IN, "Error receiving data: " << strerror(errno) << " - " << message_receiver()
+                << " (" << this << ")");
+        }
+        return 0;
+    }
+
+    for (int i = 0; i < received; ++i)
+    {
+        batch_buffers_[i].length = batch_headers_[i].msg_len;
+        batch_endpoints_[i].resize(batch_headers_[i].msg_hdr.msg_namelen);
+    }
+
+    return static_cast<uint32_t>(received);
+}
+#endif
+
 void UDPChannelResource::release()
 {
     // Cancel all asynchronous operations associated with the socket.
@@ -48,6 +48,27 @@ class UDPSenderResource : public SenderResource
                 {
                     return transport.send(data, dataSize, socket_, destination, only_multicast_purpose_, timeout);
                 };
+
+            send_buffers_lambda_ = [this, &transport] (
+                    const std::vector<NetworkBuffer>& buffers,
+                    uint32_t total_bytes,
+                    const Locator_t& destination,
+                    const std::chrono::microseconds& timeout)-> bool
+                {
+                    return transport.send(buffers, total_bytes, socket_, destination, only_multicast_purpose_,
+                            timeout);
+                };
+
+            send_to_many_lambda_ = [this, &transport] (
+                    const std::vector<NetworkBuffer>& buffers,
+                    uint32_t total_bytes,
+                    const Locator_t* destinations,
+                    size_t num_destinations,
+                    const std::chrono::microseconds& timeout)-> bool
+                {
+                    return transport.send(buffers, total_bytes, socket_, destinations, num_destinations,
+                            only_multicast_purpose_, timeout);
+                };
         }
 
         virtual ~UDPSenderResource()
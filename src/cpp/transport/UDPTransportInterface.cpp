@@ -16,16 +16,26 @@
 #include <fastrtps/transport/UDPTransportInterface.h>
 #include <fastrtps/rtps/messages/CDRMessage.h>
 #include "UDPSenderResource.hpp"
+#include "NetworkBufferSequence.hpp"
 #include <fastrtps/log/Log.h>
 #include <fastrtps/utils/Semaphore.h>
 #include <fastrtps/utils/IPLocator.h>
 #include <fastrtps/utils/eClock.h>
 
+#include <array>
+#include <cerrno>
 #include <utility>
 #include <cstring>
 #include <algorithm>
 #include <chrono>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
 using namespace std;
 using namespace asio;
 
@@ -54,6 +64,10 @@ UDPTransportDescriptor::UDPTransportDescriptor()
 UDPTransportDescriptor::UDPTransportDescriptor(const UDPTransportDescriptor& t)
     : SocketTransportDescriptor(t)
     , m_output_udp_socket(t.m_output_udp_socket)
+    , non_blocking_send(t.non_blocking_send)
+    , receive_batch_size(t.receive_batch_size)
+    , receive_threads(t.receive_threads)
+    , receive_threads_affinity(t.receive_threads_affinity)
 {
 }
 
@@ -71,6 +85,57 @@ UDPTransportInterface::~UDPTransportInterface()
 void UDPTransportInterface::clean()
 {
     assert(mInputSockets.size() == 0);
+    stop_receive_threads();
+}
+
+void UDPTransportInterface::start_receive_threads()
+{
+    const UDPTransportDescriptor* config = configuration();
+
+    for (uint32_t i = 0; i < config->receive_threads; ++i)
+    {
+        receive_threads_.emplace_back([this]()
+        {
+#if ASIO_VERSION >= 101200
+            asio::executor_work_guard<asio::io_service::executor_type> work(io_service_.get_executor());
+#else
+            io_service::work work(io_service_);
+#endif
+            io_service_.run();
+        });
+
+        if (!config->receive_threads_affinity.empty())
+        {
+            uint32_t cpu = config->receive_threads_affinity[i % config->receive_threads_affinity.size()];
+#if defined(__linux__)
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            CPU_SET(cpu, &cpu_set);
+            if (0 != pthread_setaffinity_np(receive_threads_.back().native_handle(), sizeof(cpu_set_t), &cpu_set))
+            {
+                logWarning(RTPS_MSG_IN, "Cannot pin receive thread " << i << " to CPU " << cpu);
+            }
+#else
+            logWarning(RTPS_MSG_IN, "Receive threads affinity is not supported on this platform. "
+                << "Receive thread " << i << " not pinned to CPU " << cpu);
+#endif
+        }
+    }
+
+    logInfo(RTPS_MSG_IN, "UDPTransport: " << receive_threads_.size() << " receive threads started");
+}
+
+void UDPTransportInterface::stop_receive_threads()
+{
+    if (!receive_threads_.empty())
+    {
+        io_service_.stop();
+        for (std::thread& receive_thread : receive_threads_)
+        {
+            receive_thread.join();
+        }
+        receive_threads_.clear();
+    }
 }
 
 bool UDPTransportInterface::CloseInputChannel(const Locator_t& locator)
@@ -165,6 +230,11 @@ bool UDPTransportInterface::init()
     // TODO(Ricardo) Create an event that update this list.
     get_ips(currentInterfaces);
 
+    if (configuration()->receive_threads > 0 && receive_threads_.empty())
+    {
+        start_receive_threads();
+    }
+
     return true;
 }
 
@@ -414,7 +484,173 @@ bool UDPTransportInterface::send(
         bool only_multicast_purpose,
         const std::chrono::microseconds& timeout)
 {
-    if (!IsLocatorSupported(remote_locator) || send_buffer_size > configuration()->sendBufferSize)
+    NetworkBufferSequence buffers;
+    buffers.push_back(send_buffer, send_buffer_size);
+    return send_sequence(buffers, send_buffer_size, socket, remote_locator, only_multicast_purpose, timeout);
+}
+
+bool UDPTransportInterface::send(
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        eProsimaUDPSocket& socket,
+        const Locator_t& remote_locator,
+        bool only_multicast_purpose,
+        const std::chrono::microseconds& timeout)
+{
+    NetworkBufferSequence sequence;
+    if (sequence.assign(buffers))
+    {
+        return send_sequence(sequence, total_bytes, socket, remote_locator, only_multicast_purpose, timeout);
+    }
+
+    // Too many slices to be gathered by the socket layer.
+    std::vector<octet> contiguous;
+    coalesce_network_buffers(buffers, total_bytes, contiguous);
+    return send(contiguous.data(), total_bytes, socket, remote_locator, only_multicast_purpose, timeout);
+}
+
+bool UDPTransportInterface::send(
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        eProsimaUDPSocket& socket,
+        const Locator_t* remote_locators,
+        size_t num_locators,
+        bool only_multicast_purpose,
+        const std::chrono::microseconds& timeout)
+{
+    if (total_bytes > configuration()->sendBufferSize)
+    {
+        return false;
+    }
+
+#if defined(__linux__)
+    // The same datagram is handed to the socket layer for a batch of destinations in a single sendmmsg call.
+    constexpr size_t max_batch = 64;
+
+    if (num_locators > 1 && buffers.size() <= NetworkBufferSequence::max_buffers)
+    {
+        std::array<struct iovec, NetworkBufferSequence::max_buffers> iov;
+        for (size_t i = 0; i < buffers.size(); ++i)
+        {
+            iov[i].iov_base = const_cast<void*>(buffers[i].buffer);
+            iov[i].iov_len = buffers[i].size;
+        }
+
+        std::array<asio::ip::udp::endpoint, max_batch> endpoints;
+        std::array<struct mmsghdr, max_batch> msgs;
+        int fd = getSocketPtr(socket)->native_handle();
+
+        struct timeval timeStruct;
+        timeStruct.tv_sec = 0;
+        timeStruct.tv_usec = timeout.count() > 0 ? timeout.count() : 0;
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeStruct), sizeof(timeStruct));
+
+        bool success = true;
+        // Once the socket has not accepted a datagram within the timeout, the rest are only tried without blocking.
+        int send_flags = 0;
+        size_t index = 0;
+        while (index < num_locators)
+        {
+            unsigned int num_msgs = 0;
+            for (; index < num_locators && num_msgs < max_batch; ++index)
+            {
+                const Locator_t& locator = remote_locators[index];
+                if (!IsLocatorSupported(locator))
+                {
+                    continue;
+                }
+
+                if (only_multicast_purpose && !IPLocator::isMulticast(locator))
+                {
+                    success = false;
+                    continue;
+                }
+
+                endpoints[num_msgs] = generate_endpoint(locator, IPLocator::getPhysicalPort(locator));
+                struct msghdr& hdr = msgs[num_msgs].msg_hdr;
+                memset(&msgs[num_msgs], 0, sizeof(struct mmsghdr));
+                hdr.msg_name = endpoints[num_msgs].data();
+                hdr.msg_namelen = static_cast<socklen_t>(endpoints[num_msgs].size());
+                hdr.msg_iov = iov.data();
+                hdr.msg_iovlen = buffers.size();
+                ++num_msgs;
+            }
+
+            // A partial send is retried from the first datagram not sent.
+            unsigned int sent = 0;
+            while (sent < num_msgs)
+            {
+                int ret = sendmmsg(fd, msgs.data() + sent, num_msgs - sent, send_flags);
+                if (ret < 0)
+                {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    {
+                        // Each of the remaining destinations still gets its own attempt.
+                        send_flags = MSG_DONTWAIT;
+                        for (; sent < num_msgs; ++sent)
+                        {
+                            if (sendmsg(fd, &msgs[sent].msg_hdr, send_flags) < 0)
+                            {
+                                logWarning(RTPS_MSG_OUT, "UDP send to " << endpoints[sent] <<
+                                        " would have blocked. Packet is dropped.");
+                                success = false;
+                            }
+                        }
+                        break;
+                    }
+
+                    // Skip the destination that failed and go on with the rest of the batch.
+                    logWarning(RTPS_MSG_OUT, "UDP send to " << endpoints[sent] << " failed: " << strerror(errno));
+                    success = false;
+                    ++sent;
+                    continue;
+                }
+
+                for (int i = 0; i < ret; ++i)
+                {
+                    logInfo(RTPS_MSG_OUT, "UDPTransport: " << msgs[sent + i].msg_len << " bytes TO endpoint: "
+                        << endpoints[sent + i] << " FROM " << getSocketPtr(socket)->local_endpoint());
+                }
+                sent += static_cast<unsigned int>(ret);
+            }
+        }
+
+        return success;
+    }
+#endif
+
+    NetworkBufferSequence sequence;
+    bool gathered = sequence.assign(buffers);
+    std::vector<octet> contiguous;
+    if (!gathered)
+    {
+        // Too many slices to be gathered by the socket layer.
+        coalesce_network_buffers(buffers, total_bytes, contiguous);
+        sequence.push_back(contiguous.data(), total_bytes);
+    }
+
+    bool success = true;
+    for (size_t i = 0; i < num_locators; ++i)
+    {
+        if (IsLocatorSupported(remote_locators[i]))
+        {
+            success &= send_sequence(sequence, total_bytes, socket, remote_locators[i], only_multicast_purpose,
+                    timeout);
+        }
+    }
+
+    return success;
+}
+
+bool UDPTransportInterface::send_sequence(
+        const NetworkBufferSequence& buffers,
+        uint32_t total_bytes,
+        eProsimaUDPSocket& socket,
+        const Locator_t& remote_locator,
+        bool only_multicast_purpose,
+        const std::chrono::microseconds& timeout)
+{
+    if (!IsLocatorSupported(remote_locator) || total_bytes > configuration()->sendBufferSize)
     {
         return false;
     }
@@ -440,7 +676,8 @@ bool UDPTransportInterface::send(
 #endif
 
             asio::error_code ec;
-            bytesSent = getSocketPtr(socket)->send_to(asio::buffer(send_buffer, send_buffer_size), destinationEndpoint, 0, ec);
+            // All the slices are sent as a single datagram (sendmsg / WSASendTo)
+            bytesSent = getSocketPtr(socket)->send_to(buffers, destinationEndpoint, 0, ec);
             if(!!ec)
             {
                 if ((ec.value() == asio::error::would_block) ||
@@ -0,0 +1,89 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SharedMemChannelResource.hpp"
+
+#include <fastrtps/transport/SharedMemTransport.h>
+#include <fastrtps/transport/TransportReceiverInterface.h>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+SharedMemChannelResource::SharedMemChannelResource(
+        SharedMemTransport* transport,
+        std::unique_ptr<SharedMemPort>&& port,
+        uint32_t listener,
+        const Locator_t& locator,
+        TransportReceiverInterface* receiver)
+    : ChannelResource()
+    , transport_(transport)
+    , port_(std::move(port))
+    , listener_(listener)
+    , locator_(locator)
+    , remote_locator_(transport->RemoteToMainLocal(locator))
+    , receiver_(receiver)
+{
+    thread(std::thread(&SharedMemChannelResource::perform_listen_operation, this));
+}
+
+SharedMemChannelResource::~SharedMemChannelResource()
+{
+    disable();
+    clear();
+
+    // Messages still queued were never delivered, so their buffers are given back.
+    port_->unregister_listener(listener_, [this](const SharedMemBufferDescriptor& descriptor)
+            {
+                SharedMemTransport::release_buffer(SharedMemTransport::find_segment(segments_,
+                        descriptor.segment_id), descriptor);
+            });
+}
+
+void SharedMemChannelResource::disable()
+{
+    ChannelResource::disable();
+    port_->wake_up(listener_);
+}
+
+void SharedMemChannelResource::perform_listen_operation()
+{
+    SharedMemBufferDescriptor descriptor;
+
+    while (alive())
+    {
+        if (!port_->pop(listener_, descriptor, std::chrono::milliseconds(100)))
+        {
+            continue;
+        }
+
+        SharedMemSegment* segment = SharedMemTransport::find_segment(segments_, descriptor.segment_id);
+        const octet* data = SharedMemTransport::buffer_data(segment, descriptor);
+        if (data != nullptr && receiver_ != nullptr && alive())
+        {
+            // The message is read in place, so the buffer is released once the receiver is done with it.
+            receiver_->OnDataReceived(data, descriptor.size, locator_, remote_locator_);
+        }
+        else if (data == nullptr)
+        {
+            logWarning(RTPS_MSG_IN, "Received a message from an unavailable shared memory segment");
+        }
+
+        SharedMemTransport::release_buffer(segment, descriptor);
+    }
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
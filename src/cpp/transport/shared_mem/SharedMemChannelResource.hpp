@@ -0,0 +1,75 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __TRANSPORT_SHARED_MEM_SHAREDMEMCHANNELRESOURCE_HPP__
+#define __TRANSPORT_SHARED_MEM_SHAREDMEMCHANNELRESOURCE_HPP__
+
+#include <fastrtps/transport/ChannelResource.h>
+#include <fastrtps/rtps/common/Locator.h>
+
+#include "SharedMemPort.hpp"
+
+#include <map>
+#include <memory>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+class SharedMemTransport;
+class TransportReceiverInterface;
+
+/**
+ * Listener of a shared memory port. Its thread takes the descriptors queued for it and hands the messages,
+ * read in place from the segments of their senders, to the receiver.
+ */
+class SharedMemChannelResource : public ChannelResource
+{
+public:
+
+    SharedMemChannelResource(
+            SharedMemTransport* transport,
+            std::unique_ptr<SharedMemPort>&& port,
+            uint32_t listener,
+            const Locator_t& locator,
+            TransportReceiverInterface* receiver);
+
+    //! Stops the thread and gives back the listener slot.
+    virtual ~SharedMemChannelResource() override;
+
+    virtual void disable() override;
+
+private:
+
+    void perform_listen_operation();
+
+    SharedMemTransport* transport_;
+    std::unique_ptr<SharedMemPort> port_;
+    uint32_t listener_;
+    Locator_t locator_;
+    Locator_t remote_locator_;
+    TransportReceiverInterface* receiver_;
+
+    //! Segments of the senders, mapped on their first message.
+    std::map<uint64_t, std::unique_ptr<SharedMemSegment>> segments_;
+
+    SharedMemChannelResource(const SharedMemChannelResource&) = delete;
+    SharedMemChannelResource& operator=(const SharedMemChannelResource&) = delete;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // __TRANSPORT_SHARED_MEM_SHAREDMEMCHANNELRESOURCE_HPP__
@@ -0,0 +1,515 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SharedMemPort.hpp"
+
+#include <fastrtps/log/Log.h>
+
+#include <new>
+#include <thread>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "Shared memory rings need address-free atomics");
+
+namespace {
+
+const uint32_t port_magic = 0x46525451; // "QTRF". Changed with the layout of the segment.
+
+const char* const port_name_prefix = "/fastrtps_port_";
+
+enum ListenerState : uint32_t
+{
+    LISTENER_FREE = 0,
+    LISTENER_CLAIMING,
+    LISTENER_ACTIVE,
+    LISTENER_CLEANING
+};
+
+size_t round_up(
+        size_t value,
+        size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::string port_name(
+        uint32_t port,
+        bool is_multicast)
+{
+    return std::string(port_name_prefix) + (is_multicast ? "m" : "u") + std::to_string(port);
+}
+
+uint32_t round_up_power_of_two(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value && result < 0x80000000u)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+struct SharedMemPort::Header
+{
+    std::atomic<uint32_t> initialized;
+    //! Set by the owner removing the port. Processes opening it meanwhile try again.
+    std::atomic<uint32_t> closing;
+    uint32_t queue_capacity;
+    uint32_t max_listeners;
+    uint32_t listener_size;
+    //! Process of each SharedMemPort object having the port open, zero on free entries.
+    std::atomic<uint32_t> owners[max_owners];
+};
+
+struct SharedMemPort::Cell
+{
+    std::atomic<uint32_t> sequence;
+    uint32_t reserved;
+    SharedMemBufferDescriptor descriptor;
+};
+
+struct SharedMemPort::Listener
+{
+    //! Written by the senders.
+    alignas(64) std::atomic<uint32_t> enqueue_pos;
+    //! Written by the listener.
+    alignas(64) std::atomic<uint32_t> dequeue_pos;
+    alignas(64) std::atomic<uint32_t> state;
+    //! Number of senders inside push. A slot is not emptied until it drops to zero.
+    std::atomic<uint32_t> pushers;
+    //! Set while the listener is about to block, so senders only notify when needed.
+    std::atomic<uint32_t> waiting;
+    uint32_t process_id;
+    alignas(8) uint8_t condition[SharedMemSegment::condition_storage_size];
+};
+
+size_t SharedMemPort::listeners_offset()
+{
+    return round_up(sizeof(Header), 64);
+}
+
+std::unique_ptr<SharedMemPort> SharedMemPort::open(
+        uint32_t port,
+        bool is_multicast,
+        uint32_t queue_capacity,
+        uint32_t permissions)
+{
+    std::string name = port_name(port, is_multicast);
+    uint32_t max_listeners = is_multicast ? max_multicast_listeners : 1;
+    queue_capacity = round_up_power_of_two(queue_capacity);
+    size_t listener_size = round_up(sizeof(Listener) + queue_capacity * sizeof(Cell), 64);
+    size_t header_size = listeners_offset();
+
+    // A port being removed by its last owner is created again once its name is gone.
+    for (uint32_t tries = 0; tries < 100; ++tries)
+    {
+        if (tries > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        std::unique_ptr<SharedMemSegment> segment = SharedMemSegment::create(name,
+                        header_size + max_listeners * listener_size, permissions);
+        if (segment)
+        {
+            uint8_t* base = static_cast<uint8_t*>(segment->base());
+            Header* header = new (base) Header();
+            header->queue_capacity = queue_capacity;
+            header->max_listeners = max_listeners;
+            header->listener_size = static_cast<uint32_t>(listener_size);
+            for (uint32_t i = 0; i < max_listeners; ++i)
+            {
+                Listener* listener = new (base + header_size + i * listener_size) Listener();
+                listener->state.store(LISTENER_FREE, std::memory_order_relaxed);
+            }
+            header->owners[0].store(SharedMemSegment::current_process_id(), std::memory_order_relaxed);
+            header->initialized.store(port_magic, std::memory_order_release);
+            return std::unique_ptr<SharedMemPort>(new SharedMemPort(std::move(segment), port, is_multicast, 0));
+        }
+
+        segment = SharedMemSegment::open(name);
+        if (!segment)
+        {
+            // Removed after failing to create it.
+            continue;
+        }
+
+        Header* header = static_cast<Header*>(segment->base());
+        if (segment->size() >= header_size)
+        {
+            for (uint32_t waits = 0; waits < 100 && header->initialized.load(std::memory_order_acquire) != port_magic;
+                    ++waits)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+
+        if (segment->size() < header_size ||
+                header->initialized.load(std::memory_order_acquire) != port_magic ||
+                header->max_listeners != max_listeners ||
+                header->queue_capacity == 0 || (header->queue_capacity & (header->queue_capacity - 1)) != 0 ||
+                segment->size() < header_size + static_cast<size_t>(header->max_listeners) * header->listener_size)
+        {
+            logError(RTPS_TRANSPORT_SHM, "Shared memory port " << name << " is not valid");
+            return nullptr;
+        }
+
+        int32_t owner = claim_owner(header);
+        if (owner < 0)
+        {
+            logError(RTPS_TRANSPORT_SHM, "Shared memory port " << name << " has too many owners");
+            return nullptr;
+        }
+
+        // Checked after taking the entry, so the owner removing the port either sees it or is seen here.
+        if (header->closing.load() == 0)
+        {
+            return std::unique_ptr<SharedMemPort>(new SharedMemPort(std::move(segment), port, is_multicast,
+                           static_cast<uint32_t>(owner)));
+        }
+
+        header->owners[owner].store(0);
+    }
+
+    logError(RTPS_TRANSPORT_SHM, "Cannot open shared memory port " << name);
+    return nullptr;
+}
+
+void SharedMemPort::remove_stale_ports()
+{
+    for (const std::string& name : SharedMemSegment::list(port_name_prefix))
+    {
+        std::unique_ptr<SharedMemSegment> segment = SharedMemSegment::open(name);
+        if (segment && segment->size() >= sizeof(Header))
+        {
+            Header* header = static_cast<Header*>(segment->base());
+            if (header->initialized.load(std::memory_order_acquire) == port_magic)
+            {
+                remove_if_unused(header, name);
+            }
+        }
+    }
+}
+
+SharedMemPort::SharedMemPort(
+        std::unique_ptr<SharedMemSegment>&& segment,
+        uint32_t port,
+        bool is_multicast,
+        uint32_t owner)
+    : segment_(std::move(segment))
+    , port_(port)
+    , is_multicast_(is_multicast)
+    , header_(static_cast<Header*>(segment_->base()))
+    , max_listeners_(header_->max_listeners)
+    , mask_(header_->queue_capacity - 1)
+    , owner_(owner)
+{
+}
+
+SharedMemPort::~SharedMemPort()
+{
+    header_->owners[owner_].store(0);
+    remove_if_unused(header_, segment_->name());
+}
+
+int32_t SharedMemPort::claim_owner(Header* header)
+{
+    uint32_t process_id = SharedMemSegment::current_process_id();
+
+    for (uint32_t i = 0; i < max_owners; ++i)
+    {
+        uint32_t expected = 0;
+        if (header->owners[i].compare_exchange_strong(expected, process_id))
+        {
+            return static_cast<int32_t>(i);
+        }
+    }
+
+    for (uint32_t i = 0; i < max_owners; ++i)
+    {
+        uint32_t expected = header->owners[i].load();
+        if (expected != 0 && !SharedMemSegment::is_process_alive(expected) &&
+                header->owners[i].compare_exchange_strong(expected, process_id))
+        {
+            return static_cast<int32_t>(i);
+        }
+    }
+
+    return -1;
+}
+
+bool SharedMemPort::has_live_owners(const Header* header)
+{
+    for (uint32_t i = 0; i < max_owners; ++i)
+    {
+        uint32_t process_id = header->owners[i].load();
+        if (process_id != 0 && SharedMemSegment::is_process_alive(process_id))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SharedMemPort::remove_if_unused(
+        Header* header,
+        const std::string& name)
+{
+    if (has_live_owners(header))
+    {
+        return;
+    }
+
+    uint32_t expected = 0;
+    if (!header->closing.compare_exchange_strong(expected, 1))
+    {
+        // Another owner is removing it.
+        return;
+    }
+
+    // An owner may have come in before closing was set.
+    if (has_live_owners(header))
+    {
+        header->closing.store(0);
+        return;
+    }
+
+    logInfo(RTPS_TRANSPORT_SHM, "Removing shared memory port " << name);
+    SharedMemSegment::remove(name);
+}
+
+SharedMemPort::Listener* SharedMemPort::listener(uint32_t index) const
+{
+    return reinterpret_cast<Listener*>(static_cast<uint8_t*>(segment_->base()) + listeners_offset() +
+                   static_cast<size_t>(index) * header_->listener_size);
+}
+
+SharedMemPort::Cell* SharedMemPort::cell(
+        Listener* listener,
+        uint32_t position) const
+{
+    Cell* cells = reinterpret_cast<Cell*>(reinterpret_cast<uint8_t*>(listener) + sizeof(Listener));
+    return &cells[position & mask_];
+}
+
+int32_t SharedMemPort::register_listener(const ReleaseFunction& release)
+{
+    remove_dead_listeners(release);
+
+    for (uint32_t i = 0; i < max_listeners_; ++i)
+    {
+        Listener* slot = listener(i);
+        uint32_t expected = LISTENER_FREE;
+        if (slot->state.compare_exchange_strong(expected, LISTENER_CLAIMING))
+        {
+            slot->enqueue_pos.store(0, std::memory_order_relaxed);
+            slot->dequeue_pos.store(0, std::memory_order_relaxed);
+            for (uint32_t pos = 0; pos <= mask_; ++pos)
+            {
+                cell(slot, pos)->sequence.store(pos, std::memory_order_relaxed);
+            }
+            slot->waiting.store(0, std::memory_order_relaxed);
+            slot->process_id = SharedMemSegment::current_process_id();
+            SharedMemSegment::init_condition(slot->condition);
+            slot->state.store(LISTENER_ACTIVE, std::memory_order_release);
+            return static_cast<int32_t>(i);
+        }
+    }
+
+    return -1;
+}
+
+void SharedMemPort::unregister_listener(
+        uint32_t index,
+        const ReleaseFunction& release)
+{
+    Listener* slot = listener(index);
+    slot->state.store(LISTENER_CLEANING);
+    release_listener(slot, release);
+}
+
+bool SharedMemPort::is_listener_active(uint32_t index) const
+{
+    return listener(index)->state.load(std::memory_order_acquire) == LISTENER_ACTIVE;
+}
+
+bool SharedMemPort::push(
+        uint32_t index,
+        const SharedMemBufferDescriptor& descriptor)
+{
+    Listener* slot = listener(index);
+    bool pushed = false;
+
+    slot->pushers.fetch_add(1);
+    if (slot->state.load() == LISTENER_ACTIVE)
+    {
+        uint32_t pos = slot->enqueue_pos.load(std::memory_order_relaxed);
+        Cell* target = nullptr;
+        for (;;)
+        {
+            target = cell(slot, pos);
+            uint32_t sequence = target->sequence.load(std::memory_order_acquire);
+            int32_t diff = static_cast<int32_t>(sequence - pos);
+            if (diff == 0)
+            {
+                if (slot->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // Full
+                target = nullptr;
+                break;
+            }
+            else
+            {
+                pos = slot->enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        if (target != nullptr)
+        {
+            target->descriptor = descriptor;
+            target->sequence.store(pos + 1, std::memory_order_release);
+            pushed = true;
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (slot->waiting.load(std::memory_order_relaxed) != 0)
+            {
+                SharedMemSegment::notify_condition(slot->condition);
+            }
+        }
+    }
+    slot->pushers.fetch_sub(1);
+
+    return pushed;
+}
+
+bool SharedMemPort::try_pop(
+        Listener* slot,
+        SharedMemBufferDescriptor& descriptor)
+{
+    uint32_t pos = slot->dequeue_pos.load(std::memory_order_relaxed);
+    Cell* source = nullptr;
+    for (;;)
+    {
+        source = cell(slot, pos);
+        uint32_t sequence = source->sequence.load(std::memory_order_acquire);
+        int32_t diff = static_cast<int32_t>(sequence - (pos + 1));
+        if (diff == 0)
+        {
+            if (slot->dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Empty
+            return false;
+        }
+        else
+        {
+            pos = slot->dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    descriptor = source->descriptor;
+    source->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+bool SharedMemPort::has_data(Listener* slot) const
+{
+    uint32_t pos = slot->dequeue_pos.load(std::memory_order_relaxed);
+    return cell(slot, pos)->sequence.load(std::memory_order_acquire) == pos + 1;
+}
+
+bool SharedMemPort::pop(
+        uint32_t index,
+        SharedMemBufferDescriptor& descriptor,
+        const std::chrono::milliseconds& max_wait)
+{
+    Listener* slot = listener(index);
+
+    if (try_pop(slot, descriptor))
+    {
+        return true;
+    }
+
+    slot->waiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    SharedMemSegment::wait_condition(slot->condition, [this, slot]()
+            {
+                return has_data(slot);
+            }, max_wait);
+    slot->waiting.store(0, std::memory_order_relaxed);
+
+    return try_pop(slot, descriptor);
+}
+
+void SharedMemPort::wake_up(uint32_t index)
+{
+    SharedMemSegment::notify_condition(listener(index)->condition);
+}
+
+void SharedMemPort::remove_dead_listeners(const ReleaseFunction& release)
+{
+    for (uint32_t i = 0; i < max_listeners_; ++i)
+    {
+        Listener* slot = listener(i);
+        if (slot->state.load(std::memory_order_acquire) == LISTENER_ACTIVE &&
+                !SharedMemSegment::is_process_alive(slot->process_id))
+        {
+            uint32_t expected = LISTENER_ACTIVE;
+            if (slot->state.compare_exchange_strong(expected, LISTENER_CLEANING))
+            {
+                logInfo(RTPS_TRANSPORT_SHM, "Removing dead listener of shared memory port " << port_);
+                release_listener(slot, release);
+            }
+        }
+    }
+}
+
+void SharedMemPort::release_listener(
+        Listener* slot,
+        const ReleaseFunction& release)
+{
+    // Senders that saw the slot active may still be pushing. A sender that died inside push must not block this.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+    while (slot->pushers.load() != 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+
+    SharedMemBufferDescriptor descriptor;
+    while (try_pop(slot, descriptor))
+    {
+        release(descriptor);
+    }
+
+    slot->state.store(LISTENER_FREE, std::memory_order_release);
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
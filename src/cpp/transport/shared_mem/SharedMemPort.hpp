@@ -0,0 +1,206 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __TRANSPORT_SHARED_MEM_SHAREDMEMPORT_HPP__
+#define __TRANSPORT_SHARED_MEM_SHAREDMEMPORT_HPP__
+
+#include "SharedMemSegment.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Location of a message inside the segment of the transport that sent it.
+ */
+struct SharedMemBufferDescriptor
+{
+    //! Identifier of the segment holding the message.
+    uint64_t segment_id;
+    //! Offset of the buffer inside the segment.
+    uint32_t offset;
+    //! Size of the message.
+    uint32_t size;
+};
+
+/**
+ * Listening port shared by all the processes of the host.
+ *
+ * The port lives in its own segment and has a number of listener slots (one for unicast ports, several for
+ * multicast ones). Each listener owns a bounded lock-free ring of buffer descriptors: any process pushes on it,
+ * and the listener pops. The rings only move descriptors; messages stay in the segment of their sender.
+ *
+ * Every SharedMemPort object, whether used to listen or to send, takes an owner entry in the segment. The last
+ * owner to close the port removes its segment, and owners that died are not counted, so remove_stale_ports can
+ * get rid of the ports left behind by processes that crashed.
+ */
+class SharedMemPort
+{
+public:
+
+    typedef std::function<void(const SharedMemBufferDescriptor&)> ReleaseFunction;
+
+    //! Maximum number of listeners of a multicast port.
+    static const uint32_t max_multicast_listeners = 32;
+
+    //! Maximum number of SharedMemPort objects, among all the processes, having the same port open.
+    static const uint32_t max_owners = 1024;
+
+    /**
+     * Opens a port, creating it when it does not exist yet.
+     * @param port Port number.
+     * @param is_multicast Whether the port is a multicast one.
+     * @param queue_capacity Capacity of the rings, used when creating the port. Rounded up to a power of two.
+     * @param permissions Access mode of the segment, used when creating the port.
+     * @return The port, or nullptr on error.
+     */
+    static std::unique_ptr<SharedMemPort> open(
+            uint32_t port,
+            bool is_multicast,
+            uint32_t queue_capacity,
+            uint32_t permissions);
+
+    //! Removes the ports whose owners are not running anymore.
+    static void remove_stale_ports();
+
+    //! Gives back the owner entry, removing the port when no other owner is left.
+    ~SharedMemPort();
+
+    uint32_t port() const
+    {
+        return port_;
+    }
+
+    bool is_multicast() const
+    {
+        return is_multicast_;
+    }
+
+    uint32_t max_listeners() const
+    {
+        return max_listeners_;
+    }
+
+    /**
+     * Takes a free listener slot for the calling process.
+     * Slots whose owner died are freed first.
+     * @param release Called for each descriptor left in the ring of a dead listener.
+     * @return Index of the slot, or -1 when the port has no free slot.
+     */
+    int32_t register_listener(const ReleaseFunction& release);
+
+    /**
+     * Gives back a slot taken with register_listener.
+     * @param release Called for each descriptor left in the ring.
+     */
+    void unregister_listener(
+            uint32_t listener,
+            const ReleaseFunction& release);
+
+    //! Whether a slot has a listener.
+    bool is_listener_active(uint32_t listener) const;
+
+    /**
+     * Pushes a descriptor on the ring of a listener and wakes it up.
+     * @return false when the slot has no listener, or the ring is full.
+     */
+    bool push(
+            uint32_t listener,
+            const SharedMemBufferDescriptor& descriptor);
+
+    /**
+     * Takes the next descriptor of a listener, blocking up to max_wait when the ring is empty.
+     * @return false when nothing was received.
+     */
+    bool pop(
+            uint32_t listener,
+            SharedMemBufferDescriptor& descriptor,
+            const std::chrono::milliseconds& max_wait);
+
+    //! Wakes up the listener blocked on pop.
+    void wake_up(uint32_t listener);
+
+    /**
+     * Frees the slots whose owner process is not running anymore.
+     * @param release Called for each descriptor left in their rings.
+     */
+    void remove_dead_listeners(const ReleaseFunction& release);
+
+private:
+
+    struct Cell;
+    struct Listener;
+    struct Header;
+
+    SharedMemPort(
+            std::unique_ptr<SharedMemSegment>&& segment,
+            uint32_t port,
+            bool is_multicast,
+            uint32_t owner);
+
+    SharedMemPort(const SharedMemPort&) = delete;
+    SharedMemPort& operator=(const SharedMemPort&) = delete;
+
+    //! Offset of the first listener slot inside the segment.
+    static size_t listeners_offset();
+
+    //! Takes a free owner entry for the calling process, or the entry of a dead one. Returns -1 when none is left.
+    static int32_t claim_owner(Header* header);
+
+    //! Whether a running process owns the port.
+    static bool has_live_owners(const Header* header);
+
+    //! Removes the segment of a port when it has no live owners.
+    static void remove_if_unused(
+            Header* header,
+            const std::string& name);
+
+    Listener* listener(uint32_t index) const;
+
+    Cell* cell(
+            Listener* listener,
+            uint32_t position) const;
+
+    bool try_pop(
+            Listener* listener,
+            SharedMemBufferDescriptor& descriptor);
+
+    bool has_data(Listener* listener) const;
+
+    //! Empties the ring of a slot being cleaned and frees it.
+    void release_listener(
+            Listener* listener,
+            const ReleaseFunction& release);
+
+    std::unique_ptr<SharedMemSegment> segment_;
+    uint32_t port_;
+    bool is_multicast_;
+    Header* header_;
+    uint32_t max_listeners_;
+    uint32_t mask_;
+    uint32_t owner_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // __TRANSPORT_SHARED_MEM_SHAREDMEMPORT_HPP__
@@ -0,0 +1,322 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SharedMemSegment.hpp"
+
+#include <fastrtps/log/Log.h>
+
+#include <cstring>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+#if !defined(_WIN32)
+
+namespace {
+
+struct SharedCondition
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cv;
+};
+
+static_assert(sizeof(SharedCondition) <= SharedMemSegment::condition_storage_size,
+        "condition_storage_size too small for this platform");
+
+void lock(pthread_mutex_t* mutex)
+{
+#if defined(__linux__)
+    // Recover the mutex when its owner died while holding it.
+    if (pthread_mutex_lock(mutex) == EOWNERDEAD)
+    {
+        pthread_mutex_consistent(mutex);
+    }
+#else
+    pthread_mutex_lock(mutex);
+#endif
+}
+
+} // namespace
+
+SharedMemSegment::~SharedMemSegment()
+{
+    munmap(base_, size_);
+}
+
+std::unique_ptr<SharedMemSegment> SharedMemSegment::create(
+        const std::string& name,
+        size_t size,
+        uint32_t permissions)
+{
+    mode_t mode = static_cast<mode_t>(permissions & 0777);
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, mode);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    // The umask applies to shm_open, but not to fchmod.
+    fchmod(fd, mode);
+
+    void* base = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+    {
+        base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (base == MAP_FAILED)
+    {
+        logError(RTPS_TRANSPORT_SHM, "Cannot create shared memory segment " << name << " of " << size << " bytes");
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    return std::unique_ptr<SharedMemSegment>(new SharedMemSegment(name, base, size));
+}
+
+std::unique_ptr<SharedMemSegment> SharedMemSegment::open(const std::string& name)
+{
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    // The creator sizes the segment right after creating it.
+    struct stat st;
+    st.st_size = 0;
+    for (uint32_t tries = 0; tries < 100 && fstat(fd, &st) == 0 && st.st_size == 0; ++tries)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    void* base = MAP_FAILED;
+    size_t size = static_cast<size_t>(st.st_size);
+    if (size > 0)
+    {
+        base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (base == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    return std::unique_ptr<SharedMemSegment>(new SharedMemSegment(name, base, size));
+}
+
+void SharedMemSegment::remove(const std::string& name)
+{
+    shm_unlink(name.c_str());
+}
+
+std::vector<std::string> SharedMemSegment::list(const std::string& prefix)
+{
+    std::vector<std::string> names;
+
+#if defined(__linux__)
+    // Segment names start with a slash, which is not part of the file name.
+    std::string file_prefix = prefix.substr(prefix.compare(0, 1, "/") == 0 ? 1 : 0);
+    DIR* dir = opendir("/dev/shm");
+    if (dir != nullptr)
+    {
+        struct dirent* entry = nullptr;
+        while ((entry = readdir(dir)) != nullptr)
+        {
+            if (strncmp(entry->d_name, file_prefix.c_str(), file_prefix.size()) == 0)
+            {
+                names.push_back(std::string("/") + entry->d_name);
+            }
+        }
+        closedir(dir);
+    }
+#else
+    (void)prefix;
+#endif
+
+    return names;
+}
+
+bool SharedMemSegment::is_supported()
+{
+    return true;
+}
+
+uint32_t SharedMemSegment::current_process_id()
+{
+    return static_cast<uint32_t>(getpid());
+}
+
+bool SharedMemSegment::is_process_alive(uint32_t process_id)
+{
+    return kill(static_cast<pid_t>(process_id), 0) == 0 || errno != ESRCH;
+}
+
+uint32_t SharedMemSegment::host_id()
+{
+    char host_name[256] = {0};
+    gethostname(host_name, sizeof(host_name) - 1);
+
+    // FNV-1a
+    uint32_t id = 2166136261u;
+    for (const char* c = host_name; *c != 0; ++c)
+    {
+        id ^= static_cast<uint8_t>(*c);
+        id *= 16777619u;
+    }
+
+    // Zero means an undefined address in a locator.
+    return id != 0 ? id : 1;
+}
+
+void SharedMemSegment::init_condition(void* storage)
+{
+    SharedCondition* condition = static_cast<SharedCondition*>(storage);
+
+    pthread_mutexattr_t mutex_attr;
+    pthread_mutexattr_init(&mutex_attr);
+    pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED);
+#if defined(__linux__)
+    pthread_mutexattr_setrobust(&mutex_attr, PTHREAD_MUTEX_ROBUST);
+#endif
+    pthread_mutex_init(&condition->mutex, &mutex_attr);
+    pthread_mutexattr_destroy(&mutex_attr);
+
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setpshared(&cond_attr, PTHREAD_PROCESS_SHARED);
+    pthread_cond_init(&condition->cv, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+}
+
+void SharedMemSegment::notify_condition(void* storage)
+{
+    SharedCondition* condition = static_cast<SharedCondition*>(storage);
+    lock(&condition->mutex);
+    pthread_cond_broadcast(&condition->cv);
+    pthread_mutex_unlock(&condition->mutex);
+}
+
+void SharedMemSegment::wait_condition(
+        void* storage,
+        const std::function<bool()>& ready,
+        const std::chrono::milliseconds& max_wait)
+{
+    SharedCondition* condition = static_cast<SharedCondition*>(storage);
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(max_wait).count() + deadline.tv_nsec;
+    deadline.tv_sec += static_cast<time_t>(nanoseconds / 1000000000);
+    deadline.tv_nsec = static_cast<long>(nanoseconds % 1000000000);
+
+    lock(&condition->mutex);
+    if (!ready())
+    {
+        if (pthread_cond_timedwait(&condition->cv, &condition->mutex, &deadline) == EOWNERDEAD)
+        {
+#if defined(__linux__)
+            pthread_mutex_consistent(&condition->mutex);
+#endif
+        }
+    }
+    pthread_mutex_unlock(&condition->mutex);
+}
+
+#else
+
+SharedMemSegment::~SharedMemSegment()
+{
+}
+
+std::unique_ptr<SharedMemSegment> SharedMemSegment::create(
+        const std::string&,
+        size_t,
+        uint32_t)
+{
+    return nullptr;
+}
+
+std::unique_ptr<SharedMemSegment> SharedMemSegment::open(const std::string&)
+{
+    return nullptr;
+}
+
+void SharedMemSegment::remove(const std::string&)
+{
+}
+
+std::vector<std::string> SharedMemSegment::list(const std::string&)
+{
+    return std::vector<std::string>();
+}
+
+bool SharedMemSegment::is_supported()
+{
+    return false;
+}
+
+uint32_t SharedMemSegment::current_process_id()
+{
+    return 0;
+}
+
+bool SharedMemSegment::is_process_alive(uint32_t)
+{
+    return true;
+}
+
+uint32_t SharedMemSegment::host_id()
+{
+    return 1;
+}
+
+void SharedMemSegment::init_condition(void*)
+{
+}
+
+void SharedMemSegment::notify_condition(void*)
+{
+}
+
+void SharedMemSegment::wait_condition(
+        void*,
+        const std::function<bool()>&,
+        const std::chrono::milliseconds& max_wait)
+{
+    std::this_thread::sleep_for(max_wait);
+}
+
+#endif
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
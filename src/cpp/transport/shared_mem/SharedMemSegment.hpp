@@ -0,0 +1,144 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __TRANSPORT_SHARED_MEM_SHAREDMEMSEGMENT_HPP__
+#define __TRANSPORT_SHARED_MEM_SHAREDMEMSEGMENT_HPP__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+/**
+ * Named shared memory segment mapped in the address space of the process.
+ *
+ * This class, together with its static helpers, isolates everything that depends on the platform:
+ * segments are POSIX shm objects, and the condition used to wake up listeners is a process-shared
+ * pthread mutex/condition pair. On platforms without them every operation fails.
+ */
+class SharedMemSegment
+{
+public:
+
+    //! Bytes reserved in shared memory for a condition (see init_condition).
+    static const size_t condition_storage_size = 192;
+
+    ~SharedMemSegment();
+
+    /**
+     * Creates and maps a new segment, filled with zeros.
+     * @param name Name of the segment.
+     * @param size Size of the segment in bytes.
+     * @param permissions Access mode of the segment, as in chmod. Applied regardless of the umask.
+     * @return The segment, or nullptr when it already exists or cannot be created.
+     */
+    static std::unique_ptr<SharedMemSegment> create(
+            const std::string& name,
+            size_t size,
+            uint32_t permissions);
+
+    /**
+     * Maps an existing segment.
+     * When the segment has just been created by another process, waits a little for it to be sized.
+     * @param name Name of the segment.
+     * @return The segment, or nullptr when it does not exist.
+     */
+    static std::unique_ptr<SharedMemSegment> open(const std::string& name);
+
+    //! Removes the name of a segment. Processes that have it mapped can keep using it.
+    static void remove(const std::string& name);
+
+    /**
+     * Names of the existing segments starting with a prefix.
+     * Only available where the segments can be enumerated (Linux); elsewhere the list is empty.
+     */
+    static std::vector<std::string> list(const std::string& prefix);
+
+    //! Whether shared memory segments are supported on this platform.
+    static bool is_supported();
+
+    //! Identifier of the calling process.
+    static uint32_t current_process_id();
+
+    //! Whether a process with the given identifier is running.
+    static bool is_process_alive(uint32_t process_id);
+
+    //! Identifier of the host, the same for all the processes running on it.
+    static uint32_t host_id();
+
+    /**
+     * Initializes a process-shared condition on memory of a segment.
+     * @param storage At least condition_storage_size bytes, aligned to 8 bytes.
+     */
+    static void init_condition(void* storage);
+
+    //! Wakes up a process blocked on wait_condition.
+    static void notify_condition(void* storage);
+
+    /**
+     * Blocks until notified or until max_wait expires, unless ready returns true first.
+     * ready is evaluated while the condition is locked, so a notification sent after it returns false is not lost.
+     */
+    static void wait_condition(
+            void* storage,
+            const std::function<bool()>& ready,
+            const std::chrono::milliseconds& max_wait);
+
+    void* base() const
+    {
+        return base_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    const std::string& name() const
+    {
+        return name_;
+    }
+
+private:
+
+    SharedMemSegment(
+            const std::string& name,
+            void* base,
+            size_t size)
+        : name_(name)
+        , base_(base)
+        , size_(size)
+    {
+    }
+
+    SharedMemSegment(const SharedMemSegment&) = delete;
+    SharedMemSegment& operator=(const SharedMemSegment&) = delete;
+
+    std::string name_;
+    void* base_;
+    size_t size_;
+};
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // __TRANSPORT_SHARED_MEM_SHAREDMEMSEGMENT_HPP__
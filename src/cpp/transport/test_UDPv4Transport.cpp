@@ -23,7 +23,8 @@ namespace rtps{
 
 std::vector<std::vector<octet> > test_UDPv4Transport::test_UDPv4Transport_DropLog;
 uint32_t test_UDPv4Transport::test_UDPv4Transport_DropLogLength = 0;
-bool test_UDPv4Transport::test_UDPv4Transport_ShutdownAllNetwork = false;
+std::atomic<bool> test_UDPv4Transport::test_UDPv4Transport_ShutdownAllNetwork(false);
+std::mutex test_UDPv4Transport::drop_log_mutex_;
 
 test_UDPv4Transport::test_UDPv4Transport(const test_UDPv4TransportDescriptor& descriptor):
     drop_data_messages_percentage_(descriptor.dropDataMessagesPercentage),
@@ -36,10 +37,10 @@ test_UDPv4Transport::test_UDPv4Transport(const test_UDPv4TransportDescriptor& de
     sequence_number_data_messages_to_drop_(descriptor.sequenceNumberDataMessagesToDrop),
     percentage_of_messages_to_drop_(descriptor.percentageOfMessagesToDrop)
     {
-        test_UDPv4Transport_DropLogLength = 0;
         test_UDPv4Transport_ShutdownAllNetwork = false;
         UDPv4Transport::mSendBufferSize = descriptor.sendBufferSize;
         UDPv4Transport::mReceiveBufferSize = descriptor.receiveBufferSize;
+        std::lock_guard<std::mutex> guard(drop_log_mutex_);
         test_UDPv4Transport_DropLog.clear();
         test_UDPv4Transport_DropLogLength = descriptor.dropLogLength;
     }
@@ -83,6 +84,54 @@ bool test_UDPv4Transport::send(
     }
 }
 
+bool test_UDPv4Transport::send(
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        eProsimaUDPSocket& socket,
+        const Locator_t& remote_locator,
+        bool only_multicast_purpose,
+        const std::chrono::microseconds& timeout)
+{
+    if (buffers.size() == 1)
+    {
+        return send(static_cast<const octet*>(buffers.front().buffer), total_bytes, socket, remote_locator,
+                only_multicast_purpose, timeout);
+    }
+
+    // Dropping criteria work on the whole message, so slices are inspected once they are put together.
+    std::vector<octet> contiguous;
+    coalesce_network_buffers(buffers, total_bytes, contiguous);
+    if (packet_should_drop(contiguous.data(), total_bytes))
+    {
+        log_drop(contiguous.data(), total_bytes);
+        return true;
+    }
+
+    return UDPv4Transport::send(buffers, total_bytes, socket, remote_locator, only_multicast_purpose, timeout);
+}
+
+bool test_UDPv4Transport::send(
+        const std::vector<NetworkBuffer>& buffers,
+        uint32_t total_bytes,
+        eProsimaUDPSocket& socket,
+        const Locator_t* remote_locators,
+        size_t num_locators,
+        bool only_multicast_purpose,
+        const std::chrono::microseconds& timeout)
+{
+    // Dropping criteria are applied to each datagram, so destinations are not batched.
+    bool success = true;
+    for (size_t i = 0; i < num_locators; ++i)
+    {
+        if (IsLocatorSupported(remote_locators[i]))
+        {
+            success &= send(buffers, total_bytes, socket, remote_locators[i], only_multicast_purpose, timeout);
+        }
+    }
+
+    return success;
+}
+
 static bool ReadSubmessageHeader(CDRMessage_t& msg, SubmessageHeader_t& smh)
 {
     if (msg.length - msg.pos < 4)
@@ -120,6 +169,9 @@ bool test_UDPv4Transport::packet_should_drop(const octet* send_buffer, uint32_t
         return true;
     }
 
+    // Dropping criteria keep state, so messages are inspected one at a time.
+    std::lock_guard<std::mutex> guard(drop_mutex_);
+
     CDRMessage_t cdrMessage(send_buffer_size);;
     memcpy(cdrMessage.buffer, send_buffer, send_buffer_size);
     cdrMessage.length = send_buffer_size;
@@ -214,6 +266,7 @@ bool test_UDPv4Transport::packet_should_drop(const octet* send_buffer, uint32_t
 
 bool test_UDPv4Transport::log_drop(const octet* buffer, uint32_t size)
 {
+    std::lock_guard<std::mutex> guard(drop_log_mutex_);
     if (test_UDPv4Transport_DropLog.size() < test_UDPv4Transport_DropLogLength)
     {
         vector<octet> message;
@@ -25,6 +25,7 @@
 
 #include <locale>
 #include <codecvt>
+#include <new>
 
 namespace eprosima {
 namespace fastrtps {
@@ -170,15 +171,25 @@ void DynamicData::create_members(const DynamicData* pData)
     }
     else
     {
-        values_.insert(std::make_pair(MEMBER_ID_INVALID, pData->clone_value(MEMBER_ID_INVALID, pData->get_kind())));
+        auto it = pData->values_.find(MEMBER_ID_INVALID);
+        if (it != pData->values_.end() && it->second == &pData->primitive_value_)
+        {
+            // Values stored in place are trivially copyable.
+            primitive_value_ = pData->primitive_value_;
+            values_.insert(std::make_pair(MEMBER_ID_INVALID, static_cast<void*>(&primitive_value_)));
+        }
+        else
+        {
+            values_.insert(std::make_pair(MEMBER_ID_INVALID, pData->clone_value(MEMBER_ID_INVALID, pData->get_kind())));
+        }
     }
 #endif
 }
 
 void DynamicData::create_members(DynamicType_ptr pType)
 {
-    std::map<MemberId, DynamicTypeMember*> members;
-    if (pType->get_all_members(members) == ResponseCode::RETCODE_OK)
+    // Members are read in place, copying the map of the type for every created data is expensive.
+    const std::map<MemberId, DynamicTypeMember*>& members = pType->member_by_id_;
     {
         if (pType->is_complex_kind())
         {
@@ -493,91 +504,91 @@ void DynamicData::add_value(
     case TK_INT32:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new int32_t()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) int32_t()));
 #endif
     }
     break;
     case TK_UINT32:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new uint32_t()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) uint32_t()));
 #endif
     }
     break;
     case TK_INT16:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new int16_t()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) int16_t()));
 #endif
     }
     break;
     case TK_UINT16:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new uint16_t()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) uint16_t()));
 #endif
     }
     break;
     case TK_INT64:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new int64_t()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) int64_t()));
 #endif
     }
     break;
     case TK_UINT64:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new uint64_t()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) uint64_t()));
 #endif
     }
     break;
     case TK_FLOAT32:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new float()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) float()));
 #endif
     }
     break;
     case TK_FLOAT64:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new double()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) double()));
 #endif
     }
     break;
     case TK_FLOAT128:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new long double()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) long double()));
 #endif
     }
     break;
     case TK_CHAR8:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new char()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) char()));
 #endif
     }
     break;
     case TK_CHAR16:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new wchar_t()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) wchar_t()));
 #endif
     }
     break;
     case TK_BOOLEAN:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new bool()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) bool()));
 #endif
     }
     break;
     case TK_BYTE:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new octet()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) octet()));
 #endif
     }
     break;
@@ -598,14 +609,14 @@ void DynamicData::add_value(
     case TK_ENUM:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new uint32_t()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) uint32_t()));
 #endif
     }
     break;
     case TK_BITMASK:
     {
 #ifndef DYNAMIC_TYPES_CHECKING
-        values_.insert(std::make_pair(id, new uint64_t()));
+        values_.insert(std::make_pair(id, new (&primitive_value_) uint64_t()));
 #endif
     }
     }
@@ -688,6 +699,10 @@ void DynamicData::clean_members()
             DynamicDataFactory::get_instance()->delete_data((DynamicData*)it->second);
         }
     }
+    else if (!values_.empty() && values_.begin()->second == &primitive_value_)
+    {
+        // Values stored in place are trivially destructible.
+    }
     else
     {
         switch (get_kind())
@@ -17,6 +17,9 @@
 #include <fastrtps/types/DynamicTypeBuilderFactory.h>
 #include <fastrtps/log/Log.h>
 
+#include <algorithm>
+#include <cstdint>
+
 namespace eprosima {
 namespace fastrtps {
 namespace types {
@@ -33,6 +36,13 @@ public:
 static DynamicDataFactoryReleaser s_releaser;
 static DynamicDataFactory* s_instance = nullptr;
 
+#ifndef DISABLE_DYNAMIC_MEMORY_CHECK
+// Marks the slots of the index whose data was deleted, so lookups keep probing past them.
+static char s_deleted_slot_mark;
+static DynamicData* const s_deleted_slot = reinterpret_cast<DynamicData*>(&s_deleted_slot_mark);
+static const size_t s_min_index_slots = 16;
+#endif
+
 DynamicDataFactory* DynamicDataFactory::get_instance()
 {
     if (s_instance == nullptr)
@@ -63,20 +73,111 @@ DynamicDataFactory::~DynamicDataFactory()
     std::unique_lock<std::recursive_mutex> scoped(mutex_);
     while (dynamic_datas_.size() > 0)
     {
-        delete_data(dynamic_datas_[dynamic_datas_.size() - 1]);
+        if (dynamic_datas_.back() == nullptr)
+        {
+            dynamic_datas_.pop_back();
+        }
+        else
+        {
+            delete_data(dynamic_datas_.back());
+        }
     }
-    dynamic_datas_.clear();
+    dynamic_datas_index_.clear();
 #endif
 }
 
+#ifndef DISABLE_DYNAMIC_MEMORY_CHECK
+void DynamicDataFactory::register_data(DynamicData* pData)
+{
+    std::unique_lock<std::recursive_mutex> scoped(mutex_);
+
+    // The index is kept at most half used, counting the slots of deleted data.
+    if ((used_index_slots_ + 1) * 2 > dynamic_datas_index_.size())
+    {
+        rebuild_index();
+    }
+
+    size_t slot = find_index_slot(pData);
+    if (dynamic_datas_index_[slot].data == nullptr)
+    {
+        ++used_index_slots_;
+    }
+    dynamic_datas_index_[slot] = IndexSlot{pData, dynamic_datas_.size()};
+    dynamic_datas_.push_back(pData);
+    ++live_datas_;
+}
+
+bool DynamicDataFactory::unregister_data(DynamicData* pData)
+{
+    std::unique_lock<std::recursive_mutex> scoped(mutex_);
+    if (dynamic_datas_index_.empty())
+    {
+        return false;
+    }
+
+    size_t slot = find_index_slot(pData);
+    if (dynamic_datas_index_[slot].data != pData)
+    {
+        return false;
+    }
+
+    dynamic_datas_[dynamic_datas_index_[slot].position] = nullptr;
+    dynamic_datas_index_[slot].data = s_deleted_slot;
+    --live_datas_;
+
+    if (dynamic_datas_.size() > s_min_index_slots && live_datas_ * 2 < dynamic_datas_.size())
+    {
+        rebuild_index();
+    }
+    return true;
+}
+
+size_t DynamicDataFactory::find_index_slot(DynamicData* pData) const
+{
+    size_t mask = dynamic_datas_index_.size() - 1;
+    size_t slot = ((reinterpret_cast<uintptr_t>(pData) >> 4) * 0x9E3779B1u) & mask;
+    size_t first_deleted = dynamic_datas_index_.size();
+
+    while (dynamic_datas_index_[slot].data != nullptr)
+    {
+        if (dynamic_datas_index_[slot].data == pData)
+        {
+            return slot;
+        }
+        if (dynamic_datas_index_[slot].data == s_deleted_slot && first_deleted == dynamic_datas_index_.size())
+        {
+            first_deleted = slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return first_deleted != dynamic_datas_index_.size() ? first_deleted : slot;
+}
+
+void DynamicDataFactory::rebuild_index()
+{
+    dynamic_datas_.erase(std::remove(dynamic_datas_.begin(), dynamic_datas_.end(), nullptr), dynamic_datas_.end());
+
+    size_t slots = s_min_index_slots;
+    while (slots < (live_datas_ + 1) * 4)
+    {
+        slots *= 2;
+    }
+
+    dynamic_datas_index_.assign(slots, IndexSlot{nullptr, 0});
+    for (size_t position = 0; position < dynamic_datas_.size(); ++position)
+    {
+        dynamic_datas_index_[find_index_slot(dynamic_datas_[position])] = IndexSlot{dynamic_datas_[position], position};
+    }
+    used_index_slots_ = dynamic_datas_.size();
+}
+#endif
+
 DynamicData* DynamicDataFactory::create_copy(const DynamicData* pData)
 {
     DynamicData* newData = new DynamicData(pData);
 #ifndef DISABLE_DYNAMIC_MEMORY_CHECK
-    {
-        std::unique_lock<std::recursive_mutex> scoped(mutex_);
-        dynamic_datas_.push_back(newData);
-    }
+    register_data(newData);
 #endif
 
     return newData;
@@ -115,10 +216,7 @@ DynamicData* DynamicDataFactory::create_data(DynamicType_ptr pType)
                 {
                     newData = new DynamicData(pType);
 #ifndef DISABLE_DYNAMIC_MEMORY_CHECK
-                    {
-                        std::unique_lock<std::recursive_mutex> scoped(mutex_);
-                        dynamic_datas_.push_back(newData);
-                    }
+                    register_data(newData);
 #endif
                     create_members(newData, pType->get_base_type());
                 }
@@ -127,10 +225,7 @@ DynamicData* DynamicDataFactory::create_data(DynamicType_ptr pType)
             {
                 newData = new DynamicData(pType);
 #ifndef DISABLE_DYNAMIC_MEMORY_CHECK
-                {
-                    std::unique_lock<std::recursive_mutex> scoped(mutex_);
-                    dynamic_datas_.push_back(newData);
-                }
+                register_data(newData);
 #endif
 
                 // Arrays must have created every members for serialization.
@@ -138,10 +233,7 @@ DynamicData* DynamicDataFactory::create_data(DynamicType_ptr pType)
                 {
                     DynamicData* defaultArrayData = new DynamicData(pType->get_element_type());
 #ifndef DISABLE_DYNAMIC_MEMORY_CHECK
-                    {
-                        std::unique_lock<std::recursive_mutex> scoped(mutex_);
-                        dynamic_datas_.push_back(defaultArrayData);
-                    }
+                    register_data(defaultArrayData);
 #endif
                     newData->default_array_value_ = defaultArrayData;
                 }
@@ -150,10 +242,7 @@ DynamicData* DynamicDataFactory::create_data(DynamicType_ptr pType)
                 {
                     DynamicData* discriminatorData = new DynamicData(pType->get_discriminator_type());
 #ifndef DISABLE_DYNAMIC_MEMORY_CHECK
-                    {
-                        std::unique_lock<std::recursive_mutex> scoped(mutex_);
-                        dynamic_datas_.push_back(discriminatorData);
-                    }
+                    register_data(discriminatorData);
 #endif
                     newData->set_union_discriminator(discriminatorData);
                 }
@@ -194,13 +283,7 @@ ResponseCode DynamicDataFactory::delete_data(DynamicData* pData)
     if (pData != nullptr)
     {
 #ifndef DISABLE_DYNAMIC_MEMORY_CHECK
-        std::unique_lock<std::recursive_mutex> scoped(mutex_);
-        auto it = std::find(dynamic_datas_.begin(), dynamic_datas_.end(), pData);
-        if (it != dynamic_datas_.end())
-        {
-            dynamic_datas_.erase(it);
-        }
-        else
+        if (!unregister_data(pData))
         {
             logError(DYN_TYPES, "Error deleting DynamicData. It isn't registered in the factory");
             return ResponseCode::RETCODE_ALREADY_DELETED;
@@ -215,7 +298,7 @@ bool DynamicDataFactory::is_empty() const
 {
 #ifndef DISABLE_DYNAMIC_MEMORY_CHECK
     std::unique_lock<std::recursive_mutex> scoped(mutex_);
-    return dynamic_datas_.empty();
+    return live_datas_ == 0;
 #else
     return true;
 #endif
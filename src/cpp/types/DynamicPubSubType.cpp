@@ -20,6 +20,8 @@
 #include <fastrtps/log/Log.h>
 #include <fastcdr/Cdr.h>
 
+#include "DynamicSerializationPlan.hpp"
+
 namespace eprosima {
 namespace fastrtps {
 namespace types {
@@ -27,12 +29,16 @@ namespace types {
 DynamicPubSubType::DynamicPubSubType()
     : dynamic_type_(nullptr)
     , m_keyBuffer(nullptr)
+    , m_keyBufferSize(0)
+    , m_serializationPlan(nullptr)
 {
 }
 
 DynamicPubSubType::DynamicPubSubType(DynamicType_ptr pType)
     : dynamic_type_(pType)
     , m_keyBuffer(nullptr)
+    , m_keyBufferSize(0)
+    , m_serializationPlan(nullptr)
 {
     UpdateDynamicTypeInfo();
 }
@@ -43,11 +49,14 @@ DynamicPubSubType::~DynamicPubSubType()
     {
         free(m_keyBuffer);
     }
+    delete m_serializationPlan;
 }
 
 void DynamicPubSubType::CleanDynamicType()
 {
     dynamic_type_ = nullptr;
+    delete m_serializationPlan;
+    m_serializationPlan = nullptr;
 }
 
 DynamicType_ptr DynamicPubSubType::GetDynamicType() const
@@ -108,7 +117,15 @@ bool DynamicPubSubType::deserialize(
 
     try
     {
-        ((DynamicData*)data)->deserialize(deser); //Deserialize the object:
+        //Deserialize the object:
+        if (m_serializationPlan != nullptr)
+        {
+            m_serializationPlan->deserialize((DynamicData*)data, deser);
+        }
+        else
+        {
+            ((DynamicData*)data)->deserialize(deser);
+        }
     }
     catch (eprosima::fastcdr::exception::NotEnoughMemoryException& /*exception*/)
     {
@@ -127,7 +144,7 @@ bool DynamicPubSubType::getKey(
         return false;
     }
     DynamicData* pDynamicData = (DynamicData*)data;
-    size_t keyBufferSize = static_cast<uint32_t>(DynamicData::getKeyMaxCdrSerializedSize(dynamic_type_));
+    size_t keyBufferSize = m_keyBufferSize;
 
     if (m_keyBuffer == nullptr)
     {
@@ -137,7 +154,14 @@ bool DynamicPubSubType::getKey(
 
     eprosima::fastcdr::FastBuffer fastbuffer((char*)m_keyBuffer, keyBufferSize);
     eprosima::fastcdr::Cdr ser(fastbuffer, eprosima::fastcdr::Cdr::BIG_ENDIANNESS);     // Object that serializes the data.
-    pDynamicData->serializeKey(ser);
+    if (m_serializationPlan != nullptr)
+    {
+        m_serializationPlan->serialize_key(pDynamicData, ser);
+    }
+    else
+    {
+        pDynamicData->serializeKey(ser);
+    }
     if (force_md5 || keyBufferSize > 16)
     {
         m_md5.init();
@@ -160,8 +184,13 @@ bool DynamicPubSubType::getKey(
 
 std::function<uint32_t()> DynamicPubSubType::getSerializedSizeProvider(void* data)
 {
-    return [data]() -> uint32_t
+    const DynamicSerializationPlan* plan = m_serializationPlan;
+    return [data, plan]() -> uint32_t
     {
+        if (plan != nullptr)
+        {
+            return (uint32_t)plan->serialized_size((DynamicData*)data) + 4 /*encapsulation*/;
+        }
         return (uint32_t)DynamicData::getCdrSerializedSize((DynamicData*)data) + 4 /*encapsulation*/;
     };
 }
@@ -182,7 +211,15 @@ bool DynamicPubSubType::serialize(
 
     try
     {
-        ((DynamicData*)data)->serialize(ser); // Serialize the object:
+        // Serialize the object:
+        if (m_serializationPlan != nullptr)
+        {
+            m_serializationPlan->serialize((DynamicData*)data, ser);
+        }
+        else
+        {
+            ((DynamicData*)data)->serialize(ser);
+        }
     }
     catch (eprosima::fastcdr::exception::NotEnoughMemoryException& /*exception*/)
     {
@@ -207,6 +244,11 @@ void DynamicPubSubType::UpdateDynamicTypeInfo()
         }
 
         m_typeSize = static_cast<uint32_t>(DynamicData::getMaxCdrSerializedSize(dynamic_type_) + 4);
+        m_keyBufferSize = DynamicData::getKeyMaxCdrSerializedSize(dynamic_type_);
+
+        // The type tree is only walked once, samples are processed with the compiled plan.
+        delete m_serializationPlan;
+        m_serializationPlan = new DynamicSerializationPlan(dynamic_type_);
         setName(dynamic_type_->get_name().c_str());
     }
 }
@@ -0,0 +1,647 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * @file DynamicSerializationPlan.cpp
+ *
+ */
+
+#include "DynamicSerializationPlan.hpp"
+
+#include <fastrtps/types/DynamicData.h>
+#include <fastrtps/types/DynamicDataFactory.h>
+#include <fastrtps/types/DynamicType.h>
+#include <fastrtps/types/DynamicTypeMember.h>
+#include <fastrtps/types/MemberDescriptor.h>
+#include <fastrtps/types/TypeDescriptor.h>
+#include <fastrtps/log/Log.h>
+#include <fastcdr/Cdr.h>
+
+namespace eprosima {
+namespace fastrtps {
+namespace types {
+
+using eprosima::fastcdr::Cdr;
+
+#ifndef DYNAMIC_TYPES_CHECKING
+
+// Unset elements of arrays are serialized in bulk from this buffer.
+static const uint64_t s_zeros[128] = {};
+
+template<typename T>
+static void serialize_zeros(
+        Cdr& cdr,
+        uint32_t count)
+{
+    const size_t zeros_size = sizeof(s_zeros);
+    const uint32_t chunk = static_cast<uint32_t>(zeros_size / sizeof(T));
+    while (count > 0)
+    {
+        uint32_t elements = count < chunk ? count : chunk;
+        cdr.serializeArray(reinterpret_cast<const T*>(s_zeros), elements);
+        count -= elements;
+    }
+}
+
+static inline size_t primitive_size(
+        size_t size,
+        size_t align,
+        size_t current_alignment)
+{
+    return size + Cdr::alignment(current_alignment, align);
+}
+
+template<typename T>
+inline T& DynamicSerializationPlan::value_of(const DynamicData* data)
+{
+    return *static_cast<T*>(data->values_.begin()->second);
+}
+
+// Aliases are transparent for DynamicData, which is created from the base type, but any level may disable the
+// serialization of the member.
+DynamicType_ptr DynamicSerializationPlan::resolve_alias(
+        const DynamicType_ptr& type,
+        bool& non_serialized)
+{
+    DynamicType_ptr resolved = type;
+    non_serialized = resolved->get_descriptor()->annotation_is_non_serialized();
+    while (resolved->get_kind() == TK_ALIAS && resolved->get_base_type() != nullptr)
+    {
+        resolved = resolved->get_base_type();
+        non_serialized |= resolved->get_descriptor()->annotation_is_non_serialized();
+    }
+    return resolved;
+}
+
+DynamicSerializationPlan::DynamicSerializationPlan(const DynamicType_ptr& type)
+{
+    compile(program_, type, MEMBER_ID_INVALID);
+    compile_key(key_program_, type, MEMBER_ID_INVALID);
+}
+
+void DynamicSerializationPlan::serialize(
+        const DynamicData* data,
+        Cdr& cdr) const
+{
+    serialize(program_.data(), data, cdr);
+}
+
+void DynamicSerializationPlan::serialize_key(
+        const DynamicData* data,
+        Cdr& cdr) const
+{
+    serialize(key_program_.data(), data, cdr);
+}
+
+void DynamicSerializationPlan::deserialize(
+        DynamicData* data,
+        Cdr& cdr) const
+{
+    deserialize(program_.data(), data, cdr);
+}
+
+size_t DynamicSerializationPlan::serialized_size(
+        const DynamicData* data,
+        size_t current_alignment) const
+{
+    return serialized_size(program_.data(), data, current_alignment);
+}
+
+void DynamicSerializationPlan::compile(
+        std::vector<Instruction>& program,
+        const DynamicType_ptr& type,
+        MemberId id)
+{
+    size_t position = program.size();
+    program.emplace_back(type, id);
+
+    bool non_serialized = false;
+    DynamicType_ptr resolved = resolve_alias(type, non_serialized);
+    if (non_serialized)
+    {
+        return;
+    }
+
+    OpCode code = OpCode::INTERPRETED;
+    switch (resolved->get_kind())
+    {
+        case TK_BOOLEAN: code = OpCode::BOOLEAN; break;
+        case TK_BYTE: code = OpCode::BYTE; break;
+        case TK_CHAR8: code = OpCode::CHAR8; break;
+        case TK_CHAR16: code = OpCode::CHAR16; break;
+        case TK_INT16: code = OpCode::INT16; break;
+        case TK_UINT16: code = OpCode::UINT16; break;
+        case TK_INT32: code = OpCode::INT32; break;
+        case TK_UINT32: code = OpCode::UINT32; break;
+        case TK_INT64: code = OpCode::INT64; break;
+        case TK_UINT64: code = OpCode::UINT64; break;
+        case TK_FLOAT32: code = OpCode::FLOAT32; break;
+        case TK_FLOAT64: code = OpCode::FLOAT64; break;
+        case TK_FLOAT128: code = OpCode::FLOAT128; break;
+        case TK_STRING8: code = OpCode::STRING8; break;
+        case TK_STRING16: code = OpCode::STRING16; break;
+        case TK_ENUM: code = OpCode::ENUM; break;
+        case TK_BITMASK:
+        {
+            switch (resolved->get_size())
+            {
+                case 1: code = OpCode::BITMASK8; break;
+                case 2: code = OpCode::BITMASK16; break;
+                case 3: code = OpCode::BITMASK32; break;
+                case 4: code = OpCode::BITMASK64; break;
+                default: break;
+            }
+            break;
+        }
+        case TK_STRUCTURE:
+        {
+            // Members of derived structures are created from the base type, keep them interpreted.
+            if (resolved->get_base_type() == nullptr)
+            {
+                code = OpCode::STRUCTURE;
+                for (auto it = resolved->member_by_id_.begin(); it != resolved->member_by_id_.end(); ++it)
+                {
+                    const MemberDescriptor* member = it->second->get_descriptor();
+                    if (!member->annotation_is_non_serialized())
+                    {
+                        compile(program, member->type_, it->first);
+                        ++program[position].count;
+                    }
+                }
+            }
+            break;
+        }
+        case TK_SEQUENCE:
+        {
+            code = OpCode::SEQUENCE;
+            compile(program, resolved->get_element_type(), MEMBER_ID_INVALID);
+            break;
+        }
+        case TK_ARRAY:
+        {
+            code = OpCode::ARRAY;
+            program[position].count = resolved->get_total_bounds();
+            compile(program, resolved->get_element_type(), MEMBER_ID_INVALID);
+            break;
+        }
+        default:
+            break;
+    }
+
+    program[position].code = code;
+    program[position].length = static_cast<uint32_t>(program.size() - position);
+}
+
+void DynamicSerializationPlan::compile_key(
+        std::vector<Instruction>& program,
+        const DynamicType_ptr& type,
+        MemberId id)
+{
+    bool non_serialized = false;
+    DynamicType_ptr resolved = resolve_alias(type, non_serialized);
+
+    if (resolved->get_kind() == TK_STRUCTURE || resolved->get_kind() == TK_BITSET)
+    {
+        size_t position = program.size();
+        program.emplace_back(type, id);
+
+        if (resolved->get_base_type() != nullptr)
+        {
+            program[position].code = OpCode::INTERPRETED_KEY;
+            return;
+        }
+
+        // Only the members holding part of the key are kept on the program.
+        program[position].code = OpCode::STRUCTURE;
+        for (auto it = resolved->member_by_id_.begin(); it != resolved->member_by_id_.end(); ++it)
+        {
+            size_t member_position = program.size();
+            compile_key(program, it->second->get_descriptor()->type_, it->first);
+            if (program[member_position].code == OpCode::NOOP)
+            {
+                program.erase(program.begin() + member_position, program.end());
+            }
+            else
+            {
+                ++program[position].count;
+            }
+        }
+
+        if (program[position].count == 0)
+        {
+            program[position].code = OpCode::NOOP;
+        }
+        program[position].length = static_cast<uint32_t>(program.size() - position);
+    }
+    else if (resolved->is_key_defined_)
+    {
+        compile(program, type, id);
+    }
+    else
+    {
+        program.emplace_back(type, id);
+    }
+}
+
+void DynamicSerializationPlan::serialize(
+        const Instruction* instruction,
+        const DynamicData* data,
+        Cdr& cdr)
+{
+    switch (instruction->code)
+    {
+        case OpCode::NOOP: break;
+        case OpCode::BOOLEAN: cdr << value_of<bool>(data); break;
+        case OpCode::BYTE: cdr << value_of<octet>(data); break;
+        case OpCode::CHAR8: cdr << value_of<char>(data); break;
+        case OpCode::CHAR16: cdr << value_of<wchar_t>(data); break;
+        case OpCode::INT16: cdr << value_of<int16_t>(data); break;
+        case OpCode::UINT16: cdr << value_of<uint16_t>(data); break;
+        case OpCode::INT32: cdr << value_of<int32_t>(data); break;
+        case OpCode::UINT32: cdr << value_of<uint32_t>(data); break;
+        case OpCode::INT64: cdr << value_of<int64_t>(data); break;
+        case OpCode::UINT64: cdr << value_of<uint64_t>(data); break;
+        case OpCode::FLOAT32: cdr << value_of<float>(data); break;
+        case OpCode::FLOAT64: cdr << value_of<double>(data); break;
+        case OpCode::FLOAT128: cdr << value_of<long double>(data); break;
+        case OpCode::STRING8: cdr << value_of<std::string>(data); break;
+        case OpCode::STRING16: cdr << value_of<std::wstring>(data); break;
+        case OpCode::ENUM: cdr << value_of<uint32_t>(data); break;
+        case OpCode::BITMASK8: cdr << value_of<uint8_t>(data); break;
+        case OpCode::BITMASK16: cdr << value_of<uint16_t>(data); break;
+        case OpCode::BITMASK32: cdr << value_of<uint32_t>(data); break;
+        case OpCode::BITMASK64: cdr << value_of<uint64_t>(data); break;
+        case OpCode::STRUCTURE:
+        {
+            // Members are stored sorted by id, as they are compiled.
+            const Instruction* member = instruction + 1;
+            auto it = data->values_.begin();
+            for (uint32_t i = 0; i < instruction->count; ++i, member += member->length)
+            {
+                while (it != data->values_.end() && it->first < member->id)
+                {
+                    ++it;
+                }
+
+                if (it != data->values_.end() && it->first == member->id)
+                {
+                    serialize(member, static_cast<const DynamicData*>(it->second), cdr);
+                }
+                else
+                {
+                    logError(DYN_TYPES, "Missing member " << member->id);
+                }
+            }
+            break;
+        }
+        case OpCode::SEQUENCE:
+        {
+            const Instruction* element = instruction + 1;
+            cdr << static_cast<uint32_t>(data->values_.size());
+            for (auto it = data->values_.begin(); it != data->values_.end(); ++it)
+            {
+                serialize(element, static_cast<const DynamicData*>(it->second), cdr);
+            }
+            break;
+        }
+        case OpCode::ARRAY:
+        {
+            // Arrays only store the elements that differ from the default value.
+            const Instruction* element = instruction + 1;
+            uint32_t next = 0;
+            for (auto it = data->values_.begin(); it != data->values_.end() && it->first < instruction->count; ++it)
+            {
+                serialize_empty(instruction, data, it->first - next, cdr);
+                serialize(element, static_cast<const DynamicData*>(it->second), cdr);
+                next = it->first + 1;
+            }
+            serialize_empty(instruction, data, instruction->count - next, cdr);
+            break;
+        }
+        case OpCode::INTERPRETED:
+            data->serialize(cdr);
+            break;
+        case OpCode::INTERPRETED_KEY:
+            data->serializeKey(cdr);
+            break;
+    }
+}
+
+void DynamicSerializationPlan::serialize_empty(
+        const Instruction* array,
+        const DynamicData* data,
+        uint32_t count,
+        Cdr& cdr)
+{
+    const Instruction* element = array + 1;
+    switch (element->code)
+    {
+        case OpCode::BOOLEAN:
+        case OpCode::BYTE:
+        case OpCode::CHAR8:
+        case OpCode::BITMASK8:
+            serialize_zeros<uint8_t>(cdr, count);
+            break;
+        case OpCode::INT16:
+        case OpCode::UINT16:
+        case OpCode::BITMASK16:
+            serialize_zeros<uint16_t>(cdr, count);
+            break;
+        case OpCode::CHAR16:
+        case OpCode::INT32:
+        case OpCode::UINT32:
+        case OpCode::FLOAT32:
+        case OpCode::ENUM:
+        case OpCode::BITMASK32:
+            serialize_zeros<uint32_t>(cdr, count);
+            break;
+        case OpCode::INT64:
+        case OpCode::UINT64:
+        case OpCode::FLOAT64:
+        case OpCode::BITMASK64:
+            serialize_zeros<uint64_t>(cdr, count);
+            break;
+        default:
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                data->serialize_empty_data(element->type, cdr);
+            }
+            break;
+    }
+}
+
+void DynamicSerializationPlan::deserialize(
+        const Instruction* instruction,
+        DynamicData* data,
+        Cdr& cdr)
+{
+    switch (instruction->code)
+    {
+        case OpCode::NOOP: break;
+        case OpCode::BOOLEAN: cdr >> value_of<bool>(data); break;
+        case OpCode::BYTE: cdr >> value_of<octet>(data); break;
+        case OpCode::CHAR8: cdr >> value_of<char>(data); break;
+        case OpCode::CHAR16: cdr >> value_of<wchar_t>(data); break;
+        case OpCode::INT16: cdr >> value_of<int16_t>(data); break;
+        case OpCode::UINT16: cdr >> value_of<uint16_t>(data); break;
+        case OpCode::INT32: cdr >> value_of<int32_t>(data); break;
+        case OpCode::UINT32: cdr >> value_of<uint32_t>(data); break;
+        case OpCode::INT64: cdr >> value_of<int64_t>(data); break;
+        case OpCode::UINT64: cdr >> value_of<uint64_t>(data); break;
+        case OpCode::FLOAT32: cdr >> value_of<float>(data); break;
+        case OpCode::FLOAT64: cdr >> value_of<double>(data); break;
+        case OpCode::FLOAT128: cdr >> value_of<long double>(data); break;
+        case OpCode::STRING8: cdr >> value_of<std::string>(data); break;
+        case OpCode::STRING16: cdr >> value_of<std::wstring>(data); break;
+        case OpCode::ENUM: cdr >> value_of<uint32_t>(data); break;
+        case OpCode::BITMASK8: cdr >> value_of<uint8_t>(data); break;
+        case OpCode::BITMASK16: cdr >> value_of<uint16_t>(data); break;
+        case OpCode::BITMASK32: cdr >> value_of<uint32_t>(data); break;
+        case OpCode::BITMASK64: cdr >> value_of<uint64_t>(data); break;
+        case OpCode::STRUCTURE:
+        {
+            const Instruction* member = instruction + 1;
+            auto it = data->values_.begin();
+            for (uint32_t i = 0; i < instruction->count; ++i, member += member->length)
+            {
+                while (it != data->values_.end() && it->first < member->id)
+                {
+                    ++it;
+                }
+
+                if (it == data->values_.end() || it->first != member->id)
+                {
+                    DynamicData* member_data = DynamicDataFactory::get_instance()->create_data(member->type);
+                    it = data->values_.insert(it, std::make_pair(member->id, static_cast<void*>(member_data)));
+                }
+                deserialize(member, static_cast<DynamicData*>(it->second), cdr);
+            }
+            break;
+        }
+        case OpCode::SEQUENCE:
+        {
+            const Instruction* element = instruction + 1;
+            uint32_t size(0);
+            cdr >> size;
+
+            auto it = data->values_.begin();
+            for (uint32_t i = 0; i < size; ++i)
+            {
+                while (it != data->values_.end() && it->first < i)
+                {
+                    ++it;
+                }
+
+                if (it == data->values_.end() || it->first != i)
+                {
+                    DynamicData* element_data = DynamicDataFactory::get_instance()->create_data(element->type);
+                    it = data->values_.insert(it, std::make_pair(i, static_cast<void*>(element_data)));
+                }
+                DynamicData* element_data = static_cast<DynamicData*>(it->second);
+                deserialize(element, element_data, cdr);
+                element_data->key_element_ = false;
+            }
+            break;
+        }
+        case OpCode::ARRAY:
+        {
+            const Instruction* element = instruction + 1;
+            DynamicData* input_data(nullptr);
+            auto it = data->values_.begin();
+            for (uint32_t i = 0; i < instruction->count; ++i)
+            {
+                while (it != data->values_.end() && it->first < i)
+                {
+                    ++it;
+                }
+
+                if (it != data->values_.end() && it->first == i)
+                {
+                    deserialize(element, static_cast<DynamicData*>(it->second), cdr);
+                }
+                else
+                {
+                    if (input_data == nullptr)
+                    {
+                        input_data = DynamicDataFactory::get_instance()->create_data(element->type);
+                    }
+
+                    deserialize(element, input_data, cdr);
+                    if (!input_data->equals(data->default_array_value_))
+                    {
+                        it = data->values_.insert(it, std::make_pair(i, static_cast<void*>(input_data)));
+                        input_data = nullptr;
+                    }
+                }
+            }
+            if (input_data != nullptr)
+            {
+                DynamicDataFactory::get_instance()->delete_data(input_data);
+            }
+            break;
+        }
+        case OpCode::INTERPRETED:
+        case OpCode::INTERPRETED_KEY:
+            data->deserialize(cdr);
+            break;
+    }
+}
+
+size_t DynamicSerializationPlan::serialized_size(
+        const Instruction* instruction,
+        const DynamicData* data,
+        size_t current_alignment)
+{
+    size_t initial_alignment = current_alignment;
+
+    switch (instruction->code)
+    {
+        case OpCode::NOOP:
+            break;
+        case OpCode::BOOLEAN:
+        case OpCode::BYTE:
+        case OpCode::CHAR8:
+        case OpCode::BITMASK8:
+            current_alignment += primitive_size(1, 1, current_alignment);
+            break;
+        case OpCode::INT16:
+        case OpCode::UINT16:
+        case OpCode::BITMASK16:
+            current_alignment += primitive_size(2, 2, current_alignment);
+            break;
+        case OpCode::CHAR16:
+        case OpCode::INT32:
+        case OpCode::UINT32:
+        case OpCode::FLOAT32:
+        case OpCode::ENUM:
+            current_alignment += primitive_size(4, 4, current_alignment);
+            break;
+        case OpCode::BITMASK32:
+            current_alignment += primitive_size(3, 3, current_alignment);
+            break;
+        case OpCode::INT64:
+        case OpCode::UINT64:
+        case OpCode::FLOAT64:
+            current_alignment += primitive_size(8, 8, current_alignment);
+            break;
+        case OpCode::BITMASK64:
+            current_alignment += primitive_size(4, 4, current_alignment);
+            break;
+        case OpCode::FLOAT128:
+            current_alignment += primitive_size(16, 8, current_alignment);
+            break;
+        case OpCode::STRING8:
+            // string content (length + characters + 1)
+            current_alignment += primitive_size(4, 4, current_alignment) + value_of<std::string>(data).length() + 1;
+            break;
+        case OpCode::STRING16:
+            // string content (length + (characters * 4) )
+            current_alignment += primitive_size(4, 4, current_alignment) +
+                value_of<std::wstring>(data).length() * 4;
+            break;
+        case OpCode::STRUCTURE:
+        {
+            const Instruction* member = instruction + 1;
+            auto it = data->values_.begin();
+            for (uint32_t i = 0; i < instruction->count; ++i, member += member->length)
+            {
+                while (it != data->values_.end() && it->first < member->id)
+                {
+                    ++it;
+                }
+
+                if (it != data->values_.end() && it->first == member->id)
+                {
+                    current_alignment += serialized_size(member, static_cast<const DynamicData*>(it->second),
+                            current_alignment);
+                }
+            }
+            break;
+        }
+        case OpCode::SEQUENCE:
+        {
+            const Instruction* element = instruction + 1;
+            // Elements count
+            current_alignment += primitive_size(4, 4, current_alignment);
+            for (auto it = data->values_.begin(); it != data->values_.end(); ++it)
+            {
+                current_alignment += serialized_size(element, static_cast<const DynamicData*>(it->second),
+                        current_alignment);
+            }
+            break;
+        }
+        case OpCode::ARRAY:
+        {
+            const Instruction* element = instruction + 1;
+            size_t empty_element_size = DynamicData::getEmptyCdrSerializedSize(element->type.get(), current_alignment);
+            uint32_t next = 0;
+            for (auto it = data->values_.begin(); it != data->values_.end() && it->first < instruction->count; ++it)
+            {
+                current_alignment += (it->first - next) * empty_element_size;
+                current_alignment += serialized_size(element, static_cast<const DynamicData*>(it->second),
+                        current_alignment);
+                next = it->first + 1;
+            }
+            current_alignment += (instruction->count - next) * empty_element_size;
+            break;
+        }
+        case OpCode::INTERPRETED:
+        case OpCode::INTERPRETED_KEY:
+            current_alignment += DynamicData::getCdrSerializedSize(data, current_alignment);
+            break;
+    }
+
+    return current_alignment - initial_alignment;
+}
+
+#else
+
+// Values are not stored on the generic map when checking types, so the plan falls back to DynamicData.
+DynamicSerializationPlan::DynamicSerializationPlan(const DynamicType_ptr&)
+{
+}
+
+void DynamicSerializationPlan::serialize(
+        const DynamicData* data,
+        Cdr& cdr) const
+{
+    data->serialize(cdr);
+}
+
+void DynamicSerializationPlan::serialize_key(
+        const DynamicData* data,
+        Cdr& cdr) const
+{
+    data->serializeKey(cdr);
+}
+
+void DynamicSerializationPlan::deserialize(
+        DynamicData* data,
+        Cdr& cdr) const
+{
+    data->deserialize(cdr);
+}
+
+size_t DynamicSerializationPlan::serialized_size(
+        const DynamicData* data,
+        size_t current_alignment) const
+{
+    return DynamicData::getCdrSerializedSize(data, current_alignment);
+}
+
+#endif // DYNAMIC_TYPES_CHECKING
+
+} // namespace types
+} // namespace fastrtps
+} // namespace eprosima
@@ -0,0 +1,174 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * @file DynamicSerializationPlan.hpp
+ *
+ */
+
+#ifndef FASTRTPS_TYPES_DYNAMICSERIALIZATIONPLAN_HPP_
+#define FASTRTPS_TYPES_DYNAMICSERIALIZATIONPLAN_HPP_
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+
+#include <fastrtps/types/TypesBase.h>
+#include <fastrtps/types/DynamicTypePtr.h>
+
+#include <vector>
+
+namespace eprosima {
+namespace fastcdr {
+class Cdr;
+} // namespace fastcdr
+
+namespace fastrtps {
+namespace types {
+
+class DynamicData;
+
+/**
+ * Flat list of serialization instructions compiled from a DynamicType.
+ *
+ * DynamicData walks the type tree on every (de)serialization, looking up member descriptors and annotations
+ * for each node. The plan resolves aliases, non-serialized members, bounds and key members once, so executing
+ * it only touches the values stored on the data.
+ * Kinds without a fixed layout (unions, maps, bitsets and derived structures) are delegated to DynamicData.
+ */
+class DynamicSerializationPlan
+{
+public:
+
+    explicit DynamicSerializationPlan(const DynamicType_ptr& type);
+
+    void serialize(
+            const DynamicData* data,
+            eprosima::fastcdr::Cdr& cdr) const;
+
+    void serialize_key(
+            const DynamicData* data,
+            eprosima::fastcdr::Cdr& cdr) const;
+
+    void deserialize(
+            DynamicData* data,
+            eprosima::fastcdr::Cdr& cdr) const;
+
+    size_t serialized_size(
+            const DynamicData* data,
+            size_t current_alignment = 0) const;
+
+private:
+
+    enum class OpCode : uint8_t
+    {
+        NOOP,
+        BOOLEAN,
+        BYTE,
+        CHAR8,
+        CHAR16,
+        INT16,
+        UINT16,
+        INT32,
+        UINT32,
+        INT64,
+        UINT64,
+        FLOAT32,
+        FLOAT64,
+        FLOAT128,
+        STRING8,
+        STRING16,
+        ENUM,
+        BITMASK8,
+        BITMASK16,
+        BITMASK32,
+        BITMASK64,
+        STRUCTURE,
+        SEQUENCE,
+        ARRAY,
+        INTERPRETED,
+        INTERPRETED_KEY
+    };
+
+    struct Instruction
+    {
+        Instruction(
+                const DynamicType_ptr& node_type,
+                MemberId node_id)
+            : code(OpCode::NOOP)
+            , id(node_id)
+            , count(0)
+            , length(1)
+            , type(node_type)
+        {
+        }
+
+        OpCode code;
+        //! Id of the member on its parent structure.
+        MemberId id;
+        //! Number of members of a structure or total bounds of an array.
+        uint32_t count;
+        //! Number of instructions of the subtree starting on this instruction.
+        uint32_t length;
+        //! Declared type of the node, used to create missing values.
+        DynamicType_ptr type;
+    };
+
+    template<typename T>
+    static T& value_of(const DynamicData* data);
+
+    static DynamicType_ptr resolve_alias(
+            const DynamicType_ptr& type,
+            bool& non_serialized);
+
+    static void compile(
+            std::vector<Instruction>& program,
+            const DynamicType_ptr& type,
+            MemberId id);
+
+    static void compile_key(
+            std::vector<Instruction>& program,
+            const DynamicType_ptr& type,
+            MemberId id);
+
+    static void serialize(
+            const Instruction* instruction,
+            const DynamicData* data,
+            eprosima::fastcdr::Cdr& cdr);
+
+    static void serialize_empty(
+            const Instruction* array,
+            const DynamicData* data,
+            uint32_t count,
+            eprosima::fastcdr::Cdr& cdr);
+
+    static void deserialize(
+            const Instruction* instruction,
+            DynamicData* data,
+            eprosima::fastcdr::Cdr& cdr);
+
+    static size_t serialized_size(
+            const Instruction* instruction,
+            const DynamicData* data,
+            size_t current_alignment);
+
+    std::vector<Instruction> program_;
+
+    std::vector<Instruction> key_program_;
+};
+
+} // namespace types
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS_PUBLIC
+#endif // FASTRTPS_TYPES_DYNAMICSERIALIZATIONPLAN_HPP_
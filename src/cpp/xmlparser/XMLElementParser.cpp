@@ -477,6 +477,7 @@ XMLP_ret XMLParser::getXMLThroughputController(tinyxml2::XMLElement *elem,
             <xs:all minOccurs="0">
                 <xs:element name="bytesPerPeriod" type="uint32Type" minOccurs="0"/>
                 <xs:element name="periodMillisecs" type="uint32Type" minOccurs="0"/>
+                <xs:element name="burstSize" type="uint32Type" minOccurs="0"/>
             </xs:all>
         </xs:complexType>
     */
@@ -498,6 +499,12 @@ XMLP_ret XMLParser::getXMLThroughputController(tinyxml2::XMLElement *elem,
             if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &throughputController.periodMillisecs, ident))
                 return XMLP_ret::XML_ERROR;
         }
+        else if (strcmp(name, BURST_SIZE) == 0)
+        {
+            // burstSize - uint32Type
+            if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &throughputController.burstSize, ident))
+                return XMLP_ret::XML_ERROR;
+        }
         else
         {
             logError(XMLPARSER, "Invalid element found into 'portType'. Name: " << name);
@@ -2240,6 +2247,7 @@ XMLP_ret XMLParser::getXMLHistoryMemoryPolicy(tinyxml2::XMLElement *elem,
                 <xs:enumeration value="PREALLOCATED"/>
                 <xs:enumeration value="PREALLOCATED_WITH_REALLOC"/>
                 <xs:enumeration value="DYNAMIC"/>
+                <xs:enumeration value="SIZE_CLASS"/>
             </xs:restriction>
         </xs:simpleType>
     */
@@ -2255,6 +2263,8 @@ XMLP_ret XMLParser::getXMLHistoryMemoryPolicy(tinyxml2::XMLElement *elem,
         historyMemoryPolicy = MemoryManagementPolicy::PREALLOCATED_WITH_REALLOC_MEMORY_MODE;
     else if (strcmp(text, DYNAMIC) == 0)
         historyMemoryPolicy = MemoryManagementPolicy::DYNAMIC_RESERVE_MEMORY_MODE;
+    else if (strcmp(text, SIZE_CLASS) == 0)
+        historyMemoryPolicy = MemoryManagementPolicy::SIZE_CLASS_MEMORY_MODE;
     else
     {
         logError(XMLPARSER, "Node '" << KIND << "' bad content");
@@ -21,6 +21,7 @@
 #include <fastrtps/transport/UDPv6TransportDescriptor.h>
 #include <fastrtps/transport/TCPv4TransportDescriptor.h>
 #include <fastrtps/transport/TCPv6TransportDescriptor.h>
+#include <fastrtps/transport/SharedMemTransportDescriptor.h>
 
 #include <fastrtps/xmlparser/XMLProfileManager.h>
 
@@ -248,6 +249,9 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
                 <xs:element name="receiveBufferSize" type="int32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="TTL" type="uint8Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="non_blocking_send" type="boolType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="receive_batch_size" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="receive_threads" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="receive_threads_affinity" type="cpuListType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="maxMessageSize" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="maxInitialPeersRange" type="uint32Type" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="interfaceWhiteList" type="stringListType" minOccurs="0" maxOccurs="1"/>
@@ -264,6 +268,9 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
                 <xs:element name="check_crc" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="enable_tcp_nodelay" type="boolType" minOccurs="0" maxOccurs="1"/>
                 <xs:element name="tls" type="tlsConfigType" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="segment_size" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="port_queue_capacity" type="uint32Type" minOccurs="0" maxOccurs="1"/>
+                <xs:element name="permissions" type="stringType" minOccurs="0" maxOccurs="1"/>
             </xs:all>
         </xs:complexType>
     */
@@ -322,6 +329,39 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
                     return XMLP_ret::XML_ERROR;
                 }
             }
+            // Receive batch size
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(RECEIVE_BATCH_SIZE)))
+            {
+                uint32_t batch_size = 0;
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &batch_size, 0) || batch_size == 0)
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+                pUDPDesc->receive_batch_size = batch_size;
+            }
+            // Shared receive threads
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(RECEIVE_THREADS)))
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pUDPDesc->receive_threads, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
+            // Shared receive threads affinity
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(RECEIVE_THREADS_AFFINITY)))
+            {
+                tinyxml2::XMLElement* p_aux1 = p_aux0->FirstChildElement(CPU);
+                while (nullptr != p_aux1)
+                {
+                    uint32_t cpu = 0;
+                    if (XMLP_ret::XML_OK != getXMLUint(p_aux1, &cpu, 0))
+                    {
+                        return XMLP_ret::XML_ERROR;
+                    }
+                    pUDPDesc->receive_threads_affinity.push_back(cpu);
+                    p_aux1 = p_aux1->NextSiblingElement(CPU);
+                }
+            }
         }
         else if (sType == TCPv4)
         {
@@ -355,6 +395,48 @@ XMLP_ret XMLParser::parseXMLTransportData(tinyxml2::XMLElement* p_root)
                 return ret;
             }
         }
+        else if (sType == SHM)
+        {
+            std::shared_ptr<rtps::SharedMemTransportDescriptor> pSHMDesc =
+                std::make_shared<rtps::SharedMemTransportDescriptor>();
+            pDescriptor = pSHMDesc;
+
+            // Segment size
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(SEGMENT_SIZE)))
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pSHMDesc->segment_size, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
+            // Port queue capacity
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(PORT_QUEUE_CAPACITY)))
+            {
+                if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &pSHMDesc->port_queue_capacity, 0) ||
+                        pSHMDesc->port_queue_capacity == 0)
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+            }
+            // Permissions, in octal as in chmod
+            if (nullptr != (p_aux0 = p_root->FirstChildElement(PERMISSIONS)))
+            {
+                std::string permissions;
+                if (XMLP_ret::XML_OK != getXMLString(p_aux0, &permissions, 0))
+                {
+                    return XMLP_ret::XML_ERROR;
+                }
+
+                char* end = nullptr;
+                unsigned long mode = strtoul(permissions.c_str(), &end, 8);
+                if (end == permissions.c_str() || *end != 0 || mode > 0777)
+                {
+                    logError(XMLPARSER, "Invalid permissions '" << permissions << "'");
+                    return XMLP_ret::XML_ERROR;
+                }
+                pSHMDesc->permissions = static_cast<uint32_t>(mode);
+            }
+        }
         else
         {
             logError(XMLPARSER, "Invalid transport type: '" << sType << "'");
@@ -405,6 +487,13 @@ XMLP_ret XMLParser::parseXMLCommonTransportData(tinyxml2::XMLElement* p_root, sp
     for (p_aux0 = p_root->FirstChildElement(); p_aux0 != nullptr; p_aux0 = p_aux0->NextSiblingElement())
     {
         name = p_aux0->Name();
+        if (nullptr == pDesc && (strcmp(name, SEND_BUFFER_SIZE) == 0 || strcmp(name, RECEIVE_BUFFER_SIZE) == 0 ||
+            strcmp(name, TTL) == 0 || strcmp(name, WHITE_LIST) == 0))
+        {
+            logError(XMLPARSER, "Element '" << name << "' is only valid for socket based transports");
+            return XMLP_ret::XML_ERROR;
+        }
+
         if (strcmp(name, SEND_BUFFER_SIZE) == 0)
         {
             // sendBufferSize - int32Type
@@ -435,7 +524,7 @@ XMLP_ret XMLParser::parseXMLCommonTransportData(tinyxml2::XMLElement* p_root, sp
             uint32_t uSize = 0;
             if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &uSize, 0))
                 return XMLP_ret::XML_ERROR;
-            pDesc->maxMessageSize = uSize;
+            p_transport->maxMessageSize = uSize;
         }
         else if (strcmp(name, MAX_INITIAL_PEERS_RANGE) == 0)
         {
@@ -443,7 +532,7 @@ XMLP_ret XMLParser::parseXMLCommonTransportData(tinyxml2::XMLElement* p_root, sp
             uint32_t uRange = 0;
             if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &uRange, 0))
                 return XMLP_ret::XML_ERROR;
-            pDesc->maxInitialPeersRange = uRange;
+            p_transport->maxInitialPeersRange = uRange;
         }
         else if (strcmp(name, WHITE_LIST) == 0)
         {
@@ -475,7 +564,9 @@ XMLP_ret XMLParser::parseXMLCommonTransportData(tinyxml2::XMLElement* p_root, sp
             strcmp(name, LOGICAL_PORT_INCREMENT) == 0 || strcmp(name, LISTENING_PORTS) == 0 ||
             strcmp(name, CALCULATE_CRC) == 0 || strcmp(name, CHECK_CRC) == 0 ||
             strcmp(name, ENABLE_TCP_NODELAY) == 0 || strcmp(name, TLS) == 0 ||
-            strcmp(name, NON_BLOCKING_SEND) == 0 )
+            strcmp(name, NON_BLOCKING_SEND) == 0 || strcmp(name, RECEIVE_BATCH_SIZE) == 0 ||
+            strcmp(name, RECEIVE_THREADS) == 0 || strcmp(name, RECEIVE_THREADS_AFFINITY) == 0 ||
+            strcmp(name, SEGMENT_SIZE) == 0 || strcmp(name, PORT_QUEUE_CAPACITY) == 0)
         {
             // Parsed outside of this method
         }
@@ -2619,6 +2710,8 @@ XMLP_ret XMLParser::fillDataNode(tinyxml2::XMLElement* p_profile, DataNode<Parti
                 <xs:element name="defaultMulticastLocatorList" type="locatorListType" minOccurs="0"/>
                 <xs:element name="sendSocketBufferSize" type="uint32Type" minOccurs="0"/>
                 <xs:element name="listenSocketBufferSize" type="uint32Type" minOccurs="0"/>
+                <xs:element name="receiveProcessingThreads" type="uint32Type" minOccurs="0"/>
+                <xs:element name="intraprocessDelivery" type="boolType" minOccurs="0"/>
                 <xs:element name="builtin" type="builtinAttributesType" minOccurs="0"/>
                 <xs:element name="port" type="portType" minOccurs="0"/>
                 <xs:element name="userData" type="octetVectorType" minOccurs="0"/>
@@ -2706,6 +2799,22 @@ XMLP_ret XMLParser::fillDataNode(tinyxml2::XMLElement* p_profile, DataNode<Parti
                 return XMLP_ret::XML_ERROR;
             }
         }
+        else if (strcmp(name, RECV_PROCESSING_THREADS) == 0)
+        {
+            // receiveProcessingThreads - uint32Type
+            if (XMLP_ret::XML_OK != getXMLUint(p_aux0, &participant_node.get()->rtps.receiveProcessingThreads, ident))
+            {
+                return XMLP_ret::XML_ERROR;
+            }
+        }
+        else if (strcmp(name, INTRAPROCESS_DELIVERY) == 0)
+        {
+            // intraprocessDelivery - boolType
+            if (XMLP_ret::XML_OK != getXMLBool(p_aux0, &participant_node.get()->rtps.intraprocessDelivery, ident))
+            {
+                return XMLP_ret::XML_ERROR;
+            }
+        }
         else if (strcmp(name, BUILTIN) == 0)
         {
             // builtin
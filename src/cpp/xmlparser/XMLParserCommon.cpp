@@ -41,6 +41,10 @@ const char* RECEIVE_BUFFER_SIZE = "receiveBufferSize";
 const char* SEND_BUFFER_SIZE = "sendBufferSize";
 const char* TTL = "TTL";
 const char* NON_BLOCKING_SEND = "non_blocking_send";
+const char* RECEIVE_BATCH_SIZE = "receive_batch_size";
+const char* RECEIVE_THREADS = "receive_threads";
+const char* RECEIVE_THREADS_AFFINITY = "receive_threads_affinity";
+const char* CPU = "cpu";
 const char* WHITE_LIST = "interfaceWhiteList";
 const char* MAX_MESSAGE_SIZE = "maxMessageSize";
 const char* MAX_INITIAL_PEERS_RANGE = "maxInitialPeersRange";
@@ -54,6 +58,9 @@ const char* METADATA_LOGICAL_PORT = "metadata_logical_port";
 const char* LISTENING_PORTS = "listening_ports";
 const char* CALCULATE_CRC = "calculate_crc";
 const char* CHECK_CRC = "check_crc";
+const char* SEGMENT_SIZE = "segment_size";
+const char* PORT_QUEUE_CAPACITY = "port_queue_capacity";
+const char* PERMISSIONS = "permissions";
 
 const char* QOS_PROFILE = "qos_profile";
 const char* APPLICATION = "application";
@@ -69,6 +76,8 @@ const char* DEF_UNI_LOC_LIST = "defaultUnicastLocatorList";
 const char* DEF_MULTI_LOC_LIST = "defaultMulticastLocatorList";
 const char* SEND_SOCK_BUF_SIZE = "sendSocketBufferSize";
 const char* LIST_SOCK_BUF_SIZE = "listenSocketBufferSize";
+const char* RECV_PROCESSING_THREADS = "receiveProcessingThreads";
+const char* INTRAPROCESS_DELIVERY = "intraprocessDelivery";
 const char* BUILTIN = "builtin";
 const char* PORT = "port";
 const char* PORTS = "ports_";
@@ -113,6 +122,7 @@ const char* PROPAGATE = "propagate";
 const char* PREALLOCATED = "PREALLOCATED";
 const char* PREALLOCATED_WITH_REALLOC = "PREALLOCATED_WITH_REALLOC";
 const char* DYNAMIC = "DYNAMIC";
+const char* SIZE_CLASS = "SIZE_CLASS";
 const char* LOCATOR = "locator";
 const char* UDPv4_LOCATOR = "udpv4";
 const char* UDPv6_LOCATOR = "udpv6";
@@ -127,6 +137,7 @@ const char* UDPv4 = "UDPv4";
 const char* UDPv6 = "UDPv6";
 const char* TCPv4 = "TCPv4";
 const char* TCPv6 = "TCPv6";
+const char* SHM = "SHM";
 const char* INIT_ACKNACK_DELAY = "initialAcknackDelay";
 const char* HEARTB_RESP_DELAY = "heartbeatResponseDelay";
 const char* INIT_HEARTB_DELAY = "initialHeartbeatDelay";
@@ -203,6 +214,7 @@ const char* DEPTH = "depth";
 const char* ALLOCATED_SAMPLES = "allocated_samples";
 const char* BYTES_PER_SECOND = "bytesPerPeriod";
 const char* PERIOD_MILLISECS = "periodMillisecs";
+const char* BURST_SIZE = "burstSize";
 const char* PORT_BASE = "portBase";
 const char* DOMAIN_ID_GAIN = "domainIDGain";
 const char* PARTICIPANT_ID_GAIN = "participantIDGain";
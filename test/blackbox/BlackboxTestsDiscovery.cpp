@@ -19,10 +19,49 @@
 #include "PubSubWriter.hpp"
 
 #include <fastrtps/transport/test_UDPv4Transport.h>
+#include <fastrtps/rtps/builtin/data/ParticipantProxyData.h>
+#include <fastrtps/rtps/messages/RTPSMessageCreator.h>
+
+#include <asio.hpp>
+#include <atomic>
+#include <thread>
 
 using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
 
+/*!
+ * Sends the DATA(p) of a participant that does not exist, built from pdata, to the metatraffic multicast locator of
+ * the given domain.
+ */
+static void send_participant_announcement(
+        ParticipantProxyData& pdata,
+        uint32_t domain_id)
+{
+    CacheChange_t change(DISCOVERY_PARTICIPANT_DATA_MAX_SIZE);
+    change.kind = ALIVE;
+    change.writerGUID = GUID_t(pdata.m_guid.guidPrefix, c_EntityId_SPDPWriter);
+    change.sequenceNumber = SequenceNumber_t(0, 1);
+    change.instanceHandle = pdata.m_key;
+
+    CDRMessage_t payload(change.serializedPayload);
+    change.serializedPayload.encapsulation = (uint16_t)PL_CDR_LE;
+    payload.msg_endian = LITTLEEND;
+    ASSERT_TRUE(pdata.writeToCDRMessage(&payload, true));
+    change.serializedPayload.length = (uint16_t)payload.length;
+
+    CDRMessage_t msg(RTPSMESSAGE_DEFAULT_SIZE);
+    GuidPrefix_t prefix = pdata.m_guid.guidPrefix;
+    ASSERT_TRUE(RTPSMessageCreator::addMessageData(&msg, prefix, &change, WITH_KEY, c_EntityId_SPDPReader,
+                false, nullptr));
+
+    asio::io_service service;
+    asio::ip::udp::socket socket(service);
+    socket.open(asio::ip::udp::v4());
+    socket.send_to(asio::buffer(msg.buffer, msg.length), asio::ip::udp::endpoint(
+                asio::ip::address_v4::from_string("239.255.0.1"),
+                static_cast<uint16_t>(PortParameters().getMulticastPort(domain_id))));
+}
+
 TEST(BlackBox, ParticipantRemoval)
 {
     PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
@@ -483,6 +522,110 @@ TEST(BlackBox, PubSubAsReliableHelloworldUserData)
     reader.wait_discovery_result();
 }
 
+// Periodic announcements of a participant are identical to the first one. They have to keep it alive, but must not be
+// notified as a change of its QoS.
+TEST(BlackBox, ParticipantUnchangedAnnouncementRefreshesLease)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    // The lease would expire several times while waiting below if announcements were not processed.
+    writer.lease_duration({ 1, 0 }, { 0, 200000000 }).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    std::atomic<unsigned int> changed(0);
+    std::atomic<unsigned int> removed(0);
+    reader.setOnDiscoveryFunction([&writer, &changed, &removed](const ParticipantDiscoveryInfo& info) -> bool{
+            if(info.info.m_guid == writer.participant_guid())
+            {
+                if(info.status == ParticipantDiscoveryInfo::CHANGED_QOS_PARTICIPANT)
+                {
+                    ++changed;
+                }
+                else if(info.status == ParticipantDiscoveryInfo::REMOVED_PARTICIPANT ||
+                        info.status == ParticipantDiscoveryInfo::DROPPED_PARTICIPANT)
+                {
+                    ++removed;
+                }
+            }
+
+            return false;
+        });
+
+    reader.init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    reader.wait_discovery();
+    writer.wait_discovery();
+
+    std::this_thread::sleep_for(std::chrono::seconds(4));
+
+    EXPECT_EQ(0u, changed.load());
+    EXPECT_EQ(0u, removed.load());
+}
+
+// An announcement with the GUID of a known participant but a different content has to be fully processed.
+TEST(BlackBox, ParticipantChangedAnnouncementIsNotified)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+
+    ParticipantProxyData pdata{RTPSParticipantAllocationAttributes()};
+    pdata.m_VendorId = c_VendorId_eProsima;
+    pdata.m_guid = GUID_t(GuidPrefix_t(), c_EntityId_RTPSParticipant);
+    pdata.m_guid.guidPrefix.value[0] = 0xDE;
+    pdata.m_guid.guidPrefix.value[1] = 0xAD;
+    pdata.m_guid.guidPrefix.value[4] = static_cast<octet>(GET_PID() & 0xFF);
+    pdata.m_guid.guidPrefix.value[5] = static_cast<octet>((GET_PID() >> 8) & 0xFF);
+    pdata.m_key = pdata.m_guid;
+    pdata.m_participantName = "announced";
+    pdata.m_leaseDuration = Duration_t(20, 0);
+    pdata.m_availableBuiltinEndpoints = 0;
+
+    std::atomic<unsigned int> discovered(0);
+    std::atomic<unsigned int> changed(0);
+    reader.setOnDiscoveryFunction([&pdata, &discovered, &changed](const ParticipantDiscoveryInfo& info) -> bool{
+            if(info.info.m_guid == pdata.m_guid)
+            {
+                if(info.status == ParticipantDiscoveryInfo::DISCOVERED_PARTICIPANT)
+                {
+                    ++discovered;
+                }
+                else if(info.status == ParticipantDiscoveryInfo::CHANGED_QOS_PARTICIPANT)
+                {
+                    ++changed;
+                    return info.info.m_participantName == "changed";
+                }
+            }
+
+            return false;
+        });
+
+    reader.init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    const uint32_t domain_id = (uint32_t)GET_PID() % 230;
+    while (discovered.load() == 0)
+    {
+        send_participant_announcement(pdata, domain_id);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    // The same announcement again is not a change.
+    send_participant_announcement(pdata, domain_id);
+    send_participant_announcement(pdata, domain_id);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    EXPECT_EQ(0u, changed.load());
+
+    pdata.m_participantName = "changed";
+    send_participant_announcement(pdata, domain_id);
+
+    reader.wait_discovery_result();
+    EXPECT_EQ(1u, discovered.load());
+}
+
 //! Tests discovery of 20 participants, having one publisher and one subscriber each
 TEST(Discovery, TwentyParticipants)
 {
@@ -260,3 +260,39 @@ TEST_F(BlackBoxPersistence, AsyncRTPSAsReliableWithPersistence)
 
     std::cout << "Second round finished." << std::endl;
 }
+
+TEST_F(BlackBoxPersistence, RTPSAsReliableWithAsynchronousStorage)
+{
+    RTPSWithRegistrationReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    RTPSWithRegistrationWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+    std::string ip("239.255.1.4");
+
+    reader.make_persistent(db_file_name(), guid_prefix()).add_to_multicast_locator_list(ip, global_port).
+        reliability(eprosima::fastrtps::rtps::ReliabilityKind_t::RELIABLE).
+        add_property("dds.persistence.sqlite3.mode", "ASYNCHRONOUS").init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.make_persistent(db_file_name(), guid_prefix()).
+        add_property("dds.persistence.sqlite3.mode", "ASYNCHRONOUS").
+        add_property("dds.persistence.sqlite3.flush_interval_ms", "50").init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Discover, send and receive
+    run_one_send_recv_test(reader, writer, 0, true);
+
+    // Destroying the entities commits everything still queued, so the second round
+    // should continue where the first one stopped.
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    std::cout << "First round finished." << std::endl;
+
+    reader.init();
+    writer.init();
+
+    // Discover, send and receive
+    run_one_send_recv_test(reader, writer, 20, true);
+
+    std::cout << "Second round finished." << std::endl;
+}
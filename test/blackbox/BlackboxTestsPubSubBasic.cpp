@@ -19,9 +19,170 @@
 #include "ReqRepAsReliableHelloWorldRequester.hpp"
 #include "ReqRepAsReliableHelloWorldReplier.hpp"
 
+#include <fastrtps/Domain.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/publisher/Publisher.h>
+#include <fastrtps/publisher/PublisherListener.h>
+#include <fastrtps/subscriber/Subscriber.h>
+#include <fastrtps/subscriber/SubscriberListener.h>
+#include <fastrtps/subscriber/SampleInfo.h>
+
+#include <thread>
+
 using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
 
+/*!
+ * Participant with intraprocess delivery which publishes back, from the listener of its subscriber,
+ * every sample it receives until it has echoed a given number of them.
+ */
+class IntraprocessEchoer : public PublisherListener, public SubscriberListener
+{
+    public:
+
+        IntraprocessEchoer(
+                const std::string& input_topic,
+                const std::string& output_topic,
+                uint32_t max_echoes)
+            : participant_(nullptr)
+            , publisher_(nullptr)
+            , subscriber_(nullptr)
+            , matched_(0)
+            , echoes_(0)
+            , max_echoes_(max_echoes)
+        {
+            ParticipantAttributes pattr;
+            pattr.rtps.builtin.domainId = (uint32_t)GET_PID() % 230;
+            pattr.rtps.intraprocessDelivery = true;
+            participant_ = Domain::createParticipant(pattr);
+
+            if (participant_ != nullptr)
+            {
+                Domain::registerType(participant_, &type_);
+
+                PublisherAttributes puattr;
+                puattr.topic.topicKind = NO_KEY;
+                puattr.topic.topicDataType = type_.getName();
+                puattr.topic.topicName = output_topic;
+                puattr.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+                puattr.topic.historyQos.depth = 10;
+                puattr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+                publisher_ = Domain::createPublisher(participant_, puattr, this);
+
+                SubscriberAttributes sattr;
+                sattr.topic.topicKind = NO_KEY;
+                sattr.topic.topicDataType = type_.getName();
+                sattr.topic.topicName = input_topic;
+                sattr.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+                sattr.topic.historyQos.depth = 10;
+                sattr.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+                subscriber_ = Domain::createSubscriber(participant_, sattr, this);
+            }
+        }
+
+        ~IntraprocessEchoer()
+        {
+            if (participant_ != nullptr)
+            {
+                Domain::removeParticipant(participant_);
+            }
+        }
+
+        bool isInitialized() const
+        {
+            return publisher_ != nullptr && subscriber_ != nullptr;
+        }
+
+        void onPublicationMatched(
+                Publisher* /*pub*/,
+                MatchingInfo& info) override
+        {
+            matched(info);
+        }
+
+        void onSubscriptionMatched(
+                Subscriber* /*sub*/,
+                MatchingInfo& info) override
+        {
+            matched(info);
+        }
+
+        void onNewDataMessage(
+                Subscriber* sub) override
+        {
+            HelloWorld sample;
+            SampleInfo_t info;
+
+            while (sub->takeNextData(&sample, &info))
+            {
+                if (info.sampleKind == ALIVE)
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    if (echoes_ < max_echoes_)
+                    {
+                        ++echoes_;
+                        cv_.notify_all();
+                        lock.unlock();
+
+                        sample.index(sample.index() + 1);
+                        publisher_->write(&sample);
+                    }
+                }
+            }
+        }
+
+        //! Waits until both the publisher and the subscriber have matched the other participant.
+        void wait_discovery()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() -> bool { return matched_ >= 2; });
+        }
+
+        void send(
+                uint16_t index)
+        {
+            HelloWorld sample;
+            sample.index(index);
+            sample.message("HelloWorld");
+            publisher_->write(&sample);
+        }
+
+        bool wait_all_echoed(
+                const std::chrono::seconds& max_wait)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            return cv_.wait_for(lock, max_wait, [this]() -> bool { return echoes_ >= max_echoes_; });
+        }
+
+    private:
+
+        void matched(
+                const MatchingInfo& info)
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (info.status == MATCHED_MATCHING)
+            {
+                ++matched_;
+            }
+            else
+            {
+                --matched_;
+            }
+            cv_.notify_all();
+        }
+
+        Participant* participant_;
+        Publisher* publisher_;
+        Subscriber* subscriber_;
+        HelloWorldType type_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        int matched_;
+        uint32_t echoes_;
+        uint32_t max_echoes_;
+};
+
 TEST(BlackBox, PubSubAsNonReliableHelloworld)
 {
     PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
@@ -258,3 +419,201 @@ TEST(BlackBox, PubSubAsReliableHelloworldMulticastDisabled)
     reader.block_for_all();
 }
 
+
+TEST(BlackBox, PubSubAsReliableHelloworldTakeLoan)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Wait for discovery.
+    writer.wait_discovery();
+    reader.wait_discovery();
+
+    auto data = default_helloworld_data_generator();
+    auto expected = data;
+
+    // Samples are taken by the test, not by the listener of the reader.
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+
+    SampleLoan loan;
+    SampleInfo_t info;
+    for (const HelloWorld& sample : expected)
+    {
+        ASSERT_TRUE(reader.wait_for_unread_samples(Duration_t(5, 0)));
+        ASSERT_TRUE(reader.take_loan(loan, &info));
+        ASSERT_TRUE(loan.is_loaned());
+        EXPECT_EQ(info.sampleKind, ALIVE);
+
+        // A loan not returned yet cannot hold another sample.
+        EXPECT_FALSE(reader.take_loan(loan, &info));
+
+        HelloWorld received;
+        ASSERT_TRUE(reader.deserialize(loan, received));
+        EXPECT_EQ(received, sample);
+
+        // HelloWorld is not a plain type.
+        EXPECT_EQ(loan.get<HelloWorld>(), nullptr);
+
+        ASSERT_TRUE(reader.return_loan(loan));
+        EXPECT_FALSE(loan.is_loaned());
+        EXPECT_FALSE(reader.return_loan(loan));
+    }
+}
+
+TEST(BlackBox, PubSubAsReliableHelloworldBatchReadTake)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Wait for discovery.
+    writer.wait_discovery();
+    reader.wait_discovery();
+
+    auto data = default_helloworld_data_generator();
+    auto expected = data;
+
+    // Samples are taken by the test, not by the listener of the reader.
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+
+    for (int i = 0; i < 50 && reader.get_unread_count() < expected.size(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    ASSERT_EQ(reader.get_unread_count(), expected.size());
+
+    // Read does not remove the samples, so they are all taken afterwards.
+    std::vector<HelloWorld> samples(expected.size() + 1);
+    std::vector<SampleInfo_t> infos(samples.size());
+    ASSERT_EQ(reader.read(samples, infos.data()), expected.size());
+    EXPECT_EQ(reader.get_unread_count(), 0u);
+    EXPECT_EQ(reader.read(samples, infos.data()), 0u);
+
+    samples.assign(samples.size(), HelloWorld());
+    ASSERT_EQ(reader.take(samples, infos.data()), expected.size());
+    size_t i = 0;
+    for (const HelloWorld& sample : expected)
+    {
+        EXPECT_EQ(samples[i], sample);
+        EXPECT_EQ(infos[i].sampleKind, ALIVE);
+        ++i;
+    }
+    EXPECT_EQ(reader.take(samples, nullptr), 0u);
+}
+
+TEST(BlackBox, PubSubAsReliableHelloworldIntraprocess)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    reader.history_depth(100).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    writer.history_depth(100).intraprocess_delivery(true).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    // Wait for discovery.
+    writer.wait_discovery();
+    reader.wait_discovery();
+
+    auto data = default_helloworld_data_generator();
+
+    reader.startReception(data);
+
+    // Send data
+    writer.send(data);
+    // In this test all data should be sent.
+    ASSERT_TRUE(data.empty());
+    // Block reader until reception finished or timeout.
+    reader.block_for_all();
+    // Changes are acknowledged as soon as they are handed to the reader.
+    EXPECT_TRUE(writer.waitForAllAcked(std::chrono::seconds(1)));
+}
+
+TEST(BlackBox, PubSubAsReliableHelloworldIntraprocessLateJoiner)
+{
+    PubSubReader<HelloWorldType> reader(TEST_TOPIC_NAME);
+    PubSubWriter<HelloWorldType> writer(TEST_TOPIC_NAME);
+
+    writer.history_depth(10).
+        durability_kind(eprosima::fastrtps::TRANSIENT_LOCAL_DURABILITY_QOS).
+        intraprocess_delivery(true).init();
+
+    ASSERT_TRUE(writer.isInitialized());
+
+    auto data = default_helloworld_data_generator();
+    auto expected = data;
+
+    // Samples are written before the reader exists.
+    writer.send(data);
+    ASSERT_TRUE(data.empty());
+
+    reader.history_depth(10).
+        reliability(eprosima::fastrtps::RELIABLE_RELIABILITY_QOS).
+        durability_kind(eprosima::fastrtps::TRANSIENT_LOCAL_DURABILITY_QOS).init();
+
+    ASSERT_TRUE(reader.isInitialized());
+
+    reader.startReception(expected);
+
+    // The history of the writer is delivered when the reader is matched.
+    reader.block_for_all();
+}
+
+// Listeners of local readers publish on the writer of the other participant while the application
+// keeps writing on both of them. Listeners must not be called while a writer is locked.
+TEST(BlackBox, PubSubIntraprocessCrossPublishingListeners)
+{
+    const std::string ping_topic = TEST_TOPIC_NAME + "_ping";
+    const std::string pong_topic = TEST_TOPIC_NAME + "_pong";
+    const uint32_t max_echoes = 200;
+
+    IntraprocessEchoer first(pong_topic, ping_topic, max_echoes);
+    IntraprocessEchoer second(ping_topic, pong_topic, max_echoes);
+
+    ASSERT_TRUE(first.isInitialized());
+    ASSERT_TRUE(second.isInitialized());
+
+    first.wait_discovery();
+    second.wait_discovery();
+
+    std::thread first_thread([&first]()
+    {
+        for (uint16_t i = 0; i < 20; ++i)
+        {
+            first.send(i);
+        }
+    });
+
+    for (uint16_t i = 0; i < 20; ++i)
+    {
+        second.send(i);
+    }
+
+    first_thread.join();
+
+    EXPECT_TRUE(first.wait_all_echoed(std::chrono::seconds(10)));
+    EXPECT_TRUE(second.wait_all_echoed(std::chrono::seconds(10)));
+}
@@ -29,6 +29,7 @@
 #include <fastrtps/subscriber/SubscriberListener.h>
 #include <fastrtps/attributes/SubscriberAttributes.h>
 #include <fastrtps/subscriber/SampleInfo.h>
+#include <fastrtps/subscriber/SampleLoan.h>
 #include <fastrtps/xmlparser/XMLParser.h>
 #include <fastrtps/xmlparser/XMLTree.h>
 #include <fastrtps/utils/IPLocator.h>
@@ -36,6 +37,7 @@
 
 #include <string>
 #include <list>
+#include <vector>
 #include <atomic>
 #include <condition_variable>
 #include <asio.hpp>
@@ -763,6 +765,60 @@ public:
         return false;
     }
 
+    bool take_loan(eprosima::fastrtps::SampleLoan& loan, eprosima::fastrtps::SampleInfo_t* info)
+    {
+        if (subscriber_->take_loan(loan, info))
+        {
+            current_received_count_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool return_loan(eprosima::fastrtps::SampleLoan& loan)
+    {
+        return subscriber_->return_loan(loan);
+    }
+
+    uint32_t read(std::vector<type>& samples, eprosima::fastrtps::SampleInfo_t* infos)
+    {
+        std::vector<void*> pointers;
+        for (type& sample : samples)
+        {
+            pointers.push_back(&sample);
+        }
+        return subscriber_->read(pointers.data(), infos, static_cast<uint32_t>(samples.size()));
+    }
+
+    uint32_t take(std::vector<type>& samples, eprosima::fastrtps::SampleInfo_t* infos)
+    {
+        std::vector<void*> pointers;
+        for (type& sample : samples)
+        {
+            pointers.push_back(&sample);
+        }
+        uint32_t taken = subscriber_->take(pointers.data(), infos, static_cast<uint32_t>(samples.size()));
+        current_received_count_ += taken;
+        return taken;
+    }
+
+    uint64_t get_unread_count() const
+    {
+        return subscriber_->get_unread_count();
+    }
+
+    bool wait_for_unread_samples(const eprosima::fastrtps::Duration_t& timeout)
+    {
+        return subscriber_->wait_for_unread_samples(timeout);
+    }
+
+    bool deserialize(const eprosima::fastrtps::SampleLoan& loan, type& data)
+    {
+        eprosima::fastrtps::rtps::SerializedPayload_t* payload =
+                const_cast<eprosima::fastrtps::rtps::SerializedPayload_t*>(loan.payload());
+        return payload != nullptr && type_.deserialize(payload, &data);
+    }
+
     unsigned int missed_deadlines() const
     {
         return listener_.missed_deadlines();
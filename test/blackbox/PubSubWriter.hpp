@@ -696,6 +696,12 @@ class PubSubWriter
         return *this;
     }
 
+    PubSubWriter& intraprocess_delivery(bool enabled)
+    {
+        participant_attr_.rtps.intraprocessDelivery = enabled;
+        return *this;
+    }
+
     PubSubWriter& load_participant_attr(const std::string& xml)
     {
         std::unique_ptr<eprosima::fastrtps::xmlparser::BaseNode> root;
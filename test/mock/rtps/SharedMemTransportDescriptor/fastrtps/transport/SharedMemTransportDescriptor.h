@@ -0,0 +1,66 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SHAREDMEM_TRANSPORT_DESCRIPTOR_H
+#define SHAREDMEM_TRANSPORT_DESCRIPTOR_H
+
+#include <fastrtps/transport/TransportDescriptorInterface.h>
+#include <fastrtps/fastrtps_dll.h>
+
+namespace eprosima{
+namespace fastrtps{
+namespace rtps{
+
+class TransportInterface;
+
+/**
+ * Shared memory transport configuration
+ * @ingroup TRANSPORT_MODULE
+ */
+typedef struct SharedMemTransportDescriptor : public TransportDescriptorInterface
+{
+   virtual ~SharedMemTransportDescriptor(){}
+
+   virtual TransportInterface* create_transport() const override { return nullptr; }
+
+   RTPS_DllAPI SharedMemTransportDescriptor()
+   : TransportDescriptorInterface(65500, 4)
+   , segment_size(1024 * 1024)
+   , port_queue_capacity(512)
+   , permissions(0600)
+   {
+
+   }
+
+   RTPS_DllAPI SharedMemTransportDescriptor(const SharedMemTransportDescriptor& t)
+   : TransportDescriptorInterface(t)
+   , segment_size(t.segment_size)
+   , port_queue_capacity(t.port_queue_capacity)
+   , permissions(t.permissions)
+   {
+
+   }
+
+   uint32_t segment_size;
+
+   uint32_t port_queue_capacity;
+
+   uint32_t permissions;
+} SharedMemTransportDescriptor;
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+#endif // SHAREDMEM_TRANSPORT_DESCRIPTOR_H
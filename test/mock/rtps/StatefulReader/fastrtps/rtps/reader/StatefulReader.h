@@ -18,6 +18,7 @@
 #include <fastrtps/rtps/reader/RTPSReader.h>
 #include <fastrtps/rtps/attributes/ReaderAttributes.h>
 #include <fastrtps/rtps/common/Guid.h>
+#include <fastrtps/transport/NetworkBuffer.h>
 
 namespace eprosima {
 namespace fastrtps {
@@ -66,7 +67,8 @@ class StatefulReader : public RTPSReader
         RTPSParticipantImpl* getRTPSParticipant() const { return nullptr; }
 
         bool send_sync_nts(
-                CDRMessage_t* /*message*/,
+                const std::vector<NetworkBuffer>& /*buffers*/,
+                uint32_t /*total_bytes*/,
                 const Locator_t& /*locator*/,
                 std::chrono::steady_clock::time_point& /*max_blocking_time_point*/)
         {
@@ -36,6 +36,9 @@ class StatefulWriter : public RTPSWriter
 
         StatefulWriter() : participant_(nullptr), mp_history(new WriterHistory()) {}
 
+        StatefulWriter(const HistoryAttributes& history_attributes)
+            : participant_(nullptr), mp_history(new WriterHistory(history_attributes)) {}
+
         virtual ~StatefulWriter() { delete mp_history; }
 
         MOCK_METHOD1(matched_reader_add, bool(const ReaderProxyData&));
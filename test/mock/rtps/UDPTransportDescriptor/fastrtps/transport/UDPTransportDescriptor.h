@@ -54,6 +54,12 @@ typedef struct UDPTransportDescriptor: public SocketTransportDescriptor
    uint16_t m_output_udp_socket;
    
    bool non_blocking_send = false;
+
+   uint32_t receive_batch_size = 1;
+
+   uint32_t receive_threads = 0;
+
+   std::vector<uint32_t> receive_threads_affinity;
 } UDPTransportDescriptor;
 
 } // namespace rtps
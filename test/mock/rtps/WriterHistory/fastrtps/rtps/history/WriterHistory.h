@@ -33,7 +33,7 @@ class WriterHistory
     public:
 
 
-        WriterHistory(const HistoryAttributes& /*att*/) : samples_number_(0) {}
+        WriterHistory(const HistoryAttributes& att) : m_att(att), samples_number_(0) {}
 
         WriterHistory() : samples_number_(0) {}
 
@@ -21,6 +21,7 @@
 #include "fastrtps/log/Log.h"
 #include "fastrtps/log/Colors.h"
 #include <fastrtps/xmlparser/XMLProfileManager.h>
+#include <fastrtps/transport/SharedMemTransportDescriptor.h>
 
 #include <numeric>
 #include <cmath>
@@ -78,7 +79,7 @@ LatencyTestPublisher::~LatencyTestPublisher()
 bool LatencyTestPublisher::init(int n_sub, int n_sam, bool reliable, uint32_t pid, bool hostname, bool export_csv,
         const std::string& export_prefix, const PropertyPolicy& part_property_policy,
         const PropertyPolicy& property_policy, bool large_data, const std::string& sXMLConfigFile, bool dynamic_types,
-        int forced_domain)
+        int forced_domain, bool shared_memory)
 {
     m_sXMLConfigFile = sXMLConfigFile;
     n_samples = n_sam;
@@ -216,6 +217,11 @@ bool LatencyTestPublisher::init(int n_sub, int n_sam, bool reliable, uint32_t pi
     }
     PParam.rtps.properties = part_property_policy;
     PParam.rtps.setName("Participant_pub");
+    if (shared_memory)
+    {
+        PParam.rtps.userTransports.push_back(std::make_shared<SharedMemTransportDescriptor>());
+        PParam.rtps.useBuiltinTransports = false;
+    }
 
     if (m_sXMLConfigFile.length() > 0)
     {
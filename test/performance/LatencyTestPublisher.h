@@ -80,7 +80,7 @@ public:
         const std::string& export_prefix,
         const eprosima::fastrtps::rtps::PropertyPolicy& part_property_policy,
         const eprosima::fastrtps::rtps::PropertyPolicy& property_policy, bool large_data,
-        const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain);
+        const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain, bool shared_memory = false);
     void run();
     void analyzeTimes(uint32_t datasize);
     bool test(uint32_t datasize);
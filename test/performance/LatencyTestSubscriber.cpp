@@ -21,6 +21,7 @@
 #include "fastrtps/log/Log.h"
 #include "fastrtps/log/Colors.h"
 #include <fastrtps/xmlparser/XMLProfileManager.h>
+#include <fastrtps/transport/SharedMemTransportDescriptor.h>
 
 using namespace eprosima::fastrtps;
 using namespace eprosima::fastrtps::rtps;
@@ -66,7 +67,7 @@ LatencyTestSubscriber::~LatencyTestSubscriber()
 
 bool LatencyTestSubscriber::init(bool echo, int nsam, bool reliable, uint32_t pid, bool hostname,
         const PropertyPolicy& part_property_policy, const PropertyPolicy& property_policy, bool large_data,
-        const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain)
+        const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain, bool shared_memory)
 {
     if(!large_data)
     {
@@ -113,6 +114,11 @@ bool LatencyTestSubscriber::init(bool echo, int nsam, bool reliable, uint32_t pi
     }
     PParam.rtps.setName("Participant_sub");
     PParam.rtps.properties = part_property_policy;
+    if (shared_memory)
+    {
+        PParam.rtps.userTransports.push_back(std::make_shared<SharedMemTransportDescriptor>());
+        PParam.rtps.useBuiltinTransports = false;
+    }
 
     if (m_sXMLConfigFile.length() > 0)
     {
@@ -58,7 +58,7 @@ public:
     bool init(bool echo, int nsam, bool reliable, uint32_t pid, bool hostname,
         const eprosima::fastrtps::rtps::PropertyPolicy& part_property_policy,
         const eprosima::fastrtps::rtps::PropertyPolicy& property_policy, bool large_data,
-        const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain);
+        const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain, bool shared_memory = false);
 
     void run();
     bool test(uint32_t datasize);
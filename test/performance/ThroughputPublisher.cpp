@@ -24,6 +24,7 @@
 #include <fastrtps/attributes/ParticipantAttributes.h>
 #include <fastrtps/attributes/SubscriberAttributes.h>
 #include <fastrtps/xmlparser/XMLProfileManager.h>
+#include <fastrtps/transport/SharedMemTransportDescriptor.h>
 
 #include <fastrtps/publisher/Publisher.h>
 #include <fastrtps/subscriber/Subscriber.h>
@@ -106,7 +107,7 @@ ThroughputPublisher::ThroughputPublisher(bool reliable, uint32_t pid, bool hostn
         const std::string& export_prefix,
         const eprosima::fastrtps::rtps::PropertyPolicy& part_property_policy,
         const eprosima::fastrtps::rtps::PropertyPolicy& property_policy,
-        const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain)
+        const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain, bool shared_memory)
     : disc_count_(0),
     data_disc_count_(0),
 #pragma warning(disable:4355)
@@ -153,6 +154,11 @@ ThroughputPublisher::ThroughputPublisher(bool reliable, uint32_t pid, bool hostn
     }
     PParam.rtps.setName("Participant_publisher");
     PParam.rtps.properties = part_property_policy;
+    if (shared_memory)
+    {
+        PParam.rtps.userTransports.push_back(std::make_shared<SharedMemTransportDescriptor>());
+        PParam.rtps.useBuiltinTransports = false;
+    }
 
     if (m_sXMLConfigFile.length() > 0)
     {
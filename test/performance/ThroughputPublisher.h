@@ -53,7 +53,8 @@ class ThroughputPublisher
                 const std::string& export_prefix,
                 const eprosima::fastrtps::rtps::PropertyPolicy& part_property_policy,
                 const eprosima::fastrtps::rtps::PropertyPolicy& property_policy,
-                const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain);
+                const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain,
+                bool shared_memory = false);
         virtual ~ThroughputPublisher();
         eprosima::fastrtps::Participant* mp_par;
         eprosima::fastrtps::Publisher* mp_datapub;
@@ -24,6 +24,8 @@
 #include <fastrtps/attributes/ParticipantAttributes.h>
 #include <fastrtps/attributes/PublisherAttributes.h>
 #include <fastrtps/xmlparser/XMLProfileManager.h>
+#include <fastrtps/transport/UDPv4TransportDescriptor.h>
+#include <fastrtps/transport/SharedMemTransportDescriptor.h>
 
 #include <fastrtps/publisher/Publisher.h>
 #include <fastrtps/subscriber/Subscriber.h>
@@ -311,7 +313,8 @@ ThroughputSubscriber::~ThroughputSubscriber()
 ThroughputSubscriber::ThroughputSubscriber(bool reliable, uint32_t pid, bool hostname,
     const eprosima::fastrtps::rtps::PropertyPolicy& part_property_policy,
     const eprosima::fastrtps::rtps::PropertyPolicy& property_policy,
-    const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain)
+    const std::string& sXMLConfigFile, bool dynamic_types, int forced_domain,
+    uint32_t receive_batch_size, bool shared_memory)
     : disc_count_(0)
     , data_disc_count_(0)
     , stop_count_(0)
@@ -357,6 +360,18 @@ ThroughputSubscriber::ThroughputSubscriber(bool reliable, uint32_t pid, bool hos
     }
     PParam.rtps.setName("Participant_subscriber");
     PParam.rtps.properties = part_property_policy;
+    if (shared_memory)
+    {
+        PParam.rtps.userTransports.push_back(std::make_shared<SharedMemTransportDescriptor>());
+        PParam.rtps.useBuiltinTransports = false;
+    }
+    else if (receive_batch_size > 1)
+    {
+        std::shared_ptr<UDPv4TransportDescriptor> udp_transport = std::make_shared<UDPv4TransportDescriptor>();
+        udp_transport->receive_batch_size = receive_batch_size;
+        PParam.rtps.userTransports.push_back(udp_transport);
+        PParam.rtps.useBuiltinTransports = false;
+    }
 
     if (m_sXMLConfigFile.length() > 0)
     {
@@ -22,20 +22,25 @@ security_options = []
 if certs_path:
     security_options = ["--security=true", "--certs=" + certs_path]
 
+transport_options = []
+
+if os.environ.get("SHARED_MEMORY"):
+    transport_options = ["--shm"]
+
 # Best effort
 subscriber_proc = subprocess.Popen([command, "subscriber", "--seed", str(os.getpid()), "--hostname"] +
-        security_options)
+        security_options + transport_options)
 publisher_proc = subprocess.Popen([command, "publisher", "--seed", str(os.getpid()), "--hostname", "--export_csv"] +
-        security_options)
+        security_options + transport_options)
 
 subscriber_proc.communicate()
 publisher_proc.communicate()
 
 # Reliable
 subscriber_proc = subprocess.Popen([command, "subscriber", "-r", "reliable", "--seed", str(os.getpid()), "--hostname"] +
-        security_options)
+        security_options + transport_options)
 publisher_proc = subprocess.Popen([command, "publisher", "-r", "reliable", "--seed", str(os.getpid()), "--hostname",
-    "--export_csv"] + security_options)
+    "--export_csv"] + security_options + transport_options)
 
 subscriber_proc.communicate()
 publisher_proc.communicate()
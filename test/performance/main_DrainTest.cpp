@@ -0,0 +1,285 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_DrainTest.cpp
+ *
+ * Measures how long a reliable subscriber takes to read and then take all the samples queued on its history,
+ * when they come from several writers.
+ */
+
+#include "ThroughputTypes.h"
+
+#include "optionparser.h"
+
+#include <fastrtps/Domain.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/attributes/PublisherAttributes.h>
+#include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/publisher/Publisher.h>
+#include <fastrtps/subscriber/Subscriber.h>
+#include <fastrtps/subscriber/SubscriberListener.h>
+#include <fastrtps/subscriber/SampleInfo.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+struct Arg : public option::Arg
+{
+    static option::ArgStatus Numeric(const option::Option& option, bool msg)
+    {
+        char* endptr = 0;
+        if (option.arg != 0 && strtol(option.arg, &endptr, 10))
+        {
+        };
+        if (endptr != option.arg && *endptr == 0)
+        {
+            return option::ARG_OK;
+        }
+
+        if (msg)
+        {
+            fprintf(stderr, "Option '%.*s' requires a numeric argument\n", option.namelen, option.name);
+        }
+        return option::ARG_ILLEGAL;
+    }
+};
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    SAMPLES,
+    WRITERS,
+    MSG_SIZE,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT, 0,"", "",                   Arg::None,      "Usage: DrainTest [options]\n\nOptions:" },
+    { HELP,    0,"h", "help",                  Arg::None,      "  -h \t--help  \tProduce help message." },
+    { SAMPLES, 0,"n", "samples",               Arg::Numeric,   "  -n <num>, \t--samples=<num>  \tNumber of samples queued before draining (default 100000)." },
+    { WRITERS, 0,"w", "writers",               Arg::Numeric,   "  -w <num>, \t--writers=<num>  \tNumber of writers sending the samples (default 4)." },
+    { MSG_SIZE, 0,"s","msg_size",              Arg::Numeric,   "  -s <num>, \t--msg_size=<num>  \tSize of the samples (default 64)." },
+    { FORCED_DOMAIN, 0, "", "domain",          Arg::Numeric,   "  \t--domain=<num>  \tDomain of the test (default 82)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+class MatchingListener : public SubscriberListener
+{
+public:
+
+    MatchingListener()
+        : matched_(0)
+    {
+    }
+
+    void onSubscriptionMatched(Subscriber*, MatchingInfo& info) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (info.status == MATCHED_MATCHING)
+        {
+            ++matched_;
+        }
+        else
+        {
+            --matched_;
+        }
+        cv_.notify_all();
+    }
+
+    bool wait_matched(uint32_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::seconds(10), [&]()
+                {
+                    return matched_ >= count;
+                });
+    }
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint32_t matched_;
+};
+
+int main(int argc, char** argv)
+{
+    uint32_t num_samples = 100000;
+    uint32_t num_writers = 4;
+    uint32_t msg_size = 64;
+    uint32_t domain = 82;
+
+    argc -= (argc > 0); argv += (argc > 0); // skip program name argv[0] if present
+    option::Stats stats(usage, argc, argv);
+    std::vector<option::Option> options(stats.options_max);
+    std::vector<option::Option> buffer(stats.buffer_max);
+    option::Parser parse(usage, argc, argv, &options[0], &buffer[0]);
+
+    if (parse.error())
+    {
+        return 1;
+    }
+
+    if (options[HELP] || options[UNKNOWN_OPT])
+    {
+        option::printUsage(fwrite, stdout, usage);
+        return 0;
+    }
+
+    for (int i = 0; i < parse.optionsCount(); ++i)
+    {
+        option::Option& opt = buffer[i];
+        switch (opt.index())
+        {
+            case SAMPLES:
+                num_samples = strtol(opt.arg, nullptr, 10);
+                break;
+            case WRITERS:
+                num_writers = strtol(opt.arg, nullptr, 10);
+                break;
+            case MSG_SIZE:
+                msg_size = strtol(opt.arg, nullptr, 10);
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (num_writers == 0)
+    {
+        num_writers = 1;
+    }
+    uint32_t samples_per_writer = (num_samples + num_writers - 1) / num_writers;
+    num_samples = samples_per_writer * num_writers;
+
+    ParticipantAttributes part_att;
+    part_att.rtps.builtin.domainId = domain;
+    part_att.rtps.setName("Drain_participant");
+    Participant* participant = Domain::createParticipant(part_att);
+    if (participant == nullptr)
+    {
+        return 1;
+    }
+
+    std::string topic_name = "DrainTopic_" + std::to_string(domain);
+    ThroughputDataType type(msg_size);
+    Domain::registerType(participant, &type);
+
+    // Every sample stays on the history until it is taken.
+    SubscriberAttributes sub_att;
+    sub_att.topic.topicDataType = type.getName();
+    sub_att.topic.topicName = topic_name;
+    sub_att.topic.historyQos.kind = KEEP_ALL_HISTORY_QOS;
+    sub_att.topic.resourceLimitsQos.max_samples = static_cast<int32_t>(num_samples);
+    sub_att.topic.resourceLimitsQos.allocated_samples = 1000;
+    sub_att.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    sub_att.historyMemoryPolicy = DYNAMIC_RESERVE_MEMORY_MODE;
+
+    MatchingListener listener;
+    Subscriber* subscriber = Domain::createSubscriber(participant, sub_att, &listener);
+    if (subscriber == nullptr)
+    {
+        Domain::removeParticipant(participant);
+        return 1;
+    }
+
+    std::vector<Publisher*> publishers;
+    for (uint32_t i = 0; i < num_writers; ++i)
+    {
+        PublisherAttributes pub_att;
+        pub_att.topic.topicDataType = type.getName();
+        pub_att.topic.topicName = topic_name;
+        pub_att.topic.historyQos.kind = KEEP_ALL_HISTORY_QOS;
+        pub_att.topic.resourceLimitsQos.max_samples = static_cast<int32_t>(samples_per_writer);
+        pub_att.topic.resourceLimitsQos.allocated_samples = 1000;
+        pub_att.qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+        pub_att.historyMemoryPolicy = DYNAMIC_RESERVE_MEMORY_MODE;
+        Publisher* publisher = Domain::createPublisher(participant, pub_att);
+        if (publisher == nullptr)
+        {
+            break;
+        }
+        publishers.push_back(publisher);
+    }
+
+    bool ok = publishers.size() == num_writers && listener.wait_matched(num_writers);
+    if (ok)
+    {
+        // Writers interleave their samples, as if they were publishing at the same time.
+        ThroughputType sample(static_cast<uint16_t>(msg_size));
+        for (uint32_t i = 0; i < samples_per_writer; ++i)
+        {
+            ++sample.seqnum;
+            for (Publisher* publisher : publishers)
+            {
+                publisher->write(&sample);
+            }
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+        while (subscriber->get_unread_count() < num_samples && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        uint64_t queued = subscriber->get_unread_count();
+        ThroughputType data(static_cast<uint16_t>(msg_size + 8));
+        SampleInfo_t info;
+
+        uint64_t read = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (subscriber->readNextData(&data, &info))
+        {
+            ++read;
+        }
+        std::chrono::duration<double, std::milli> read_time = std::chrono::steady_clock::now() - start;
+
+        uint64_t taken = 0;
+        start = std::chrono::steady_clock::now();
+        while (subscriber->takeNextData(&data, &info))
+        {
+            ++taken;
+        }
+        std::chrono::duration<double, std::milli> take_time = std::chrono::steady_clock::now() - start;
+
+        printf("[Queued samples, Writers, Read samples, Read time (ms), Taken samples, Take time (ms)]\n");
+        printf("[--------------,--------,-------------,---------------,--------------,---------------]\n");
+        printf("%15u,%8u,%13u,%15.3f,%14u,%15.3f\n", static_cast<uint32_t>(queued), num_writers,
+                static_cast<uint32_t>(read), read_time.count(), static_cast<uint32_t>(taken), take_time.count());
+
+        ok = queued == num_samples && read == num_samples && taken == num_samples;
+    }
+    else
+    {
+        printf("Subscriber could not match all the writers\n");
+    }
+
+    Domain::removeParticipant(participant);
+    Domain::stopAll();
+    return ok ? 0 : 1;
+}
@@ -122,7 +122,8 @@ enum  optionIndex {
     LARGE_DATA,
     XML_FILE,
     DYNAMIC_TYPES,
-    FORCED_DOMAIN
+    FORCED_DOMAIN,
+    SHARED_MEMORY
 };
 
 const option::Descriptor usage[] = {
@@ -136,6 +137,7 @@ const option::Descriptor usage[] = {
     { XML_FILE, 0, "", "xml",               Arg::String,    "\t--xml \tXML Configuration file." },
     { FORCED_DOMAIN, 0, "", "domain",       Arg::Numeric,   "\t--RTPS Domain." },
     { DYNAMIC_TYPES, 0, "", "dynamic_types",Arg::None,      "\t--dynamic_types \tUse dynamic types." },
+    { SHARED_MEMORY, 0, "", "shm",          Arg::None,      "\t--shm \tUse the shared memory transport instead of UDP." },
 #if HAVE_SECURITY
     { USE_SECURITY, 0, "", "security",      Arg::Required,      "  --security <arg>  \tEcho mode (\"true\"/\"false\")." },
     { CERTS_PATH, 0, "", "certs",           Arg::Required,      "  --certs <arg>  \tPath where located certificates." },
@@ -189,6 +191,7 @@ int main(int argc, char** argv)
     std::string sXMLConfigFile = "";
     bool dynamic_types = false;
     int forced_domain = -1;
+    bool shared_memory = false;
 
     argc -= (argc > 0);
     argv += (argc > 0); // skip program name argv[0] if present
@@ -323,6 +326,9 @@ int main(int argc, char** argv)
             case FORCED_DOMAIN:
                 forced_domain = strtol(opt.arg, nullptr, 10);
                 break;
+            case SHARED_MEMORY:
+                shared_memory = true;
+                break;
 
 #if HAVE_SECURITY
             case USE_SECURITY:
@@ -406,14 +412,15 @@ int main(int argc, char** argv)
         cout << "Performing test with " << sub_number << " subscribers and " << n_samples << " samples" << endl;
         LatencyTestPublisher latencyPub;
         latencyPub.init(sub_number, n_samples, reliable, seed, hostname, export_csv, export_prefix,
-            pub_part_property_policy, pub_property_policy, large_data, sXMLConfigFile, dynamic_types, forced_domain);
+            pub_part_property_policy, pub_property_policy, large_data, sXMLConfigFile, dynamic_types, forced_domain,
+            shared_memory);
         latencyPub.run();
     }
     else
     {
         LatencyTestSubscriber latencySub;
         latencySub.init(echo, n_samples, reliable, seed, hostname, sub_part_property_policy, sub_property_policy,
-            large_data, sXMLConfigFile, dynamic_types, forced_domain);
+            large_data, sXMLConfigFile, dynamic_types, forced_domain, shared_memory);
         latencySub.run();
     }
 
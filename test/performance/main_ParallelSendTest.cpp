@@ -0,0 +1,303 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main_ParallelSendTest.cpp
+ *
+ * Measures how many samples per second the writers of a single participant can send when each one is written
+ * from its own thread, for an increasing number of writers.
+ */
+
+#include "ThroughputTypes.h"
+
+#include "optionparser.h"
+
+#include <fastrtps/Domain.h>
+#include <fastrtps/attributes/ParticipantAttributes.h>
+#include <fastrtps/attributes/PublisherAttributes.h>
+#include <fastrtps/attributes/SubscriberAttributes.h>
+#include <fastrtps/participant/Participant.h>
+#include <fastrtps/publisher/Publisher.h>
+#include <fastrtps/subscriber/Subscriber.h>
+#include <fastrtps/subscriber/SubscriberListener.h>
+#include <fastrtps/subscriber/SampleInfo.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+struct Arg : public option::Arg
+{
+    static option::ArgStatus Numeric(const option::Option& option, bool msg)
+    {
+        char* endptr = 0;
+        if (option.arg != 0 && strtol(option.arg, &endptr, 10))
+        {
+        };
+        if (endptr != option.arg && *endptr == 0)
+        {
+            return option::ARG_OK;
+        }
+
+        if (msg)
+        {
+            fprintf(stderr, "Option '%.*s' requires a numeric argument\n", option.namelen, option.name);
+        }
+        return option::ARG_ILLEGAL;
+    }
+};
+
+enum  optionIndex {
+    UNKNOWN_OPT,
+    HELP,
+    WRITERS,
+    TIME,
+    MSG_SIZE,
+    FORCED_DOMAIN
+};
+
+const option::Descriptor usage[] = {
+    { UNKNOWN_OPT, 0,"", "",                   Arg::None,      "Usage: ParallelSendTest [options]\n\nOptions:" },
+    { HELP,    0,"h", "help",                  Arg::None,      "  -h \t--help  \tProduce help message." },
+    { WRITERS, 0,"w", "writers",               Arg::Numeric,   "  -w <num>, \t--writers=<num>  \tMaximum number of writers of the participant. "
+                                                               "Every power of two up to this value is run (default number of cores)." },
+    { TIME, 0,"t","time",                      Arg::Numeric,   "  -t <num>, \t--time=<num>  \tTime of each run in seconds (default 5)." },
+    { MSG_SIZE, 0,"s","msg_size",              Arg::Numeric,   "  -s <num>, \t--msg_size=<num>  \tSize of the samples (default 64)." },
+    { FORCED_DOMAIN, 0, "", "domain",          Arg::Numeric,   "  \t--domain=<num>  \tDomain of the test (default 83)." },
+    { 0, 0, 0, 0, 0, 0 }
+};
+
+class MatchingListener : public SubscriberListener
+{
+public:
+
+    MatchingListener()
+        : matched_(0)
+    {
+    }
+
+    void onSubscriptionMatched(Subscriber*, MatchingInfo& info) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (info.status == MATCHED_MATCHING)
+        {
+            ++matched_;
+        }
+        else
+        {
+            --matched_;
+        }
+        cv_.notify_all();
+    }
+
+    bool wait_matched(uint32_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, std::chrono::seconds(10), [&]()
+                {
+                    return matched_ >= count;
+                });
+    }
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint32_t matched_;
+};
+
+static bool run(
+        uint32_t num_writers,
+        uint32_t test_time_sec,
+        uint32_t msg_size,
+        uint32_t domain)
+{
+    std::string topic_name = "ParallelSendTopic_" + std::to_string(domain);
+
+    ParticipantAttributes sub_part_att;
+    sub_part_att.rtps.builtin.domainId = domain;
+    sub_part_att.rtps.setName("ParallelSend_subscriber");
+    Participant* sub_participant = Domain::createParticipant(sub_part_att);
+    if (sub_participant == nullptr)
+    {
+        return false;
+    }
+
+    ThroughputDataType sub_type(msg_size);
+    Domain::registerType(sub_participant, &sub_type);
+
+    // Samples are not taken, only the sending side is measured.
+    SubscriberAttributes sub_att;
+    sub_att.topic.topicDataType = sub_type.getName();
+    sub_att.topic.topicName = topic_name;
+    sub_att.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+    sub_att.topic.historyQos.depth = 1;
+    sub_att.qos.m_reliability.kind = BEST_EFFORT_RELIABILITY_QOS;
+
+    MatchingListener listener;
+    if (Domain::createSubscriber(sub_participant, sub_att, &listener) == nullptr)
+    {
+        Domain::removeParticipant(sub_participant);
+        return false;
+    }
+
+    // All the writers share the participant, and so its send resources.
+    ParticipantAttributes pub_part_att;
+    pub_part_att.rtps.builtin.domainId = domain;
+    pub_part_att.rtps.setName("ParallelSend_publisher");
+    Participant* pub_participant = Domain::createParticipant(pub_part_att);
+    if (pub_participant == nullptr)
+    {
+        Domain::removeParticipant(sub_participant);
+        return false;
+    }
+
+    ThroughputDataType pub_type(msg_size);
+    Domain::registerType(pub_participant, &pub_type);
+
+    std::vector<Publisher*> publishers;
+    for (uint32_t i = 0; i < num_writers; ++i)
+    {
+        PublisherAttributes pub_att;
+        pub_att.topic.topicDataType = pub_type.getName();
+        pub_att.topic.topicName = topic_name;
+        pub_att.topic.historyQos.kind = KEEP_LAST_HISTORY_QOS;
+        pub_att.topic.historyQos.depth = 1;
+        pub_att.qos.m_reliability.kind = BEST_EFFORT_RELIABILITY_QOS;
+        Publisher* publisher = Domain::createPublisher(pub_participant, pub_att);
+        if (publisher == nullptr)
+        {
+            break;
+        }
+        publishers.push_back(publisher);
+    }
+
+    bool ret = publishers.size() == num_writers && listener.wait_matched(num_writers);
+    if (ret)
+    {
+        std::atomic<bool> stop(false);
+        std::atomic<uint64_t> sent(0);
+        std::vector<std::thread> threads;
+        for (Publisher* publisher : publishers)
+        {
+            threads.emplace_back([publisher, msg_size, &stop, &sent]()
+                    {
+                        ThroughputType sample(static_cast<uint16_t>(msg_size));
+                        while (!stop)
+                        {
+                            ++sample.seqnum;
+                            if (publisher->write(&sample))
+                            {
+                                ++sent;
+                            }
+                        }
+                    });
+        }
+
+        // Let the writers start before counting.
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        uint64_t first_sent = sent;
+        auto start = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::seconds(test_time_sec));
+        uint64_t total_sent = sent - first_sent;
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+        stop = true;
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        double packs_sec = static_cast<double>(total_sent) * 1000000 / elapsed.count();
+        printf("%8u,%13.0f,%11.0f,%16.0f\n", num_writers, (double)total_sent, packs_sec, packs_sec / num_writers);
+    }
+    else
+    {
+        printf("Run with %u writers could not match all of them\n", num_writers);
+    }
+
+    Domain::removeParticipant(pub_participant);
+    Domain::removeParticipant(sub_participant);
+
+    return ret;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t max_writers = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t test_time_sec = 5;
+    uint32_t msg_size = 64;
+    uint32_t domain = 83;
+
+    argc -= (argc > 0); argv += (argc > 0); // skip program name argv[0] if present
+    option::Stats stats(usage, argc, argv);
+    std::vector<option::Option> options(stats.options_max);
+    std::vector<option::Option> buffer(stats.buffer_max);
+    option::Parser parse(usage, argc, argv, &options[0], &buffer[0]);
+
+    if (parse.error())
+    {
+        return 1;
+    }
+
+    if (options[HELP] || options[UNKNOWN_OPT])
+    {
+        option::printUsage(fwrite, stdout, usage);
+        return 0;
+    }
+
+    for (int i = 0; i < parse.optionsCount(); ++i)
+    {
+        option::Option& opt = buffer[i];
+        switch (opt.index())
+        {
+            case WRITERS:
+                max_writers = strtol(opt.arg, nullptr, 10);
+                break;
+            case TIME:
+                test_time_sec = strtol(opt.arg, nullptr, 10);
+                break;
+            case MSG_SIZE:
+                msg_size = strtol(opt.arg, nullptr, 10);
+                break;
+            case FORCED_DOMAIN:
+                domain = strtol(opt.arg, nullptr, 10);
+                break;
+            default:
+                break;
+        }
+    }
+
+    printf("[Writers, Sent samples, Packs/sec, Packs/sec/writer]\n");
+    printf("[-------,-------------,----------,-----------------]\n");
+
+    bool ok = true;
+    for (uint32_t writers = 1; writers <= max_writers; writers *= 2)
+    {
+        ok &= run(writers, test_time_sec, msg_size, domain);
+    }
+
+    Domain::stopAll();
+    return ok ? 0 : 1;
+}
@@ -133,7 +133,9 @@ enum  optionIndex {
     CERTS_PATH,
     XML_FILE,
     DYNAMIC_TYPES,
-    FORCED_DOMAIN
+    FORCED_DOMAIN,
+    RECV_BATCH,
+    SHARED_MEMORY
 };
 
 const option::Descriptor usage[] = {
@@ -145,6 +147,7 @@ const option::Descriptor usage[] = {
     { XML_FILE, 0, "", "xml",               Arg::String,    "\t--xml \tXML Configuration file." },
     { DYNAMIC_TYPES, 0, "", "dynamic_types",Arg::None,      "\t--dynamic_types \tUse dynamic types." },
     { FORCED_DOMAIN, 0, "", "domain",       Arg::Numeric,   "\t--domain \tSet the domain to connect." },
+    { SHARED_MEMORY, 0, "", "shm",          Arg::None,      "\t--shm \tUse the shared memory transport instead of UDP." },
 #if HAVE_SECURITY
     { USE_SECURITY, 0, "", "security",      Arg::Required,  "  --security <arg>  \tEcho mode (\"true\"/\"false\")." },
     { CERTS_PATH, 0, "", "certs",           Arg::Required,  "  --certs <arg>  \tPath where located certificates." },
@@ -157,6 +160,8 @@ const option::Descriptor usage[] = {
     { FILE_R,0,"f","file",                  Arg::Required,  "  -f <arg>, \t--file=<arg> \tFile to read the payload demands from." },
     { EXPORT_CSV,0,"","export_csv",         Arg::None,      "\t--export_csv \tFlag to export a CVS file." },
     { EXPORT_PREFIX,0,"","export_prefix",   Arg::String,    "\t--export_prefix \tFile prefix for the CSV file." },
+    { UNKNOWN_OPT, 0,"", "",                Arg::None,      "\nSubscriber options:"},
+    { RECV_BATCH, 0,"","recv_batch",        Arg::Numeric,   "  \t--recv_batch=<num>  \tNumber of UDP datagrams retrieved per receive call." },
     { UNKNOWN_OPT, 0,"", "",                Arg::None,      "\nNote:\nIf no demand or msg_size is provided the .csv file is used.\n"},
     { 0, 0, 0, 0, 0, 0 }
 };
@@ -195,6 +200,8 @@ int main(int argc, char** argv)
     std::string sXMLConfigFile = "";
     bool dynamic_types = false;
     int forced_domain = -1;
+    uint32_t receive_batch_size = 1;
+    bool shared_memory = false;
 #if HAVE_SECURITY
     bool use_security = false;
     std::string certs_path;
@@ -328,6 +335,14 @@ int main(int argc, char** argv)
                 forced_domain = strtol(opt.arg, nullptr, 10);
                 break;
 
+            case RECV_BATCH:
+                receive_batch_size = strtol(opt.arg, nullptr, 10);
+                break;
+
+            case SHARED_MEMORY:
+                shared_memory = true;
+                break;
+
 #if HAVE_SECURITY
             case USE_SECURITY:
                 if (strcmp(opt.arg, "true") == 0)
@@ -410,13 +425,14 @@ int main(int argc, char** argv)
     if (pub_sub)
     {
         ThroughputPublisher tpub(reliable, seed, hostname, export_csv, export_prefix, pub_part_property_policy,
-            pub_property_policy, sXMLConfigFile, dynamic_types, forced_domain);
+            pub_property_policy, sXMLConfigFile, dynamic_types, forced_domain, shared_memory);
         tpub.m_file_name = file_name;
         tpub.run(test_time_sec, recovery_time_ms, demand, msg_size);
     }
     else
     {
-        ThroughputSubscriber tsub(reliable, seed, hostname, sub_part_property_policy, sub_property_policy, sXMLConfigFile, dynamic_types, forced_domain);
+        ThroughputSubscriber tsub(reliable, seed, hostname, sub_part_property_policy, sub_property_policy, sXMLConfigFile, dynamic_types, forced_domain,
+            receive_batch_size, shared_memory);
         tsub.run();
     }
 
@@ -200,4 +200,19 @@ void print_results(
     outFile.close();
 }
 
+/**
+ * Check no allocations were registered while transmitting the samples after the first one.
+ */
+bool steady_state_is_allocation_free()
+{
+    size_t allocs = g_allocations[2].load();
+    if (allocs > 0)
+    {
+        std::cerr << allocs << " allocations registered while transmitting samples" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
 }   // namespace eprosima_profiling
@@ -75,6 +75,13 @@ void print_results(
         const std::string& entity,
         const std::string& config);
 
+/**
+ * Check no allocations were registered while transmitting the samples after the first one.
+ *
+ * @return true when the steady state phase has been allocation free.
+ */
+bool steady_state_is_allocation_free();
+
 }   // namespace eprosima_profiling
 
 #endif   // FASTRTPS_TEST_PROFILING_ALLOCATIONS_ALLOCTESTCOMMON_H_
@@ -19,6 +19,7 @@
 
 #include "AllocTestPublisher.h"
 #include "AllocTestSubscriber.h"
+#include "AllocTestCommon.h"
 
 #include <fastrtps/Domain.h>
 
@@ -67,7 +68,8 @@ int main(int argc, char** argv)
             << "        tl_be: transient-local best-effort" << std::endl
             << "        tl_re: transient-local reliable" << std::endl
             << "        vo_be: volatile best-effort" << std::endl
-            << "        vo_re: volatile reliable" << std::endl;
+            << "        vo_re: volatile reliable" << std::endl
+            << "        sc_re: volatile reliable with size class memory policy" << std::endl;
         Log::Reset();
         return 0;
     }
@@ -98,5 +100,5 @@ int main(int argc, char** argv)
     Domain::stopAll();
     Log::Reset();
 
-    return 0;
+    return eprosima_profiling::steady_state_is_allocation_free() ? 0 : 1;
 }
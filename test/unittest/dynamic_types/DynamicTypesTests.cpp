@@ -3317,6 +3317,120 @@ TEST_F(DynamicTypesTests, DynamicType_structure_unit_tests)
     ASSERT_TRUE(DynamicDataFactory::get_instance()->is_empty());
 }
 
+TEST_F(DynamicTypesTests, DynamicData_in_place_primitives_unit_tests)
+{
+    {
+        DynamicTypeBuilderFactory* factory = DynamicTypeBuilderFactory::get_instance();
+
+        // A single primitive keeps its value in place.
+        DynamicTypeBuilder_ptr int64_builder = factory->create_int64_builder();
+        ASSERT_TRUE(int64_builder != nullptr);
+        DynamicType_ptr int64_type = factory->create_type(int64_builder.get());
+        ASSERT_TRUE(int64_type != nullptr);
+        DynamicData* int64_data = DynamicDataFactory::get_instance()->create_data(int64_type);
+        ASSERT_TRUE(int64_data != nullptr);
+
+        int64_t iTest64 = 0;
+        ASSERT_TRUE(int64_data->get_int64_value(iTest64, MEMBER_ID_INVALID) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(iTest64 == 0);
+        ASSERT_TRUE(int64_data->set_int64_value(-1234567890123LL, MEMBER_ID_INVALID) == ResponseCode::RETCODE_OK);
+
+        DynamicData* int64_copy = DynamicDataFactory::get_instance()->create_copy(int64_data);
+        ASSERT_TRUE(int64_copy != nullptr);
+        ASSERT_TRUE(int64_copy->equals(int64_data));
+        ASSERT_TRUE(int64_copy->get_int64_value(iTest64, MEMBER_ID_INVALID) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(iTest64 == -1234567890123LL);
+
+        // Each copy owns its value.
+        ASSERT_TRUE(int64_copy->set_int64_value(42, MEMBER_ID_INVALID) == ResponseCode::RETCODE_OK);
+        ASSERT_FALSE(int64_copy->equals(int64_data));
+        ASSERT_TRUE(int64_data->get_int64_value(iTest64, MEMBER_ID_INVALID) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(iTest64 == -1234567890123LL);
+
+        ASSERT_TRUE(DynamicDataFactory::get_instance()->delete_data(int64_data) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(int64_copy->get_int64_value(iTest64, MEMBER_ID_INVALID) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(iTest64 == 42);
+        ASSERT_TRUE(DynamicDataFactory::get_instance()->delete_data(int64_copy) == ResponseCode::RETCODE_OK);
+
+        // Primitive members of a structure, of every size stored in place.
+        DynamicTypeBuilder_ptr struct_type_builder = factory->create_struct_builder();
+        ASSERT_TRUE(struct_type_builder != nullptr);
+        ASSERT_TRUE(struct_type_builder->add_member(0, "int32", factory->create_int32_type()) ==
+                ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_type_builder->add_member(1, "uint64", factory->create_uint64_type()) ==
+                ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_type_builder->add_member(2, "float64", factory->create_float64_type()) ==
+                ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_type_builder->add_member(3, "float128", factory->create_float128_type()) ==
+                ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_type_builder->add_member(4, "char16", factory->create_char16_type()) ==
+                ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_type_builder->add_member(5, "bool", factory->create_bool_type()) ==
+                ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_type_builder->add_member(6, "byte", factory->create_byte_type()) ==
+                ResponseCode::RETCODE_OK);
+        auto struct_type = struct_type_builder->build();
+        ASSERT_TRUE(struct_type != nullptr);
+
+        DynamicData* struct_data = DynamicDataFactory::get_instance()->create_data(struct_type);
+        ASSERT_TRUE(struct_data != nullptr);
+
+        ASSERT_TRUE(struct_data->set_int32_value(-123, 0) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_data->set_uint64_value(0xFEDCBA9876543210ULL, 1) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_data->set_float64_value(3.25, 2) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_data->set_float128_value(-1.5L, 3) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_data->set_char16_value(L'x', 4) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_data->set_bool_value(true, 5) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_data->set_byte_value(0xA5, 6) == ResponseCode::RETCODE_OK);
+
+        DynamicData* struct_copy = DynamicDataFactory::get_instance()->create_copy(struct_data);
+        ASSERT_TRUE(struct_copy != nullptr);
+        ASSERT_TRUE(struct_copy->equals(struct_data));
+
+        // Changing a member of the copy does not change the original one.
+        ASSERT_TRUE(struct_copy->set_float64_value(-7.0, 2) == ResponseCode::RETCODE_OK);
+        ASSERT_FALSE(struct_copy->equals(struct_data));
+        double fTest64 = 0;
+        ASSERT_TRUE(struct_data->get_float64_value(fTest64, 2) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(fTest64 == 3.25);
+
+        ASSERT_TRUE(DynamicDataFactory::get_instance()->delete_data(struct_data) == ResponseCode::RETCODE_OK);
+
+        int32_t iTest32 = 0;
+        ASSERT_TRUE(struct_copy->get_int32_value(iTest32, 0) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(iTest32 == -123);
+        uint64_t uTest64 = 0;
+        ASSERT_TRUE(struct_copy->get_uint64_value(uTest64, 1) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(uTest64 == 0xFEDCBA9876543210ULL);
+        ASSERT_TRUE(struct_copy->get_float64_value(fTest64, 2) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(fTest64 == -7.0);
+        long double fTest128 = 0;
+        ASSERT_TRUE(struct_copy->get_float128_value(fTest128, 3) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(fTest128 == -1.5L);
+        wchar_t cTest16 = 0;
+        ASSERT_TRUE(struct_copy->get_char16_value(cTest16, 4) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(cTest16 == L'x');
+        bool bTest = false;
+        ASSERT_TRUE(struct_copy->get_bool_value(bTest, 5) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(bTest);
+        octet oTest = 0;
+        ASSERT_TRUE(struct_copy->get_byte_value(oTest, 6) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(oTest == 0xA5);
+
+        // Loaned members keep their value in place too.
+        DynamicData* loaned = struct_copy->loan_value(0);
+        ASSERT_TRUE(loaned != nullptr);
+        ASSERT_TRUE(loaned->set_int32_value(77, MEMBER_ID_INVALID) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_copy->return_loaned_value(loaned) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(struct_copy->get_int32_value(iTest32, 0) == ResponseCode::RETCODE_OK);
+        ASSERT_TRUE(iTest32 == 77);
+
+        ASSERT_TRUE(DynamicDataFactory::get_instance()->delete_data(struct_copy) == ResponseCode::RETCODE_OK);
+    }
+    ASSERT_TRUE(DynamicTypeBuilderFactory::get_instance()->is_empty());
+    ASSERT_TRUE(DynamicDataFactory::get_instance()->is_empty());
+}
+
 TEST_F(DynamicTypesTests, DynamicType_structure_inheritance_unit_tests)
 {
     {
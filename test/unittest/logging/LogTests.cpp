@@ -17,10 +17,13 @@
 #include <fastrtps/log/StdoutConsumer.h>
 #include "mock/MockConsumer.h"
 #include <gtest/gtest.h>
+#include <atomic>
 #include <memory>
 #include <thread>
 #include <chrono>
 #include <sstream>
+#include <iomanip>
+#include <stdexcept>
 
 using namespace eprosima::fastrtps;
 using namespace std;
@@ -143,6 +146,100 @@ TEST_F(LogTests, multiple_verbosity_levels)
     ASSERT_EQ(3u, consumedEntries.size());
 }
 
+TEST_F(LogTests, category_rate_limit)
+{
+    Log::SetCategoryRateLimit(2);
+    for (int i = 0; i != 10; i++)
+    {
+        logWarning(RateLimited, "Rate limited message " << i);
+    }
+    logWarning(NotRateLimited, "This should be logged");
+
+    // At most two entries per second, and the test could cross a second boundary
+    auto consumedEntries = HELPER_WaitForEntries(3);
+    ASSERT_GE(consumedEntries.size(), 3u);
+    ASSERT_LE(consumedEntries.size(), 5u);
+}
+
+TEST_F(LogTests, long_messages_are_truncated)
+{
+    std::string long_message(Log::MaxMessageSize * 2, 'a');
+    logError(Truncation, long_message);
+
+    auto consumedEntries = HELPER_WaitForEntries(1);
+    ASSERT_EQ(1u, consumedEntries.size());
+    ASSERT_LT(consumedEntries.back().message.size(), long_message.size());
+    ASSERT_EQ(0u, consumedEntries.back().message.find(std::string(Log::MaxMessageSize, 'a')));
+}
+
+TEST_F(LogTests, format_does_not_leak_to_next_message)
+{
+    logError(Format, std::hex << std::setprecision(2) << std::setfill('*') << std::setw(6) << 255 << " " << 3.14159);
+    logError(Format, std::setw(4) << 255 << " " << 3.14159);
+
+    auto consumedEntries = HELPER_WaitForEntries(2);
+    ASSERT_EQ(2u, consumedEntries.size());
+    ASSERT_EQ("****ff 3.1", consumedEntries[0].message);
+    ASSERT_EQ(" 255 3.14159", consumedEntries[1].message);
+}
+
+struct ThrowsOnOutput
+{
+};
+
+static std::ostream& operator<<(std::ostream& stream, const ThrowsOnOutput&)
+{
+    stream << "partial";
+    throw std::runtime_error("cannot print");
+}
+
+TEST_F(LogTests, throwing_message_does_not_block_thread)
+{
+    ASSERT_THROW(logError(Throwing, "Message " << ThrowsOnOutput()), std::runtime_error);
+    logError(Throwing, "Next message");
+
+    auto consumedEntries = HELPER_WaitForEntries(1);
+    ASSERT_EQ(1u, consumedEntries.size());
+    ASSERT_EQ(0u, consumedEntries.back().message.find("Next message"));
+}
+
+class SlowConsumer : public LogConsumer
+{
+public:
+
+    SlowConsumer()
+        : started(false)
+        , finished(false)
+    {
+    }
+
+    virtual void Consume(const Log::Entry&)
+    {
+        started = true;
+        this_thread::sleep_for(chrono::milliseconds(100));
+        finished = true;
+    }
+
+    std::atomic<bool> started;
+    std::atomic<bool> finished;
+};
+
+TEST_F(LogTests, flush_waits_for_consumers)
+{
+    SlowConsumer* slowConsumer = new SlowConsumer();
+    Log::RegisterConsumer(std::unique_ptr<LogConsumer>(slowConsumer));
+
+    logError(Flushing, "Slowly consumed message");
+    while (!slowConsumer->started)
+    {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+
+    // The entry is being consumed, but it is not done yet.
+    Log::Flush();
+    ASSERT_TRUE(slowConsumer->finished);
+}
+
 std::vector<Log::Entry> LogTests::HELPER_WaitForEntries(uint32_t amount)
 {
     size_t entries = 0;
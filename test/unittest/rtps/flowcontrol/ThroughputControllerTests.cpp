@@ -95,7 +95,7 @@ TEST_F(ThroughputControllerTests, if_changes_are_fragmented_throughput_controlle
 
     while(!testChangesForUse.empty())
     {
-        RTPSWriterCollector<ReaderLocator*>::Item item = testChangesForUse.pop();
+        RTPSWriterCollector<ReaderLocator*>::Item& item = testChangesForUse.pop();
         ASSERT_EQ(item.sequenceNumber, seqNum);
         ASSERT_EQ(item.fragmentNumber, fragNum);
 
@@ -141,6 +141,40 @@ TEST_F(ThroughputControllerTests, throughput_controller_resets_completely_after_
    std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 50));
 }
 
+TEST_F(ThroughputControllerTests, burst_size_bounds_the_bytes_sent_at_once)
+{
+   // Given a controller that accumulates more than one period
+   static const unsigned int burstSize = 8000;
+   ThroughputController burstController({controllerSize, periodMillisecs, burstSize}, (RTPSWriter*)nullptr);
+
+   // When
+   burstController(testChangesForUse);
+
+   // Then
+   ASSERT_EQ(burstSize / testPayloadSize, testChangesForUse.size());
+
+   // The bucket is now empty
+   burstController(otherChangesForUse);
+   EXPECT_EQ(0u, otherChangesForUse.size());
+}
+
+TEST_F(ThroughputControllerTests, change_bigger_than_burst_is_let_through_when_bucket_is_full)
+{
+   // Given a controller smaller than a single change
+   ThroughputController smallController({testPayloadSize / 2, periodMillisecs}, (RTPSWriter*)nullptr);
+
+   // When
+   smallController(testChangesForUse);
+
+   // Then only the first one goes through, leaving the bucket in debt
+   ASSERT_EQ(1u, testChangesForUse.size());
+
+   // One period only pays the debt back
+   std::this_thread::sleep_for(std::chrono::milliseconds(periodMillisecs + 10));
+   smallController(otherChangesForUse);
+   EXPECT_EQ(0u, otherChangesForUse.size());
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
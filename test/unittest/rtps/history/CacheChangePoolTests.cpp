@@ -17,6 +17,8 @@
 #include <fastrtps/rtps/common/CacheChange.h>
 
 #include <tuple>
+#include <thread>
+#include <vector>
 
 using namespace eprosima::fastrtps::rtps;
 using namespace ::testing;
@@ -121,6 +123,10 @@ TEST_P(CacheChangePoolTests, reserve_cache)
             case MemoryManagementPolicy_t::DYNAMIC_RESERVE_MEMORY_MODE:
                 ASSERT_EQ(ch->serializedPayload.max_size, data_size);
                 break;
+            case MemoryManagementPolicy_t::SIZE_CLASS_MEMORY_MODE:
+                ASSERT_GE(ch->serializedPayload.max_size, data_size);
+                ASSERT_LE(ch->serializedPayload.max_size, max(256U, 2U * data_size));
+                break;
         }
 
         if (max_size > 0)
@@ -245,7 +251,83 @@ INSTANTIATE_TEST_CASE_P(
             Values(128, 256, 512, 1024),
             Values(MemoryManagementPolicy_t::PREALLOCATED_MEMORY_MODE,
                    MemoryManagementPolicy_t::PREALLOCATED_WITH_REALLOC_MEMORY_MODE,
-                   MemoryManagementPolicy_t::DYNAMIC_RESERVE_MEMORY_MODE)), );
+                   MemoryManagementPolicy_t::DYNAMIC_RESERVE_MEMORY_MODE,
+                   MemoryManagementPolicy_t::SIZE_CLASS_MEMORY_MODE)), );
+
+TEST(CacheChangePoolSizeClassTests, reuse_by_size_class)
+{
+    // A single change with the smallest payload size is preallocated
+    CacheChangePool pool(0, 2 * 1024 * 1024, 0, MemoryManagementPolicy_t::SIZE_CLASS_MEMORY_MODE);
+    ASSERT_EQ(pool.get_allCachesSize(), 1U);
+
+    CacheChange_t* small = nullptr;
+    CacheChange_t* big = nullptr;
+    ASSERT_TRUE(pool.reserve_Cache(&small, 200U));
+    ASSERT_TRUE(pool.reserve_Cache(&big, 1024U * 1024U + 1U));
+    ASSERT_EQ(small->serializedPayload.max_size, 256U);
+    ASSERT_EQ(big->serializedPayload.max_size, 2U * 1024U * 1024U);
+    pool.release_Cache(small);
+    pool.release_Cache(big);
+    ASSERT_EQ(pool.get_freeCachesSize(), 2U);
+
+    // Changes are only reused for requests of their size class
+    CacheChange_t* ch = nullptr;
+    ASSERT_TRUE(pool.reserve_Cache(&ch, 100U));
+    ASSERT_EQ(ch, small);
+    ASSERT_TRUE(pool.reserve_Cache(&ch, 2U * 1024U * 1024U));
+    ASSERT_EQ(ch, big);
+    ASSERT_TRUE(pool.reserve_Cache(&ch, 1000U));
+    ASSERT_NE(ch, small);
+    ASSERT_NE(ch, big);
+    ASSERT_EQ(pool.get_allCachesSize(), 3U);
+}
+
+TEST(CacheChangePoolSizeClassTests, concurrent_release)
+{
+    const uint32_t num_changes = 1000;
+    const uint32_t num_threads = 4;
+    CacheChangePool pool(0, 4096, 0, MemoryManagementPolicy_t::SIZE_CLASS_MEMORY_MODE);
+
+    std::vector<CacheChange_t*> changes(num_changes * num_threads);
+    for (CacheChange_t*& ch : changes)
+    {
+        ASSERT_TRUE(pool.reserve_Cache(&ch, 512U));
+    }
+
+    // Release from several threads while reserving again from the main one
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&pool, &changes, t, num_changes]()
+                {
+                    for (uint32_t i = 0; i < num_changes; ++i)
+                    {
+                        pool.release_Cache(changes[t * num_changes + i]);
+                    }
+                });
+    }
+
+    std::vector<CacheChange_t*> reserved;
+    for (uint32_t i = 0; i < num_changes; ++i)
+    {
+        CacheChange_t* ch = nullptr;
+        ASSERT_TRUE(pool.reserve_Cache(&ch, 512U));
+        reserved.push_back(ch);
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (CacheChange_t* ch : reserved)
+    {
+        pool.release_Cache(ch);
+    }
+
+    ASSERT_EQ(pool.get_freeCachesSize(), pool.get_allCachesSize());
+    ASSERT_LE(pool.get_allCachesSize(), static_cast<size_t>(num_changes * (num_threads + 1)));
+}
 
 int main(int argc, char **argv)
 {
@@ -19,6 +19,9 @@
 #include <fastrtps/rtps/reader/StatefulReader.h>
 #include <fastrtps/utils/TimedMutex.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
 #include <vector>
 
 using namespace eprosima::fastrtps;
@@ -209,6 +212,220 @@ TEST_F(ReaderHistoryTests, remove_changes_with_guid)
     ASSERT_EQ(history->getHistorySize(), num_changes - num_sequence_numbers);
 }
 
+TEST_F(ReaderHistoryTests, add_out_of_order_changes_keeps_timestamp_order)
+{
+    for (uint32_t i=num_changes; i>0; i--)
+    {
+        history->add_change(changes_list[i-1]);
+    }
+
+    ASSERT_EQ(history->getHistorySize(), num_changes);
+
+    uint32_t i = 0;
+    for (auto it = history->changesBegin(); it != history->changesEnd(); ++it, ++i)
+    {
+        ASSERT_EQ(*it, changes_list[i]);
+    }
+}
+
+TEST_F(ReaderHistoryTests, min_and_max_changes_are_tracked)
+{
+    EXPECT_CALL(*readerMock, change_removed_by_history(_)).Times(2).
+            WillRepeatedly(Return(true));
+
+    CacheChange_t* ch = nullptr;
+    ASSERT_FALSE(history->get_min_change(&ch));
+    ASSERT_FALSE(history->get_max_change(&ch));
+
+    // Changes of the second writer, received before the ones of the first writer
+    history->add_change(changes_list[3]);
+    history->add_change(changes_list[2]);
+    history->add_change(changes_list[1]);
+    history->add_change(changes_list[0]);
+
+    ASSERT_TRUE(history->get_min_change(&ch));
+    ASSERT_EQ(ch->sequenceNumber, SequenceNumber_t(0,1U));
+    ASSERT_TRUE(history->get_max_change(&ch));
+    ASSERT_EQ(ch->sequenceNumber, SequenceNumber_t(0,num_sequence_numbers));
+
+    // Removing all changes of the first writer
+    GUID_t w1 = GUID_t(GuidPrefix_t::unknown(), 1U);
+    ASSERT_TRUE(history->remove_changes_with_guid(w1));
+
+    ASSERT_TRUE(history->get_min_change(&ch));
+    ASSERT_EQ(ch->writerGUID, GUID_t(GuidPrefix_t::unknown(), 2U));
+    ASSERT_EQ(ch->sequenceNumber, SequenceNumber_t(0,1U));
+    ASSERT_TRUE(history->get_max_change(&ch));
+    ASSERT_EQ(ch->writerGUID, GUID_t(GuidPrefix_t::unknown(), 2U));
+    ASSERT_EQ(ch->sequenceNumber, SequenceNumber_t(0,num_sequence_numbers));
+}
+
+/*!
+ * Deep history receiving most changes in order and some of them late, with pairs of changes sharing the same
+ * timestamp. Changes should stay ordered by timestamp, keeping the arrival order between equal timestamps.
+ */
+TEST_F(ReaderHistoryTests, add_change_keeps_order_on_deep_history)
+{
+    const uint32_t depth = 10000;
+    const uint32_t delay = 5;
+
+    GUID_t writer_guid = GUID_t(GuidPrefix_t::unknown(), 1U);
+    vector<CacheChange_t*> deep_changes;
+    deep_changes.reserve(depth);
+    for (uint32_t i=0; i<depth; i++)
+    {
+        CacheChange_t* ch = new CacheChange_t();
+        ch->writerGUID = writer_guid;
+        ch->sequenceNumber = SequenceNumber_t(0,i+1);
+        ch->sourceTimestamp = rtps::Time_t(1,i - i % 2);
+        deep_changes.push_back(ch);
+    }
+
+    // One of every ten changes arrives after the following ones.
+    vector<CacheChange_t*> arrival;
+    vector<CacheChange_t*> delayed;
+    for (uint32_t i=0; i<depth; i++)
+    {
+        if (i % 10 == 3)
+        {
+            delayed.push_back(deep_changes[i]);
+        }
+        else
+        {
+            arrival.push_back(deep_changes[i]);
+        }
+
+        if (i % 10 == 3 + delay)
+        {
+            arrival.push_back(delayed.front());
+            delayed.erase(delayed.begin());
+        }
+    }
+    arrival.insert(arrival.end(), delayed.begin(), delayed.end());
+    ASSERT_EQ(arrival.size(), depth);
+
+    for (CacheChange_t* ch : arrival)
+    {
+        ASSERT_TRUE(history->add_change(ch));
+    }
+
+    vector<CacheChange_t*> expected = arrival;
+    std::stable_sort(expected.begin(), expected.end(), [](const CacheChange_t* c1, const CacheChange_t* c2)
+            {
+                return c1->sourceTimestamp < c2->sourceTimestamp;
+            });
+    ASSERT_EQ(history->getHistorySize(), depth);
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), history->changesBegin()));
+
+    CacheChange_t* ch = nullptr;
+    ASSERT_TRUE(history->get_min_change(&ch));
+    ASSERT_EQ(ch, deep_changes.front());
+    ASSERT_TRUE(history->get_max_change(&ch));
+    ASSERT_EQ(ch, deep_changes.back());
+
+    // Removing changes keeps the order of the rest.
+    EXPECT_CALL(*readerMock, change_removed_by_history(_)).Times(depth / 3 + 1).
+            WillRepeatedly(Return(true));
+    for (uint32_t i=0; i<depth; i+=3)
+    {
+        ASSERT_TRUE(history->remove_change(deep_changes[i]));
+    }
+    expected.erase(std::remove_if(expected.begin(), expected.end(), [](const CacheChange_t* c)
+            {
+                return (c->sequenceNumber.low - 1) % 3 == 0;
+            }), expected.end());
+    ASSERT_EQ(history->getHistorySize(), expected.size());
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), history->changesBegin()));
+
+    ASSERT_TRUE(history->get_min_change(&ch));
+    ASSERT_EQ(ch, deep_changes[1]);
+    ASSERT_TRUE(history->get_max_change(&ch));
+    ASSERT_EQ(ch, deep_changes[depth - 2]);
+
+    for (CacheChange_t* deep_change : deep_changes)
+    {
+        delete deep_change;
+    }
+}
+
+/*!
+ * Microbenchmark of a KEEP_ALL history used as a FIFO.
+ * Reports the average cost of add_change and of removing the oldest change on different history depths, which
+ * should stay roughly the same.
+ */
+TEST_F(ReaderHistoryTests, add_and_remove_cost_on_deep_history)
+{
+    const uint32_t depth_step = 10000;
+    const uint32_t num_steps = 4;
+    const uint32_t num_changes = depth_step * num_steps;
+
+    GUID_t writer_guid = GUID_t(GuidPrefix_t::unknown(), 1U);
+    vector<CacheChange_t*> deep_changes;
+    deep_changes.reserve(num_changes);
+    for (uint32_t i=0; i<num_changes; i++)
+    {
+        CacheChange_t* ch = new CacheChange_t();
+        ch->writerGUID = writer_guid;
+        ch->sequenceNumber = SequenceNumber_t(0,i+1);
+        ch->sourceTimestamp = rtps::Time_t(1,i);
+        deep_changes.push_back(ch);
+    }
+
+    for (uint32_t step=0; step<num_steps; step++)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint32_t i=step*depth_step; i<(step+1)*depth_step; i++)
+        {
+            ASSERT_TRUE(history->add_change(deep_changes[i]));
+        }
+        auto t1 = std::chrono::steady_clock::now();
+
+        double ns_per_add = std::chrono::duration<double, std::nano>(t1 - t0).count() / depth_step;
+        std::cout << "Depth " << step * depth_step << " to " << (step + 1) * depth_step << ": " << ns_per_add <<
+            " ns per add_change" << std::endl;
+    }
+
+    ASSERT_EQ(history->getHistorySize(), num_changes);
+
+    CacheChange_t* ch = nullptr;
+    ASSERT_TRUE(history->get_min_change(&ch));
+    ASSERT_EQ(ch, deep_changes.front());
+    ASSERT_TRUE(history->get_max_change(&ch));
+    ASSERT_EQ(ch, deep_changes.back());
+
+    EXPECT_CALL(*readerMock, change_removed_by_history(_)).Times(num_changes).
+            WillRepeatedly(Return(true));
+    for (uint32_t step=0; step<num_steps; step++)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint32_t i=step*depth_step; i<(step+1)*depth_step; i++)
+        {
+            ASSERT_TRUE(history->remove_change(*history->changesBegin()));
+        }
+        auto t1 = std::chrono::steady_clock::now();
+
+        double ns_per_remove = std::chrono::duration<double, std::nano>(t1 - t0).count() / depth_step;
+        std::cout << "Depth " << num_changes - step * depth_step << " to " <<
+            num_changes - (step + 1) * depth_step << ": " << ns_per_remove << " ns per remove_change" << std::endl;
+
+        if (step + 1 < num_steps)
+        {
+            ASSERT_TRUE(history->get_min_change(&ch));
+            ASSERT_EQ(ch, deep_changes[(step + 1) * depth_step]);
+            ASSERT_TRUE(history->get_max_change(&ch));
+            ASSERT_EQ(ch, deep_changes.back());
+        }
+    }
+
+    ASSERT_EQ(history->getHistorySize(), 0u);
+    ASSERT_FALSE(history->get_min_change(&ch));
+
+    for (CacheChange_t* deep_change : deep_changes)
+    {
+        delete deep_change;
+    }
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleMock(&argc, argv);
@@ -0,0 +1,123 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/messages/ReceiveProcessingPool.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace eprosima::fastrtps::rtps;
+
+static GUID_t writer_guid(uint8_t participant, uint8_t writer)
+{
+    GUID_t guid;
+    guid.guidPrefix.value[0] = participant;
+    guid.entityId.value[2] = writer;
+    guid.entityId.value[3] = 0x02;
+    return guid;
+}
+
+TEST(ReceiveProcessingPoolTests, tasks_of_a_writer_are_processed_in_order)
+{
+    const uint32_t num_writers = 32;
+    const uint32_t tasks_per_writer = 2000;
+
+    std::vector<std::vector<uint32_t>> processed(num_writers);
+
+    {
+        ReceiveProcessingPool pool(4);
+
+        // Two receiving threads pushing interleaved writers.
+        auto receive = [&](uint32_t first_writer)
+                {
+                    for (uint32_t seq = 0; seq < tasks_per_writer; ++seq)
+                    {
+                        for (uint32_t w = first_writer; w < num_writers; w += 2)
+                        {
+                            std::vector<uint32_t>* writer_tasks = &processed[w];
+                            pool.push(writer_guid(static_cast<uint8_t>(w % 3), static_cast<uint8_t>(w)),
+                                    [writer_tasks, seq]()
+                                    {
+                                        writer_tasks->push_back(seq);
+                                    });
+                        }
+                    }
+                };
+
+        std::thread even(receive, 0u);
+        std::thread odd(receive, 1u);
+        even.join();
+        odd.join();
+
+        // Destruction processes everything still queued.
+    }
+
+    for (uint32_t w = 0; w < num_writers; ++w)
+    {
+        ASSERT_EQ(processed[w].size(), tasks_per_writer);
+        for (uint32_t seq = 0; seq < tasks_per_writer; ++seq)
+        {
+            ASSERT_EQ(processed[w][seq], seq);
+        }
+    }
+}
+
+TEST(ReceiveProcessingPoolTests, different_writers_use_several_workers)
+{
+    std::mutex mutex;
+    std::set<std::thread::id> workers;
+
+    ReceiveProcessingPool pool(4);
+    for (uint8_t w = 0; w < 64; ++w)
+    {
+        pool.push(writer_guid(1, w), [&]()
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    workers.insert(std::this_thread::get_id());
+                });
+    }
+    pool.stop();
+
+    EXPECT_GT(workers.size(), 1u);
+    EXPECT_EQ(workers.count(std::this_thread::get_id()), 0u);
+}
+
+TEST(ReceiveProcessingPoolTests, tasks_pushed_after_stop_are_discarded)
+{
+    std::atomic<uint32_t> executed(0);
+
+    ReceiveProcessingPool pool(2);
+    pool.push(writer_guid(1, 1), [&]()
+            {
+                ++executed;
+            });
+    pool.stop();
+    pool.push(writer_guid(1, 1), [&]()
+            {
+                ++executed;
+            });
+
+    EXPECT_EQ(executed.load(), 1u);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -16,7 +16,10 @@
 #include <fastrtps/rtps/attributes/PropertyPolicy.h>
 #include <fastrtps/rtps/history/CacheChangePool.h>
 
+#include <chrono>
 #include <climits>
+#include <cstdio>
+#include <iostream>
 #include <gtest/gtest.h>
 
 using namespace eprosima::fastrtps::rtps;
@@ -165,6 +168,157 @@ TEST_F(PersistenceTest, Reader)
     ASSERT_EQ(seq_map_loaded, seq_map);
 }
 
+/*!
+* @fn TEST_F(PersistenceTest, AsyncWriter)
+* @brief This test checks the writer persistence interface of the asynchronous persistence service.
+*/
+TEST_F(PersistenceTest, AsyncWriter)
+{
+    const std::string persist_guid("TEST_WRITER");
+
+    PropertyPolicy policy;
+    policy.properties().emplace_back("dds.persistence.plugin", "builtin.SQLITE3");
+    policy.properties().emplace_back("dds.persistence.sqlite3.filename", "test.db");
+    policy.properties().emplace_back("dds.persistence.sqlite3.mode", "ASYNCHRONOUS");
+    policy.properties().emplace_back("dds.persistence.sqlite3.flush_interval_ms", "1000");
+
+    // Get service from factory
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+
+    CacheChangePool pool(10, 128, 0, MemoryManagementPolicy_t::PREALLOCATED_MEMORY_MODE);
+    CacheChange_t change;
+    GUID_t guid(GuidPrefix_t::unknown(), 1U);
+    std::vector<CacheChange_t*> changes;
+    change.kind = ALIVE;
+    change.writerGUID = guid;
+    change.serializedPayload.length = 0;
+
+    // Add three changes and remove the second one before they are committed
+    change.sequenceNumber.low = 1;
+    ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    change.sequenceNumber.low = 2;
+    ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    change.sequenceNumber.low = 3;
+    ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    change.sequenceNumber.low = 2;
+    ASSERT_TRUE(service->remove_writer_change_from_storage(persist_guid, change));
+
+    // Loading waits for the queued operations (seqs = 1, 3)
+    changes.clear();
+    ASSERT_TRUE(service->load_writer_from_storage(persist_guid, guid, changes, &pool));
+    ASSERT_EQ(changes.size(), 2u);
+    ASSERT_EQ(changes[0]->sequenceNumber, SequenceNumber_t(0, 1));
+    ASSERT_EQ(changes[1]->sequenceNumber, SequenceNumber_t(0, 3));
+    for (CacheChange_t* loaded : changes)
+    {
+        pool.release_Cache(loaded);
+    }
+
+    // Add another change and destroy the service before the flush interval expires
+    change.sequenceNumber.low = 4;
+    ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+    delete service;
+    service = nullptr;
+
+    // Queued changes should have been committed on destruction
+    PropertyPolicy sync_policy;
+    sync_policy.properties().emplace_back("dds.persistence.plugin", "builtin.SQLITE3");
+    sync_policy.properties().emplace_back("dds.persistence.sqlite3.filename", "test.db");
+    service = PersistenceFactory::create_persistence_service(sync_policy);
+    ASSERT_NE(service, nullptr);
+
+    changes.clear();
+    ASSERT_TRUE(service->load_writer_from_storage(persist_guid, guid, changes, &pool));
+    ASSERT_EQ(changes.size(), 3u);
+    ASSERT_EQ(changes[2]->sequenceNumber, SequenceNumber_t(0, 4));
+}
+
+/*!
+* @fn TEST_F(PersistenceTest, AsyncReader)
+* @brief This test checks the reader persistence interface of the asynchronous persistence service.
+*/
+TEST_F(PersistenceTest, AsyncReader)
+{
+    const std::string persist_guid("TEST_READER");
+
+    PropertyPolicy policy;
+    policy.properties().emplace_back("dds.persistence.plugin", "builtin.SQLITE3");
+    policy.properties().emplace_back("dds.persistence.sqlite3.filename", "test.db");
+    policy.properties().emplace_back("dds.persistence.sqlite3.mode", "ASYNCHRONOUS");
+
+    // Get service from factory
+    service = PersistenceFactory::create_persistence_service(policy);
+    ASSERT_NE(service, nullptr);
+
+    IPersistenceService::map_allocator_t pool(128, 1024);
+    foonathan::memory::map<GUID_t, SequenceNumber_t, IPersistenceService::map_allocator_t> seq_map(pool);
+    foonathan::memory::map<GUID_t, SequenceNumber_t, IPersistenceService::map_allocator_t> seq_map_loaded(pool);
+    GUID_t guid_1(GuidPrefix_t::unknown(), 1U);
+    GUID_t guid_2(GuidPrefix_t::unknown(), 2U);
+
+    // Several updates of the same writers should keep the last value
+    for (uint32_t i = 1; i <= 100; ++i)
+    {
+        SequenceNumber_t seq_1(0, i);
+        SequenceNumber_t seq_2(0, 2 * i);
+        seq_map[guid_1] = seq_1;
+        seq_map[guid_2] = seq_2;
+        ASSERT_TRUE(service->update_writer_seq_on_storage(persist_guid, guid_1, seq_1));
+        ASSERT_TRUE(service->update_writer_seq_on_storage(persist_guid, guid_2, seq_2));
+    }
+
+    // Loading should return local map
+    seq_map_loaded.clear();
+    ASSERT_TRUE(service->load_reader_from_storage(persist_guid, seq_map_loaded));
+    ASSERT_EQ(seq_map_loaded, seq_map);
+}
+
+/*!
+* @fn TEST_F(PersistenceTest, WriterStorageRate)
+* @brief This test prints the rate at which the synchronous and asynchronous services store writer changes.
+*/
+TEST_F(PersistenceTest, WriterStorageRate)
+{
+    const std::string persist_guid("TEST_WRITER");
+    const uint32_t num_changes = 1000;
+
+    CacheChange_t change(128);
+    change.kind = ALIVE;
+    change.writerGUID = GUID_t(GuidPrefix_t::unknown(), 1U);
+    change.serializedPayload.length = 128;
+
+    for (const char* mode : {"SYNCHRONOUS", "ASYNCHRONOUS"})
+    {
+        std::remove("test.db");
+
+        PropertyPolicy policy;
+        policy.properties().emplace_back("dds.persistence.plugin", "builtin.SQLITE3");
+        policy.properties().emplace_back("dds.persistence.sqlite3.filename", "test.db");
+        policy.properties().emplace_back("dds.persistence.sqlite3.mode", mode);
+        service = PersistenceFactory::create_persistence_service(policy);
+        ASSERT_NE(service, nullptr);
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 1; i <= num_changes; ++i)
+        {
+            change.sequenceNumber.low = i;
+            ASSERT_TRUE(service->add_writer_change_to_storage(persist_guid, change));
+        }
+        auto queued = std::chrono::steady_clock::now();
+
+        // Destruction waits for everything to be stored
+        delete service;
+        service = nullptr;
+        auto stored = std::chrono::steady_clock::now();
+
+        auto write_us = std::chrono::duration_cast<std::chrono::microseconds>(queued - start).count();
+        auto total_us = std::chrono::duration_cast<std::chrono::microseconds>(stored - start).count();
+        std::cout << mode << ": " << (write_us / num_changes) << " us per call, " <<
+            (total_us > 0 ? (num_changes * 1000000ull / total_us) : 0) << " changes stored per second" << std::endl;
+    }
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,298 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "FragmentedChangePitStop.h"
+#include <fastrtps/rtps/reader/StatefulReader.h>
+
+#include <rtps/reader/FragmentedChangePitStop.cpp>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace eprosima {
+namespace fastrtps {
+namespace rtps {
+
+using ::testing::_;
+using ::testing::Invoke;
+
+class FragmentedChangePitStopTests : public ::testing::Test
+{
+    protected:
+
+        FragmentedChangePitStopTests()
+            : pit_(&reader_)
+        {
+            writer_guid_.guidPrefix.value[0] = 1;
+            writer_guid_.entityId = c_EntityId_RTPSParticipant;
+
+            ON_CALL(reader_, reserveCache(_, _)).WillByDefault(Invoke(
+                        [](CacheChange_t** change, uint32_t size) -> bool
+                        {
+                            *change = new CacheChange_t(size);
+                            return true;
+                        }));
+            ON_CALL(reader_, releaseCache(_)).WillByDefault(Invoke(
+                        [](CacheChange_t* change)
+                        {
+                            delete change;
+                        }));
+        }
+
+        ~FragmentedChangePitStopTests()
+        {
+            pit_.try_to_remove_until(SequenceNumber_t(0, 100), writer_guid_);
+        }
+
+        //! Fills the sample with a different value on each position.
+        void create_sample(
+                uint32_t size)
+        {
+            sample_.resize(size);
+            for (uint32_t i = 0; i < size; ++i)
+            {
+                sample_[i] = static_cast<octet>(i * 7u + i / 251u);
+            }
+        }
+
+        /*!
+         * Builds the change a DATA_FRAG carrying fragment_count fragments of the sample, starting on fragment
+         * starting_num, as the MessageReceiver does. Fragments out of the sample are filled with zeros.
+         */
+        std::unique_ptr<CacheChange_t> data_frag(
+                uint32_t starting_num,
+                uint16_t fragment_count,
+                uint16_t fragment_size)
+        {
+            size_t begin = starting_num > 0 ? size_t(starting_num - 1) * fragment_size : 0;
+            size_t end = begin + size_t(fragment_count) * fragment_size;
+            size_t length = begin < sample_.size() ? std::min(end, sample_.size()) - begin : end - begin;
+
+            std::unique_ptr<CacheChange_t> change(new CacheChange_t(static_cast<uint32_t>(length)));
+            change->kind = ALIVE;
+            change->writerGUID = writer_guid_;
+            change->sequenceNumber = SequenceNumber_t(0, 1);
+            if (begin < sample_.size())
+            {
+                memcpy(change->serializedPayload.data, sample_.data() + begin, length);
+            }
+            change->serializedPayload.length = static_cast<uint32_t>(length);
+            change->setFragmentSize(fragment_size);
+            change->getDataFragments()->assign(fragment_count, ChangeFragmentStatus_t::PRESENT);
+            return change;
+        }
+
+        CacheChange_t* process(
+                uint32_t starting_num,
+                uint16_t fragment_count,
+                uint16_t fragment_size)
+        {
+            std::unique_ptr<CacheChange_t> change = data_frag(starting_num, fragment_count, fragment_size);
+            return pit_.process(change.get(), static_cast<uint32_t>(sample_.size()), starting_num);
+        }
+
+        FragmentNumberSet_t missing()
+        {
+            FragmentNumberSet_t missing;
+            EXPECT_TRUE(pit_.get_missing_fragments(SequenceNumber_t(0, 1), writer_guid_, missing));
+            return missing;
+        }
+
+        //! Checks the completed change holds the whole sample, and releases it.
+        void check_completed(
+                CacheChange_t* change)
+        {
+            ASSERT_NE(nullptr, change);
+            EXPECT_EQ(sample_.size(), change->serializedPayload.length);
+            EXPECT_EQ(0, memcmp(sample_.data(), change->serializedPayload.data, sample_.size()));
+            EXPECT_TRUE(std::all_of(change->getDataFragments()->begin(), change->getDataFragments()->end(),
+                        [](uint32_t status) { return status == ChangeFragmentStatus_t::PRESENT; }));
+            EXPECT_EQ(nullptr, pit_.find(SequenceNumber_t(0, 1), writer_guid_));
+            delete change;
+        }
+
+        ::testing::NiceMock<StatefulReader> reader_;
+        FragmentedChangePitStop pit_;
+        GUID_t writer_guid_;
+        std::vector<octet> sample_;
+};
+
+TEST_F(FragmentedChangePitStopTests, OutOfOrderAndDuplicatedFragments)
+{
+    // Five fragments, the last one shorter.
+    create_sample(450);
+
+    EXPECT_EQ(nullptr, process(4, 1, 100));
+    EXPECT_EQ(nullptr, process(2, 1, 100));
+    EXPECT_EQ(nullptr, process(4, 1, 100));
+    EXPECT_EQ(nullptr, process(5, 1, 100));
+    EXPECT_EQ(nullptr, process(1, 1, 100));
+    EXPECT_EQ(nullptr, process(2, 1, 100));
+
+    FragmentNumberSet_t set = missing();
+    EXPECT_EQ(3u, set.base());
+    EXPECT_TRUE(set.is_set(3u));
+    EXPECT_FALSE(set.is_set(4u));
+    EXPECT_FALSE(set.is_set(5u));
+
+    check_completed(process(3, 1, 100));
+}
+
+TEST_F(FragmentedChangePitStopTests, FragmentsOverlappingReceivedRuns)
+{
+    create_sample(1000);
+
+    EXPECT_EQ(nullptr, process(2, 1, 100));
+    EXPECT_EQ(nullptr, process(5, 2, 100));
+    EXPECT_EQ(nullptr, process(9, 1, 100));
+
+    // Covers runs already received on both sides and holes between them.
+    EXPECT_EQ(nullptr, process(1, 7, 100));
+
+    FragmentNumberSet_t set = missing();
+    EXPECT_EQ(8u, set.base());
+    EXPECT_TRUE(set.is_set(8u));
+    EXPECT_FALSE(set.is_set(9u));
+    EXPECT_TRUE(set.is_set(10u));
+
+    // Last DATA_FRAG ends with the short last fragment.
+    check_completed(process(7, 4, 100));
+}
+
+TEST_F(FragmentedChangePitStopTests, ShortLastFragment)
+{
+    create_sample(201);
+
+    EXPECT_EQ(nullptr, process(3, 1, 100));
+
+    FragmentNumberSet_t set = missing();
+    EXPECT_EQ(1u, set.base());
+    EXPECT_TRUE(set.is_set(1u));
+    EXPECT_TRUE(set.is_set(2u));
+    EXPECT_FALSE(set.is_set(3u));
+
+    check_completed(process(1, 2, 100));
+}
+
+TEST_F(FragmentedChangePitStopTests, OutOfRangeFragmentsAreIgnored)
+{
+    create_sample(300);
+
+    EXPECT_EQ(nullptr, process(4, 1, 100));
+    EXPECT_EQ(nullptr, process(10, 2, 100));
+    EXPECT_EQ(nullptr, process(0, 1, 100));
+
+    FragmentNumberSet_t set = missing();
+    EXPECT_EQ(1u, set.base());
+    EXPECT_TRUE(set.is_set(1u));
+    EXPECT_TRUE(set.is_set(2u));
+    EXPECT_TRUE(set.is_set(3u));
+    EXPECT_FALSE(set.is_set(4u));
+
+    // Fragments beyond the sample on the same DATA_FRAG are not taken into account.
+    EXPECT_EQ(nullptr, process(1, 2, 100));
+    check_completed(process(3, 2, 100));
+}
+
+TEST_F(FragmentedChangePitStopTests, FragmentsOfAnotherSizeAreIgnored)
+{
+    create_sample(400);
+
+    EXPECT_EQ(nullptr, process(1, 1, 100));
+
+    // Would complete the sample if its fragment size were taken.
+    EXPECT_EQ(nullptr, process(2, 2, 200));
+    EXPECT_EQ(nullptr, process(2, 3, 150));
+
+    FragmentNumberSet_t set = missing();
+    EXPECT_EQ(2u, set.base());
+    EXPECT_TRUE(set.is_set(2u));
+    EXPECT_TRUE(set.is_set(3u));
+    EXPECT_TRUE(set.is_set(4u));
+
+    check_completed(process(2, 3, 100));
+}
+
+TEST_F(FragmentedChangePitStopTests, MissingFragmentsAcrossWordBoundary)
+{
+    // 130 fragments use three words of the bitmap.
+    create_sample(130 * 10);
+
+    // Fragments 1 to 64 fill the first word, fragment 65 is the first one of the second word.
+    EXPECT_EQ(nullptr, process(1, 64, 10));
+    EXPECT_EQ(nullptr, process(66, 1, 10));
+    EXPECT_EQ(nullptr, process(129, 1, 10));
+
+    FragmentNumberSet_t set = missing();
+    EXPECT_EQ(65u, set.base());
+    EXPECT_TRUE(set.is_set(65u));
+    EXPECT_FALSE(set.is_set(66u));
+    for (uint32_t fragment = 67; fragment <= 128; ++fragment)
+    {
+        EXPECT_TRUE(set.is_set(fragment));
+    }
+    EXPECT_FALSE(set.is_set(129u));
+    EXPECT_TRUE(set.is_set(130u));
+    EXPECT_EQ(130u, set.max());
+
+    // Now the first two words are full.
+    EXPECT_EQ(nullptr, process(65, 1, 10));
+    EXPECT_EQ(nullptr, process(67, 62, 10));
+
+    set = missing();
+    EXPECT_EQ(130u, set.base());
+    EXPECT_TRUE(set.is_set(130u));
+    EXPECT_EQ(130u, set.max());
+
+    check_completed(process(130, 1, 10));
+}
+
+TEST_F(FragmentedChangePitStopTests, MissingFragmentsBeyondBitmapSize)
+{
+    create_sample(300 * 10);
+
+    EXPECT_EQ(nullptr, process(2, 1, 10));
+
+    // Only 256 fragments can be requested at once, from the first missing one.
+    FragmentNumberSet_t set = missing();
+    EXPECT_EQ(1u, set.base());
+    EXPECT_TRUE(set.is_set(1u));
+    EXPECT_FALSE(set.is_set(2u));
+    EXPECT_TRUE(set.is_set(256u));
+    EXPECT_EQ(256u, set.max());
+
+    EXPECT_EQ(nullptr, process(1, 1, 10));
+    EXPECT_EQ(nullptr, process(3, 100, 10));
+
+    set = missing();
+    EXPECT_EQ(103u, set.base());
+    EXPECT_EQ(300u, set.max());
+
+    check_completed(process(103, 198, 10));
+}
+
+} // namespace rtps
+} // namespace fastrtps
+} // namespace eprosima
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
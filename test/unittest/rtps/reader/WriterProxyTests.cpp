@@ -19,7 +19,8 @@
     FRIEND_TEST(WriterProxyTests, MissingChangesUpdate); \
     FRIEND_TEST(WriterProxyTests, LostChangesUpdate); \
     FRIEND_TEST(WriterProxyTests, ReceivedChangeSet); \
-    FRIEND_TEST(WriterProxyTests, IrrelevantChangeSet);
+    FRIEND_TEST(WriterProxyTests, IrrelevantChangeSet); \
+    FRIEND_TEST(WriterProxyTests, AvailableChanges);
 
 #include "WriterProxy.h"
 #include <rtps/participant/RTPSParticipantImpl.h>
@@ -340,6 +341,56 @@ TEST(WriterProxyTests, IrrelevantChangeSet)
     ASSERT_EQ(wproxy.changes_from_writer_.size(), 0u);
 }
 
+TEST(WriterProxyTests, AvailableChanges)
+{
+    WriterProxyData wattr(4u, 1u);
+    StatefulReader readerMock;
+    WriterProxy wproxy(&readerMock, RemoteLocatorsAllocationAttributes(), ResourceLimitedContainerConfig());
+    EXPECT_CALL(*wproxy.initial_acknack_, update_interval(readerMock.getTimes().initialAcknackDelay)).Times(1u);
+    EXPECT_CALL(*wproxy.heartbeat_response_, update_interval(readerMock.getTimes().heartbeatResponseDelay)).Times(1u);
+    EXPECT_CALL(*wproxy.initial_acknack_, restart_timer()).Times(1u);
+    wproxy.start(wattr);
+
+    ASSERT_EQ(wproxy.first_available_change(), nullptr);
+    ASSERT_EQ(wproxy.first_unread_change(), nullptr);
+
+    CacheChange_t changes[5];
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        changes[i].sequenceNumber = SequenceNumber_t(0, i + 1);
+        wproxy.received_change_set(changes[i].sequenceNumber);
+        wproxy.change_made_available(&changes[i]);
+    }
+    ASSERT_EQ(wproxy.first_available_change(), &changes[0]);
+    ASSERT_EQ(wproxy.first_unread_change(), &changes[0]);
+
+    // Read changes are skipped.
+    changes[0].isRead = true;
+    changes[1].isRead = true;
+    ASSERT_EQ(wproxy.first_available_change(), &changes[0]);
+    ASSERT_EQ(wproxy.first_unread_change(), &changes[2]);
+
+    // Removing read changes does not affect the unread ones.
+    wproxy.change_removed_from_history(SequenceNumber_t(0, 1));
+    ASSERT_EQ(wproxy.first_available_change(), &changes[1]);
+    ASSERT_EQ(wproxy.first_unread_change(), &changes[2]);
+
+    // Changes may be removed out of order.
+    wproxy.change_removed_from_history(SequenceNumber_t(0, 3));
+    ASSERT_EQ(wproxy.first_available_change(), &changes[1]);
+    ASSERT_EQ(wproxy.first_unread_change(), &changes[3]);
+
+    changes[3].isRead = true;
+    changes[4].isRead = true;
+    ASSERT_EQ(wproxy.first_unread_change(), nullptr);
+
+    wproxy.change_removed_from_history(SequenceNumber_t(0, 2));
+    wproxy.change_removed_from_history(SequenceNumber_t(0, 4));
+    wproxy.change_removed_from_history(SequenceNumber_t(0, 5));
+    ASSERT_EQ(wproxy.first_available_change(), nullptr);
+    ASSERT_EQ(wproxy.first_unread_change(), nullptr);
+}
+
 } // namespace rtps
 } // namespace fastrtps
 } // namespace eprosima
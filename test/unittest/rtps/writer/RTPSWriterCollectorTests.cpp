@@ -0,0 +1,143 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rtps/writer/RTPSWriterCollector.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+class RTPSWriterCollectorTests : public ::testing::Test
+{
+    public:
+
+        RTPSWriterCollectorTests()
+            : collector(ResourceLimitedContainerConfig::fixed_size_configuration(3u), 4u)
+        {
+            for (uint32_t i = 0; i < 5; ++i)
+            {
+                changes.emplace_back(new CacheChange_t(1000));
+                changes.back()->sequenceNumber = {0, i + 1};
+                changes.back()->serializedPayload.length = 1000;
+            }
+        }
+
+        std::vector<std::unique_ptr<CacheChange_t>> changes;
+        RTPSWriterCollector<int> collector;
+};
+
+TEST_F(RTPSWriterCollectorTests, items_are_ordered_and_readers_merged)
+{
+    // Reader 1 has all changes pending, reader 2 only the odd ones, added out of order.
+    for (auto& change : changes)
+    {
+        collector.add_change(change.get(), 1, FragmentNumberSet_t());
+    }
+    collector.add_change(changes[4].get(), 2, FragmentNumberSet_t());
+    collector.add_change(changes[0].get(), 2, FragmentNumberSet_t());
+    collector.add_change(changes[2].get(), 2, FragmentNumberSet_t());
+
+    ASSERT_EQ(5u, collector.size());
+
+    SequenceNumber_t expected(0, 1);
+    while (!collector.empty())
+    {
+        RTPSWriterCollector<int>::Item& item = collector.pop();
+        EXPECT_EQ(expected, item.sequenceNumber);
+        EXPECT_EQ(0u, item.fragmentNumber);
+        EXPECT_EQ(changes[expected.low - 1].get(), item.cacheChange);
+        EXPECT_EQ((expected.low % 2) ? 2u : 1u, item.remoteReaders.size());
+        EXPECT_EQ(1, item.remoteReaders[0]);
+        ++expected;
+    }
+}
+
+TEST_F(RTPSWriterCollectorTests, fragments_are_ordered_inside_changes)
+{
+    FragmentNumberSet_t fragments(1);
+    fragments.add(2);
+    fragments.add(3);
+
+    changes[1]->setFragmentSize(400);
+    changes[0]->setFragmentSize(400);
+    collector.add_change(changes[1].get(), 1, fragments);
+    collector.add_change(changes[0].get(), 1, fragments);
+
+    ASSERT_EQ(6u, collector.size());
+
+    SequenceNumber_t seq(0, 1);
+    FragmentNumber_t frag = 2;
+    while (!collector.empty())
+    {
+        RTPSWriterCollector<int>::Item& item = collector.pop();
+        EXPECT_EQ(seq, item.sequenceNumber);
+        EXPECT_EQ(frag, item.fragmentNumber);
+        if (++frag > 3)
+        {
+            ++seq;
+            frag = 2;
+        }
+    }
+}
+
+TEST_F(RTPSWriterCollectorTests, erase_drops_the_tail)
+{
+    for (auto& change : changes)
+    {
+        collector.add_change(change.get(), 1, FragmentNumberSet_t());
+    }
+
+    collector.pop();
+    collector.erase(collector.begin() + 2, collector.end());
+
+    ASSERT_EQ(2u, collector.size());
+    EXPECT_EQ(SequenceNumber_t(0, 2), collector.pop().sequenceNumber);
+    EXPECT_EQ(SequenceNumber_t(0, 3), collector.pop().sequenceNumber);
+    EXPECT_TRUE(collector.empty());
+}
+
+TEST_F(RTPSWriterCollectorTests, items_are_reused_after_clear)
+{
+    for (auto& change : changes)
+    {
+        collector.add_change(change.get(), 1, FragmentNumberSet_t());
+    }
+    std::vector<RTPSWriterCollector<int>::Item*> first_round(collector.begin(), collector.end());
+
+    collector.clear();
+    EXPECT_TRUE(collector.empty());
+
+    for (auto& change : changes)
+    {
+        collector.add_change(change.get(), 2, FragmentNumberSet_t());
+    }
+    std::vector<RTPSWriterCollector<int>::Item*> second_round(collector.begin(), collector.end());
+
+    EXPECT_EQ(first_round, second_round);
+    for (RTPSWriterCollector<int>::Item* item : second_round)
+    {
+        ASSERT_EQ(1u, item->remoteReaders.size());
+        EXPECT_EQ(2, item->remoteReaders[0]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -15,6 +15,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#define TEST_FRIENDS \
+    FRIEND_TEST(ReaderProxyTests, ring_is_bounded_by_history_maximum); \
+    FRIEND_TEST(ReaderProxyTests, ring_is_bounded_on_unlimited_history);
+
 #include <fastrtps/rtps/writer/ReaderProxy.h>
 #include <fastrtps/rtps/writer/StatefulWriter.h>
 
@@ -133,6 +137,228 @@ TEST(ReaderProxyTests, are_there_gaps)
     ASSERT_FALSE(rproxy.are_there_gaps());
 }
 
+TEST(ReaderProxyTests, for_each_unsent_change_skips_sent_changes)
+{
+    StatefulWriter writerMock;
+    WriterTimes wTimes;
+    RemoteLocatorsAllocationAttributes alloc;
+    ReaderProxy rproxy(wTimes, alloc, &writerMock);
+    ReaderProxyData reader_attributes(0, 0);
+    reader_attributes.m_qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    rproxy.start(reader_attributes);
+
+    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 1)), false);
+    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 2)), false);
+    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 3)), false);
+    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 5)), false); // GAP on 4
+    rproxy.set_change_to_status(SequenceNumber_t(0, 2), UNDERWAY, false);
+    rproxy.set_change_to_status(SequenceNumber_t(0, 3), UNDERWAY, false);
+
+    std::vector<std::pair<SequenceNumber_t, bool>> visited;
+    auto visit = [&visited](const SequenceNumber_t& seq, const ChangeForReader_t* change)
+            {
+                visited.emplace_back(seq, change != nullptr);
+            };
+
+    rproxy.for_each_unsent_change(SequenceNumber_t(0, 8), visit);
+    std::vector<std::pair<SequenceNumber_t, bool>> expected = {
+        {SequenceNumber_t(0, 1), true},
+        {SequenceNumber_t(0, 4), false},
+        {SequenceNumber_t(0, 5), true},
+        {SequenceNumber_t(0, 6), false},
+        {SequenceNumber_t(0, 7), false}
+    };
+    ASSERT_EQ(visited, expected);
+
+    // Requested changes are sent again after the acknack response.
+    ASSERT_FALSE(rproxy.has_unacknowledged());
+    ASSERT_TRUE(rproxy.perform_nack_supression());
+    ASSERT_TRUE(rproxy.has_unacknowledged());
+    SequenceNumberSet_t requested(SequenceNumber_t(0, 3));
+    requested.add(SequenceNumber_t(0, 3));
+    ASSERT_TRUE(rproxy.requested_changes_set(requested));
+    ASSERT_TRUE(rproxy.perform_acknack_response());
+    ASSERT_FALSE(rproxy.perform_acknack_response());
+
+    visited.clear();
+    rproxy.change_has_been_removed(SequenceNumber_t(0, 1));
+    rproxy.for_each_unsent_change(SequenceNumber_t(0, 6), visit);
+    expected = {
+        {SequenceNumber_t(0, 1), false},
+        {SequenceNumber_t(0, 3), true},
+        {SequenceNumber_t(0, 4), false},
+        {SequenceNumber_t(0, 5), true}
+    };
+    ASSERT_EQ(visited, expected);
+}
+
+TEST(ReaderProxyTests, changes_wrap_around_and_grow)
+{
+    StatefulWriter writerMock;
+    WriterTimes wTimes;
+    RemoteLocatorsAllocationAttributes alloc;
+    ReaderProxy rproxy(wTimes, alloc, &writerMock);
+    ReaderProxyData reader_attributes(0, 0);
+    reader_attributes.m_qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    rproxy.start(reader_attributes);
+
+    uint32_t next = 1;
+    for (; next <= 1000; ++next)
+    {
+        rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, next)), false);
+    }
+    rproxy.acked_changes_set(SequenceNumber_t(0, 901));
+
+    for (; next <= 3000; ++next)
+    {
+        rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, next)), false);
+        if (next % 2 == 0)
+        {
+            rproxy.set_change_to_status(SequenceNumber_t(0, next), UNDERWAY, false);
+        }
+    }
+
+    ASSERT_TRUE(rproxy.change_is_acked(SequenceNumber_t(0, 900)));
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 901)));
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 3000)));
+    ASSERT_FALSE(rproxy.are_there_gaps());
+
+    uint32_t unsent = 0;
+    rproxy.for_each_unsent_change(SequenceNumber_t(0, 3001),
+            [&unsent](const SequenceNumber_t& seq, const ChangeForReader_t* change)
+            {
+                ASSERT_NE(change, nullptr);
+                ASSERT_EQ(change->getSequenceNumber(), seq);
+                ASSERT_TRUE(seq.low <= 1000 || seq.low % 2 == 1);
+                ++unsent;
+            });
+    ASSERT_EQ(unsent, 100u + 1000u);
+
+    rproxy.acked_changes_set(SequenceNumber_t(0, 3001));
+    ASSERT_FALSE(rproxy.has_changes());
+    ASSERT_EQ(rproxy.changes_low_mark(), SequenceNumber_t(0, 3000));
+}
+
+/*
+ * On keyed histories an old change of an instance is kept while the rest of instances are written, so the sequence
+ * numbers kept may span much more than the maximum number of changes of the history.
+ */
+TEST(ReaderProxyTests, ring_is_bounded_by_history_maximum)
+{
+    StatefulWriter writerMock(HistoryAttributes(PREALLOCATED_MEMORY_MODE, 500, 10, 100));
+    WriterTimes wTimes;
+    RemoteLocatorsAllocationAttributes alloc;
+    ReaderProxy rproxy(wTimes, alloc, &writerMock);
+    ReaderProxyData reader_attributes(0, 0);
+    reader_attributes.m_qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    rproxy.start(reader_attributes);
+
+    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 1)), false);
+    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 50)), false);
+    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 60)), false);
+    rproxy.set_change_to_status(SequenceNumber_t(0, 60), UNDERWAY, false);
+    for (uint32_t seq = 100; seq <= 100000; ++seq)
+    {
+        rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, seq)), false);
+        rproxy.set_change_to_status(SequenceNumber_t(0, seq), UNDERWAY, false);
+        if (seq > 100)
+        {
+            rproxy.change_has_been_removed(SequenceNumber_t(0, seq - 1));
+        }
+    }
+
+    ASSERT_EQ(128u, rproxy.changes_for_reader_.size());
+    ASSERT_EQ(3u, rproxy.sparse_changes_.size());
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 1)));
+    ASSERT_TRUE(rproxy.change_is_acked(SequenceNumber_t(0, 2)));
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 50)));
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 60)));
+    ASSERT_TRUE(rproxy.change_is_acked(SequenceNumber_t(0, 99999)));
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 100000)));
+    ASSERT_TRUE(rproxy.are_there_gaps());
+
+    std::vector<SequenceNumber_t> unsent;
+    uint32_t holes = 0;
+    auto visit = [&unsent, &holes](const SequenceNumber_t& seq, const ChangeForReader_t* change)
+            {
+                if (change == nullptr)
+                {
+                    ++holes;
+                }
+                else
+                {
+                    ASSERT_EQ(change->getSequenceNumber(), seq);
+                    unsent.push_back(seq);
+                }
+            };
+    rproxy.for_each_unsent_change(SequenceNumber_t(0, 100001), visit);
+    std::vector<SequenceNumber_t> expected = { SequenceNumber_t(0, 1), SequenceNumber_t(0, 50) };
+    ASSERT_EQ(unsent, expected);
+    ASSERT_EQ(100000u - 4u, holes);
+
+    // Changes out of the ring follow the same status transitions.
+    ASSERT_TRUE(rproxy.perform_nack_supression());
+    ASSERT_TRUE(rproxy.has_unacknowledged());
+    SequenceNumberSet_t requested(SequenceNumber_t(0, 60));
+    requested.add(SequenceNumber_t(0, 60));
+    ASSERT_TRUE(rproxy.requested_changes_set(requested));
+    ASSERT_TRUE(rproxy.perform_acknack_response());
+
+    unsent.clear();
+    holes = 0;
+    rproxy.change_has_been_removed(SequenceNumber_t(0, 50));
+    rproxy.for_each_unsent_change(SequenceNumber_t(0, 100001), visit);
+    expected = { SequenceNumber_t(0, 1), SequenceNumber_t(0, 60) };
+    ASSERT_EQ(unsent, expected);
+
+    ASSERT_TRUE(rproxy.set_change_to_status(SequenceNumber_t(0, 1), ACKNOWLEDGED, false));
+    ASSERT_EQ(rproxy.changes_low_mark(), SequenceNumber_t(0, 1));
+    ASSERT_EQ(1u, rproxy.sparse_changes_.size());
+
+    rproxy.acked_changes_set(SequenceNumber_t(0, 100000));
+    ASSERT_TRUE(rproxy.sparse_changes_.empty());
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 100000)));
+    ASSERT_FALSE(rproxy.are_there_gaps());
+
+    rproxy.acked_changes_set(SequenceNumber_t(0, 100001));
+    ASSERT_FALSE(rproxy.has_changes());
+}
+
+TEST(ReaderProxyTests, ring_is_bounded_on_unlimited_history)
+{
+    StatefulWriter writerMock(HistoryAttributes(PREALLOCATED_MEMORY_MODE, 500, 10, 0));
+    WriterTimes wTimes;
+    RemoteLocatorsAllocationAttributes alloc;
+    ReaderProxy rproxy(wTimes, alloc, &writerMock);
+    ReaderProxyData reader_attributes(0, 0);
+    reader_attributes.m_qos.m_reliability.kind = RELIABLE_RELIABILITY_QOS;
+    rproxy.start(reader_attributes);
+
+    // The ring may hold twice as many slots as changes are kept.
+    rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, 1)), false);
+    for (uint32_t seq = 2; seq <= 100000; ++seq)
+    {
+        rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, seq)), false);
+        if (seq > 2)
+        {
+            rproxy.change_has_been_removed(SequenceNumber_t(0, seq - 1));
+        }
+    }
+    ASSERT_EQ(64u, rproxy.changes_for_reader_.size());
+    ASSERT_EQ(1u, rproxy.sparse_changes_.size());
+
+    // A contiguous run of changes makes it grow.
+    for (uint32_t seq = 100001; seq <= 101000; ++seq)
+    {
+        rproxy.add_change(ChangeForReader_t(SequenceNumber_t(0, seq)), false);
+    }
+    ASSERT_EQ(1024u, rproxy.changes_for_reader_.size());
+    ASSERT_EQ(1u, rproxy.sparse_changes_.size());
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 1)));
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 100000)));
+    ASSERT_FALSE(rproxy.change_is_acked(SequenceNumber_t(0, 101000)));
+}
+
 } // namespace rtps
 } // namespace fastrtps
 } // namespace eprosima
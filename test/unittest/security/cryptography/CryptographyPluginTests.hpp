@@ -22,8 +22,10 @@
 
 #include <gtest/gtest.h>
 #include <openssl/rand.h>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <iostream>
 
 class CryptographyPluginTest : public ::testing::Test
 {
@@ -1426,4 +1428,116 @@ TEST_F(CryptographyPluginTest, transform_preprocess_secure_submessage)
     delete i_handle;
 }
 
+
+TEST_F(CryptographyPluginTest, benchmark_RTPSMessage)
+{
+    const int num_messages = 20000;
+    const uint32_t message_size = 1024;
+
+    eprosima::fastrtps::rtps::security::PKIIdentityHandle* i_handle = new eprosima::fastrtps::rtps::security::PKIIdentityHandle();
+    eprosima::fastrtps::rtps::security::AccessPermissionsHandle* perm_handle = new eprosima::fastrtps::rtps::security::AccessPermissionsHandle();
+    eprosima::fastrtps::rtps::PropertySeq prop_handle;
+    eprosima::fastrtps::rtps::security::ParticipantSecurityAttributes part_sec_attr;
+    eprosima::fastrtps::rtps::security::SharedSecretHandle* shared_secret = new eprosima::fastrtps::rtps::security::SharedSecretHandle();
+
+    eprosima::fastrtps::rtps::security::SecurityException exception;
+
+    part_sec_attr.is_rtps_protected = true;
+    part_sec_attr.plugin_participant_attributes = PLUGIN_PARTICIPANT_SECURITY_ATTRIBUTES_FLAG_IS_RTPS_ENCRYPTED |
+        PLUGIN_PARTICIPANT_SECURITY_ATTRIBUTES_FLAG_IS_RTPS_ORIGIN_AUTHENTICATED;
+
+    //Fill shared secret with dummy values
+    std::vector<uint8_t> dummy_data, challenge_1, challenge_2;
+    eprosima::fastrtps::rtps::security::SharedSecret::BinaryData binary_data;
+    challenge_1.resize(8);
+    challenge_2.resize(8);
+
+    RAND_bytes(challenge_1.data(),8);
+    binary_data.name("Challenge1");
+    binary_data.value(challenge_1);
+    (*shared_secret)->data_.push_back(binary_data);
+
+    RAND_bytes(challenge_2.data(),8);
+    binary_data.name("Challenge2");
+    binary_data.value(challenge_2);
+    (*shared_secret)->data_.push_back(binary_data);
+
+    dummy_data.resize(32);
+    RAND_bytes(dummy_data.data(),32);
+    binary_data.name("SharedSecret");
+    binary_data.value(dummy_data);
+    (*shared_secret)->data_.push_back(binary_data);
+
+    //Session keys are renewed every 16 messages, so cached keys have to follow the session changes
+    eprosima::fastrtps::rtps::Property prop;
+    prop.name("dds.sec.crypto.maxblockspersession");
+    prop.value("16");
+    prop_handle.push_back(prop);
+
+    eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *ParticipantA = CryptoPlugin->keyfactory()->register_local_participant(*i_handle,*perm_handle,prop_handle,part_sec_attr,exception);
+    eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *ParticipantB = CryptoPlugin->keyfactory()->register_local_participant(*i_handle,*perm_handle,prop_handle,part_sec_attr,exception);
+
+    ASSERT_TRUE( (ParticipantA != nullptr) & (ParticipantB != nullptr) );
+
+    eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *ParticipantA_remote =CryptoPlugin->keyfactory()->register_matched_remote_participant(*ParticipantA,*i_handle,*perm_handle,*shared_secret, exception);
+    eprosima::fastrtps::rtps::security::ParticipantCryptoHandle *ParticipantB_remote =CryptoPlugin->keyfactory()->register_matched_remote_participant(*ParticipantB,*i_handle,*perm_handle,*shared_secret, exception);
+
+    eprosima::fastrtps::rtps::security::ParticipantCryptoTokenSeq ParticipantA_CryptoTokens, ParticipantB_CryptoTokens;
+
+    CryptoPlugin->keyexchange()->create_local_participant_crypto_tokens(ParticipantA_CryptoTokens, *ParticipantA, *ParticipantA_remote, exception);
+    CryptoPlugin->keyexchange()->create_local_participant_crypto_tokens(ParticipantB_CryptoTokens, *ParticipantB, *ParticipantB_remote, exception);
+
+    CryptoPlugin->keyexchange()->set_remote_participant_crypto_tokens(*ParticipantA,*ParticipantA_remote,ParticipantB_CryptoTokens,exception);
+    CryptoPlugin->keyexchange()->set_remote_participant_crypto_tokens(*ParticipantB,*ParticipantB_remote,ParticipantA_CryptoTokens,exception);
+
+    eprosima::fastrtps::rtps::CDRMessage_t plain_rtps_message;
+    eprosima::fastrtps::rtps::CDRMessage_t encoded_rtps_message;
+    eprosima::fastrtps::rtps::CDRMessage_t decoded_rtps_message;
+
+    RAND_bytes(plain_rtps_message.buffer, message_size);
+    plain_rtps_message.length = message_size;
+
+    std::vector<eprosima::fastrtps::rtps::security::ParticipantCryptoHandle*> receivers;
+    receivers.push_back(ParticipantA_remote);
+
+    std::chrono::steady_clock::duration encode_time = std::chrono::steady_clock::duration::zero();
+    std::chrono::steady_clock::duration decode_time = std::chrono::steady_clock::duration::zero();
+
+    for(int i = 0; i < num_messages; ++i)
+    {
+        plain_rtps_message.pos = 0;
+        encoded_rtps_message.pos = 0;
+        encoded_rtps_message.length = 0;
+        decoded_rtps_message.pos = 0;
+        decoded_rtps_message.length = 0;
+
+        auto t0 = std::chrono::steady_clock::now();
+        ASSERT_TRUE(CryptoPlugin->cryptotransform()->encode_rtps_message(encoded_rtps_message, plain_rtps_message,*ParticipantA,receivers,exception));
+        auto t1 = std::chrono::steady_clock::now();
+        encoded_rtps_message.pos = 0;
+        ASSERT_TRUE(CryptoPlugin->cryptotransform()->decode_rtps_message(decoded_rtps_message,encoded_rtps_message,*ParticipantB,*ParticipantB_remote,exception));
+        auto t2 = std::chrono::steady_clock::now();
+
+        encode_time += t1 - t0;
+        decode_time += t2 - t1;
+
+        ASSERT_EQ(plain_rtps_message.length, decoded_rtps_message.length);
+        ASSERT_EQ(memcmp(plain_rtps_message.buffer, decoded_rtps_message.buffer, decoded_rtps_message.length), 0);
+    }
+
+    double encode_us = std::chrono::duration<double, std::micro>(encode_time).count() / num_messages;
+    double decode_us = std::chrono::duration<double, std::micro>(decode_time).count() / num_messages;
+    std::cout << num_messages << " messages of " << message_size << " bytes. Encode: " << encode_us <<
+        " us/msg. Decode: " << decode_us << " us/msg." << std::endl;
+
+    CryptoPlugin->keyfactory()->unregister_participant(ParticipantA,exception);
+    CryptoPlugin->keyfactory()->unregister_participant(ParticipantB,exception);
+    CryptoPlugin->keyfactory()->unregister_participant(ParticipantA_remote,exception);
+    CryptoPlugin->keyfactory()->unregister_participant(ParticipantB_remote,exception);
+
+    delete shared_secret;
+    delete i_handle;
+    delete perm_handle;
+}
+
 #endif
@@ -0,0 +1,424 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/utils/Semaphore.h>
+#include <fastrtps/transport/SharedMemTransport.h>
+#include <fastrtps/utils/IPLocator.h>
+#include <fastrtps/log/Log.h>
+#include <gtest/gtest.h>
+#include <MockReceiverResource.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace eprosima::fastrtps;
+using namespace eprosima::fastrtps::rtps;
+
+static uint32_t g_default_port = 0;
+
+#if defined(__linux__)
+//! Mode of a shared memory object, or zero when it does not exist.
+static mode_t shm_mode(const std::string& name)
+{
+    struct stat st;
+    return stat(("/dev/shm/" + name).c_str(), &st) == 0 ? (st.st_mode & 0777) : 0;
+}
+#endif
+
+uint32_t get_port()
+{
+    uint32_t port = static_cast<uint16_t>(getpid());
+
+    if(4000 > port)
+    {
+        port += 4000;
+    }
+
+    return port;
+}
+
+class SharedMemTests: public ::testing::Test
+{
+    public:
+        SharedMemTests()
+        {
+            HELPER_SetDescriptorDefaults();
+        }
+
+        void HELPER_SetDescriptorDefaults();
+
+        SharedMemTransportDescriptor descriptor;
+};
+
+TEST_F(SharedMemTests, locators_with_kind_16_supported)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    Locator_t supportedLocator;
+    supportedLocator.kind = LOCATOR_KIND_SHM;
+    Locator_t unsupportedLocator;
+    unsupportedLocator.kind = LOCATOR_KIND_UDPv4;
+
+    ASSERT_TRUE(transportUnderTest.IsLocatorSupported(supportedLocator));
+    ASSERT_FALSE(transportUnderTest.IsLocatorSupported(unsupportedLocator));
+}
+
+TEST_F(SharedMemTests, default_locators_belong_to_this_host)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    LocatorList_t unicast;
+    LocatorList_t multicast;
+    transportUnderTest.getDefaultUnicastLocators(unicast, g_default_port);
+    transportUnderTest.getDefaultMetatrafficMulticastLocators(multicast, g_default_port);
+    ASSERT_EQ(unicast.size(), 1u);
+    ASSERT_EQ(multicast.size(), 1u);
+
+    Locator_t unicastLocator = *unicast.begin();
+    Locator_t multicastLocator = *multicast.begin();
+    EXPECT_FALSE(IPLocator::isMulticast(unicastLocator));
+    EXPECT_TRUE(IPLocator::isMulticast(multicastLocator));
+    EXPECT_TRUE(transportUnderTest.is_local_locator(unicastLocator));
+    EXPECT_TRUE(transportUnderTest.is_locator_allowed(multicastLocator));
+
+    // A locator of another host is never reachable.
+    Locator_t remoteLocator(unicastLocator);
+    remoteLocator.address[15] ^= 0xFF;
+    EXPECT_FALSE(transportUnderTest.is_locator_allowed(remoteLocator));
+    EXPECT_FALSE(transportUnderTest.DoInputLocatorsMatch(unicastLocator, multicastLocator));
+}
+
+TEST_F(SharedMemTests, opening_and_closing_input_channel)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    LocatorList_t list;
+    transportUnderTest.getDefaultUnicastLocators(list, g_default_port);
+    Locator_t unicastLocator = *list.begin();
+
+    ASSERT_FALSE (transportUnderTest.IsInputChannelOpen(unicastLocator));
+    ASSERT_TRUE  (transportUnderTest.OpenInputChannel(unicastLocator, nullptr, 0x8FFF));
+    ASSERT_TRUE  (transportUnderTest.IsInputChannelOpen(unicastLocator));
+    ASSERT_TRUE  (transportUnderTest.CloseInputChannel(unicastLocator));
+    ASSERT_FALSE (transportUnderTest.IsInputChannelOpen(unicastLocator));
+    ASSERT_FALSE (transportUnderTest.CloseInputChannel(unicastLocator));
+}
+
+TEST_F(SharedMemTests, unicast_port_has_a_single_listener)
+{
+    SharedMemTransport firstTransport(descriptor);
+    ASSERT_TRUE(firstTransport.init());
+    SharedMemTransport secondTransport(descriptor);
+    ASSERT_TRUE(secondTransport.init());
+
+    LocatorList_t list;
+    firstTransport.getDefaultUnicastLocators(list, g_default_port);
+    Locator_t unicastLocator = *list.begin();
+
+    ASSERT_TRUE(firstTransport.OpenInputChannel(unicastLocator, nullptr, 0x8FFF));
+    ASSERT_FALSE(secondTransport.OpenInputChannel(unicastLocator, nullptr, 0x8FFF));
+    ASSERT_TRUE(firstTransport.CloseInputChannel(unicastLocator));
+    ASSERT_TRUE(secondTransport.OpenInputChannel(unicastLocator, nullptr, 0x8FFF));
+    ASSERT_TRUE(secondTransport.CloseInputChannel(unicastLocator));
+}
+
+TEST_F(SharedMemTests, send_and_receive_between_transports)
+{
+    SharedMemTransport senderTransport(descriptor);
+    ASSERT_TRUE(senderTransport.init());
+    SharedMemTransport receiverTransport(descriptor);
+    ASSERT_TRUE(receiverTransport.init());
+
+    LocatorList_t list;
+    receiverTransport.getDefaultUnicastLocators(list, g_default_port);
+    Locator_t unicastLocator = *list.begin();
+
+    MockReceiverResource receiver(receiverTransport, unicastLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(senderTransport.OpenOutputChannel(send_resource_list, unicastLocator));
+    ASSERT_EQ(send_resource_list.size(), 1u);
+    ASSERT_TRUE(senderTransport.OpenOutputChannel(send_resource_list, unicastLocator));
+    ASSERT_EQ(send_resource_list.size(), 1u);
+    ASSERT_TRUE(receiverTransport.IsInputChannelOpen(unicastLocator));
+    octet message[5] = { 'H','e','l','l','o' };
+
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message,msg_recv->data,5), 0);
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, unicastLocator, std::chrono::microseconds(100)));
+    sem.wait();
+}
+
+TEST_F(SharedMemTests, send_gathered_buffers_as_a_single_message)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    LocatorList_t list;
+    transportUnderTest.getDefaultUnicastLocators(list, g_default_port);
+    Locator_t unicastLocator = *list.begin();
+
+    MockReceiverResource receiver(transportUnderTest, unicastLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    octet header[4] = { 'R','T','P','S' };
+    octet payload[7] = { 'P','a','y','l','o','a','d' };
+    octet expected[11] = { 'R','T','P','S','P','a','y','l','o','a','d' };
+
+    std::vector<NetworkBuffer> buffers;
+    buffers.emplace_back(header, 4);
+    buffers.emplace_back(payload, 7);
+
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(expected, msg_recv->data, 11), 0);
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    EXPECT_TRUE(transportUnderTest.send(buffers, 11, unicastLocator, std::chrono::microseconds(100)));
+    sem.wait();
+}
+
+TEST_F(SharedMemTests, multicast_is_received_by_every_listener)
+{
+    SharedMemTransport senderTransport(descriptor);
+    ASSERT_TRUE(senderTransport.init());
+    SharedMemTransport firstTransport(descriptor);
+    ASSERT_TRUE(firstTransport.init());
+    SharedMemTransport secondTransport(descriptor);
+    ASSERT_TRUE(secondTransport.init());
+
+    LocatorList_t list;
+    senderTransport.getDefaultMetatrafficMulticastLocators(list, g_default_port);
+    Locator_t multicastLocator = *list.begin();
+
+    MockReceiverResource firstReceiver(firstTransport, multicastLocator);
+    MockMessageReceiver *first_recv = dynamic_cast<MockMessageReceiver*>(firstReceiver.CreateMessageReceiver());
+    MockReceiverResource secondReceiver(secondTransport, multicastLocator);
+    MockMessageReceiver *second_recv = dynamic_cast<MockMessageReceiver*>(secondReceiver.CreateMessageReceiver());
+
+    octet message[5] = { 'H','e','l','l','o' };
+
+    Semaphore sem;
+    first_recv->setCallback([&]()
+    {
+        EXPECT_EQ(memcmp(message, first_recv->data, 5), 0);
+        sem.post();
+    });
+    second_recv->setCallback([&]()
+    {
+        EXPECT_EQ(memcmp(message, second_recv->data, 5), 0);
+        sem.post();
+    });
+
+    EXPECT_TRUE(senderTransport.send(message, 5, multicastLocator, std::chrono::microseconds(100)));
+    sem.wait();
+    sem.wait();
+}
+
+TEST_F(SharedMemTests, segment_space_is_reused)
+{
+    descriptor.maxMessageSize = 1000;
+    descriptor.segment_size = 4096;
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    LocatorList_t list;
+    transportUnderTest.getDefaultUnicastLocators(list, g_default_port);
+    Locator_t unicastLocator = *list.begin();
+
+    MockReceiverResource receiver(transportUnderTest, unicastLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    octet message[1000];
+    Semaphore sem;
+    msg_recv->setCallback([&]()
+    {
+        EXPECT_EQ(memcmp(message, msg_recv->data, sizeof(message)), 0);
+        sem.post();
+    });
+
+    // Many more messages than fit in the segment at once.
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        memset(message, static_cast<int>(i), sizeof(message));
+        ASSERT_TRUE(transportUnderTest.send(message, sizeof(message), unicastLocator,
+                std::chrono::microseconds(100000)));
+        sem.wait();
+    }
+}
+
+TEST_F(SharedMemTests, send_to_port_without_listener_is_discarded)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    LocatorList_t list;
+    transportUnderTest.getDefaultUnicastLocators(list, g_default_port + 1);
+    Locator_t unicastLocator = *list.begin();
+
+    octet message[5] = { 'H','e','l','l','o' };
+    EXPECT_TRUE(transportUnderTest.send(message, 5, unicastLocator, std::chrono::microseconds(100)));
+}
+
+TEST_F(SharedMemTests, message_bigger_than_max_message_size_is_rejected)
+{
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    LocatorList_t list;
+    transportUnderTest.getDefaultUnicastLocators(list, g_default_port);
+    Locator_t unicastLocator = *list.begin();
+
+    std::vector<octet> message(descriptor.max_message_size() + 1);
+    EXPECT_FALSE(transportUnderTest.send(message.data(), static_cast<uint32_t>(message.size()), unicastLocator,
+            std::chrono::microseconds(100)));
+}
+
+TEST_F(SharedMemTests, segment_smaller_than_max_message_size_fails_to_init)
+{
+    descriptor.maxMessageSize = 65500;
+    descriptor.segment_size = 1024;
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_FALSE(transportUnderTest.init());
+}
+
+#if defined(__linux__)
+TEST_F(SharedMemTests, port_is_removed_by_its_last_owner)
+{
+    SharedMemTransport receiverTransport(descriptor);
+    ASSERT_TRUE(receiverTransport.init());
+    std::unique_ptr<SharedMemTransport> senderTransport(new SharedMemTransport(descriptor));
+    ASSERT_TRUE(senderTransport->init());
+
+    LocatorList_t list;
+    receiverTransport.getDefaultUnicastLocators(list, g_default_port);
+    Locator_t unicastLocator = *list.begin();
+    std::string port_name = "fastrtps_port_u" + std::to_string(g_default_port);
+
+    ASSERT_TRUE(receiverTransport.OpenInputChannel(unicastLocator, nullptr, 0x8FFF));
+    EXPECT_EQ(shm_mode(port_name), 0600u);
+
+    octet message[5] = { 'H','e','l','l','o' };
+    EXPECT_TRUE(senderTransport->send(message, 5, unicastLocator, std::chrono::microseconds(100)));
+
+    // The sender still has the port open.
+    ASSERT_TRUE(receiverTransport.CloseInputChannel(unicastLocator));
+    EXPECT_NE(shm_mode(port_name), 0u);
+
+    senderTransport.reset();
+    EXPECT_EQ(shm_mode(port_name), 0u);
+}
+
+TEST_F(SharedMemTests, permissions_are_configurable)
+{
+    descriptor.permissions = 0660;
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+
+    LocatorList_t list;
+    transportUnderTest.getDefaultUnicastLocators(list, g_default_port);
+    Locator_t unicastLocator = *list.begin();
+
+    ASSERT_TRUE(transportUnderTest.OpenInputChannel(unicastLocator, nullptr, 0x8FFF));
+    EXPECT_EQ(shm_mode("fastrtps_port_u" + std::to_string(g_default_port)), 0660u);
+    ASSERT_TRUE(transportUnderTest.CloseInputChannel(unicastLocator));
+}
+
+TEST_F(SharedMemTests, objects_of_dead_processes_are_removed_on_init)
+{
+    uint32_t port = g_default_port + 1;
+    std::string port_name = "fastrtps_port_u" + std::to_string(port);
+
+    // A process that dies without closing anything.
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        SharedMemTransport crashingTransport(descriptor);
+        LocatorList_t list;
+        bool opened = crashingTransport.init() &&
+                crashingTransport.getDefaultUnicastLocators(list, port) &&
+                crashingTransport.OpenInputChannel(*list.begin(), nullptr, 0x8FFF);
+        _exit(opened ? 0 : 1);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    // Only the upper half of the segment identifier, the process, is known.
+    char segment_prefix[32];
+    snprintf(segment_prefix, sizeof(segment_prefix), "fastrtps_%08x", static_cast<uint32_t>(child));
+    auto child_segment_exists = [&segment_prefix]()
+            {
+                bool found = false;
+                DIR* dir = opendir("/dev/shm");
+                struct dirent* entry = nullptr;
+                while (dir != nullptr && !found && (entry = readdir(dir)) != nullptr)
+                {
+                    found = strncmp(entry->d_name, segment_prefix, strlen(segment_prefix)) == 0;
+                }
+                if (dir != nullptr)
+                {
+                    closedir(dir);
+                }
+                return found;
+            };
+    EXPECT_NE(shm_mode(port_name), 0u);
+    EXPECT_TRUE(child_segment_exists());
+
+    SharedMemTransport transportUnderTest(descriptor);
+    ASSERT_TRUE(transportUnderTest.init());
+    EXPECT_EQ(shm_mode(port_name), 0u);
+    EXPECT_FALSE(child_segment_exists());
+}
+#endif
+
+void SharedMemTests::HELPER_SetDescriptorDefaults()
+{
+    descriptor.segment_size = 128 * 1024;
+    descriptor.port_queue_capacity = 16;
+}
+
+int main(int argc, char **argv)
+{
+    Log::SetVerbosity(Log::Warning);
+    g_default_port = get_port();
+
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -174,6 +174,238 @@ TEST_F(UDPv4Tests, send_and_receive_between_ports)
     sem.wait();
 }
 
+TEST_F(UDPv4Tests, send_and_receive_between_ports_using_shared_receive_threads)
+{
+    descriptor.receive_threads = 2;
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t multicastLocator;
+    multicastLocator.port = g_default_port;
+    multicastLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(multicastLocator, 239, 255, 0, 1);
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+
+    MockReceiverResource receiver(transportUnderTest, multicastLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, outputChannelLocator)); // Includes loopback
+    ASSERT_FALSE(send_resource_list.empty());
+    ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(multicastLocator));
+    octet message[5] = { 'H','e','l','l','o' };
+
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(message,msg_recv->data,5), 0);
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(send_resource_list.at(0)->send(message, 5, multicastLocator, std::chrono::microseconds(100)));
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    senderThread->join();
+    sem.wait();
+}
+
+TEST_F(UDPv4Tests, send_gathered_buffers_as_a_single_datagram)
+{
+    descriptor.maxMessageSize = 65000;
+    descriptor.sendBufferSize = 65000;
+    descriptor.receiveBufferSize = 65000;
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    Locator_t multicastLocator;
+    multicastLocator.port = g_default_port;
+    multicastLocator.kind = LOCATOR_KIND_UDPv4;
+    IPLocator::setIPv4(multicastLocator, 239, 255, 0, 1);
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+
+    MockReceiverResource receiver(transportUnderTest, multicastLocator);
+    MockMessageReceiver *msg_recv = dynamic_cast<MockMessageReceiver*>(receiver.CreateMessageReceiver());
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, outputChannelLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(multicastLocator));
+    octet header[4] = { 'R','T','P','S' };
+    octet payload[7] = { 'P','a','y','l','o','a','d' };
+    octet padding[1] = { 0 };
+    octet expected[12] = { 'R','T','P','S','P','a','y','l','o','a','d', 0 };
+
+    std::vector<NetworkBuffer> buffers;
+    buffers.emplace_back(header, 4);
+    buffers.emplace_back(payload, 7);
+    buffers.emplace_back(padding, 1);
+
+    Semaphore sem;
+    std::function<void()> recCallback = [&]()
+    {
+        EXPECT_EQ(memcmp(expected, msg_recv->data, 12), 0);
+        sem.post();
+    };
+
+    msg_recv->setCallback(recCallback);
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(send_resource_list.at(0)->send(buffers, 12, multicastLocator, std::chrono::microseconds(100)));
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    senderThread->join();
+    sem.wait();
+}
+
+TEST_F(UDPv4Tests, send_to_several_destinations_at_once)
+{
+    descriptor.maxMessageSize = 65000;
+    descriptor.sendBufferSize = 65000;
+    descriptor.receiveBufferSize = 65000;
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    const size_t num_destinations = 3;
+    Locator_t destinations[num_destinations];
+    std::vector<std::unique_ptr<MockReceiverResource>> receivers;
+    std::vector<MockMessageReceiver*> msg_recvs;
+    for (size_t i = 0; i < num_destinations; ++i)
+    {
+        destinations[i].port = static_cast<uint32_t>(g_default_port + 2 * i);
+        destinations[i].kind = LOCATOR_KIND_UDPv4;
+        IPLocator::setIPv4(destinations[i], 239, 255, 0, 1);
+
+        receivers.emplace_back(new MockReceiverResource(transportUnderTest, destinations[i]));
+        msg_recvs.push_back(dynamic_cast<MockMessageReceiver*>(receivers.back()->CreateMessageReceiver()));
+        ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(destinations[i]));
+    }
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, outputChannelLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet header[4] = { 'R','T','P','S' };
+    octet payload[5] = { 'H','e','l','l','o' };
+    octet expected[9] = { 'R','T','P','S','H','e','l','l','o' };
+
+    std::vector<NetworkBuffer> buffers;
+    buffers.emplace_back(header, 4);
+    buffers.emplace_back(payload, 5);
+
+    Semaphore sem;
+    for (MockMessageReceiver* msg_recv : msg_recvs)
+    {
+        msg_recv->setCallback([&sem, msg_recv, &expected]()
+                {
+                    EXPECT_EQ(memcmp(expected, msg_recv->data, 9), 0);
+                    sem.post();
+                });
+    }
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(send_resource_list.at(0)->send(buffers, 9, destinations, num_destinations,
+                std::chrono::microseconds(100)));
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    senderThread->join();
+    for (size_t i = 0; i < num_destinations; ++i)
+    {
+        sem.wait();
+    }
+}
+
+TEST_F(UDPv4Tests, send_to_several_unicast_destinations_at_once)
+{
+    descriptor.maxMessageSize = 65000;
+    descriptor.sendBufferSize = 65000;
+    descriptor.receiveBufferSize = 65000;
+    UDPv4Transport transportUnderTest(descriptor);
+    transportUnderTest.init();
+
+    const size_t num_receivers = 3;
+    Locator_t receiver_locators[num_receivers];
+    std::vector<std::unique_ptr<MockReceiverResource>> receivers;
+    std::vector<MockMessageReceiver*> msg_recvs;
+    for (size_t i = 0; i < num_receivers; ++i)
+    {
+        receiver_locators[i].port = static_cast<uint32_t>(g_default_port + 2 * i);
+        receiver_locators[i].kind = LOCATOR_KIND_UDPv4;
+        IPLocator::setIPv4(receiver_locators[i], 127, 0, 0, 1);
+
+        receivers.emplace_back(new MockReceiverResource(transportUnderTest, receiver_locators[i]));
+        msg_recvs.push_back(dynamic_cast<MockMessageReceiver*>(receivers.back()->CreateMessageReceiver()));
+        ASSERT_TRUE(transportUnderTest.IsInputChannelOpen(receiver_locators[i]));
+    }
+
+    // More destinations than datagrams are sent on a single call, so the list is sent in several of them.
+    const size_t num_destinations = 65;
+    std::vector<Locator_t> destinations;
+    for (size_t i = 0; i < num_destinations; ++i)
+    {
+        destinations.push_back(receiver_locators[i % num_receivers]);
+    }
+
+    Locator_t outputChannelLocator;
+    outputChannelLocator.port = g_default_port + 1;
+    outputChannelLocator.kind = LOCATOR_KIND_UDPv4;
+
+    SendResourceList send_resource_list;
+    ASSERT_TRUE(transportUnderTest.OpenOutputChannel(send_resource_list, outputChannelLocator));
+    ASSERT_FALSE(send_resource_list.empty());
+    octet header[4] = { 'R','T','P','S' };
+    octet payload[5] = { 'H','e','l','l','o' };
+    octet expected[9] = { 'R','T','P','S','H','e','l','l','o' };
+
+    std::vector<NetworkBuffer> buffers;
+    buffers.emplace_back(header, 4);
+    buffers.emplace_back(payload, 5);
+
+    Semaphore sem;
+    for (MockMessageReceiver* msg_recv : msg_recvs)
+    {
+        msg_recv->setCallback([&sem, msg_recv, &expected]()
+                {
+                    EXPECT_EQ(memcmp(expected, msg_recv->data, 9), 0);
+                    sem.post();
+                });
+    }
+
+    auto sendThreadFunction = [&]()
+    {
+        EXPECT_TRUE(send_resource_list.at(0)->send(buffers, 9, destinations.data(), destinations.size(),
+                std::chrono::microseconds(100)));
+    };
+
+    senderThread.reset(new std::thread(sendThreadFunction));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    senderThread->join();
+    for (size_t i = 0; i < num_destinations; ++i)
+    {
+        sem.wait();
+    }
+}
+
 TEST_F(UDPv4Tests, send_to_loopback)
 {
     UDPv4Transport transportUnderTest(descriptor);
@@ -0,0 +1,136 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/utils/collections/HeadIndexedVector.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace eprosima::fastrtps;
+
+TEST(HeadIndexedVectorTests, empty_vector)
+{
+    HeadIndexedVector<int> uut;
+
+    ASSERT_TRUE(uut.empty());
+    ASSERT_EQ(uut.size(), 0u);
+    ASSERT_TRUE(uut.begin() == uut.end());
+    ASSERT_TRUE(uut.rbegin() == uut.rend());
+}
+
+TEST(HeadIndexedVectorTests, erase_front_keeps_order)
+{
+    HeadIndexedVector<int> uut;
+    for (int i = 0; i < 10; ++i)
+    {
+        uut.push_back(i);
+    }
+
+    auto it = uut.erase(uut.begin());
+    ASSERT_TRUE(it == uut.begin());
+    ASSERT_EQ(uut.size(), 9u);
+    ASSERT_EQ(uut.front(), 1);
+    ASSERT_EQ(uut.back(), 9);
+    ASSERT_EQ(uut[0], 1);
+
+    // Near the front, near the back and the last one
+    it = uut.erase(uut.begin() + 2);
+    ASSERT_EQ(*it, 4);
+    it = uut.erase(uut.begin() + 5);
+    ASSERT_EQ(*it, 8);
+    it = uut.erase(uut.end() - 1);
+    ASSERT_TRUE(it == uut.end());
+
+    std::vector<int> expected = {1, 2, 4, 5, 6, 8};
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), uut.begin()));
+    ASSERT_TRUE(std::equal(expected.rbegin(), expected.rend(), uut.rbegin()));
+}
+
+TEST(HeadIndexedVectorTests, fifo_does_not_grow)
+{
+    HeadIndexedVector<int> uut;
+    uut.reserve(16);
+    for (int i = 0; i < 8; ++i)
+    {
+        uut.push_back(i);
+    }
+
+    // Once the room before the head is reclaimed, the storage is reused.
+    const int* first_storage = &uut.front();
+    for (int i = 8; i < 10000; ++i)
+    {
+        uut.erase(uut.begin());
+        uut.push_back(i);
+        ASSERT_EQ(uut.size(), 8u);
+        ASSERT_EQ(uut.front(), i - 7);
+        ASSERT_EQ(uut.back(), i);
+    }
+    uut.erase(uut.begin());
+    uut.push_back(0);
+    ASSERT_GE(&uut.front(), first_storage);
+    ASSERT_LT(&uut.back(), first_storage + 16);
+}
+
+TEST(HeadIndexedVectorTests, random_operations_match_vector)
+{
+    HeadIndexedVector<int> uut;
+    std::vector<int> expected;
+    std::mt19937 rng(12345);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        uint32_t op = rng() % 4;
+        if (expected.empty() || op == 0)
+        {
+            uut.push_back(i);
+            expected.push_back(i);
+        }
+        else if (op == 1)
+        {
+            size_t pos = rng() % (expected.size() + 1);
+            auto it = uut.insert(uut.begin() + pos, i);
+            expected.insert(expected.begin() + pos, i);
+            ASSERT_EQ(*it, i);
+            ASSERT_EQ(static_cast<size_t>(it - uut.begin()), pos);
+        }
+        else if (op == 2)
+        {
+            uut.erase(uut.begin());
+            expected.erase(expected.begin());
+        }
+        else
+        {
+            size_t pos = rng() % expected.size();
+            auto it = uut.erase(uut.begin() + pos);
+            expected.erase(expected.begin() + pos);
+            ASSERT_EQ(static_cast<size_t>(it - uut.begin()), pos);
+        }
+
+        ASSERT_EQ(uut.size(), expected.size());
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), uut.begin()));
+    }
+
+    uut.clear();
+    ASSERT_TRUE(uut.empty());
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,124 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fastrtps/utils/collections/IndexedHeap.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+using namespace eprosima::fastrtps;
+
+TEST(IndexedHeapTests, empty_heap)
+{
+    IndexedHeap<int, int> uut;
+
+    ASSERT_TRUE(uut.empty());
+    ASSERT_EQ(uut.size(), 0u);
+    ASSERT_FALSE(uut.contains(1));
+    ASSERT_FALSE(uut.erase(1));
+}
+
+TEST(IndexedHeapTests, top_is_lowest_priority)
+{
+    IndexedHeap<int, int> uut;
+
+    uut.update(1, 50);
+    uut.update(2, 10);
+    uut.update(3, 30);
+
+    ASSERT_EQ(uut.size(), 3u);
+    EXPECT_EQ(uut.top().first, 10);
+    EXPECT_EQ(uut.top().second, 2);
+}
+
+TEST(IndexedHeapTests, update_existing_key)
+{
+    IndexedHeap<int, int> uut;
+
+    uut.update(1, 50);
+    uut.update(2, 10);
+    uut.update(3, 30);
+
+    // Moving the top down
+    uut.update(2, 60);
+    ASSERT_EQ(uut.size(), 3u);
+    EXPECT_EQ(uut.top().second, 3);
+
+    // Moving a leaf up
+    uut.update(2, 5);
+    EXPECT_EQ(uut.top().second, 2);
+    EXPECT_EQ(uut.top().first, 5);
+}
+
+TEST(IndexedHeapTests, erase_keys)
+{
+    IndexedHeap<int, int> uut;
+
+    uut.update(1, 50);
+    uut.update(2, 10);
+    uut.update(3, 30);
+
+    ASSERT_TRUE(uut.erase(2));
+    ASSERT_FALSE(uut.erase(2));
+    ASSERT_FALSE(uut.contains(2));
+    EXPECT_EQ(uut.top().second, 3);
+
+    ASSERT_TRUE(uut.erase(1));
+    EXPECT_EQ(uut.top().second, 3);
+
+    ASSERT_TRUE(uut.erase(3));
+    ASSERT_TRUE(uut.empty());
+}
+
+TEST(IndexedHeapTests, random_operations_keep_order)
+{
+    IndexedHeap<uint32_t, uint32_t> uut;
+    std::map<uint32_t, uint32_t> reference;
+    std::mt19937 generator(1234);
+
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        uint32_t key = generator() % 256;
+        if (generator() % 4 == 0)
+        {
+            ASSERT_EQ(uut.erase(key), reference.erase(key) == 1u);
+        }
+        else
+        {
+            uint32_t priority = generator() % 100000;
+            uut.update(key, priority);
+            reference[key] = priority;
+        }
+
+        ASSERT_EQ(uut.size(), reference.size());
+        if (!reference.empty())
+        {
+            auto lowest = std::min_element(reference.begin(), reference.end(),
+                    [](const std::pair<const uint32_t, uint32_t>& lhs, const std::pair<const uint32_t, uint32_t>& rhs)
+                    {
+                        return lhs.second < rhs.second;
+                    });
+            ASSERT_EQ(uut.top().first, lowest->second);
+            ASSERT_EQ(reference[uut.top().second], lowest->second);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -18,6 +18,7 @@
 #include <fastrtps/utils/IPLocator.h>
 #include <fastrtps/transport/TCPTransportDescriptor.h>
 #include <fastrtps/transport/UDPTransportDescriptor.h>
+#include <fastrtps/transport/SharedMemTransportDescriptor.h>
 #include <gtest/gtest.h>
 #include <memory>
 #include <thread>
@@ -100,6 +101,8 @@ TEST_F(XMLProfileParserTests, XMLParserParcipant)
     locator.port = 1979;
     EXPECT_EQ(rtps_atts.sendSocketBufferSize, 32u);
     EXPECT_EQ(rtps_atts.listenSocketBufferSize, 1000u);
+    EXPECT_EQ(rtps_atts.receiveProcessingThreads, 2u);
+    EXPECT_EQ(rtps_atts.intraprocessDelivery, true);
     EXPECT_EQ(builtin.discovery_config.discoveryProtocol, eprosima::fastrtps::rtps::DiscoveryProtocol::SIMPLE);
     EXPECT_EQ(builtin.use_WriterLivelinessProtocol, false);
     EXPECT_EQ(builtin.discovery_config.use_SIMPLE_EndpointDiscoveryProtocol, true);
@@ -169,6 +172,8 @@ TEST_F(XMLProfileParserTests, XMLParserDefaultParcipantProfile)
     locator.port = 1979;
     EXPECT_EQ(rtps_atts.sendSocketBufferSize, 32u);
     EXPECT_EQ(rtps_atts.listenSocketBufferSize, 1000u);
+    EXPECT_EQ(rtps_atts.receiveProcessingThreads, 2u);
+    EXPECT_EQ(rtps_atts.intraprocessDelivery, true);
     EXPECT_EQ(builtin.discovery_config.discoveryProtocol, eprosima::fastrtps::rtps::DiscoveryProtocol::SIMPLE);
     EXPECT_EQ(builtin.use_WriterLivelinessProtocol, false);
     EXPECT_EQ(builtin.discovery_config.use_SIMPLE_EndpointDiscoveryProtocol, true);
@@ -276,6 +281,7 @@ TEST_F(XMLProfileParserTests, XMLParserPublisher)
     //EXPECT_EQ(loc_list_it->get_port(), 2021);
     EXPECT_EQ(publisher_atts.throughputController.bytesPerPeriod, 9236u);
     EXPECT_EQ(publisher_atts.throughputController.periodMillisecs, 234u);
+    EXPECT_EQ(publisher_atts.throughputController.burstSize, 18472u);
     EXPECT_EQ(publisher_atts.historyMemoryPolicy, DYNAMIC_RESERVE_MEMORY_MODE);
     EXPECT_EQ(publisher_atts.getUserDefinedID(), 67);
     EXPECT_EQ(publisher_atts.getEntityID(), 87);
@@ -344,6 +350,7 @@ TEST_F(XMLProfileParserTests, XMLParserDefaultPublisherProfile)
     //EXPECT_EQ(loc_list_it->get_port(), 2021);
     EXPECT_EQ(publisher_atts.throughputController.bytesPerPeriod, 9236u);
     EXPECT_EQ(publisher_atts.throughputController.periodMillisecs, 234u);
+    EXPECT_EQ(publisher_atts.throughputController.burstSize, 18472u);
     EXPECT_EQ(publisher_atts.historyMemoryPolicy, DYNAMIC_RESERVE_MEMORY_MODE);
     EXPECT_EQ(publisher_atts.getUserDefinedID(), 67);
     EXPECT_EQ(publisher_atts.getEntityID(), 87);
@@ -637,6 +644,11 @@ TEST_F(XMLProfileParserTests, UDP_transport_descriptors_config)
     EXPECT_EQ(descriptor->receiveBufferSize, 8192u);
     EXPECT_EQ(descriptor->TTL, 250u);
     EXPECT_EQ(descriptor->non_blocking_send, true);
+    EXPECT_EQ(descriptor->receive_batch_size, 16u);
+    EXPECT_EQ(descriptor->receive_threads, 2u);
+    ASSERT_EQ(descriptor->receive_threads_affinity.size(), 2u);
+    EXPECT_EQ(descriptor->receive_threads_affinity[0], 1u);
+    EXPECT_EQ(descriptor->receive_threads_affinity[1], 3u);
     EXPECT_EQ(descriptor->maxMessageSize, 16384u);
     EXPECT_EQ(descriptor->maxInitialPeersRange, 100u);
     EXPECT_EQ(descriptor->interfaceWhiteList.size(), 2u);
@@ -645,6 +657,24 @@ TEST_F(XMLProfileParserTests, UDP_transport_descriptors_config)
     EXPECT_EQ(descriptor->m_output_udp_socket, 5101u);
 }
 
+TEST_F(XMLProfileParserTests, SHM_transport_descriptors_config)
+{
+    ASSERT_EQ(  xmlparser::XMLP_ret::XML_OK,
+        xmlparser::XMLProfileManager::loadXMLFile("SHM_transport_descriptors_config.xml"));
+
+    xmlparser::sp_transport_t transport = xmlparser::XMLProfileManager::getTransportById("TestSHM");
+
+    using SharedMemDescriptor = std::shared_ptr<SharedMemTransportDescriptor>;
+    SharedMemDescriptor descriptor = std::dynamic_pointer_cast<SharedMemTransportDescriptor>(transport);
+
+    ASSERT_NE(descriptor, nullptr);
+    EXPECT_EQ(descriptor->segment_size, 4194304u);
+    EXPECT_EQ(descriptor->port_queue_capacity, 1024u);
+    EXPECT_EQ(descriptor->permissions, 0660u);
+    EXPECT_EQ(descriptor->maxMessageSize, 1048576u);
+    EXPECT_EQ(descriptor->maxInitialPeersRange, 10u);
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);